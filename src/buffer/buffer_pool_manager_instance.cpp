@@ -48,44 +48,124 @@ BufferPoolManagerInstance::~BufferPoolManagerInstance() {
 }
 
 bool BufferPoolManagerInstance::FlushPgImp(page_id_t page_id) {
-  // Make sure you call DiskManager::WritePage!
-  return false;
+  std::scoped_lock guard(latch_);
+  auto iter = page_table_.find(page_id);
+  if (page_id == INVALID_PAGE_ID || iter == page_table_.end()) {
+    return false;
+  }
+  Page *page = &pages_[iter->second];
+  disk_manager_->WritePage(page_id, page->GetData());
+  page->is_dirty_ = false;
+  return true;
 }
 
 void BufferPoolManagerInstance::FlushAllPgsImp() {
-  // You can do it!
+  std::scoped_lock guard(latch_);
+  for (const auto &entry : page_table_) {
+    Page *page = &pages_[entry.second];
+    disk_manager_->WritePage(entry.first, page->GetData());
+    page->is_dirty_ = false;
+  }
 }
 
 Page *BufferPoolManagerInstance::NewPgImp(page_id_t *page_id) {
-  // 0.   Make sure you call AllocatePage!
-  // 1.   If all the pages in the buffer pool are pinned, return nullptr.
-  // 2.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
-  // 3.   Update P's metadata, zero out memory and add P to the page table.
-  // 4.   Set the page ID output parameter. Return a pointer to P.
-  return nullptr;
+  std::scoped_lock guard(latch_);
+  frame_id_t frame_id;
+  if (!FindVictimFrame(&frame_id)) {
+    return nullptr;
+  }
+  *page_id = AllocatePage();
+  Page *page = &pages_[frame_id];
+  page->ResetMemory();
+  page->page_id_ = *page_id;
+  page->pin_count_ = 1;
+  page->is_dirty_ = false;
+  page_table_.emplace(*page_id, frame_id);
+  replacer_->Pin(frame_id);
+  return page;
 }
 
 Page *BufferPoolManagerInstance::FetchPgImp(page_id_t page_id) {
-  // 1.     Search the page table for the requested page (P).
-  // 1.1    If P exists, pin it and return it immediately.
-  // 1.2    If P does not exist, find a replacement page (R) from either the free list or the replacer.
-  //        Note that pages are always found from the free list first.
-  // 2.     If R is dirty, write it back to the disk.
-  // 3.     Delete R from the page table and insert P.
-  // 4.     Update P's metadata, read in the page content from disk, and then return a pointer to P.
-  return nullptr;
+  std::scoped_lock guard(latch_);
+  auto iter = page_table_.find(page_id);
+  if (iter != page_table_.end()) {
+    Page *page = &pages_[iter->second];
+    page->pin_count_++;
+    replacer_->Pin(iter->second);
+    return page;
+  }
+  frame_id_t frame_id;
+  if (!FindVictimFrame(&frame_id)) {
+    return nullptr;
+  }
+  Page *page = &pages_[frame_id];
+  page->page_id_ = page_id;
+  page->pin_count_ = 1;
+  page->is_dirty_ = false;
+  disk_manager_->ReadPage(page_id, page->GetData());
+  page_table_.emplace(page_id, frame_id);
+  replacer_->Pin(frame_id);
+  return page;
 }
 
 bool BufferPoolManagerInstance::DeletePgImp(page_id_t page_id) {
-  // 0.   Make sure you call DeallocatePage!
-  // 1.   Search the page table for the requested page (P).
-  // 1.   If P does not exist, return true.
-  // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
-  // 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
-  return false;
+  std::scoped_lock guard(latch_);
+  auto iter = page_table_.find(page_id);
+  if (iter == page_table_.end()) {
+    DeallocatePage(page_id);
+    return true;
+  }
+  frame_id_t frame_id = iter->second;
+  Page *page = &pages_[frame_id];
+  if (page->pin_count_ > 0) {
+    return false;
+  }
+  page_table_.erase(iter);
+  replacer_->Pin(frame_id);
+  page->ResetMemory();
+  page->page_id_ = INVALID_PAGE_ID;
+  page->pin_count_ = 0;
+  page->is_dirty_ = false;
+  free_list_.push_back(frame_id);
+  DeallocatePage(page_id);
+  return true;
+}
+
+bool BufferPoolManagerInstance::UnpinPgImp(page_id_t page_id, bool is_dirty) {
+  std::scoped_lock guard(latch_);
+  auto iter = page_table_.find(page_id);
+  if (iter == page_table_.end()) {
+    return false;
+  }
+  Page *page = &pages_[iter->second];
+  if (page->pin_count_ <= 0) {
+    return false;
+  }
+  page->is_dirty_ = page->is_dirty_ || is_dirty;
+  if (--page->pin_count_ == 0) {
+    replacer_->Unpin(iter->second);
+  }
+  return true;
 }
 
-bool BufferPoolManagerInstance::UnpinPgImp(page_id_t page_id, bool is_dirty) { return false; }
+bool BufferPoolManagerInstance::FindVictimFrame(frame_id_t *frame_id) {
+  if (!free_list_.empty()) {
+    *frame_id = free_list_.front();
+    free_list_.pop_front();
+    return true;
+  }
+  if (!replacer_->Victim(frame_id)) {
+    return false;
+  }
+  // Evict the old page, writing it back first if it was modified.
+  Page *victim = &pages_[*frame_id];
+  if (victim->is_dirty_) {
+    disk_manager_->WritePage(victim->page_id_, victim->GetData());
+    victim->is_dirty_ = false;
+  }
+  page_table_.erase(victim->page_id_);
+  return true;
+}
 
 page_id_t BufferPoolManagerInstance::AllocatePage() {
   const page_id_t next_page_id = next_page_id_;
@@ -14,16 +14,44 @@
 
 namespace bustub {
 
-LRUReplacer::LRUReplacer(size_t num_pages) {}
+LRUReplacer::LRUReplacer(size_t num_pages) : capacity_(num_pages) {}
 
 LRUReplacer::~LRUReplacer() = default;
 
-bool LRUReplacer::Victim(frame_id_t *frame_id) { return false; }
-
-void LRUReplacer::Pin(frame_id_t frame_id) {}
-
-void LRUReplacer::Unpin(frame_id_t frame_id) {}
-
-size_t LRUReplacer::Size() { return 0; }
+bool LRUReplacer::Victim(frame_id_t *frame_id) {
+  std::scoped_lock guard(latch_);
+  if (lru_list_.empty()) {
+    return false;
+  }
+  // The least recently unpinned frame lives at the back of the list.
+  *frame_id = lru_list_.back();
+  lru_map_.erase(*frame_id);
+  lru_list_.pop_back();
+  return true;
+}
+
+void LRUReplacer::Pin(frame_id_t frame_id) {
+  std::scoped_lock guard(latch_);
+  auto iter = lru_map_.find(frame_id);
+  if (iter == lru_map_.end()) {
+    return;
+  }
+  lru_list_.erase(iter->second);
+  lru_map_.erase(iter);
+}
+
+void LRUReplacer::Unpin(frame_id_t frame_id) {
+  std::scoped_lock guard(latch_);
+  if (lru_map_.count(frame_id) != 0 || lru_list_.size() >= capacity_) {
+    return;
+  }
+  lru_list_.push_front(frame_id);
+  lru_map_.emplace(frame_id, lru_list_.begin());
+}
+
+size_t LRUReplacer::Size() {
+  std::scoped_lock guard(latch_);
+  return lru_list_.size();
+}
 
 }  // namespace bustub
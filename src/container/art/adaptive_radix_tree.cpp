@@ -0,0 +1,760 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// adaptive_radix_tree.cpp
+//
+// Identification: src/container/art/adaptive_radix_tree.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "container/art/adaptive_radix_tree.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <thread>  // NOLINT
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "common/rid.h"
+
+namespace bustub {
+
+enum class ArtNodeType : uint8_t { NODE4, NODE16, NODE48, NODE256, LEAF };
+
+/*
+ * Version word: bit 0 marks a replaced (obsolete) node, bit 1 is the write lock, the remaining bits count
+ * modifications. Unlocking adds the lock bit again, which clears it and bumps the count in one step.
+ */
+static constexpr uint64_t ART_OBSOLETE_BIT = 0b01;
+static constexpr uint64_t ART_LOCKED_BIT = 0b10;
+
+struct ArtNode {
+  ArtNode(ArtNodeType type, std::string prefix) : type_(type), prefix_(std::move(prefix)) {}
+
+  std::atomic<uint64_t> version_{0};
+  const ArtNodeType type_;
+  // key bytes every key below this node shares at this point of the path; never changes after construction
+  const std::string prefix_;
+  uint16_t count_{0};
+};
+
+struct ArtNode4 : public ArtNode {
+  explicit ArtNode4(std::string prefix) : ArtNode(ArtNodeType::NODE4, std::move(prefix)) {}
+  uint8_t keys_[4]{};
+  ArtNode *children_[4]{};
+};
+
+struct ArtNode16 : public ArtNode {
+  explicit ArtNode16(std::string prefix) : ArtNode(ArtNodeType::NODE16, std::move(prefix)) {}
+  uint8_t keys_[16]{};
+  ArtNode *children_[16]{};
+};
+
+struct ArtNode48 : public ArtNode {
+  static constexpr uint8_t EMPTY = 48;
+  explicit ArtNode48(std::string prefix) : ArtNode(ArtNodeType::NODE48, std::move(prefix)) {
+    std::fill(child_index_, child_index_ + 256, EMPTY);
+  }
+  uint8_t child_index_[256];
+  ArtNode *children_[48]{};
+};
+
+struct ArtNode256 : public ArtNode {
+  explicit ArtNode256(std::string prefix) : ArtNode(ArtNodeType::NODE256, std::move(prefix)) {}
+  ArtNode *children_[256]{};
+};
+
+template <typename ValueType>
+struct ArtLeaf : public ArtNode {
+  ArtLeaf(std::string key, uint32_t capacity)
+      : ArtNode(ArtNodeType::LEAF, ""), key_(std::move(key)), capacity_(capacity), values_(new ValueType[capacity]) {}
+  const std::string key_;
+  // values_[0, size_) are the values stored under key_; they change in place under the lock of the leaf, and a leaf
+  // that holds capacity_ values is replaced by a larger copy to take one more
+  const uint32_t capacity_;
+  std::atomic<uint32_t> size_{0};
+  const std::unique_ptr<ValueType[]> values_;
+};
+
+namespace {
+
+/*****************************************************************************
+ * OPTIMISTIC LOCK COUPLING
+ *****************************************************************************/
+bool ReadLockOrRestart(const ArtNode *node, uint64_t *version) {
+  uint64_t v = node->version_.load(std::memory_order_acquire);
+  while ((v & ART_LOCKED_BIT) != 0) {
+    std::this_thread::yield();
+    v = node->version_.load(std::memory_order_acquire);
+  }
+  *version = v;
+  return (v & ART_OBSOLETE_BIT) == 0;
+}
+
+/** @return true if nothing changed node since version was read */
+bool CheckOrRestart(const ArtNode *node, uint64_t version) {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return node->version_.load(std::memory_order_relaxed) == version;
+}
+
+bool UpgradeToWriteLockOrRestart(ArtNode *node, uint64_t version) {
+  return node->version_.compare_exchange_strong(version, version + ART_LOCKED_BIT, std::memory_order_acquire);
+}
+
+void WriteUnlock(ArtNode *node) { node->version_.fetch_add(ART_LOCKED_BIT, std::memory_order_release); }
+
+void WriteUnlockObsolete(ArtNode *node) {
+  node->version_.fetch_add(ART_LOCKED_BIT | ART_OBSOLETE_BIT, std::memory_order_release);
+}
+
+/*****************************************************************************
+ * NODE OPERATIONS
+ *****************************************************************************/
+/** @return the slot of byte in a node with a key array, or -1 */
+template <typename NodeType>
+int KeySlot(const NodeType *node, uint8_t byte) {
+  int count = std::min<int>(node->count_, sizeof(node->keys_));
+#if defined(__SSE2__)
+  if constexpr (sizeof(node->keys_) == 16) {
+    __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i *>(node->keys_));
+    __m128i matches = _mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(byte)));
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+    mask &= (1U << count) - 1;
+    return mask == 0 ? -1 : __builtin_ctz(mask);
+  }
+#endif
+  for (int i = 0; i < count; i++) {
+    if (node->keys_[i] == byte) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+ArtNode *FindChild(const ArtNode *node, uint8_t byte) {
+  switch (node->type_) {
+    case ArtNodeType::NODE4: {
+      auto *n = static_cast<const ArtNode4 *>(node);
+      int slot = KeySlot(n, byte);
+      return slot < 0 ? nullptr : n->children_[slot];
+    }
+    case ArtNodeType::NODE16: {
+      auto *n = static_cast<const ArtNode16 *>(node);
+      int slot = KeySlot(n, byte);
+      return slot < 0 ? nullptr : n->children_[slot];
+    }
+    case ArtNodeType::NODE48: {
+      auto *n = static_cast<const ArtNode48 *>(node);
+      uint8_t slot = n->child_index_[byte];
+      return slot == ArtNode48::EMPTY ? nullptr : n->children_[slot];
+    }
+    case ArtNodeType::NODE256:
+      return static_cast<const ArtNode256 *>(node)->children_[byte];
+    case ArtNodeType::LEAF:
+      break;
+  }
+  return nullptr;
+}
+
+bool IsFull(const ArtNode *node) {
+  switch (node->type_) {
+    case ArtNodeType::NODE4:
+      return node->count_ == 4;
+    case ArtNodeType::NODE16:
+      return node->count_ == 16;
+    case ArtNodeType::NODE48:
+      return node->count_ == 48;
+    default:
+      return false;
+  }
+}
+
+/** Adds a child under a byte the node does not hold yet; the node must not be full. */
+void AddChild(ArtNode *node, uint8_t byte, ArtNode *child) {
+  switch (node->type_) {
+    case ArtNodeType::NODE4: {
+      auto *n = static_cast<ArtNode4 *>(node);
+      n->keys_[n->count_] = byte;
+      n->children_[n->count_] = child;
+      break;
+    }
+    case ArtNodeType::NODE16: {
+      auto *n = static_cast<ArtNode16 *>(node);
+      n->keys_[n->count_] = byte;
+      n->children_[n->count_] = child;
+      break;
+    }
+    case ArtNodeType::NODE48: {
+      // removals leave holes, so look for a free slot
+      auto *n = static_cast<ArtNode48 *>(node);
+      uint8_t slot = 0;
+      while (n->children_[slot] != nullptr) {
+        slot++;
+      }
+      n->children_[slot] = child;
+      n->child_index_[byte] = slot;
+      break;
+    }
+    case ArtNodeType::NODE256:
+      static_cast<ArtNode256 *>(node)->children_[byte] = child;
+      break;
+    case ArtNodeType::LEAF:
+      UNREACHABLE("leaves have no children");
+  }
+  node->count_++;
+}
+
+/** Replaces the child under byte. */
+void ChangeChild(ArtNode *node, uint8_t byte, ArtNode *child) {
+  switch (node->type_) {
+    case ArtNodeType::NODE4: {
+      auto *n = static_cast<ArtNode4 *>(node);
+      n->children_[KeySlot(n, byte)] = child;
+      break;
+    }
+    case ArtNodeType::NODE16: {
+      auto *n = static_cast<ArtNode16 *>(node);
+      n->children_[KeySlot(n, byte)] = child;
+      break;
+    }
+    case ArtNodeType::NODE48: {
+      auto *n = static_cast<ArtNode48 *>(node);
+      n->children_[n->child_index_[byte]] = child;
+      break;
+    }
+    case ArtNodeType::NODE256:
+      static_cast<ArtNode256 *>(node)->children_[byte] = child;
+      break;
+    case ArtNodeType::LEAF:
+      UNREACHABLE("leaves have no children");
+  }
+}
+
+template <typename NodeType>
+void RemoveKeySlot(NodeType *node, uint8_t byte) {
+  int slot = KeySlot(node, byte);
+  int last = node->count_ - 1;
+  node->keys_[slot] = node->keys_[last];
+  node->children_[slot] = node->children_[last];
+  node->children_[last] = nullptr;
+}
+
+/** Removes the child under byte. */
+void RemoveChild(ArtNode *node, uint8_t byte) {
+  switch (node->type_) {
+    case ArtNodeType::NODE4:
+      RemoveKeySlot(static_cast<ArtNode4 *>(node), byte);
+      break;
+    case ArtNodeType::NODE16:
+      RemoveKeySlot(static_cast<ArtNode16 *>(node), byte);
+      break;
+    case ArtNodeType::NODE48: {
+      auto *n = static_cast<ArtNode48 *>(node);
+      n->children_[n->child_index_[byte]] = nullptr;
+      n->child_index_[byte] = ArtNode48::EMPTY;
+      break;
+    }
+    case ArtNodeType::NODE256:
+      static_cast<ArtNode256 *>(node)->children_[byte] = nullptr;
+      break;
+    case ArtNodeType::LEAF:
+      UNREACHABLE("leaves have no children");
+  }
+  node->count_--;
+}
+
+/** Calls visit(byte, child) for every child of an inner node. */
+template <typename Visitor>
+void ForEachChild(const ArtNode *node, Visitor &&visit) {
+  switch (node->type_) {
+    case ArtNodeType::NODE4: {
+      auto *n = static_cast<const ArtNode4 *>(node);
+      for (int i = 0; i < n->count_; i++) {
+        visit(n->keys_[i], n->children_[i]);
+      }
+      break;
+    }
+    case ArtNodeType::NODE16: {
+      auto *n = static_cast<const ArtNode16 *>(node);
+      for (int i = 0; i < n->count_; i++) {
+        visit(n->keys_[i], n->children_[i]);
+      }
+      break;
+    }
+    case ArtNodeType::NODE48: {
+      auto *n = static_cast<const ArtNode48 *>(node);
+      for (int byte = 0; byte < 256; byte++) {
+        if (n->child_index_[byte] != ArtNode48::EMPTY) {
+          visit(static_cast<uint8_t>(byte), n->children_[n->child_index_[byte]]);
+        }
+      }
+      break;
+    }
+    case ArtNodeType::NODE256: {
+      auto *n = static_cast<const ArtNode256 *>(node);
+      for (int byte = 0; byte < 256; byte++) {
+        if (n->children_[byte] != nullptr) {
+          visit(static_cast<uint8_t>(byte), n->children_[byte]);
+        }
+      }
+      break;
+    }
+    case ArtNodeType::LEAF:
+      break;
+  }
+}
+
+/** @return a copy of node holding the same children under a new prefix, one size larger if grow is set */
+ArtNode *CopyNode(const ArtNode *node, std::string prefix, bool grow) {
+  ArtNode *copy = nullptr;
+  switch (node->type_) {
+    case ArtNodeType::NODE4:
+      copy = grow ? static_cast<ArtNode *>(new ArtNode16(std::move(prefix))) : new ArtNode4(std::move(prefix));
+      break;
+    case ArtNodeType::NODE16:
+      copy = grow ? static_cast<ArtNode *>(new ArtNode48(std::move(prefix))) : new ArtNode16(std::move(prefix));
+      break;
+    case ArtNodeType::NODE48:
+      copy = grow ? static_cast<ArtNode *>(new ArtNode256(std::move(prefix))) : new ArtNode48(std::move(prefix));
+      break;
+    case ArtNodeType::NODE256:
+      copy = new ArtNode256(std::move(prefix));
+      break;
+    case ArtNodeType::LEAF:
+      UNREACHABLE("leaves are copied with their values");
+  }
+  ForEachChild(node, [copy](uint8_t byte, ArtNode *child) { AddChild(copy, byte, child); });
+  return copy;
+}
+
+/** @return a new leaf holding a single value under key */
+template <typename ValueType>
+ArtLeaf<ValueType> *NewLeaf(std::string key, const ValueType &value) {
+  auto *leaf = new ArtLeaf<ValueType>(std::move(key), 1);
+  leaf->values_[0] = value;
+  leaf->size_.store(1, std::memory_order_relaxed);
+  return leaf;
+}
+
+/** @return a copy of a full leaf with twice its capacity, holding value as well */
+template <typename ValueType>
+ArtLeaf<ValueType> *GrowLeaf(const ArtLeaf<ValueType> *leaf, const ValueType &value) {
+  uint32_t size = leaf->size_.load(std::memory_order_relaxed);
+  auto *grown = new ArtLeaf<ValueType>(leaf->key_, leaf->capacity_ * 2);
+  std::copy(leaf->values_.get(), leaf->values_.get() + size, grown->values_.get());
+  grown->values_[size] = value;
+  grown->size_.store(size + 1, std::memory_order_relaxed);
+  return grown;
+}
+
+/** @return the position of value among the first size values of leaf, or size if it holds no such value */
+template <typename ValueType>
+uint32_t FindValue(const ArtLeaf<ValueType> *leaf, uint32_t size, const ValueType &value) {
+  const ValueType *values = leaf->values_.get();
+  return std::find(values, values + size, value) - values;
+}
+
+/** @return the key byte at pos */
+inline uint8_t KeyByte(const std::string &key, size_t pos) { return static_cast<uint8_t>(key[pos]); }
+
+}  // namespace
+
+/*****************************************************************************
+ * TREE
+ *****************************************************************************/
+template <typename ValueType>
+AdaptiveRadixTree<ValueType>::AdaptiveRadixTree() : root_(new ArtNode256("")) {}
+
+template <typename ValueType>
+AdaptiveRadixTree<ValueType>::~AdaptiveRadixTree() {
+  FreeSubtree(root_);
+  for (auto &retired : retired_) {
+    FreeNode(retired.second);
+  }
+}
+
+template <typename ValueType>
+bool AdaptiveRadixTree<ValueType>::GetValue(const std::string &key, std::vector<ValueType> *result) {
+  bool restart;
+  bool found;
+  uint64_t epoch = EnterEpoch();
+  do {
+    restart = false;
+    found = TryGetValue(key, result, &restart);
+  } while (restart);
+  ExitEpoch(epoch);
+  return found;
+}
+
+template <typename ValueType>
+bool AdaptiveRadixTree<ValueType>::Insert(const std::string &key, const ValueType &value) {
+  bool restart;
+  bool inserted;
+  uint64_t epoch = EnterEpoch();
+  do {
+    restart = false;
+    inserted = TryInsert(key, value, &restart);
+  } while (restart);
+  ExitEpoch(epoch);
+  return inserted;
+}
+
+template <typename ValueType>
+bool AdaptiveRadixTree<ValueType>::Remove(const std::string &key, const ValueType &value) {
+  bool restart;
+  bool removed;
+  uint64_t epoch = EnterEpoch();
+  do {
+    restart = false;
+    removed = TryRemove(key, value, &restart);
+  } while (restart);
+  ExitEpoch(epoch);
+  return removed;
+}
+
+template <typename ValueType>
+bool AdaptiveRadixTree<ValueType>::TryGetValue(const std::string &key, std::vector<ValueType> *result,
+                                               bool *restart) {
+  ArtNode *node = root_;
+  uint64_t version;
+  if (!ReadLockOrRestart(node, &version)) {
+    return *restart = true;
+  }
+  size_t depth = 0;
+  while (true) {
+    const std::string &prefix = node->prefix_;
+    if (depth + prefix.size() >= key.size() || key.compare(depth, prefix.size(), prefix) != 0) {
+      *restart = !CheckOrRestart(node, version);
+      return false;
+    }
+    depth += prefix.size();
+    ArtNode *next = FindChild(node, KeyByte(key, depth));
+    if (!CheckOrRestart(node, version)) {
+      return *restart = true;
+    }
+    if (next == nullptr) {
+      return false;
+    }
+    if (next->type_ == ArtNodeType::LEAF) {
+      // the key of a leaf never changes, its values are read under its version like the children of a node
+      auto *leaf = static_cast<ArtLeaf<ValueType> *>(next);
+      if (leaf->key_ != key) {
+        return false;
+      }
+      uint64_t leaf_version;
+      if (!ReadLockOrRestart(leaf, &leaf_version)) {
+        return *restart = true;
+      }
+      size_t old_size = result->size();
+      uint32_t size = leaf->size_.load(std::memory_order_relaxed);
+      result->insert(result->end(), leaf->values_.get(), leaf->values_.get() + size);
+      if (!CheckOrRestart(leaf, leaf_version)) {
+        result->resize(old_size);
+        return *restart = true;
+      }
+      return true;
+    }
+    uint64_t next_version;
+    if (!ReadLockOrRestart(next, &next_version) || !CheckOrRestart(node, version)) {
+      return *restart = true;
+    }
+    node = next;
+    version = next_version;
+    depth++;
+  }
+}
+
+template <typename ValueType>
+bool AdaptiveRadixTree<ValueType>::TryInsert(const std::string &key, const ValueType &value, bool *restart) {
+  ArtNode *parent = nullptr;
+  uint64_t parent_version = 0;
+  uint8_t parent_byte = 0;
+  ArtNode *node = root_;
+  uint64_t version;
+  if (!ReadLockOrRestart(node, &version)) {
+    return *restart = true;
+  }
+  size_t depth = 0;
+  while (true) {
+    const std::string &prefix = node->prefix_;
+    size_t match = 0;
+    while (match < prefix.size() && depth + match < key.size() && key[depth + match] == prefix[match]) {
+      match++;
+    }
+    if (match < prefix.size()) {
+      // the key leaves the compressed path: a new node takes the shared part, the old node moves below it
+      BUSTUB_ASSERT(depth + match < key.size(), "keys must be prefix-free");
+      if (!UpgradeToWriteLockOrRestart(parent, parent_version)) {
+        return *restart = true;
+      }
+      if (!UpgradeToWriteLockOrRestart(node, version)) {
+        WriteUnlock(parent);
+        return *restart = true;
+      }
+      auto *split = new ArtNode4(prefix.substr(0, match));
+      AddChild(split, KeyByte(prefix, match), CopyNode(node, prefix.substr(match + 1), false));
+      AddChild(split, KeyByte(key, depth + match), NewLeaf(key, value));
+      ChangeChild(parent, parent_byte, split);
+      WriteUnlockObsolete(node);
+      WriteUnlock(parent);
+      Retire(node);
+      return true;
+    }
+    depth += prefix.size();
+    BUSTUB_ASSERT(depth < key.size(), "keys must be prefix-free");
+    uint8_t byte = KeyByte(key, depth);
+    ArtNode *next = FindChild(node, byte);
+    if (!CheckOrRestart(node, version)) {
+      return *restart = true;
+    }
+
+    if (next == nullptr) {
+      if (IsFull(node)) {
+        if (!UpgradeToWriteLockOrRestart(parent, parent_version)) {
+          return *restart = true;
+        }
+        if (!UpgradeToWriteLockOrRestart(node, version)) {
+          WriteUnlock(parent);
+          return *restart = true;
+        }
+        ArtNode *grown = CopyNode(node, prefix, true);
+        AddChild(grown, byte, NewLeaf(key, value));
+        ChangeChild(parent, parent_byte, grown);
+        WriteUnlockObsolete(node);
+        WriteUnlock(parent);
+        Retire(node);
+        return true;
+      }
+      if (!UpgradeToWriteLockOrRestart(node, version)) {
+        return *restart = true;
+      }
+      if (parent != nullptr && !CheckOrRestart(parent, parent_version)) {
+        WriteUnlock(node);
+        return *restart = true;
+      }
+      AddChild(node, byte, NewLeaf(key, value));
+      WriteUnlock(node);
+      return true;
+    }
+    if (parent != nullptr && !CheckOrRestart(parent, parent_version)) {
+      return *restart = true;
+    }
+
+    if (next->type_ == ArtNodeType::LEAF) {
+      auto *leaf = static_cast<ArtLeaf<ValueType> *>(next);
+      if (leaf->key_ == key) {
+        uint64_t leaf_version;
+        if (!ReadLockOrRestart(leaf, &leaf_version)) {
+          return *restart = true;
+        }
+        uint32_t size = leaf->size_.load(std::memory_order_relaxed);
+        if (FindValue(leaf, size, value) < size) {
+          *restart = !CheckOrRestart(leaf, leaf_version);
+          return false;
+        }
+        if (size < leaf->capacity_) {
+          // the leaf has room, and stays where it is
+          if (!UpgradeToWriteLockOrRestart(leaf, leaf_version)) {
+            return *restart = true;
+          }
+          leaf->values_[size] = value;
+          leaf->size_.store(size + 1, std::memory_order_relaxed);
+          WriteUnlock(leaf);
+          return true;
+        }
+        if (!UpgradeToWriteLockOrRestart(node, version)) {
+          return *restart = true;
+        }
+        if (!UpgradeToWriteLockOrRestart(leaf, leaf_version)) {
+          WriteUnlock(node);
+          return *restart = true;
+        }
+        ChangeChild(node, byte, GrowLeaf(leaf, value));
+        WriteUnlockObsolete(leaf);
+        WriteUnlock(node);
+        Retire(leaf);
+        return true;
+      }
+      if (!UpgradeToWriteLockOrRestart(node, version)) {
+        return *restart = true;
+      }
+      // two keys share this slot now: a new node takes their common bytes past the slot
+      size_t end = depth + 1;
+      while (end < key.size() && end < leaf->key_.size() && key[end] == leaf->key_[end]) {
+        end++;
+      }
+      BUSTUB_ASSERT(end < key.size() && end < leaf->key_.size(), "keys must be prefix-free");
+      auto *split = new ArtNode4(key.substr(depth + 1, end - depth - 1));
+      AddChild(split, KeyByte(leaf->key_, end), leaf);
+      AddChild(split, KeyByte(key, end), NewLeaf(key, value));
+      ChangeChild(node, byte, split);
+      WriteUnlock(node);
+      return true;
+    }
+
+    parent = node;
+    parent_version = version;
+    parent_byte = byte;
+    node = next;
+    if (!ReadLockOrRestart(node, &version)) {
+      return *restart = true;
+    }
+    depth++;
+  }
+}
+
+template <typename ValueType>
+bool AdaptiveRadixTree<ValueType>::TryRemove(const std::string &key, const ValueType &value, bool *restart) {
+  ArtNode *node = root_;
+  uint64_t version;
+  if (!ReadLockOrRestart(node, &version)) {
+    return *restart = true;
+  }
+  size_t depth = 0;
+  while (true) {
+    const std::string &prefix = node->prefix_;
+    if (depth + prefix.size() >= key.size() || key.compare(depth, prefix.size(), prefix) != 0) {
+      *restart = !CheckOrRestart(node, version);
+      return false;
+    }
+    depth += prefix.size();
+    uint8_t byte = KeyByte(key, depth);
+    ArtNode *next = FindChild(node, byte);
+    if (!CheckOrRestart(node, version)) {
+      return *restart = true;
+    }
+    if (next == nullptr) {
+      return false;
+    }
+    if (next->type_ == ArtNodeType::LEAF) {
+      auto *leaf = static_cast<ArtLeaf<ValueType> *>(next);
+      if (leaf->key_ != key) {
+        return false;
+      }
+      uint64_t leaf_version;
+      if (!ReadLockOrRestart(leaf, &leaf_version)) {
+        return *restart = true;
+      }
+      uint32_t size = leaf->size_.load(std::memory_order_relaxed);
+      uint32_t pos = FindValue(leaf, size, value);
+      if (pos == size) {
+        *restart = !CheckOrRestart(leaf, leaf_version);
+        return false;
+      }
+      if (size > 1) {
+        // the last value fills the hole, the leaf stays where it is
+        if (!UpgradeToWriteLockOrRestart(leaf, leaf_version)) {
+          return *restart = true;
+        }
+        leaf->values_[pos] = leaf->values_[size - 1];
+        leaf->size_.store(size - 1, std::memory_order_relaxed);
+        WriteUnlock(leaf);
+        return true;
+      }
+      if (!UpgradeToWriteLockOrRestart(node, version)) {
+        return *restart = true;
+      }
+      if (!UpgradeToWriteLockOrRestart(leaf, leaf_version)) {
+        WriteUnlock(node);
+        return *restart = true;
+      }
+      RemoveChild(node, byte);
+      WriteUnlockObsolete(leaf);
+      WriteUnlock(node);
+      Retire(leaf);
+      return true;
+    }
+    uint64_t next_version;
+    if (!ReadLockOrRestart(next, &next_version) || !CheckOrRestart(node, version)) {
+      return *restart = true;
+    }
+    node = next;
+    version = next_version;
+    depth++;
+  }
+}
+
+template <typename ValueType>
+size_t AdaptiveRadixTree<ValueType>::EpochShard() {
+  static thread_local const size_t shard = std::hash<std::thread::id>{}(std::this_thread::get_id()) % EPOCH_SHARDS;
+  return shard;
+}
+
+template <typename ValueType>
+uint64_t AdaptiveRadixTree<ValueType>::EnterEpoch() {
+  size_t shard = EpochShard();
+  while (true) {
+    uint64_t epoch = epoch_.load();
+    active_[epoch % 3][shard].active_.fetch_add(1);
+    // the epoch may have moved on before the operation was counted in it, then count it in the new one instead
+    if (epoch_.load() == epoch) {
+      return epoch;
+    }
+    active_[epoch % 3][shard].active_.fetch_sub(1);
+  }
+}
+
+template <typename ValueType>
+void AdaptiveRadixTree<ValueType>::ExitEpoch(uint64_t epoch) {
+  active_[epoch % 3][EpochShard()].active_.fetch_sub(1);
+}
+
+template <typename ValueType>
+void AdaptiveRadixTree<ValueType>::Retire(ArtNode *node) {
+  std::scoped_lock guard(retired_latch_);
+  // node is unlinked already, so only operations of this epoch or earlier ones can still read it
+  uint64_t epoch = epoch_.load();
+  retired_.emplace_back(epoch, node);
+
+  // the epoch moves on once the operations of the one before have all finished
+  bool idle = true;
+  for (size_t shard = 0; shard < EPOCH_SHARDS && idle; shard++) {
+    idle = active_[(epoch + 2) % 3][shard].active_.load() == 0;
+  }
+  if (idle) {
+    epoch_.store(++epoch);
+  }
+  while (!retired_.empty() && retired_.front().first + 2 <= epoch) {
+    FreeNode(retired_.front().second);
+    retired_.pop_front();
+  }
+}
+
+template <typename ValueType>
+void AdaptiveRadixTree<ValueType>::FreeSubtree(ArtNode *node) {
+  ForEachChild(node, [this](uint8_t byte, ArtNode *child) { FreeSubtree(child); });
+  FreeNode(node);
+}
+
+template <typename ValueType>
+void AdaptiveRadixTree<ValueType>::FreeNode(ArtNode *node) {
+  switch (node->type_) {
+    case ArtNodeType::NODE4:
+      delete static_cast<ArtNode4 *>(node);
+      break;
+    case ArtNodeType::NODE16:
+      delete static_cast<ArtNode16 *>(node);
+      break;
+    case ArtNodeType::NODE48:
+      delete static_cast<ArtNode48 *>(node);
+      break;
+    case ArtNodeType::NODE256:
+      delete static_cast<ArtNode256 *>(node);
+      break;
+    case ArtNodeType::LEAF:
+      delete static_cast<ArtLeaf<ValueType> *>(node);
+      break;
+  }
+}
+
+template class AdaptiveRadixTree<RID>;
+template class AdaptiveRadixTree<int>;
+
+}  // namespace bustub
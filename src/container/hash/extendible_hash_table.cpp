@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -26,7 +28,22 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::ExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                      const KeyComparator &comparator, HashFunction<KeyType> hash_fn)
     : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
-  //  implement me!
+  // start with a directory of global depth 0 pointing at a single empty bucket
+  Page *dir_page = buffer_pool_manager_->NewPage(&directory_page_id_);
+  if (dir_page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate hash table directory page");
+  }
+  page_id_t bucket_page_id;
+  if (buffer_pool_manager_->NewPage(&bucket_page_id) == nullptr) {
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate hash table bucket page");
+  }
+  auto *dir = reinterpret_cast<HashTableDirectoryPage *>(dir_page->GetData());
+  dir->SetPageId(directory_page_id_);
+  dir->SetBucketPageId(0, bucket_page_id);
+  dir->SetLocalDepth(0, 0);
+  buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, true);
 }
 
 /*****************************************************************************
@@ -46,43 +63,160 @@ uint32_t HASH_TABLE_TYPE::Hash(KeyType key) {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 uint32_t HASH_TABLE_TYPE::KeyToDirectoryIndex(KeyType key, HashTableDirectoryPage *dir_page) {
-  return 0;
+  return Hash(key) & dir_page->GetGlobalDepthMask();
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 page_id_t HASH_TABLE_TYPE::KeyToPageId(KeyType key, HashTableDirectoryPage *dir_page) {
-  return 0;
+  return dir_page->GetBucketPageId(KeyToDirectoryIndex(key, dir_page));
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+Page *HASH_TABLE_TYPE::FetchPage(page_id_t page_id) {
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch hash table page");
+  }
+  return page;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 HashTableDirectoryPage *HASH_TABLE_TYPE::FetchDirectoryPage() {
-  return nullptr;
+  return reinterpret_cast<HashTableDirectoryPage *>(FetchPage(directory_page_id_)->GetData());
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_BUCKET_TYPE *HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) {
-  return nullptr;
+  return reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(FetchPage(bucket_page_id)->GetData());
 }
 
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
+/*
+ * Readers only share the directory, so lookups into different buckets never
+ * wait on each other; the bucket page latch orders them against writers of
+ * the same bucket.
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) {
-  return false;
+  uint32_t hash = Hash(key);
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  page_id_t bucket_page_id = dir_page->GetBucketPageId(hash & dir_page->GetGlobalDepthMask());
+  Page *page = FetchPage(bucket_page_id);
+  auto *bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+
+  page->RLatch();
+  bool found = bucket->GetValue(key, comparator_, result, HASH_TABLE_BUCKET_TYPE::Fingerprint(hash));
+  page->RUnlatch();
+
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  return found;
 }
 
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
+/*
+ * The common case fits into the bucket and runs under the shared directory
+ * latch and the bucket's write latch. Only a full bucket falls back to
+ * SplitInsert, which takes the directory exclusively.
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) {
-  return false;
+  uint32_t hash = Hash(key);
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  page_id_t bucket_page_id = dir_page->GetBucketPageId(hash & dir_page->GetGlobalDepthMask());
+  Page *page = FetchPage(bucket_page_id);
+  auto *bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+
+  page->WLatch();
+  bool full = bucket->IsFull();
+  bool inserted = !full && bucket->Insert(key, value, comparator_, HASH_TABLE_BUCKET_TYPE::Fingerprint(hash));
+  page->WUnlatch();
+
+  buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  if (!full) {
+    return inserted;
+  }
+  return SplitInsert(transaction, key, value);
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) {
-  return false;
+  uint8_t tag = HASH_TABLE_BUCKET_TYPE::Fingerprint(Hash(key));
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  bool dir_dirty = false;
+  bool inserted = false;
+  while (true) {
+    // the bucket may have changed while no latch was held, look it up again
+    uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    HASH_TABLE_BUCKET_TYPE *bucket = FetchBucketPage(bucket_page_id);
+    if (!bucket->IsFull()) {
+      inserted = bucket->Insert(key, value, comparator_, tag);
+      buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+      break;
+    }
+    std::vector<ValueType> values;
+    bucket->GetValue(key, comparator_, &values, tag);
+    bool duplicate = std::find(values.begin(), values.end(), value) != values.end();
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    if (duplicate || (local_depth == dir_page->GetGlobalDepth() && dir_page->Size() * 2 > DIRECTORY_ARRAY_SIZE)) {
+      // either nothing to insert or the directory cannot grow any further
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      break;
+    }
+
+    page_id_t image_page_id;
+    Page *image_page = buffer_pool_manager_->NewPage(&image_page_id);
+    if (image_page == nullptr) {
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      break;
+    }
+    auto *image = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(image_page->GetData());
+    if (local_depth == dir_page->GetGlobalDepth()) {
+      dir_page->IncrGlobalDepth();
+    }
+    dir_dirty = true;
+
+    // every slot that pointed at the full bucket gains a bit of local depth, the ones with the new bit set move
+    uint32_t high_bit = dir_page->GetLocalHighBit(bucket_idx);
+    for (uint32_t i = 0; i < dir_page->Size(); i++) {
+      if (dir_page->GetBucketPageId(i) == bucket_page_id) {
+        dir_page->IncrLocalDepth(i);
+        if ((i & high_bit) != 0) {
+          dir_page->SetBucketPageId(i, image_page_id);
+        }
+      }
+    }
+
+    // rebuild the full bucket without tombstones while moving the split image's entries over
+    std::vector<std::pair<MappingType, uint8_t>> entries;
+    entries.reserve(BUCKET_ARRAY_SIZE);
+    for (uint32_t i = 0; i < BUCKET_ARRAY_SIZE; i++) {
+      if (bucket->IsReadable(i)) {
+        entries.emplace_back(MappingType(bucket->KeyAt(i), bucket->ValueAt(i)), bucket->TagAt(i));
+      }
+    }
+    memset(reinterpret_cast<char *>(bucket), 0, PAGE_SIZE);
+    for (const auto &[entry, entry_tag] : entries) {
+      auto *target = (Hash(entry.first) & high_bit) != 0 ? image : bucket;
+      target->Insert(entry.first, entry.second, comparator_, entry_tag);
+    }
+    buffer_pool_manager_->UnpinPage(image_page_id, true);
+    buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, dir_dirty);
+  table_latch_.WUnlock();
+  return inserted;
 }
 
 /*****************************************************************************
@@ -90,14 +224,65 @@ bool HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) {
-  return false;
+  uint32_t hash = Hash(key);
+  table_latch_.RLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  page_id_t bucket_page_id = dir_page->GetBucketPageId(hash & dir_page->GetGlobalDepthMask());
+  Page *page = FetchPage(bucket_page_id);
+  auto *bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(page->GetData());
+
+  page->WLatch();
+  bool removed = bucket->Remove(key, value, comparator_, HASH_TABLE_BUCKET_TYPE::Fingerprint(hash));
+  bool empty = bucket->IsEmpty();
+  page->WUnlatch();
+
+  buffer_pool_manager_->UnpinPage(bucket_page_id, removed);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  table_latch_.RUnlock();
+  if (removed && empty) {
+    Merge(transaction, key, value);
+  }
+  return removed;
 }
 
 /*****************************************************************************
  * MERGE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {}
+void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+  page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+  uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+  uint32_t image_idx = dir_page->GetSplitImageIndex(bucket_idx);
+  page_id_t image_page_id = dir_page->GetBucketPageId(image_idx);
+
+  // the exclusive directory latch keeps everybody else out of the buckets, no page latch needed
+  HASH_TABLE_BUCKET_TYPE *bucket = FetchBucketPage(bucket_page_id);
+  bool empty = bucket->IsEmpty();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  if (!empty || local_depth == 0 || dir_page->GetLocalDepth(image_idx) != local_depth ||
+      image_page_id == bucket_page_id) {
+    buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+    table_latch_.WUnlock();
+    return;
+  }
+
+  for (uint32_t i = 0; i < dir_page->Size(); i++) {
+    page_id_t page_id = dir_page->GetBucketPageId(i);
+    if (page_id == bucket_page_id || page_id == image_page_id) {
+      dir_page->SetBucketPageId(i, image_page_id);
+      dir_page->DecrLocalDepth(i);
+    }
+  }
+  buffer_pool_manager_->DeletePage(bucket_page_id);
+  while (dir_page->CanShrink()) {
+    dir_page->DecrGlobalDepth();
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, true);
+  table_latch_.WUnlock();
+}
 
 /*****************************************************************************
  * GETGLOBALDEPTH - DO NOT TOUCH
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -23,46 +24,288 @@
 namespace bustub {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-HASH_TABLE_TYPE::LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
-                                      const KeyComparator &comparator, size_t num_buckets,
-                                      HashFunction<KeyType> hash_fn)
-    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {}
+LINEAR_PROBE_HASH_TABLE_TYPE::LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
+                                                   const KeyComparator &comparator, size_t num_buckets,
+                                                   HashFunction<KeyType> hash_fn)
+    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
+  header_page_id_ = CreateTable(std::max<size_t>(num_buckets, 1));
+}
+
+/*****************************************************************************
+ * HELPERS
+ *****************************************************************************/
+template <typename KeyType, typename ValueType, typename KeyComparator>
+Page *LINEAR_PROBE_HASH_TABLE_TYPE::FetchPage(page_id_t page_id) {
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch hash table page");
+  }
+  return page;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+page_id_t LINEAR_PROBE_HASH_TABLE_TYPE::CreateTable(size_t num_buckets) {
+  size_t num_blocks = (num_buckets - 1) / BLOCK_ARRAY_SIZE + 1;
+  page_id_t header_page_id;
+  Page *page = buffer_pool_manager_->NewPage(&header_page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate hash table header page");
+  }
+  auto *header = reinterpret_cast<HashTableHeaderPage *>(page->GetData());
+  header->SetPageId(header_page_id);
+  header->SetNextPageId(INVALID_PAGE_ID);
+  header->SetSize(num_blocks * BLOCK_ARRAY_SIZE);
+  // the blocks that do not fit in a header page go to the next header page of the chain
+  page_id_t last_page_id = header_page_id;
+  auto *last = header;
+  for (size_t i = 0; i < num_blocks; i++) {
+    if (last->NumBlocks() == HashTableHeaderPage::MaxBlocks()) {
+      page_id_t next_page_id;
+      Page *next_page = buffer_pool_manager_->NewPage(&next_page_id);
+      if (next_page == nullptr) {
+        buffer_pool_manager_->UnpinPage(last_page_id, true);
+        throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate hash table header page");
+      }
+      auto *next = reinterpret_cast<HashTableHeaderPage *>(next_page->GetData());
+      next->SetPageId(next_page_id);
+      next->SetNextPageId(INVALID_PAGE_ID);
+      next->SetSize(0);
+      last->SetNextPageId(next_page_id);
+      buffer_pool_manager_->UnpinPage(last_page_id, true);
+      last_page_id = next_page_id;
+      last = next;
+    }
+    page_id_t block_page_id;
+    if (buffer_pool_manager_->NewPage(&block_page_id) == nullptr) {
+      buffer_pool_manager_->UnpinPage(last_page_id, true);
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate hash table block page");
+    }
+    buffer_pool_manager_->UnpinPage(block_page_id, true);
+    last->AddBlockPageId(block_page_id);
+  }
+  buffer_pool_manager_->UnpinPage(last_page_id, true);
+  return header_page_id;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+page_id_t LINEAR_PROBE_HASH_TABLE_TYPE::GetBlockPageId(HashTableHeaderPage *header, size_t block_idx) {
+  if (block_idx < header->NumBlocks()) {
+    return header->GetBlockPageId(block_idx);
+  }
+  block_idx -= header->NumBlocks();
+  page_id_t page_id = header->GetNextPageId();
+  while (true) {
+    auto *next = reinterpret_cast<HashTableHeaderPage *>(FetchPage(page_id)->GetData());
+    if (block_idx < next->NumBlocks()) {
+      page_id_t block_page_id = next->GetBlockPageId(block_idx);
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      return block_page_id;
+    }
+    block_idx -= next->NumBlocks();
+    page_id_t next_page_id = next->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void LINEAR_PROBE_HASH_TABLE_TYPE::GetTablePages(page_id_t header_page_id, std::vector<page_id_t> *header_page_ids,
+                                                 std::vector<page_id_t> *block_page_ids) {
+  for (page_id_t page_id = header_page_id; page_id != INVALID_PAGE_ID;) {
+    auto *header = reinterpret_cast<HashTableHeaderPage *>(FetchPage(page_id)->GetData());
+    header_page_ids->push_back(page_id);
+    for (size_t i = 0; i < header->NumBlocks(); i++) {
+      block_page_ids->push_back(header->GetBlockPageId(i));
+    }
+    page_id_t next_page_id = header->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+template <typename Visitor>
+void LINEAR_PROBE_HASH_TABLE_TYPE::Probe(HashTableHeaderPage *header, const KeyType &key, bool exclusive,
+                                         Visitor &&visit) {
+  size_t size = header->GetSize();
+  size_t num_blocks = size / BLOCK_ARRAY_SIZE;
+  size_t slot = hash_fn_.GetHash(key) % size;
+  size_t block_idx = slot / BLOCK_ARRAY_SIZE;
+  slot_offset_t offset = slot % BLOCK_ARRAY_SIZE;
+  size_t probed = 0;
+  bool stop = false;
+  while (!stop && probed < size) {
+    page_id_t block_page_id = GetBlockPageId(header, block_idx);
+    Page *page = FetchPage(block_page_id);
+    auto *block = reinterpret_cast<HASH_TABLE_BLOCK_TYPE *>(page->GetData());
+    bool dirty = false;
+    exclusive ? page->WLatch() : page->RLatch();
+    for (; offset < BLOCK_ARRAY_SIZE && probed < size && !stop; offset++, probed++) {
+      stop = visit(block, offset, &dirty);
+    }
+    exclusive ? page->WUnlatch() : page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(block_page_id, dirty);
+    block_idx = (block_idx + 1) % num_blocks;
+    offset = 0;
+  }
+}
 
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-bool HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) {
-  return false;
+bool LINEAR_PROBE_HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key,
+                                            std::vector<ValueType> *result) {
+  table_latch_.RLock();
+  auto *header = reinterpret_cast<HashTableHeaderPage *>(FetchPage(header_page_id_)->GetData());
+  bool found = false;
+  Probe(header, key, false, [&](HASH_TABLE_BLOCK_TYPE *block, slot_offset_t offset, bool *dirty) {
+    if (!block->IsOccupied(offset)) {
+      return true;
+    }
+    if (block->IsReadable(offset) && comparator_(block->KeyAt(offset), key) == 0) {
+      result->push_back(block->ValueAt(offset));
+      found = true;
+    }
+    return false;
+  });
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  table_latch_.RUnlock();
+  return found;
 }
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-bool HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) {
-  return false;
+bool LINEAR_PROBE_HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  write_latch_.WLock();
+  bool inserted = false;
+  bool duplicate = false;
+  while (!inserted && !duplicate) {
+    auto *header = reinterpret_cast<HashTableHeaderPage *>(FetchPage(header_page_id_)->GetData());
+    size_t size = header->GetSize();
+    if ((occupied_slots_ + 1) * 4 > size * 3) {
+      // keep the load factor below 3/4; mostly tombstones only need a rehash at the same size
+      buffer_pool_manager_->UnpinPage(header_page_id_, false);
+      Rehash(live_slots_ * 2 < occupied_slots_ ? size : size * 2);
+      continue;
+    }
+    // tombstones are never reused, so the first never occupied slot ends the duplicate check as well
+    Probe(header, key, true, [&](HASH_TABLE_BLOCK_TYPE *block, slot_offset_t offset, bool *dirty) {
+      if (!block->IsOccupied(offset)) {
+        inserted = block->Insert(offset, key, value);
+        *dirty = inserted;
+        return true;
+      }
+      duplicate = block->IsReadable(offset) && comparator_(block->KeyAt(offset), key) == 0 &&
+                  block->ValueAt(offset) == value;
+      return duplicate;
+    });
+    buffer_pool_manager_->UnpinPage(header_page_id_, false);
+    if (inserted) {
+      occupied_slots_++;
+      live_slots_++;
+    } else if (!duplicate) {
+      // every slot is taken
+      Rehash(size * 2);
+    }
+  }
+  write_latch_.WUnlock();
+  return inserted;
 }
 
 /*****************************************************************************
  * REMOVE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-bool HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) {
-  return false;
+bool LINEAR_PROBE_HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  write_latch_.WLock();
+  auto *header = reinterpret_cast<HashTableHeaderPage *>(FetchPage(header_page_id_)->GetData());
+  bool removed = false;
+  Probe(header, key, true, [&](HASH_TABLE_BLOCK_TYPE *block, slot_offset_t offset, bool *dirty) {
+    if (!block->IsOccupied(offset)) {
+      return true;
+    }
+    if (block->IsReadable(offset) && comparator_(block->KeyAt(offset), key) == 0 && block->ValueAt(offset) == value) {
+      block->Remove(offset);
+      *dirty = true;
+      removed = true;
+    }
+    return removed;
+  });
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  if (removed) {
+    live_slots_--;
+  }
+  write_latch_.WUnlock();
+  return removed;
 }
 
 /*****************************************************************************
  * RESIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Resize(size_t initial_size) {}
+void LINEAR_PROBE_HASH_TABLE_TYPE::Resize(size_t initial_size) {
+  write_latch_.WLock();
+  Rehash(std::max<size_t>(initial_size * 2, 1));
+  write_latch_.WUnlock();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void LINEAR_PROBE_HASH_TABLE_TYPE::Rehash(size_t num_buckets) {
+  // writers are held off by write_latch_, so the old table only has readers and can be copied without latches
+  std::vector<page_id_t> old_header_page_ids;
+  std::vector<page_id_t> old_block_page_ids;
+  GetTablePages(header_page_id_, &old_header_page_ids, &old_block_page_ids);
+  page_id_t new_header_page_id = CreateTable(std::max(num_buckets, live_slots_ + 1));
+  auto *new_header = reinterpret_cast<HashTableHeaderPage *>(FetchPage(new_header_page_id)->GetData());
+
+  size_t live = 0;
+  for (page_id_t block_page_id : old_block_page_ids) {
+    auto *block = reinterpret_cast<HASH_TABLE_BLOCK_TYPE *>(FetchPage(block_page_id)->GetData());
+    for (slot_offset_t offset = 0; offset < BLOCK_ARRAY_SIZE; offset++) {
+      if (!block->IsReadable(offset)) {
+        continue;
+      }
+      KeyType key = block->KeyAt(offset);
+      ValueType value = block->ValueAt(offset);
+      Probe(new_header, key, true, [&](HASH_TABLE_BLOCK_TYPE *new_block, slot_offset_t new_offset, bool *dirty) {
+        *dirty = new_block->Insert(new_offset, key, value);
+        return *dirty;
+      });
+      live++;
+    }
+    buffer_pool_manager_->UnpinPage(block_page_id, false);
+  }
+  buffer_pool_manager_->UnpinPage(new_header_page_id, false);
+
+  // lookups only wait for the swap itself
+  table_latch_.WLock();
+  header_page_id_ = new_header_page_id;
+  table_latch_.WUnlock();
+  occupied_slots_ = live;
+  live_slots_ = live;
+
+  for (page_id_t block_page_id : old_block_page_ids) {
+    buffer_pool_manager_->DeletePage(block_page_id);
+  }
+  for (page_id_t header_page_id : old_header_page_ids) {
+    buffer_pool_manager_->DeletePage(header_page_id);
+  }
+}
 
 /*****************************************************************************
  * GETSIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-size_t HASH_TABLE_TYPE::GetSize() {
-  return 0;
+size_t LINEAR_PROBE_HASH_TABLE_TYPE::GetSize() {
+  table_latch_.RLock();
+  auto *header = reinterpret_cast<HashTableHeaderPage *>(FetchPage(header_page_id_)->GetData());
+  size_t size = header->GetSize();
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+  table_latch_.RUnlock();
+  return size;
 }
 
 template class LinearProbeHashTable<int, int, IntComparator>;
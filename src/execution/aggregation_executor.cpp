@@ -1,29 +1,96 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// aggregation_executor.cpp
-//
-// Identification: src/execution/aggregation_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-#include <memory>
-#include <vector>
-
-#include "execution/executors/aggregation_executor.h"
-
-namespace bustub {
-
-AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
-                                         std::unique_ptr<AbstractExecutor> &&child)
-    : AbstractExecutor(exec_ctx) {}
-
-void AggregationExecutor::Init() {}
-
-bool AggregationExecutor::Next(Tuple *tuple, RID *rid) { return false; }
-
-const AbstractExecutor *AggregationExecutor::GetChildExecutor() const { return child_.get(); }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_executor.cpp
+//
+// Identification: src/execution/aggregation_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include <memory>
+#include <vector>
+
+#include "execution/executors/aggregation_executor.h"
+
+namespace bustub {
+
+AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const AggregationPlanNode *plan,
+                                         std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)) {}
+
+void AggregationExecutor::Init() {
+  child_->Init();
+  ResetRowBatch();
+
+  auto *shared = exec_ctx_->GetSharedState<AggregationSharedState>(plan_);
+  size_t memory_budget = exec_ctx_->GetMemoryBudget();
+  if (shared != nullptr) {
+    // every worker holds a share of the budget until it merges into the shared table
+    memory_budget /= exec_ctx_->GetWorkerCount();
+  }
+  aht_ = std::make_unique<SimpleAggregationHashTable>(plan_, exec_ctx_->GetBufferPoolManager(), memory_budget);
+
+  // the group-by and aggregate inputs of a whole child batch are computed at once, then folded in unboxed
+  TupleBatch batch(child_->GetOutputSchema());
+  std::vector<ColumnVector> group_bys;
+  std::vector<ColumnVector> aggregates;
+  while (child_->NextBatch(&batch)) {
+    group_bys.clear();
+    for (const auto *expr : plan_->GetGroupBys()) {
+      group_bys.push_back(expr->EvaluateBatch(batch));
+    }
+    aggregates.clear();
+    for (const auto *expr : plan_->GetAggregates()) {
+      aggregates.push_back(expr->EvaluateBatch(batch));
+    }
+    aht_->InsertCombine(batch, group_bys, aggregates);
+  }
+
+  if (shared != nullptr) {
+    size_t worker = shared->next_worker_++;
+    size_t worker_count = shared->tables_.size();
+    shared->tables_[worker] = aht_.get();
+    shared->published_.ArriveAndWait();
+    // every partition is merged by one worker, all of them at once
+    for (uint32_t p = worker; p < SimpleAggregationHashTable::NUM_PARTITIONS; p += worker_count) {
+      for (auto *table : shared->tables_) {
+        if (table != aht_.get()) {
+          aht_->MergePartition(table, p);
+        }
+      }
+    }
+    // the other tables are only read while merging, each worker outputs its own once none is read anymore
+    shared->merged_.ArriveAndWait();
+  }
+  aht_iterator_ = aht_->Begin();
+}
+
+bool AggregationExecutor::Next(Tuple *tuple, RID *rid) { return NextFromBatch(tuple, rid); }
+
+bool AggregationExecutor::NextBatch(TupleBatch *batch) {
+  batch->Reset();
+  const AbstractExpression *having = plan_->GetHaving();
+  for (; !batch->IsFull() && aht_iterator_ != aht_->End(); ++aht_iterator_) {
+    const auto &group_bys = aht_iterator_.Key().group_bys_;
+    const auto aggregates = aht_iterator_.Val().aggregates_;
+    if (having != nullptr) {
+      Value passed = having->EvaluateAggregate(group_bys, aggregates);
+      if (passed.IsNull() || !passed.GetAs<bool>()) {
+        continue;
+      }
+    }
+    std::vector<Value> values;
+    values.reserve(GetOutputSchema()->GetColumnCount());
+    for (const auto &column : GetOutputSchema()->GetColumns()) {
+      values.push_back(column.GetExpr()->EvaluateAggregate(group_bys, aggregates));
+    }
+    batch->Append(values);
+  }
+  return batch->Size() > 0;
+}
+
+const AbstractExecutor *AggregationExecutor::GetChildExecutor() const { return child_.get(); }
+
+}  // namespace bustub
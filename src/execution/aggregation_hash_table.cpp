@@ -0,0 +1,595 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_hash_table.cpp
+//
+// Identification: src/execution/aggregation_hash_table.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/aggregation_hash_table.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "common/exception.h"
+#include "execution/expressions/abstract_expression.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+namespace {
+
+bool IsIntegral(TypeId type) {
+  return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+}
+
+bool IsDecimalRegister(AggregationType agg_type, TypeId input_type) {
+  return agg_type != AggregationType::CountAggregate && input_type == TypeId::DECIMAL;
+}
+
+std::vector<Column> MakeSpillColumns(const AggregationPlanNode *plan) {
+  std::vector<Column> columns;
+  for (uint32_t i = 0; i < plan->GetGroupBys().size(); i++) {
+    TypeId type = plan->GetGroupByAt(i)->GetReturnType();
+    std::string name = "group_" + std::to_string(i);
+    if (type == TypeId::VARCHAR) {
+      columns.emplace_back(name, type, PAGE_SIZE);
+    } else {
+      columns.emplace_back(name, type);
+    }
+  }
+  for (uint32_t i = 0; i < plan->GetAggregates().size(); i++) {
+    bool is_decimal = IsDecimalRegister(plan->GetAggregateTypes()[i], plan->GetAggregateAt(i)->GetReturnType());
+    columns.emplace_back("aggregate_" + std::to_string(i), is_decimal ? TypeId::DECIMAL : TypeId::BIGINT);
+  }
+  return columns;
+}
+
+int64_t AsInteger(const Value &val) {
+  switch (val.GetTypeId()) {
+    case TypeId::TINYINT:
+      return val.GetAs<int8_t>();
+    case TypeId::SMALLINT:
+      return val.GetAs<int16_t>();
+    case TypeId::INTEGER:
+      return val.GetAs<int32_t>();
+    case TypeId::BIGINT:
+      return val.GetAs<int64_t>();
+    default:
+      return val.CastAs(TypeId::BIGINT).GetAs<int64_t>();
+  }
+}
+
+double AsDecimal(const Value &val) {
+  return val.GetTypeId() == TypeId::DECIMAL ? val.GetAs<double>() : val.CastAs(TypeId::DECIMAL).GetAs<double>();
+}
+
+}  // namespace
+
+SimpleAggregationHashTable::SimpleAggregationHashTable(const AggregationPlanNode *plan, BufferPoolManager *bpm,
+                                                       size_t memory_budget, uint32_t level)
+    : plan_(plan),
+      agg_types_(plan->GetAggregateTypes()),
+      spill_schema_(MakeSpillColumns(plan)),
+      bpm_(bpm),
+      memory_budget_(memory_budget),
+      level_(level),
+      partitions_(NUM_PARTITIONS) {
+  BUSTUB_ASSERT(level <= MAX_LEVEL, "no hash bits left to partition by");
+  for (uint32_t i = 0; i < agg_types_.size(); i++) {
+    TypeId input_type = plan->GetAggregateAt(i)->GetReturnType();
+    is_decimal_.push_back(IsDecimalRegister(agg_types_[i], input_type));
+    if (agg_types_[i] == AggregationType::CountAggregate) {
+      output_types_.push_back(TypeId::INTEGER);
+      continue;
+    }
+    if (!IsIntegral(input_type) && input_type != TypeId::DECIMAL) {
+      throw NotImplementedException("SUM, MIN and MAX are only computed over numeric values.");
+    }
+    if (agg_types_[i] == AggregationType::SumAggregate && input_type != TypeId::DECIMAL) {
+      output_types_.push_back(input_type == TypeId::BIGINT ? TypeId::BIGINT : TypeId::INTEGER);
+    } else {
+      output_types_.push_back(input_type);
+    }
+  }
+}
+
+hash_t SimpleAggregationHashTable::HashKey(const AggregateKey &agg_key) {
+  hash_t hash = 0;
+  for (const auto &key : agg_key.group_bys_) {
+    if (!key.IsNull()) {
+      hash = HashUtil::CombineHashes(hash, HashUtil::HashValue(&key));
+    }
+  }
+  return hash;
+}
+
+uint32_t SimpleAggregationHashTable::FindOrInsert(Partition *partition, hash_t hash, const AggregateKey &agg_key) {
+  size_t mask = partition->slots_.size() - 1;
+  if (!partition->slots_.empty()) {
+    for (size_t slot = hash & mask; partition->slots_[slot] != 0; slot = (slot + 1) & mask) {
+      uint32_t group = partition->slots_[slot] - 1;
+      if (partition->hashes_[group] == hash && partition->keys_[group] == agg_key) {
+        return group;
+      }
+    }
+  }
+
+  auto group = static_cast<uint32_t>(partition->hashes_.size());
+  if (2 * (partition->hashes_.size() + 1) > partition->slots_.size()) {
+    // at most half the slots are taken, which keeps the probe sequences short
+    partition->slots_.assign(std::max<size_t>(16, 2 * partition->slots_.size()), 0);
+    mask = partition->slots_.size() - 1;
+    for (uint32_t i = 0; i < group; i++) {
+      size_t slot = partition->hashes_[i] & mask;
+      while (partition->slots_[slot] != 0) {
+        slot = (slot + 1) & mask;
+      }
+      partition->slots_[slot] = i + 1;
+    }
+  }
+  size_t slot = hash & mask;
+  while (partition->slots_[slot] != 0) {
+    slot = (slot + 1) & mask;
+  }
+  partition->slots_[slot] = group + 1;
+
+  partition->hashes_.push_back(hash);
+  partition->keys_.push_back(agg_key);
+  for (uint32_t i = 0; i < agg_types_.size(); i++) {
+    Register reg;
+    switch (agg_types_[i]) {
+      case AggregationType::CountAggregate:
+      case AggregationType::SumAggregate:
+        reg.integer_ = 0;
+        if (is_decimal_[i]) {
+          reg.decimal_ = 0;
+        }
+        break;
+      case AggregationType::MinAggregate:
+        if (is_decimal_[i]) {
+          reg.decimal_ = std::numeric_limits<double>::max();
+        } else {
+          reg.integer_ = std::numeric_limits<int64_t>::max();
+        }
+        break;
+      case AggregationType::MaxAggregate:
+        if (is_decimal_[i]) {
+          reg.decimal_ = std::numeric_limits<double>::lowest();
+        } else {
+          reg.integer_ = std::numeric_limits<int64_t>::min();
+        }
+        break;
+    }
+    partition->registers_.push_back(reg);
+    partition->nulls_.push_back(0);
+  }
+
+  size_t size = sizeof(hash_t) + sizeof(AggregateKey) + 2 * sizeof(uint32_t) +
+                agg_types_.size() * (sizeof(Register) + sizeof(uint8_t));
+  for (const auto &key : agg_key.group_bys_) {
+    size += sizeof(Value) + (key.GetTypeId() == TypeId::VARCHAR ? key.GetLength() : 0);
+  }
+  partition->memory_usage_ += size;
+  memory_usage_ += size;
+  return group;
+}
+
+void SimpleAggregationHashTable::Combine(Register *reg, uint8_t *is_null, uint32_t i, bool input_null,
+                                         int64_t integer, double decimal) const {
+  if (agg_types_[i] == AggregationType::CountAggregate) {
+    // Count increases by one, nulls included.
+    reg->integer_++;
+    return;
+  }
+  if (*is_null != 0) {
+    return;
+  }
+  if (input_null) {
+    *is_null = 1;
+    return;
+  }
+  switch (agg_types_[i]) {
+    case AggregationType::SumAggregate:
+      if (is_decimal_[i]) {
+        reg->decimal_ += decimal;
+      } else if (__builtin_add_overflow(reg->integer_, integer, &reg->integer_)) {
+        throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+      }
+      break;
+    case AggregationType::MinAggregate:
+      if (is_decimal_[i]) {
+        reg->decimal_ = std::min(reg->decimal_, decimal);
+      } else {
+        reg->integer_ = std::min(reg->integer_, integer);
+      }
+      break;
+    case AggregationType::MaxAggregate:
+      if (is_decimal_[i]) {
+        reg->decimal_ = std::max(reg->decimal_, decimal);
+      } else {
+        reg->integer_ = std::max(reg->integer_, integer);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void SimpleAggregationHashTable::CombineColumn(Register *reg, uint8_t *is_null, uint32_t i, const TupleBatch &batch,
+                                               const ColumnVector &column) const {
+  if (agg_types_[i] == AggregationType::CountAggregate) {
+    reg->integer_ += batch.Size();
+    return;
+  }
+  for (uint32_t row : batch.GetSelection()) {
+    if (*is_null != 0) {
+      return;
+    }
+    if (column.GetType() == TypeId::DECIMAL) {
+      Combine(reg, is_null, i, column.IsNull(row), 0, column.GetDecimals()[row]);
+    } else {
+      int64_t integer = column.GetIntegers()[row];
+      Combine(reg, is_null, i, column.IsNull(row), integer, static_cast<double>(integer));
+    }
+  }
+}
+
+void SimpleAggregationHashTable::MergeRegister(Register *reg, uint8_t *is_null, uint32_t i, const Register &partial,
+                                               bool partial_null) const {
+  if (agg_types_[i] == AggregationType::CountAggregate) {
+    // Partial counts add up.
+    reg->integer_ += partial.integer_;
+    return;
+  }
+  // every other partial aggregate folds in like one more input
+  Combine(reg, is_null, i, partial_null, partial.integer_, partial.decimal_);
+}
+
+void SimpleAggregationHashTable::InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
+  hash_t hash = HashKey(agg_key);
+  Partition &partition = partitions_[PartitionOf(hash)];
+  uint32_t group = FindOrInsert(&partition, hash, agg_key);
+  size_t base = group * agg_types_.size();
+  for (uint32_t i = 0; i < agg_types_.size(); i++) {
+    const Value &val = agg_val.aggregates_[i];
+    bool input_null = val.IsNull();
+    int64_t integer = 0;
+    double decimal = 0;
+    if (!input_null && agg_types_[i] != AggregationType::CountAggregate) {
+      if (is_decimal_[i]) {
+        decimal = AsDecimal(val);
+      } else {
+        integer = AsInteger(val);
+      }
+    }
+    Combine(&partition.registers_[base + i], &partition.nulls_[base + i], i, input_null, integer, decimal);
+  }
+  if (memory_usage_ > memory_budget_) {
+    Shrink();
+  }
+}
+
+void SimpleAggregationHashTable::InsertCombine(const TupleBatch &batch, const std::vector<ColumnVector> &group_bys,
+                                               const std::vector<ColumnVector> &aggregates) {
+  if (group_bys.empty()) {
+    // an ungrouped aggregation folds every column straight into the registers of its single group
+    if (batch.Size() == 0) {
+      return;
+    }
+    Partition &partition = partitions_[0];
+    uint32_t group = FindOrInsert(&partition, 0, AggregateKey{});
+    for (uint32_t i = 0; i < agg_types_.size(); i++) {
+      CombineColumn(&partition.registers_[group * agg_types_.size() + i],
+                    &partition.nulls_[group * agg_types_.size() + i], i, batch, aggregates[i]);
+    }
+    return;
+  }
+
+  // the keys are hashed a column at a time, integer columns in one pass, in the order HashKey combines them
+  std::vector<hash_t> hashes(batch.GetCapacity(), 0);
+  std::vector<hash_t> column_hashes(batch.GetCapacity());
+  for (const auto &column : group_bys) {
+    if (IsIntegral(column.GetType())) {
+      HashUtil::HashInts(column.GetIntegers(), batch.GetRowCount(), column_hashes.data());
+    } else {
+      for (uint32_t row : batch.GetSelection()) {
+        if (!column.IsNull(row)) {
+          Value key = column.GetValue(row);
+          column_hashes[row] = HashUtil::HashValue(&key);
+        }
+      }
+    }
+    for (uint32_t row : batch.GetSelection()) {
+      if (!column.IsNull(row)) {
+        hashes[row] = HashUtil::CombineHashes(hashes[row], column_hashes[row]);
+      }
+    }
+  }
+
+  AggregateKey agg_key;
+  for (uint32_t row : batch.GetSelection()) {
+    agg_key.group_bys_.clear();
+    for (const auto &column : group_bys) {
+      agg_key.group_bys_.push_back(column.GetValue(row));
+    }
+    Partition &partition = partitions_[PartitionOf(hashes[row])];
+    uint32_t group = FindOrInsert(&partition, hashes[row], agg_key);
+    size_t base = group * agg_types_.size();
+    for (uint32_t i = 0; i < agg_types_.size(); i++) {
+      const ColumnVector &column = aggregates[i];
+      int64_t integer = 0;
+      double decimal = 0;
+      if (column.GetType() == TypeId::DECIMAL) {
+        decimal = column.GetDecimals()[row];
+      } else if (column.IsInteger()) {
+        integer = column.GetIntegers()[row];
+        decimal = static_cast<double>(integer);
+      }
+      Combine(&partition.registers_[base + i], &partition.nulls_[base + i], i, column.IsNull(row), integer,
+              decimal);
+    }
+    if (memory_usage_ > memory_budget_) {
+      Shrink();
+    }
+  }
+}
+
+void SimpleAggregationHashTable::Reset(Partition *partition) {
+  memory_usage_ -= partition->memory_usage_;
+  partition->memory_usage_ = 0;
+  std::vector<hash_t>().swap(partition->hashes_);
+  std::vector<AggregateKey>().swap(partition->keys_);
+  std::vector<Register>().swap(partition->registers_);
+  std::vector<uint8_t>().swap(partition->nulls_);
+  std::vector<uint32_t>().swap(partition->slots_);
+  partition->reloaded_ = false;
+}
+
+void SimpleAggregationHashTable::Spill(Partition *partition) {
+  if (partition->spill_ == nullptr) {
+    partition->spill_ = std::make_unique<SpillFile>(bpm_);
+  }
+  uint32_t key_count = spill_schema_.GetColumnCount() - agg_types_.size();
+  std::vector<Value> values;
+  for (uint32_t group = 0; group < partition->keys_.size(); group++) {
+    values.clear();
+    for (uint32_t i = 0; i < key_count; i++) {
+      const Value &key = partition->keys_[group].group_bys_[i];
+      TypeId type = spill_schema_.GetColumn(i).GetType();
+      if (key.IsNull()) {
+        values.push_back(ValueFactory::GetNullValueByType(type));
+      } else {
+        values.push_back(key.GetTypeId() == type ? key.Copy() : key.CastAs(type));
+      }
+    }
+    size_t base = group * agg_types_.size();
+    for (uint32_t i = 0; i < agg_types_.size(); i++) {
+      const Register &reg = partition->registers_[base + i];
+      if (partition->nulls_[base + i] != 0) {
+        values.push_back(ValueFactory::GetNullValueByType(is_decimal_[i] ? TypeId::DECIMAL : TypeId::BIGINT));
+      } else if (is_decimal_[i]) {
+        values.push_back(ValueFactory::GetDecimalValue(reg.decimal_));
+      } else {
+        values.push_back(ValueFactory::GetBigIntValue(reg.integer_));
+      }
+    }
+    partition->spill_->Append(Tuple(values, &spill_schema_));
+  }
+  Reset(partition);
+}
+
+void SimpleAggregationHashTable::Shrink() {
+  while (memory_usage_ > memory_budget_) {
+    auto largest = std::max_element(partitions_.begin(), partitions_.end(), [](const auto &lhs, const auto &rhs) {
+      return lhs.memory_usage_ < rhs.memory_usage_;
+    });
+    if (largest->memory_usage_ == 0) {
+      return;
+    }
+    Spill(&*largest);
+  }
+}
+
+void SimpleAggregationHashTable::Reload(Partition *partition) {
+  std::unique_ptr<SpillFile> spill = std::move(partition->spill_);
+  size_t register_count = agg_types_.size();
+  SimpleAggregationHashTable *table = this;
+  if (level_ < MAX_LEVEL) {
+    // the groups of the partition may not fit in the budget either, they are split again by a table of their own;
+    // the keys of a partition of the last level cannot be split any further, it is read back whole
+    size_t memory_budget = level_ + 1 < MAX_LEVEL ? memory_budget_ : std::numeric_limits<size_t>::max();
+    auto reloaded = std::make_unique<SimpleAggregationHashTable>(plan_, bpm_, memory_budget, level_ + 1);
+    table = reloaded.get();
+    for (uint32_t group = 0; group < partition->keys_.size(); group++) {
+      hash_t hash = partition->hashes_[group];
+      table->MergeGroup(&table->partitions_[table->PartitionOf(hash)], hash, partition->keys_[group],
+                        &partition->registers_[group * register_count], &partition->nulls_[group * register_count]);
+      if (table->memory_usage_ > table->memory_budget_) {
+        table->Shrink();
+      }
+    }
+    Reset(partition);
+    partition->reloaded_table_ = std::move(reloaded);
+  } else {
+    partition->reloaded_ = true;
+  }
+
+  uint32_t key_count = spill_schema_.GetColumnCount() - register_count;
+  AggregateKey agg_key;
+  std::vector<Register> partials(register_count);
+  std::vector<uint8_t> partial_nulls(register_count);
+  // the partial aggregates are read in place, from the pinned page
+  auto reader = [&](const std::vector<TupleView> &views) {
+    for (const auto &view : views) {
+      agg_key.group_bys_.clear();
+      for (uint32_t i = 0; i < key_count; i++) {
+        agg_key.group_bys_.push_back(view.GetValue(&spill_schema_, i));
+      }
+      for (uint32_t i = 0; i < register_count; i++) {
+        Value val = view.GetValue(&spill_schema_, key_count + i);
+        partials[i].integer_ = 0;
+        partial_nulls[i] = static_cast<uint8_t>(val.IsNull());
+        if (!val.IsNull()) {
+          if (is_decimal_[i]) {
+            partials[i].decimal_ = val.GetAs<double>();
+          } else {
+            partials[i].integer_ = val.GetAs<int64_t>();
+          }
+        }
+      }
+      hash_t hash = HashKey(agg_key);
+      if (table == this) {
+        MergeGroup(partition, hash, agg_key, partials.data(), partial_nulls.data());
+        continue;
+      }
+      table->MergeGroup(&table->partitions_[table->PartitionOf(hash)], hash, agg_key, partials.data(),
+                        partial_nulls.data());
+      if (table->memory_usage_ > table->memory_budget_) {
+        table->Shrink();
+      }
+    }
+  };
+  for (size_t page = 0; page < spill->GetPageCount(); page++) {
+    spill->ViewPage(page, reader);
+  }
+}
+
+void SimpleAggregationHashTable::MergeGroup(Partition *partition, hash_t hash, const AggregateKey &agg_key,
+                                            const Register *partials, const uint8_t *partial_nulls) {
+  uint32_t group = FindOrInsert(partition, hash, agg_key);
+  size_t base = group * agg_types_.size();
+  for (uint32_t i = 0; i < agg_types_.size(); i++) {
+    MergeRegister(&partition->registers_[base + i], &partition->nulls_[base + i], i, partials[i],
+                  partial_nulls[i] != 0);
+  }
+}
+
+void SimpleAggregationHashTable::MergePartition(SimpleAggregationHashTable *other, uint32_t partition_idx) {
+  Partition &partition = partitions_[partition_idx];
+  Partition &other_partition = other->partitions_[partition_idx];
+  // partial aggregates merge in any order, spilled ones are merged when the partition is read back
+  if (other_partition.spill_ != nullptr) {
+    if (partition.spill_ == nullptr) {
+      partition.spill_ = std::move(other_partition.spill_);
+    } else {
+      partition.spill_->Splice(other_partition.spill_.get());
+      other_partition.spill_ = nullptr;
+    }
+  }
+  for (uint32_t other_group = 0; other_group < other_partition.keys_.size(); other_group++) {
+    uint32_t group =
+        FindOrInsert(&partition, other_partition.hashes_[other_group], other_partition.keys_[other_group]);
+    size_t base = group * agg_types_.size();
+    size_t other_base = other_group * agg_types_.size();
+    for (uint32_t i = 0; i < agg_types_.size(); i++) {
+      MergeRegister(&partition.registers_[base + i], &partition.nulls_[base + i], i,
+                    other_partition.registers_[other_base + i], other_partition.nulls_[other_base + i] != 0);
+    }
+  }
+  other->Reset(&other_partition);
+  // only the merged partition is spilled, the others may be merged by other threads meanwhile
+  if (memory_usage_ > memory_budget_ && !partition.keys_.empty()) {
+    Spill(&partition);
+  }
+}
+
+void SimpleAggregationHashTable::Merge(SimpleAggregationHashTable *other) {
+  for (uint32_t p = 0; p < NUM_PARTITIONS; p++) {
+    MergePartition(other, p);
+  }
+}
+
+void SimpleAggregationHashTable::Swap(SimpleAggregationHashTable *other) {
+  partitions_.swap(other->partitions_);
+  memory_usage_ = other->memory_usage_.exchange(memory_usage_);
+}
+
+void SimpleAggregationHashTable::Clear() {
+  for (auto &partition : partitions_) {
+    Reset(&partition);
+    partition.spill_ = nullptr;
+    partition.reloaded_table_ = nullptr;
+  }
+}
+
+bool SimpleAggregationHashTable::HasSpilled() const {
+  return std::any_of(partitions_.begin(), partitions_.end(),
+                     [](const auto &partition) { return partition.spill_ != nullptr; });
+}
+
+Value SimpleAggregationHashTable::GetRegisterValue(uint32_t i, const Register &reg, bool is_null) const {
+  TypeId type = output_types_[i];
+  if (is_null) {
+    return ValueFactory::GetNullValueByType(type);
+  }
+  switch (type) {
+    case TypeId::TINYINT:
+      return ValueFactory::GetTinyIntValue(static_cast<int8_t>(reg.integer_));
+    case TypeId::SMALLINT:
+      return ValueFactory::GetSmallIntValue(static_cast<int16_t>(reg.integer_));
+    case TypeId::INTEGER:
+      if (reg.integer_ > BUSTUB_INT32_MAX || reg.integer_ < BUSTUB_INT32_MIN) {
+        throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+      }
+      return ValueFactory::GetIntegerValue(static_cast<int32_t>(reg.integer_));
+    case TypeId::DECIMAL:
+      return ValueFactory::GetDecimalValue(reg.decimal_);
+    default:
+      return ValueFactory::GetBigIntValue(reg.integer_);
+  }
+}
+
+AggregateValue SimpleAggregationHashTable::GetAggregateValue(uint32_t partition, uint32_t group) const {
+  const Partition &part = partitions_[partition];
+  size_t base = group * agg_types_.size();
+  AggregateValue agg_val;
+  agg_val.aggregates_.reserve(agg_types_.size());
+  for (uint32_t i = 0; i < agg_types_.size(); i++) {
+    agg_val.aggregates_.push_back(GetRegisterValue(i, part.registers_[base + i], part.nulls_[base + i] != 0));
+  }
+  return agg_val;
+}
+
+void SimpleAggregationHashTable::Iterator::Settle() {
+  while (true) {
+    Position &pos = path_.back();
+    if (pos.partition_ == NUM_PARTITIONS) {
+      if (path_.size() == 1) {
+        return;
+      }
+      // the table a partition was read back into is dropped once iterated over, like the partition itself
+      path_.pop_back();
+      Position &outer = path_.back();
+      outer.table_->partitions_[outer.partition_].reloaded_table_ = nullptr;
+      outer.partition_++;
+      outer.group_ = 0;
+      continue;
+    }
+    Partition &partition = pos.table_->partitions_[pos.partition_];
+    if (pos.group_ == 0 && partition.spill_ != nullptr) {
+      pos.table_->Reload(&partition);
+    }
+    if (partition.reloaded_table_ != nullptr) {
+      path_.push_back(Position{partition.reloaded_table_.get(), 0, 0});
+      continue;
+    }
+    if (pos.group_ < partition.keys_.size()) {
+      return;
+    }
+    if (partition.reloaded_) {
+      // a partition read back from disk is dropped once iterated over, so that one at a time is in memory
+      pos.table_->Reset(&partition);
+    }
+    pos.partition_++;
+    pos.group_ = 0;
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,238 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression.cpp
+//
+// Identification: src/execution/compiled_expression.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/compiled_expression.h"
+
+#include <cstring>
+
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+bool IsIntegral(TypeId type) {
+  return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+}
+
+bool IsCompilable(TypeId type) { return type != TypeId::VARCHAR && type != TypeId::INVALID; }
+
+template <typename T>
+T ReadAs(const char *data) {
+  T val;
+  std::memcpy(&val, data, sizeof(T));
+  return val;
+}
+
+template <typename T>
+bool CompareWith(ComparisonType comp_type, T lhs, T rhs) {
+  switch (comp_type) {
+    case ComparisonType::Equal:
+      return lhs == rhs;
+    case ComparisonType::NotEqual:
+      return lhs != rhs;
+    case ComparisonType::LessThan:
+      return lhs < rhs;
+    case ComparisonType::LessThanOrEqual:
+      return lhs <= rhs;
+    case ComparisonType::GreaterThan:
+      return lhs > rhs;
+    case ComparisonType::GreaterThanOrEqual:
+      return lhs >= rhs;
+  }
+  return false;
+}
+
+}  // namespace
+
+std::unique_ptr<CompiledExpression> CompiledExpression::Compile(const AbstractExpression *expr,
+                                                                const Schema *left_schema,
+                                                                const Schema *right_schema) {
+  std::unique_ptr<CompiledExpression> compiled(new CompiledExpression());
+  int result = compiled->CompileNode(expr, left_schema, right_schema);
+  if (result < 0) {
+    return nullptr;
+  }
+  compiled->result_ = static_cast<uint32_t>(result);
+  compiled->return_type_ = expr->GetReturnType();
+  return compiled;
+}
+
+int CompiledExpression::CompileNode(const AbstractExpression *expr, const Schema *left_schema,
+                                    const Schema *right_schema) {
+  if (!IsCompilable(expr->GetReturnType())) {
+    return -1;
+  }
+  auto dst = static_cast<uint32_t>(registers_.size());
+
+  if (const auto *constant = dynamic_cast<const ConstantValueExpression *>(expr); constant != nullptr) {
+    Value val = constant->Evaluate(nullptr, nullptr);
+    // a column vector unboxes the constant the way loaded columns are
+    ColumnVector unboxed(val.GetTypeId(), 1);
+    unboxed.SetValue(0, val);
+    Register reg{};
+    reg.is_null_ = unboxed.IsNull(0);
+    if (val.GetTypeId() == TypeId::DECIMAL) {
+      reg.decimal_ = unboxed.GetDecimals()[0];
+    } else {
+      reg.integer_ = unboxed.GetIntegers()[0];
+    }
+    registers_.push_back(reg);
+    is_decimal_.push_back(val.GetTypeId() == TypeId::DECIMAL);
+    return static_cast<int>(dst);
+  }
+
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr); column != nullptr) {
+    uint8_t side = right_schema == nullptr ? 0 : static_cast<uint8_t>(column->GetTupleIdx());
+    const Schema *schema = side == 0 ? left_schema : right_schema;
+    const Column &col = schema->GetColumn(column->GetColIdx());
+    if (!IsCompilable(col.GetType())) {
+      return -1;
+    }
+    Instruction inst{};
+    inst.op_ = OpCode::LoadColumn;
+    inst.type_ = col.GetType();
+    inst.side_ = side;
+    inst.col_idx_ = column->GetColIdx();
+    inst.offset_ = col.GetOffset();
+    inst.dst_ = dst;
+    program_.push_back(inst);
+    registers_.push_back(Register{});
+    is_decimal_.push_back(col.GetType() == TypeId::DECIMAL);
+    return static_cast<int>(dst);
+  }
+
+  if (const auto *comparison = dynamic_cast<const ComparisonExpression *>(expr); comparison != nullptr) {
+    TypeId lhs_type = comparison->GetChildAt(0)->GetReturnType();
+    TypeId rhs_type = comparison->GetChildAt(1)->GetReturnType();
+    bool numeric = (IsIntegral(lhs_type) || lhs_type == TypeId::DECIMAL) &&
+                   (IsIntegral(rhs_type) || rhs_type == TypeId::DECIMAL);
+    if (!numeric && lhs_type != rhs_type) {
+      return -1;
+    }
+    int lhs = CompileNode(comparison->GetChildAt(0), left_schema, right_schema);
+    int rhs = lhs < 0 ? -1 : CompileNode(comparison->GetChildAt(1), left_schema, right_schema);
+    if (rhs < 0) {
+      return -1;
+    }
+    // the operands come first, so the comparison gets the next register
+    dst = static_cast<uint32_t>(registers_.size());
+    Instruction inst{};
+    inst.op_ = OpCode::Compare;
+    inst.type_ = lhs_type == TypeId::DECIMAL || rhs_type == TypeId::DECIMAL ? TypeId::DECIMAL : TypeId::BIGINT;
+    inst.comp_type_ = comparison->GetComparisonType();
+    inst.lhs_ = static_cast<uint32_t>(lhs);
+    inst.rhs_ = static_cast<uint32_t>(rhs);
+    inst.dst_ = dst;
+    program_.push_back(inst);
+    registers_.push_back(Register{});
+    is_decimal_.push_back(false);
+    return static_cast<int>(dst);
+  }
+
+  return -1;
+}
+
+void CompiledExpression::Load(const Instruction &inst, const Side &side, Register *reg) {
+  if (side.batch_ != nullptr) {
+    const ColumnVector &column = side.batch_->GetColumn(inst.col_idx_);
+    reg->is_null_ = column.IsNull(side.row_);
+    if (inst.type_ == TypeId::DECIMAL) {
+      reg->decimal_ = column.GetDecimals()[side.row_];
+    } else {
+      reg->integer_ = column.GetIntegers()[side.row_];
+    }
+    return;
+  }
+  // inlined values are stored at their column offset, nulls as the smallest value of their type
+  const char *data = side.data_ + inst.offset_;
+  switch (inst.type_) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT: {
+      auto val = ReadAs<int8_t>(data);
+      reg->is_null_ = val == BUSTUB_INT8_NULL;
+      reg->integer_ = val;
+      break;
+    }
+    case TypeId::SMALLINT: {
+      auto val = ReadAs<int16_t>(data);
+      reg->is_null_ = val == BUSTUB_INT16_NULL;
+      reg->integer_ = val;
+      break;
+    }
+    case TypeId::INTEGER: {
+      auto val = ReadAs<int32_t>(data);
+      reg->is_null_ = val == BUSTUB_INT32_NULL;
+      reg->integer_ = val;
+      break;
+    }
+    case TypeId::BIGINT: {
+      auto val = ReadAs<int64_t>(data);
+      reg->is_null_ = val == BUSTUB_INT64_NULL;
+      reg->integer_ = val;
+      break;
+    }
+    case TypeId::TIMESTAMP: {
+      auto val = ReadAs<uint64_t>(data);
+      reg->is_null_ = val == BUSTUB_TIMESTAMP_NULL;
+      reg->integer_ = static_cast<int64_t>(val);
+      break;
+    }
+    case TypeId::DECIMAL: {
+      auto val = ReadAs<double>(data);
+      reg->is_null_ = val == BUSTUB_DECIMAL_NULL;
+      reg->decimal_ = val;
+      break;
+    }
+    default:
+      UNREACHABLE("Only fixed-size columns are compiled.");
+  }
+}
+
+void CompiledExpression::Run(const Side &left, const Side &right) const {
+  for (const auto &inst : program_) {
+    Register &dst = registers_[inst.dst_];
+    if (inst.op_ == OpCode::LoadColumn) {
+      Load(inst, inst.side_ == 0 ? left : right, &dst);
+      continue;
+    }
+    const Register &lhs = registers_[inst.lhs_];
+    const Register &rhs = registers_[inst.rhs_];
+    dst.is_null_ = lhs.is_null_ || rhs.is_null_;
+    if (dst.is_null_) {
+      continue;
+    }
+    if (inst.type_ == TypeId::DECIMAL) {
+      double left_val = is_decimal_[inst.lhs_] ? lhs.decimal_ : static_cast<double>(lhs.integer_);
+      double right_val = is_decimal_[inst.rhs_] ? rhs.decimal_ : static_cast<double>(rhs.integer_);
+      dst.integer_ = static_cast<int64_t>(CompareWith(inst.comp_type_, left_val, right_val));
+    } else {
+      dst.integer_ = static_cast<int64_t>(CompareWith(inst.comp_type_, lhs.integer_, rhs.integer_));
+    }
+  }
+}
+
+void CompiledExpression::EvaluateInto(const char *data, ColumnVector *column, uint32_t row) const {
+  Run(Side{data, nullptr, 0}, Side{});
+  const Register &reg = registers_[result_];
+  column->SetNull(row, reg.is_null_);
+  if (return_type_ == TypeId::DECIMAL) {
+    column->GetDecimals()[row] = reg.decimal_;
+  } else {
+    column->GetIntegers()[row] = reg.integer_;
+  }
+}
+
+}  // namespace bustub
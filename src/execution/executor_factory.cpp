@@ -19,20 +19,30 @@
 #include "execution/executors/aggregation_executor.h"
 #include "execution/executors/delete_executor.h"
 #include "execution/executors/distinct_executor.h"
+#include "execution/executors/gather_executor.h"
 #include "execution/executors/hash_join_executor.h"
 #include "execution/executors/index_scan_executor.h"
 #include "execution/executors/insert_executor.h"
 #include "execution/executors/limit_executor.h"
+#include "execution/executors/merge_join_executor.h"
 #include "execution/executors/nested_index_join_executor.h"
 #include "execution/executors/nested_loop_join_executor.h"
 #include "execution/executors/seq_scan_executor.h"
+#include "execution/executors/sort_executor.h"
+#include "execution/executors/topn_executor.h"
 #include "execution/executors/update_executor.h"
+#include "execution/plans/topn_plan.h"
 #include "storage/index/generic_key.h"
 
 namespace bustub {
 
 std::unique_ptr<AbstractExecutor> ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx,
-                                                                  const AbstractPlanNode *plan) {
+                                                                  const AbstractPlanNode *plan, bool parallel) {
+  // Run the plan on several workers at once
+  if (parallel && exec_ctx->GetWorkerCount() > 1 && GatherExecutor::IsParallelizable(plan)) {
+    return std::make_unique<GatherExecutor>(exec_ctx, plan, exec_ctx->GetWorkerCount());
+  }
+
   switch (plan->GetType()) {
     // Create a new sequential scan executor
     case PlanType::SeqScan: {
@@ -47,51 +57,58 @@ std::unique_ptr<AbstractExecutor> ExecutorFactory::CreateExecutor(ExecutorContex
     // Create a new insert executor
     case PlanType::Insert: {
       auto insert_plan = dynamic_cast<const InsertPlanNode *>(plan);
-      auto child_executor =
-          insert_plan->IsRawInsert() ? nullptr : ExecutorFactory::CreateExecutor(exec_ctx, insert_plan->GetChildPlan());
+      auto child_executor = insert_plan->IsRawInsert()
+                                ? nullptr
+                                : ExecutorFactory::CreateExecutor(exec_ctx, insert_plan->GetChildPlan(), false);
       return std::make_unique<InsertExecutor>(exec_ctx, insert_plan, std::move(child_executor));
     }
 
     // Create a new update executor
     case PlanType::Update: {
       auto update_plan = dynamic_cast<const UpdatePlanNode *>(plan);
-      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, update_plan->GetChildPlan());
+      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, update_plan->GetChildPlan(), false);
       return std::make_unique<UpdateExecutor>(exec_ctx, update_plan, std::move(child_executor));
     }
 
     // Create a new delete executor
     case PlanType::Delete: {
       auto delete_plan = dynamic_cast<const DeletePlanNode *>(plan);
-      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, delete_plan->GetChildPlan());
+      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, delete_plan->GetChildPlan(), false);
       return std::make_unique<DeleteExecutor>(exec_ctx, delete_plan, std::move(child_executor));
     }
 
     // Create a new limit executor
     case PlanType::Limit: {
       auto limit_plan = dynamic_cast<const LimitPlanNode *>(plan);
-      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, limit_plan->GetChildPlan());
+      if (limit_plan->GetChildPlan()->GetType() == PlanType::Sort) {
+        // the sort only has to keep the tuples that make it past the limit
+        auto sort_plan = dynamic_cast<const SortPlanNode *>(limit_plan->GetChildPlan());
+        auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, sort_plan->GetChildPlan(), parallel);
+        return std::make_unique<TopNExecutor>(exec_ctx, sort_plan, limit_plan->GetLimit(), std::move(child_executor));
+      }
+      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, limit_plan->GetChildPlan(), parallel);
       return std::make_unique<LimitExecutor>(exec_ctx, limit_plan, std::move(child_executor));
     }
 
     // Create a new limit executor
     case PlanType::Distinct: {
       auto distinct_plan = dynamic_cast<const DistinctPlanNode *>(plan);
-      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, distinct_plan->GetChildPlan());
+      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, distinct_plan->GetChildPlan(), parallel);
       return std::make_unique<DistinctExecutor>(exec_ctx, distinct_plan, std::move(child_executor));
     }
 
     // Create a new aggregation executor
     case PlanType::Aggregation: {
       auto agg_plan = dynamic_cast<const AggregationPlanNode *>(plan);
-      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, agg_plan->GetChildPlan());
+      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, agg_plan->GetChildPlan(), parallel);
       return std::make_unique<AggregationExecutor>(exec_ctx, agg_plan, std::move(child_executor));
     }
 
     // Create a new nested-loop join executor
     case PlanType::NestedLoopJoin: {
       auto nested_loop_join_plan = dynamic_cast<const NestedLoopJoinPlanNode *>(plan);
-      auto left = ExecutorFactory::CreateExecutor(exec_ctx, nested_loop_join_plan->GetLeftPlan());
-      auto right = ExecutorFactory::CreateExecutor(exec_ctx, nested_loop_join_plan->GetRightPlan());
+      auto left = ExecutorFactory::CreateExecutor(exec_ctx, nested_loop_join_plan->GetLeftPlan(), parallel);
+      auto right = ExecutorFactory::CreateExecutor(exec_ctx, nested_loop_join_plan->GetRightPlan(), false);
       return std::make_unique<NestedLoopJoinExecutor>(exec_ctx, nested_loop_join_plan, std::move(left),
                                                       std::move(right));
     }
@@ -99,18 +116,40 @@ std::unique_ptr<AbstractExecutor> ExecutorFactory::CreateExecutor(ExecutorContex
     // Create a new nested-index join executor
     case PlanType::NestedIndexJoin: {
       auto nested_index_join_plan = dynamic_cast<const NestedIndexJoinPlanNode *>(plan);
-      auto left = ExecutorFactory::CreateExecutor(exec_ctx, nested_index_join_plan->GetChildPlan());
+      auto left = ExecutorFactory::CreateExecutor(exec_ctx, nested_index_join_plan->GetChildPlan(), parallel);
       return std::make_unique<NestIndexJoinExecutor>(exec_ctx, nested_index_join_plan, std::move(left));
     }
 
     // Create a new hash join executor
     case PlanType::HashJoin: {
       auto hash_join_plan = dynamic_cast<const HashJoinPlanNode *>(plan);
-      auto left = ExecutorFactory::CreateExecutor(exec_ctx, hash_join_plan->GetLeftPlan());
-      auto right = ExecutorFactory::CreateExecutor(exec_ctx, hash_join_plan->GetRightPlan());
+      auto left = ExecutorFactory::CreateExecutor(exec_ctx, hash_join_plan->GetLeftPlan(), parallel);
+      auto right = ExecutorFactory::CreateExecutor(exec_ctx, hash_join_plan->GetRightPlan(), parallel);
       return std::make_unique<HashJoinExecutor>(exec_ctx, hash_join_plan, std::move(left), std::move(right));
     }
 
+    // Create a new merge join executor
+    case PlanType::MergeJoin: {
+      auto merge_join_plan = dynamic_cast<const MergeJoinPlanNode *>(plan);
+      auto left = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetLeftPlan(), false);
+      auto right = ExecutorFactory::CreateExecutor(exec_ctx, merge_join_plan->GetRightPlan(), false);
+      return std::make_unique<MergeJoinExecutor>(exec_ctx, merge_join_plan, std::move(left), std::move(right));
+    }
+
+    // Create a new sort executor
+    case PlanType::Sort: {
+      auto sort_plan = dynamic_cast<const SortPlanNode *>(plan);
+      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, sort_plan->GetChildPlan(), parallel);
+      return std::make_unique<SortExecutor>(exec_ctx, sort_plan, std::move(child_executor));
+    }
+
+    // Create a new top-n executor
+    case PlanType::TopN: {
+      auto topn_plan = dynamic_cast<const TopNPlanNode *>(plan);
+      auto child_executor = ExecutorFactory::CreateExecutor(exec_ctx, topn_plan->GetChildPlan(), parallel);
+      return std::make_unique<TopNExecutor>(exec_ctx, topn_plan, topn_plan->GetN(), std::move(child_executor));
+    }
+
     default:
       UNREACHABLE("Unsupported plan type.");
   }
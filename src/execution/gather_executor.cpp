@@ -0,0 +1,187 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.cpp
+//
+// Identification: src/execution/gather_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/gather_executor.h"
+
+#include <utility>
+
+#include "common/exception.h"
+#include "execution/executor_factory.h"
+#include "execution/executors/aggregation_executor.h"
+#include "execution/executors/hash_join_executor.h"
+#include "execution/morsel_queue.h"
+#include "execution/plans/seq_scan_plan.h"
+
+namespace bustub {
+
+GatherExecutor::GatherExecutor(ExecutorContext *exec_ctx, const AbstractPlanNode *plan, uint32_t worker_count)
+    : AbstractExecutor(exec_ctx), plan_(plan) {
+  for (uint32_t i = 0; i < worker_count; i++) {
+    workers_.push_back(ExecutorFactory::CreateExecutor(exec_ctx, plan, false));
+  }
+}
+
+GatherExecutor::~GatherExecutor() {
+  Stop();
+  ShareState(plan_, false);
+}
+
+bool GatherExecutor::IsParallelizable(const AbstractPlanNode *plan) {
+  switch (plan->GetType()) {
+    case PlanType::SeqScan:
+      return true;
+    case PlanType::HashJoin:
+    case PlanType::Aggregation:
+      for (const auto *child : plan->GetChildren()) {
+        if (!IsParallelizable(child)) {
+          return false;
+        }
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+void GatherExecutor::ShareState(const AbstractPlanNode *plan, bool share) {
+  std::shared_ptr<void> state;
+  if (share) {
+    switch (plan->GetType()) {
+      case PlanType::SeqScan: {
+        auto *scan_plan = dynamic_cast<const SeqScanPlanNode *>(plan);
+        auto *table_info = exec_ctx_->GetCatalog()->GetTable(scan_plan->GetTableOid());
+        state = std::make_shared<MorselQueue>(table_info->table_.get(), exec_ctx_->GetBufferPoolManager());
+        break;
+      }
+      case PlanType::HashJoin: {
+        auto join_state = std::make_shared<HashJoinSharedState>(exec_ctx_->GetBufferPoolManager(),
+                                                                exec_ctx_->GetMemoryBudget(), workers_.size());
+        barriers_.push_back(&join_state->merged_);
+        barriers_.push_back(&join_state->built_);
+        state = std::move(join_state);
+        break;
+      }
+      case PlanType::Aggregation: {
+        auto aggregation_state = std::make_shared<AggregationSharedState>(workers_.size());
+        barriers_.push_back(&aggregation_state->published_);
+        barriers_.push_back(&aggregation_state->merged_);
+        state = std::move(aggregation_state);
+        break;
+      }
+      default:
+        UNREACHABLE("Plan cannot run in parallel.");
+    }
+  }
+  exec_ctx_->SetSharedState(plan, std::move(state));
+  for (const auto *child : plan->GetChildren()) {
+    ShareState(child, share);
+  }
+}
+
+void GatherExecutor::Init() {
+  Stop();
+  ResetRowBatch();
+  batches_.clear();
+  stopped_ = false;
+  error_ = nullptr;
+  running_ = workers_.size();
+  barriers_.clear();
+  // fresh morsels, build tables and barriers for this run
+  ShareState(plan_, true);
+  for (auto &worker : workers_) {
+    threads_.emplace_back(&GatherExecutor::RunWorker, this, worker.get());
+  }
+}
+
+void GatherExecutor::RunWorker(AbstractExecutor *executor) {
+  // a couple of batches per worker keeps them busy while the consumer catches up
+  const size_t max_queued = 2 * workers_.size();
+  try {
+    executor->Init();
+    std::unique_ptr<TupleBatch> batch;
+    while (true) {
+      {
+        std::scoped_lock latch(latch_);
+        if (spare_batches_.empty()) {
+          batch = std::make_unique<TupleBatch>(GetOutputSchema());
+        } else {
+          batch = std::move(spare_batches_.back());
+          spare_batches_.pop_back();
+        }
+      }
+      if (!executor->NextBatch(batch.get())) {
+        break;
+      }
+      std::unique_lock<std::mutex> latch(latch_);
+      has_room_.wait(latch, [&] { return stopped_ || batches_.size() < max_queued; });
+      if (stopped_) {
+        break;
+      }
+      batches_.push_back(std::move(batch));
+      has_batch_.notify_one();
+    }
+  } catch (...) {
+    // the other workers may wait at a barrier for this one, and the consumer rethrows the first error
+    std::scoped_lock latch(latch_);
+    if (error_ == nullptr) {
+      error_ = std::current_exception();
+    }
+    CancelBarriers();
+  }
+  std::scoped_lock latch(latch_);
+  running_--;
+  has_batch_.notify_all();
+}
+
+void GatherExecutor::Stop() {
+  {
+    std::scoped_lock latch(latch_);
+    stopped_ = true;
+    has_room_.notify_all();
+    CancelBarriers();
+  }
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+}
+
+void GatherExecutor::CancelBarriers() {
+  for (auto *barrier : barriers_) {
+    barrier->Cancel();
+  }
+}
+
+bool GatherExecutor::Next(Tuple *tuple, RID *rid) { return NextFromBatch(tuple, rid); }
+
+bool GatherExecutor::NextBatch(TupleBatch *batch) {
+  if (batch->GetCapacity() != BATCH_SIZE) {
+    // the workers fill full-size batches, hand them out through the row interface instead
+    return AbstractExecutor::NextBatch(batch);
+  }
+  std::unique_lock<std::mutex> latch(latch_);
+  has_batch_.wait(latch, [this] { return !batches_.empty() || running_ == 0 || error_ != nullptr; });
+  if (error_ != nullptr) {
+    std::rethrow_exception(error_);
+  }
+  if (batches_.empty()) {
+    batch->Reset();
+    return false;
+  }
+  std::swap(*batch, *batches_.front());
+  spare_batches_.push_back(std::move(batches_.front()));
+  batches_.pop_front();
+  has_room_.notify_one();
+  return true;
+}
+
+}  // namespace bustub
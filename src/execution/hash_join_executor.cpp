@@ -12,15 +12,249 @@
 
 #include "execution/executors/hash_join_executor.h"
 
+#include <limits>
+#include <mutex>  // NOLINT
+
 namespace bustub {
 
 HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlanNode *plan,
                                    std::unique_ptr<AbstractExecutor> &&left_child,
                                    std::unique_ptr<AbstractExecutor> &&right_child)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_child)),
+      right_executor_(std::move(right_child)) {}
+
+void HashJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  ResetRowBatch();
+  Build();
+
+  output_columns_.clear();
+  for (const auto &column : GetOutputSchema()->GetColumns()) {
+    output_columns_.push_back(dynamic_cast<const ColumnValueExpression *>(column.GetExpr()));
+  }
+  probe_batch_ = std::make_unique<TupleBatch>(right_executor_->GetOutputSchema());
+  probe_hashes_.resize(probe_batch_->GetCapacity());
+  probe_pos_ = 0;
+  matches_.clear();
+  match_pos_ = 0;
+
+  right_done_ = false;
+  probe_spills_.clear();
+  probe_spills_.resize(JoinHashTable::NUM_PARTITIONS);
+  spilled_partitions_.clear();
+  spilled_partition_ = SpilledPartition();
+  spilled_table_ = nullptr;
+  spill_page_ = 0;
+  spill_tuple_pos_ = 0;
+}
+
+void HashJoinExecutor::HashKeys(const TupleBatch &batch, const ColumnVector &keys, std::vector<hash_t> *hashes) {
+  if (keys.IsInteger() && keys.GetType() != TypeId::BOOLEAN) {
+    // integers are hashed widened to 64 bits, as they are stored, in one pass over the whole column
+    HashUtil::HashInts(keys.GetIntegers(), batch.GetRowCount(), hashes->data());
+    return;
+  }
+  for (uint32_t row : batch.GetSelection()) {
+    if (!keys.IsNull(row)) {
+      Value key = keys.GetValue(row);
+      (*hashes)[row] = HashUtil::HashValue(&key);
+    }
+  }
+}
+
+void HashJoinExecutor::Build() {
+  BufferPoolManager *bpm = exec_ctx_->GetBufferPoolManager();
+  auto *shared = exec_ctx_->GetSharedState<HashJoinSharedState>(plan_);
+  size_t memory_budget = exec_ctx_->GetMemoryBudget();
+  if (shared != nullptr) {
+    // every worker holds a share of the budget until it merges into the shared table
+    memory_budget /= exec_ctx_->GetWorkerCount();
+  }
+  memory_budget_ = memory_budget;
+  hash_table_ = std::make_unique<JoinHashTable>(bpm, memory_budget);
+
+  TupleBatch build_batch(left_executor_->GetOutputSchema());
+  std::vector<hash_t> hashes(build_batch.GetCapacity());
+  while (left_executor_->NextBatch(&build_batch)) {
+    ColumnVector keys = plan_->LeftJoinKeyExpression()->EvaluateBatch(build_batch);
+    HashKeys(build_batch, keys, &hashes);
+    for (uint32_t row : build_batch.GetSelection()) {
+      if (!keys.IsNull(row)) {
+        hash_table_->Insert(hashes[row], keys.GetValue(row), build_batch.GetTuple(row));
+      }
+    }
+  }
+
+  if (shared == nullptr) {
+    hash_table_->Build();
+    table_ = hash_table_.get();
+    return;
+  }
+  {
+    std::scoped_lock latch(shared->latch_);
+    shared->table_.Merge(hash_table_.get());
+  }
+  hash_table_ = nullptr;
+  if (shared->merged_.ArriveAndWait()) {
+    shared->table_.Build();
+  }
+  // the shared table is complete, and only read, once every worker is past the second barrier
+  shared->built_.ArriveAndWait();
+  table_ = &shared->table_;
+}
+
+bool HashJoinExecutor::NextSpilledPartition() {
+  if (spilled_table_ == nullptr && hash_table_ != nullptr) {
+    // the right child is exhausted, the table of a serial join is only needed for its spilled partitions
+    hash_table_->ReleaseEntries();
+  }
+  // the partitions spilled by the table just probed are joined next, so that few spill files are around at once
+  for (uint32_t i = JoinHashTable::NUM_PARTITIONS; i-- > 0;) {
+    if (probe_spills_[i] == nullptr || probe_spills_[i]->Size() == 0) {
+      continue;
+    }
+    SpilledPartition partition;
+    if (spilled_table_ != nullptr) {
+      partition.level_ = spilled_table_->GetLevel() + 1;
+      partition.owned_build_ = spilled_table_->TakeSpill(i);
+      partition.build_ = partition.owned_build_.get();
+    } else {
+      partition.level_ = table_->GetLevel() + 1;
+      partition.build_ = &table_->GetSpill(i);
+    }
+    partition.probe_ = std::move(probe_spills_[i]);
+    spilled_partitions_.push_back(std::move(partition));
+  }
+  probe_spills_.clear();
+  probe_spills_.resize(JoinHashTable::NUM_PARTITIONS);
+  spilled_table_ = nullptr;
+  if (spilled_partitions_.empty()) {
+    return false;
+  }
+  spilled_partition_ = std::move(spilled_partitions_.back());
+  spilled_partitions_.pop_back();
+
+  // the keys of a partition of the last level cannot be split any further, it is read back whole
+  size_t memory_budget = spilled_partition_.level_ < JoinHashTable::MAX_LEVEL ? memory_budget_
+                                                                               : std::numeric_limits<size_t>::max();
+  BufferPoolManager *bpm = exec_ctx_->GetBufferPoolManager();
+  spilled_table_ = std::make_unique<JoinHashTable>(bpm, memory_budget, spilled_partition_.level_);
+  const SpillFile &build_spill = *spilled_partition_.build_;
+  const Schema *left_schema = left_executor_->GetOutputSchema();
+  std::vector<Tuple> tuples;
+  for (size_t i = 0; i < build_spill.GetPageCount(); i++) {
+    tuples.clear();
+    build_spill.ReadPage(i, &tuples);
+    for (auto &tuple : tuples) {
+      Value key = plan_->LeftJoinKeyExpression()->Evaluate(&tuple, left_schema);
+      spilled_table_->Insert(HashUtil::HashValue(&key), key, std::move(tuple));
+    }
+  }
+  spilled_table_->Build();
+  // the build rows are in the table, or spilled again by it
+  spilled_partition_.build_ = nullptr;
+  spilled_partition_.owned_build_ = nullptr;
+  spill_page_ = 0;
+  spill_tuple_pos_ = 0;
+  return true;
+}
+
+bool HashJoinExecutor::NextProbeBatch() {
+  if (!right_done_) {
+    if (right_executor_->NextBatch(probe_batch_.get())) {
+      return true;
+    }
+    right_done_ = true;
+  }
+
+  // grace hash join: every spilled partition is joined on its own, its probe rows read back a page at a time
+  while (true) {
+    if (spilled_table_ != nullptr && spill_page_ < spilled_partition_.probe_->GetPageCount()) {
+      // the probe rows are unboxed straight from the pinned page, resuming past the ones of the previous batch
+      probe_batch_->Reset();
+      spilled_partition_.probe_->ViewPage(spill_page_, [&](const std::vector<TupleView> &views) {
+        for (; !probe_batch_->IsFull() && spill_tuple_pos_ < views.size(); spill_tuple_pos_++) {
+          probe_batch_->Append(views[spill_tuple_pos_]);
+        }
+        if (spill_tuple_pos_ == views.size()) {
+          spill_page_++;
+          spill_tuple_pos_ = 0;
+        }
+      });
+      if (probe_batch_->GetRowCount() > 0) {
+        return true;
+      }
+      continue;
+    }
+    if (!NextSpilledPartition()) {
+      probe_batch_->Reset();
+      return false;
+    }
+  }
+}
+
+bool HashJoinExecutor::Next(Tuple *tuple, RID *rid) { return NextFromBatch(tuple, rid); }
 
-void HashJoinExecutor::Init() {}
+bool HashJoinExecutor::NextBatch(TupleBatch *batch) {
+  batch->Reset();
+  while (!batch->IsFull()) {
+    if (match_pos_ < matches_.size()) {
+      batch->Append(JoinRow(*matches_[match_pos_++], probe_row_));
+      continue;
+    }
+    if (probe_pos_ >= probe_batch_->Size()) {
+      probe_pos_ = 0;
+      if (!NextProbeBatch()) {
+        break;
+      }
+      probe_keys_ = plan_->RightJoinKeyExpression()->EvaluateBatch(*probe_batch_);
+      HashKeys(*probe_batch_, probe_keys_, &probe_hashes_);
+    }
+    probe_row_ = probe_batch_->RowAt(probe_pos_++);
+    matches_.clear();
+    match_pos_ = 0;
+    if (probe_keys_.IsNull(probe_row_)) {
+      continue;
+    }
+    hash_t hash = probe_hashes_[probe_row_];
+    // the rows of a spilled partition probe the table it was read back into, which may have spilled in turn
+    const JoinHashTable *table = spilled_table_ != nullptr ? spilled_table_.get() : table_;
+    uint32_t partition = table->PartitionOf(hash);
+    if (table->IsSpilled(partition)) {
+      // the matches of the row are on disk, it is joined with them after the right child is exhausted
+      auto &spill = probe_spills_[partition];
+      if (spill == nullptr) {
+        spill = std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager());
+      }
+      spill->Append(probe_batch_->GetTuple(probe_row_));
+      continue;
+    }
+    table->Probe(hash, probe_keys_.GetValue(probe_row_), &matches_);
+  }
+  return batch->Size() > 0;
+}
 
-bool HashJoinExecutor::Next(Tuple *tuple, RID *rid) { return false; }
+std::vector<Value> HashJoinExecutor::JoinRow(const Tuple &left_tuple, uint32_t row) const {
+  const Schema *left_schema = left_executor_->GetOutputSchema();
+  const Schema *right_schema = right_executor_->GetOutputSchema();
+  std::vector<Value> values;
+  values.reserve(output_columns_.size());
+  for (uint32_t i = 0; i < output_columns_.size(); i++) {
+    const ColumnValueExpression *column = output_columns_[i];
+    if (column == nullptr) {
+      Tuple right_tuple = probe_batch_->GetTuple(row);
+      values.push_back(plan_->OutputSchema()->GetColumn(i).GetExpr()->EvaluateJoin(&left_tuple, left_schema,
+                                                                                      &right_tuple, right_schema));
+    } else if (column->GetTupleIdx() == 0) {
+      values.push_back(left_tuple.GetValue(left_schema, column->GetColIdx()));
+    } else {
+      values.push_back(probe_batch_->GetColumn(column->GetColIdx()).GetValue(row));
+    }
+  }
+  return values;
+}
 
 }  // namespace bustub
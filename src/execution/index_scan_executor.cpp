@@ -11,12 +11,262 @@
 //===----------------------------------------------------------------------===//
 #include "execution/executors/index_scan_executor.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "type/limits.h"
+#include "type/value_factory.h"
+
 namespace bustub {
+namespace {
+
+/**
+ * @return `true` if bound turns into a key of key_type holding the very same value, so that a range on it selects
+ * the same rows as the comparison. A null compares to nothing, a decimal is not rounded to an integer key and an
+ * integer is not cast to a narrower key it does not fit in: those comparisons stay a predicate.
+ */
+bool IsExactKeyBound(const Value &bound, TypeId key_type) {
+  if (bound.IsNull()) {
+    return false;
+  }
+  auto is_integer = [](TypeId type) { return type >= TypeId::TINYINT && type <= TypeId::BIGINT; };
+  if (!is_integer(key_type) || !is_integer(bound.GetTypeId())) {
+    return bound.GetTypeId() == key_type;
+  }
+  int64_t val = bound.CastAs(TypeId::BIGINT).GetAs<int64_t>();
+  switch (key_type) {
+    case TypeId::TINYINT:
+      return val >= BUSTUB_INT8_MIN && val <= BUSTUB_INT8_MAX;
+    case TypeId::SMALLINT:
+      return val >= BUSTUB_INT16_MIN && val <= BUSTUB_INT16_MAX;
+    case TypeId::INTEGER:
+      return val >= BUSTUB_INT32_MIN && val <= BUSTUB_INT32_MAX;
+    default:
+      return true;
+  }
+}
+
+}  // namespace
+
+template <size_t KeySize>
+class IndexScanExecutor::TreeCursor : public IndexScanExecutor::Cursor {
+ public:
+  using TreeIterator = IndexIterator<GenericKey<KeySize>, RID, GenericComparator<KeySize>>;
+
+  TreeCursor(const IndexScanExecutor *executor, TreeIterator iter)
+      : executor_(executor), iter_(std::move(iter)) {}
+
+  bool IsEnd() override { return iter_.IsEnd(); }
+
+  RID GetRid() override { return (*iter_).second; }
+
+  Tuple GetEntry() override { return executor_->TupleFromKey((*iter_).first); }
+
+  void Advance() override { ++iter_; }
+
+ private:
+  /** The executor the scan belongs to, which knows the schemas of the entries */
+  const IndexScanExecutor *executor_;
+  /** The position of the scan inside the index */
+  TreeIterator iter_;
+};
+
 IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+void IndexScanExecutor::Init() {
+  Catalog *catalog = exec_ctx_->GetCatalog();
+  index_info_ = catalog->GetIndex(plan_->GetIndexOid());
+  table_info_ = catalog->GetTable(index_info_->table_name_);
+  if (plan_->IsIndexOnly()) {
+    bool covered = plan_->GetPredicate() == nullptr || IsCovered(plan_->GetPredicate());
+    for (const auto &column : GetOutputSchema()->GetColumns()) {
+      covered = covered && IsCovered(column.GetExpr());
+    }
+    if (!covered) {
+      throw Exception(ExceptionType::NOT_IMPLEMENTED, "index-only scan reads a column the index does not store");
+    }
+  }
+
+  IndexScanRange range;
+  predicate_ = plan_->GetPredicate();
+  if (plan_->HasRange()) {
+    range = plan_->GetRange();
+  } else if (PushDownPredicate(&range)) {
+    predicate_ = nullptr;
+  }
+  compiled_predicate_ =
+      predicate_ == nullptr ? nullptr : CompiledExpression::Compile(predicate_, &table_info_->schema_);
+
+  switch (index_info_->key_size_) {
+    case 4:
+      cursor_ = OpenCursor<4>(range);
+      break;
+    case 8:
+      cursor_ = OpenCursor<8>(range);
+      break;
+    case 16:
+      cursor_ = OpenCursor<16>(range);
+      break;
+    case 32:
+      cursor_ = OpenCursor<32>(range);
+      break;
+    case 64:
+      cursor_ = OpenCursor<64>(range);
+      break;
+    default:
+      throw Exception(ExceptionType::NOT_IMPLEMENTED, "index scan requires a key size of 4, 8, 16, 32 or 64 bytes");
+  }
+}
+
+template <size_t KeySize>
+std::unique_ptr<IndexScanExecutor::Cursor> IndexScanExecutor::OpenCursor(const IndexScanRange &range) const {
+  using TreeIndex = BPlusTreeIndex<GenericKey<KeySize>, RID, GenericComparator<KeySize>>;
+  auto *tree = dynamic_cast<TreeIndex *>(index_info_->index_.get());
+  if (tree == nullptr) {
+    throw Exception(ExceptionType::NOT_IMPLEMENTED, "index scan requires a B+ tree index");
+  }
+  GenericKey<KeySize> lower;
+  GenericKey<KeySize> upper;
+  const GenericKey<KeySize> *lower_bound = nullptr;
+  const GenericKey<KeySize> *upper_bound = nullptr;
+  if (!range.lower_.empty()) {
+    lower = MakeKey<KeySize>(range.lower_);
+    lower_bound = &lower;
+  }
+  if (!range.upper_.empty()) {
+    upper = MakeKey<KeySize>(range.upper_);
+    upper_bound = &upper;
+  }
+  if (range.reverse_) {
+    return std::make_unique<TreeCursor<KeySize>>(
+        this, tree->GetReverseBeginIterator(lower_bound, range.lower_inclusive_, upper_bound, range.upper_inclusive_));
+  }
+  return std::make_unique<TreeCursor<KeySize>>(
+      this, tree->GetBeginIterator(lower_bound, range.lower_inclusive_, upper_bound, range.upper_inclusive_));
+}
+
+bool IndexScanExecutor::Next(Tuple *tuple, RID *rid) {
+  const Schema *table_schema = &table_info_->schema_;
+  while (!cursor_->IsEnd()) {
+    RID table_rid = cursor_->GetRid();
+    Tuple table_tuple;
+    if (plan_->IsIndexOnly()) {
+      table_tuple = cursor_->GetEntry();
+      cursor_->Advance();
+    } else {
+      cursor_->Advance();
+      if (!table_info_->table_->GetTuple(table_rid, &table_tuple, exec_ctx_->GetTransaction())) {
+        continue;
+      }
+    }
+    if (compiled_predicate_ != nullptr) {
+      if (!compiled_predicate_->Test(table_tuple)) {
+        continue;
+      }
+    } else if (predicate_ != nullptr) {
+      Value passed = predicate_->Evaluate(&table_tuple, table_schema);
+      if (passed.IsNull() || !passed.GetAs<bool>()) {
+        continue;
+      }
+    }
+
+    std::vector<Value> values;
+    values.reserve(GetOutputSchema()->GetColumnCount());
+    for (const auto &column : GetOutputSchema()->GetColumns()) {
+      values.push_back(column.GetExpr()->Evaluate(&table_tuple, table_schema));
+    }
+    *tuple = Tuple(values, GetOutputSchema(), NextOutputArena());
+    *rid = table_rid;
+    return true;
+  }
+  return false;
+}
+
+bool IndexScanExecutor::PushDownPredicate(IndexScanRange *range) const {
+  const auto *comparison = dynamic_cast<const ComparisonExpression *>(plan_->GetPredicate());
+  if (comparison == nullptr || index_info_->index_->GetIndexColumnCount() != 1) {
+    return false;
+  }
+  const ColumnValueExpression *column;
+  const ConstantValueExpression *constant;
+  ComparisonType type;
+  if (!comparison->MatchColumnConstant(&column, &constant, &type) ||
+      column->GetColIdx() != index_info_->index_->GetKeyAttrs()[0]) {
+    return false;
+  }
+
+  Value bound = constant->Evaluate(nullptr, nullptr);
+  if (!IsExactKeyBound(bound, index_info_->index_->GetSearchKeySchema()->GetColumn(0).GetType())) {
+    return false;
+  }
+  switch (type) {
+    case ComparisonType::Equal:
+      range->lower_ = {bound};
+      range->upper_ = {bound};
+      return true;
+    case ComparisonType::LessThan:
+    case ComparisonType::LessThanOrEqual:
+      range->upper_ = {bound};
+      range->upper_inclusive_ = type == ComparisonType::LessThanOrEqual;
+      return true;
+    case ComparisonType::GreaterThan:
+    case ComparisonType::GreaterThanOrEqual:
+      range->lower_ = {bound};
+      range->lower_inclusive_ = type == ComparisonType::GreaterThanOrEqual;
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <size_t KeySize>
+GenericKey<KeySize> IndexScanExecutor::MakeKey(const std::vector<Value> &values) const {
+  const Schema *key_schema = index_info_->index_->GetSearchKeySchema();
+  std::vector<Value> key_values;
+  key_values.reserve(values.size());
+  for (uint32_t i = 0; i < values.size(); i++) {
+    key_values.push_back(values[i].CastAs(key_schema->GetColumn(i).GetType()));
+  }
+  GenericKey<KeySize> key;
+  if (!key.SetFromKey(Tuple(key_values, key_schema), key_schema, index_info_->index_->IsNormalized())) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "index scan bound does not fit in the key size");
+  }
+  return key;
+}
 
-void IndexScanExecutor::Init() {}
+bool IndexScanExecutor::IsCovered(const AbstractExpression *expr) const {
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr); column != nullptr) {
+    const auto &attrs = index_info_->index_->GetKeyAttrs();
+    return std::find(attrs.begin(), attrs.end(), column->GetColIdx()) != attrs.end();
+  }
+  for (const auto *child : expr->GetChildren()) {
+    if (!IsCovered(child)) {
+      return false;
+    }
+  }
+  return true;
+}
 
-bool IndexScanExecutor::Next(Tuple *tuple, RID *rid) { return false; }
+template <size_t KeySize>
+Tuple IndexScanExecutor::TupleFromKey(const GenericKey<KeySize> &key) const {
+  const Schema *table_schema = &table_info_->schema_;
+  Schema *entry_schema = index_info_->index_->GetKeySchema();
+  const auto &attrs = index_info_->index_->GetKeyAttrs();
+  std::vector<Value> values;
+  values.reserve(table_schema->GetColumnCount());
+  for (const auto &column : table_schema->GetColumns()) {
+    values.push_back(ValueFactory::GetZeroValueByType(column.GetType()));
+  }
+  bool normalized = index_info_->index_->IsNormalized();
+  for (uint32_t i = 0; i < attrs.size(); i++) {
+    values[attrs[i]] = normalized ? key.ToNormalizedValue(entry_schema, i) : key.ToValue(entry_schema, i);
+  }
+  return Tuple(values, table_schema);
+}
 
 }  // namespace bustub
@@ -0,0 +1,149 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_hash_table.cpp
+//
+// Identification: src/execution/join_hash_table.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/join_hash_table.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace bustub {
+
+JoinHashTable::JoinHashTable(BufferPoolManager *bpm, size_t memory_budget, uint32_t level)
+    : bpm_(bpm), memory_budget_(memory_budget), level_(level), partitions_(NUM_PARTITIONS) {
+  BUSTUB_ASSERT(level <= MAX_LEVEL, "no hash bits left to partition by");
+}
+
+size_t JoinHashTable::EntrySize(const Entry &entry) {
+  size_t size = sizeof(Entry) + entry.tuple_.GetLength();
+  if (entry.key_.GetTypeId() == TypeId::VARCHAR) {
+    size += entry.key_.GetLength();
+  }
+  return size;
+}
+
+void JoinHashTable::Insert(hash_t hash, Value key, Tuple tuple) {
+  Partition &partition = partitions_[PartitionOf(hash)];
+  if (partition.spill_ != nullptr) {
+    partition.spill_->Append(tuple);
+    return;
+  }
+  partition.entries_.push_back(Entry{hash, std::move(key), std::move(tuple)});
+  size_t size = EntrySize(partition.entries_.back());
+  partition.memory_usage_ += size;
+  memory_usage_ += size;
+  if (memory_usage_ > memory_budget_) {
+    Shrink();
+  }
+}
+
+void JoinHashTable::Spill(Partition *partition) {
+  partition->spill_ = std::make_unique<SpillFile>(bpm_);
+  for (const auto &entry : partition->entries_) {
+    partition->spill_->Append(entry.tuple_);
+  }
+  std::vector<Entry>().swap(partition->entries_);
+  memory_usage_ -= partition->memory_usage_;
+  partition->memory_usage_ = 0;
+}
+
+void JoinHashTable::Shrink() {
+  while (memory_usage_ > memory_budget_) {
+    auto largest = std::max_element(partitions_.begin(), partitions_.end(), [](const auto &lhs, const auto &rhs) {
+      return lhs.memory_usage_ < rhs.memory_usage_;
+    });
+    if (largest->memory_usage_ == 0) {
+      return;
+    }
+    Spill(&*largest);
+  }
+}
+
+void JoinHashTable::Merge(JoinHashTable *other) {
+  for (uint32_t i = 0; i < NUM_PARTITIONS; i++) {
+    Partition &partition = partitions_[i];
+    Partition &other_partition = other->partitions_[i];
+    if (partition.spill_ != nullptr || other_partition.spill_ != nullptr) {
+      if (partition.spill_ == nullptr) {
+        Spill(&partition);
+      }
+      for (const auto &entry : other_partition.entries_) {
+        partition.spill_->Append(entry.tuple_);
+      }
+      if (other_partition.spill_ != nullptr) {
+        partition.spill_->Splice(other_partition.spill_.get());
+      }
+    } else {
+      partition.entries_.insert(partition.entries_.end(), std::make_move_iterator(other_partition.entries_.begin()),
+                                std::make_move_iterator(other_partition.entries_.end()));
+      partition.memory_usage_ += other_partition.memory_usage_;
+      memory_usage_ += other_partition.memory_usage_;
+    }
+    other_partition.entries_.clear();
+    other->memory_usage_ -= other_partition.memory_usage_;
+    other_partition.memory_usage_ = 0;
+  }
+  Shrink();
+}
+
+void JoinHashTable::Build() {
+  for (auto &partition : partitions_) {
+    if (partition.entries_.empty()) {
+      continue;
+    }
+    // at most half the slots are taken, which keeps the probe sequences short
+    size_t num_slots = 1;
+    while (num_slots < 2 * partition.entries_.size()) {
+      num_slots <<= 1;
+    }
+    size_t mask = num_slots - 1;
+    partition.slots_.assign(num_slots, 0);
+    for (uint32_t i = 0; i < partition.entries_.size(); i++) {
+      size_t slot = partition.entries_[i].hash_ & mask;
+      while (partition.slots_[slot] != 0) {
+        slot = (slot + 1) & mask;
+      }
+      partition.slots_[slot] = i + 1;
+    }
+    partition.memory_usage_ += num_slots * sizeof(uint32_t);
+    memory_usage_ += num_slots * sizeof(uint32_t);
+  }
+}
+
+void JoinHashTable::ReleaseEntries() {
+  for (auto &partition : partitions_) {
+    std::vector<Entry>().swap(partition.entries_);
+    std::vector<uint32_t>().swap(partition.slots_);
+    partition.memory_usage_ = 0;
+  }
+  memory_usage_ = 0;
+}
+
+bool JoinHashTable::HasSpilled() const {
+  return std::any_of(partitions_.begin(), partitions_.end(),
+                     [](const auto &partition) { return partition.spill_ != nullptr; });
+}
+
+void JoinHashTable::Probe(hash_t hash, const Value &key, std::vector<const Tuple *> *matches) const {
+  const Partition &partition = partitions_[PartitionOf(hash)];
+  if (partition.slots_.empty()) {
+    return;
+  }
+  size_t mask = partition.slots_.size() - 1;
+  for (size_t slot = hash & mask; partition.slots_[slot] != 0; slot = (slot + 1) & mask) {
+    const Entry &entry = partition.entries_[partition.slots_[slot] - 1];
+    if (entry.hash_ == hash && entry.key_.CompareEquals(key) == CmpBool::CmpTrue) {
+      matches->push_back(&entry.tuple_);
+    }
+  }
+}
+
+}  // namespace bustub
@@ -12,14 +12,35 @@
 
 #include "execution/executors/limit_executor.h"
 
+#include <algorithm>
+
 namespace bustub {
 
 LimitExecutor::LimitExecutor(ExecutorContext *exec_ctx, const LimitPlanNode *plan,
                              std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+
+void LimitExecutor::Init() {
+  child_executor_->Init();
+  emitted_ = 0;
+}
 
-void LimitExecutor::Init() {}
+bool LimitExecutor::Next(Tuple *tuple, RID *rid) {
+  if (emitted_ >= plan_->GetLimit() || !child_executor_->Next(tuple, rid)) {
+    return false;
+  }
+  emitted_++;
+  return true;
+}
 
-bool LimitExecutor::Next(Tuple *tuple, RID *rid) { return false; }
+bool LimitExecutor::NextBatch(TupleBatch *batch) {
+  if (emitted_ >= plan_->GetLimit() || !child_executor_->NextBatch(batch)) {
+    batch->Reset();
+    return false;
+  }
+  batch->Truncate(static_cast<uint32_t>(std::min<size_t>(plan_->GetLimit() - emitted_, batch->Size())));
+  emitted_ += batch->Size();
+  return true;
+}
 
 }  // namespace bustub
@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.cpp
+//
+// Identification: src/execution/merge_join_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/merge_join_executor.h"
+
+namespace bustub {
+
+MergeJoinExecutor::MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                                     std::unique_ptr<AbstractExecutor> &&left_child,
+                                     std::unique_ptr<AbstractExecutor> &&right_child)
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_child)),
+      right_executor_(std::move(right_child)) {}
+
+void MergeJoinExecutor::Init() {
+  left_executor_->Init();
+  right_executor_->Init();
+  run_.clear();
+  run_pos_ = 0;
+  AdvanceLeft();
+  AdvanceRight();
+}
+
+bool MergeJoinExecutor::AdvanceLeft() {
+  RID rid;
+  while ((left_valid_ = left_executor_->Next(&left_tuple_, &rid))) {
+    left_key_ = plan_->LeftJoinKeyExpression()->Evaluate(&left_tuple_, left_executor_->GetOutputSchema());
+    if (!left_key_.IsNull()) {
+      break;
+    }
+  }
+  return left_valid_;
+}
+
+bool MergeJoinExecutor::AdvanceRight() {
+  RID rid;
+  while ((right_valid_ = right_executor_->Next(&right_tuple_, &rid))) {
+    right_key_ = plan_->RightJoinKeyExpression()->Evaluate(&right_tuple_, right_executor_->GetOutputSchema());
+    if (!right_key_.IsNull()) {
+      break;
+    }
+  }
+  return right_valid_;
+}
+
+bool MergeJoinExecutor::Next(Tuple *tuple, RID *rid) {
+  const Schema *left_schema = left_executor_->GetOutputSchema();
+  const Schema *right_schema = right_executor_->GetOutputSchema();
+  while (true) {
+    if (run_pos_ < run_.size()) {
+      const Tuple &right_tuple = run_[run_pos_++];
+      std::vector<Value> values;
+      values.reserve(GetOutputSchema()->GetColumnCount());
+      for (const auto &column : GetOutputSchema()->GetColumns()) {
+        values.push_back(column.GetExpr()->EvaluateJoin(&left_tuple_, left_schema, &right_tuple, right_schema));
+      }
+      *tuple = Tuple(values, GetOutputSchema(), NextOutputArena());
+      return true;
+    }
+    if (!run_.empty()) {
+      // the left tuple is done with the run, which the next one joins again if it has the same key
+      if (AdvanceLeft() && left_key_.CompareEquals(run_key_) == CmpBool::CmpTrue) {
+        run_pos_ = 0;
+        continue;
+      }
+      run_.clear();
+      run_pos_ = 0;
+    }
+    if (!left_valid_ || !right_valid_) {
+      return false;
+    }
+
+    if (left_key_.CompareLessThan(right_key_) == CmpBool::CmpTrue) {
+      AdvanceLeft();
+    } else if (left_key_.CompareGreaterThan(right_key_) == CmpBool::CmpTrue) {
+      AdvanceRight();
+    } else {
+      // buffer the right tuples of the key, the left tuples of the key are streamed over them
+      run_key_ = right_key_;
+      do {
+        // the right child reuses the memory of its tuples as it moves on
+        run_.push_back(right_tuple_);
+        run_.back().Materialize();
+      } while (AdvanceRight() && right_key_.CompareEquals(run_key_) == CmpBool::CmpTrue);
+    }
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,39 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// morsel_queue.cpp
+//
+// Identification: src/execution/morsel_queue.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/morsel_queue.h"
+
+#include "storage/page/table_page.h"
+
+namespace bustub {
+
+bool MorselQueue::Next(page_id_t *first_page_id, page_id_t *stop_page_id) {
+  std::scoped_lock latch(latch_);
+  if (next_page_id_ == INVALID_PAGE_ID) {
+    return false;
+  }
+  *first_page_id = next_page_id_;
+  // only the page headers are read here, the pages stay in the buffer pool for the worker that scans them
+  for (uint32_t i = 0; i < morsel_size_ && next_page_id_ != INVALID_PAGE_ID; i++) {
+    auto page = static_cast<TablePage *>(bpm_->FetchPage(next_page_id_));
+    BUSTUB_ASSERT(page != nullptr, "table page could not be fetched");
+    page->RLatch();
+    page_id_t next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    bpm_->UnpinPage(next_page_id_, false);
+    next_page_id_ = next_page_id;
+  }
+  *stop_page_id = next_page_id_;
+  return true;
+}
+
+}  // namespace bustub
@@ -12,15 +12,123 @@
 
 #include "execution/executors/nested_loop_join_executor.h"
 
+#include <string>
+
 namespace bustub {
 
+namespace {
+
+/** @return the number of bytes a batch takes, its column vectors and the strings of its selected rows */
+size_t BatchMemoryUsage(const TupleBatch &batch) {
+  const Schema *schema = batch.GetSchema();
+  size_t size = batch.GetCapacity() * (sizeof(RID) + sizeof(uint32_t));
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    if (schema->GetColumn(i).GetType() != TypeId::VARCHAR) {
+      size += batch.GetCapacity() * (sizeof(int64_t) + sizeof(uint8_t));
+      continue;
+    }
+    size += batch.GetCapacity() * (sizeof(std::string) + sizeof(uint8_t));
+    for (uint32_t row : batch.GetSelection()) {
+      size += batch.GetColumn(i).GetString(row).capacity();
+    }
+  }
+  return size;
+}
+
+}  // namespace
+
 NestedLoopJoinExecutor::NestedLoopJoinExecutor(ExecutorContext *exec_ctx, const NestedLoopJoinPlanNode *plan,
                                                std::unique_ptr<AbstractExecutor> &&left_executor,
                                                std::unique_ptr<AbstractExecutor> &&right_executor)
-    : AbstractExecutor(exec_ctx) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      left_executor_(std::move(left_executor)),
+      right_executor_(std::move(right_executor)) {}
+
+void NestedLoopJoinExecutor::Init() {
+  left_executor_->Init();
+  compiled_predicate_ = plan_->Predicate() == nullptr
+                            ? nullptr
+                            : CompiledExpression::Compile(plan_->Predicate(), left_executor_->GetOutputSchema(),
+                                                          right_executor_->GetOutputSchema());
+  block_.clear();
+  right_valid_ = false;
+  batch_idx_ = 0;
+  matches_.clear();
+  match_pos_ = 0;
+}
+
+bool NestedLoopJoinExecutor::NextBlock() {
+  block_.clear();
+  size_t memory_usage = 0;
+  // a block holds at least one batch, whatever the budget
+  while (block_.empty() || memory_usage < exec_ctx_->GetMemoryBudget()) {
+    TupleBatch batch(left_executor_->GetOutputSchema());
+    if (!left_executor_->NextBatch(&batch)) {
+      break;
+    }
+    memory_usage += BatchMemoryUsage(batch);
+    block_.push_back(std::move(batch));
+  }
+  return !block_.empty();
+}
 
-void NestedLoopJoinExecutor::Init() {}
+void NestedLoopJoinExecutor::Probe(const TupleBatch &left_batch) {
+  matches_.clear();
+  match_pos_ = 0;
+  if (plan_->Predicate() == nullptr) {
+    matches_ = left_batch.GetSelection();
+    return;
+  }
+  if (compiled_predicate_ != nullptr) {
+    for (uint32_t row : left_batch.GetSelection()) {
+      if (compiled_predicate_->TestJoin(left_batch, row, right_tuple_)) {
+        matches_.push_back(row);
+      }
+    }
+    return;
+  }
+  ColumnVector result =
+      plan_->Predicate()->EvaluateJoinBatch(left_batch, &right_tuple_, right_executor_->GetOutputSchema());
+  const int64_t *match = result.GetIntegers();
+  for (uint32_t row : left_batch.GetSelection()) {
+    if (!result.IsNull(row) && match[row] != 0) {
+      matches_.push_back(row);
+    }
+  }
+}
 
-bool NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) { return false; }
+bool NestedLoopJoinExecutor::Next(Tuple *tuple, RID *rid) {
+  const Schema *left_schema = left_executor_->GetOutputSchema();
+  const Schema *right_schema = right_executor_->GetOutputSchema();
+  while (true) {
+    if (match_pos_ < matches_.size()) {
+      Tuple left_tuple = block_[batch_idx_ - 1].GetTuple(matches_[match_pos_++]);
+      std::vector<Value> values;
+      values.reserve(GetOutputSchema()->GetColumnCount());
+      for (const auto &column : GetOutputSchema()->GetColumns()) {
+        values.push_back(column.GetExpr()->EvaluateJoin(&left_tuple, left_schema, &right_tuple_, right_schema));
+      }
+      *tuple = Tuple(values, GetOutputSchema(), NextOutputArena());
+      return true;
+    }
+    if (right_valid_ && batch_idx_ < block_.size()) {
+      Probe(block_[batch_idx_++]);
+      continue;
+    }
+    RID right_rid;
+    if (!block_.empty() && right_executor_->Next(&right_tuple_, &right_rid)) {
+      right_valid_ = true;
+      batch_idx_ = 0;
+      continue;
+    }
+    // the right child is exhausted for this block, it is scanned again for the next one
+    right_valid_ = false;
+    if (!NextBlock()) {
+      return false;
+    }
+    right_executor_->Init();
+  }
+}
 
 }  // namespace bustub
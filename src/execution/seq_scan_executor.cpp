@@ -1,23 +1,345 @@
-//===----------------------------------------------------------------------===//
-//
-//                         BusTub
-//
-// seq_scan_executor.cpp
-//
-// Identification: src/execution/seq_scan_executor.cpp
-//
-// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
-//
-//===----------------------------------------------------------------------===//
-
-#include "execution/executors/seq_scan_executor.h"
-
-namespace bustub {
-
-SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan) : AbstractExecutor(exec_ctx) {}
-
-void SeqScanExecutor::Init() {}
-
-bool SeqScanExecutor::Next(Tuple *tuple, RID *rid) { return false; }
-
-}  // namespace bustub
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// seq_scan_executor.cpp
+//
+// Identification: src/execution/seq_scan_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/seq_scan_executor.h"
+
+#include <utility>
+
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "type/limits.h"
+
+namespace bustub {
+
+SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan), table_info_(exec_ctx->GetCatalog()->GetTable(plan->GetTableOid())) {}
+
+void SeqScanExecutor::Init() {
+  morsels_ = exec_ctx_->GetSharedState<MorselQueue>(plan_);
+  page_id_ = morsels_ == nullptr ? table_info_->table_->GetFirstPageId() : INVALID_PAGE_ID;
+  stop_page_id_ = INVALID_PAGE_ID;
+  tuples_.clear();
+  tuple_pos_ = 0;
+  // the minipages are read without locking the rows, so a locking scan puts the tuples back together
+  read_columns_ = table_info_->table_->GetLayout() == TableLayout::PAX && !enable_logging;
+  slot_ = 0;
+  ResetRowBatch();
+  column_mask_.assign(table_info_->schema_.GetColumnCount(), false);
+  MarkColumns(plan_->GetPredicate());
+  for (const auto &column : GetOutputSchema()->GetColumns()) {
+    MarkColumns(column.GetExpr());
+  }
+
+  const Schema *schema = &table_info_->schema_;
+  compiled_predicate_ = nullptr;
+  filter_ = nullptr;
+  if (plan_->GetPredicate() != nullptr) {
+    compiled_predicate_ = CompiledExpression::Compile(plan_->GetPredicate(), schema);
+  }
+  if (compiled_predicate_ != nullptr) {
+    // the predicate is pushed down into the pages, only the tuples that pass it are read
+    filter_ = [predicate = compiled_predicate_.get()](const char *data) { return predicate->Test(data); };
+  }
+  PlanPruning();
+  pruned_pages_ = 0;
+  compiled_outputs_.clear();
+  // the tuples of a PAX table are not put back together for compiled expressions to run over their bytes, and a
+  // predicate that did not compile needs the batch
+  compiled_projection_ = !read_columns_ && (plan_->GetPredicate() == nullptr || compiled_predicate_ != nullptr);
+  for (const auto &column : GetOutputSchema()->GetColumns()) {
+    if (!compiled_projection_) {
+      break;
+    }
+    compiled_outputs_.push_back(CompiledExpression::Compile(column.GetExpr(), schema));
+    // results are written as they are computed, without the casts of TupleBatch::Assign
+    if (compiled_outputs_.back() == nullptr || compiled_outputs_.back()->GetReturnType() != column.GetType()) {
+      compiled_projection_ = false;
+      break;
+    }
+  }
+}
+
+void SeqScanExecutor::MarkColumns(const AbstractExpression *expr) {
+  if (expr == nullptr) {
+    return;
+  }
+  if (const auto *column = dynamic_cast<const ColumnValueExpression *>(expr); column != nullptr) {
+    column_mask_[column->GetColIdx()] = true;
+  }
+  for (const auto *child : expr->GetChildren()) {
+    MarkColumns(child);
+  }
+}
+
+void SeqScanExecutor::PlanPruning() {
+  zone_map_ = nullptr;
+  filter_encoded_ = false;
+  const auto *comparison = dynamic_cast<const ComparisonExpression *>(plan_->GetPredicate());
+  if (comparison == nullptr) {
+    return;
+  }
+  const ColumnValueExpression *column;
+  const ConstantValueExpression *constant;
+  ComparisonType type;
+  if (!comparison->MatchColumnConstant(&column, &constant, &type)) {
+    return;
+  }
+  prune_column_ = column->GetColIdx();
+  prune_comparison_ = type;
+  prune_constant_ = constant->Evaluate(nullptr, nullptr);
+  ZoneMap *zone_map = table_info_->table_->GetZoneMap();
+  if (zone_map != nullptr && zone_map->HasColumn(prune_column_)) {
+    zone_map_ = zone_map;
+  }
+
+  if (!read_columns_ || prune_constant_.IsNull()) {
+    return;
+  }
+  auto is_integer = [](TypeId type) { return type >= TypeId::TINYINT && type <= TypeId::BIGINT; };
+  TypeId column_type = table_info_->schema_.GetColumn(prune_column_).GetType();
+  TypeId constant_type = prune_constant_.GetTypeId();
+  if (is_integer(column_type) && is_integer(constant_type)) {
+    // every comparison is a range of values, or the values outside of one
+    int64_t val = prune_constant_.CastAs(TypeId::BIGINT).GetAs<int64_t>();
+    filter_lo_ = val;
+    filter_hi_ = val;
+    filter_inside_ = type == ComparisonType::Equal || type == ComparisonType::LessThanOrEqual ||
+                     type == ComparisonType::GreaterThanOrEqual;
+    if (type == ComparisonType::LessThan || type == ComparisonType::GreaterThanOrEqual) {
+      filter_hi_ = BUSTUB_INT64_MAX;
+    }
+    if (type == ComparisonType::LessThanOrEqual || type == ComparisonType::GreaterThan) {
+      filter_lo_ = BUSTUB_INT64_MIN;
+    }
+    filter_encoded_ = true;
+  } else if (column_type == TypeId::VARCHAR && constant_type == TypeId::VARCHAR &&
+             (type == ComparisonType::Equal || type == ComparisonType::NotEqual)) {
+    // the stored length counts the trailing terminator
+    filter_string_.assign(prune_constant_.GetData(), prune_constant_.GetLength() - 1);
+    filter_inside_ = type == ComparisonType::Equal;
+    filter_encoded_ = true;
+  }
+}
+
+bool SeqScanExecutor::CanSkipPage(page_id_t page_id) const {
+  Value min;
+  Value max;
+  if (zone_map_ == nullptr || !zone_map_->GetBounds(page_id, prune_column_, &min, &max)) {
+    return false;
+  }
+  // a page without a non-null value of the column, or a null constant, fails every comparison
+  if (min.IsNull() || prune_constant_.IsNull()) {
+    return true;
+  }
+  const Value &val = prune_constant_;
+  switch (prune_comparison_) {
+    case ComparisonType::Equal:
+      return val.CompareLessThan(min) == CmpBool::CmpTrue || val.CompareGreaterThan(max) == CmpBool::CmpTrue;
+    case ComparisonType::NotEqual:
+      return min.CompareEquals(val) == CmpBool::CmpTrue && max.CompareEquals(val) == CmpBool::CmpTrue;
+    case ComparisonType::LessThan:
+      return min.CompareGreaterThanEquals(val) == CmpBool::CmpTrue;
+    case ComparisonType::LessThanOrEqual:
+      return min.CompareGreaterThan(val) == CmpBool::CmpTrue;
+    case ComparisonType::GreaterThan:
+      return max.CompareLessThanEquals(val) == CmpBool::CmpTrue;
+    case ComparisonType::GreaterThanOrEqual:
+      return max.CompareLessThan(val) == CmpBool::CmpTrue;
+  }
+  return false;
+}
+
+bool SeqScanExecutor::NextMorsel() { return morsels_ != nullptr && morsels_->Next(&page_id_, &stop_page_id_); }
+
+bool SeqScanExecutor::NextPage() {
+  tuples_.clear();
+  tuple_pos_ = 0;
+  while (tuples_.empty()) {
+    if (page_id_ == INVALID_PAGE_ID || page_id_ == stop_page_id_) {
+      if (!NextMorsel()) {
+        return false;
+      }
+      continue;
+    }
+    if (CanSkipPage(page_id_)) {
+      pruned_pages_++;
+      zone_map_->AddPrunedPages(1);
+      page_id_ = table_info_->table_->GetNextPageId(page_id_);
+      continue;
+    }
+    page_id_ = table_info_->table_->ScanPage(page_id_, filter_, &tuples_, exec_ctx_->GetTransaction());
+  }
+  return true;
+}
+
+bool SeqScanExecutor::NextViews(size_t room,
+                                const std::function<void(const std::vector<TupleView> &views)> &reader) {
+  if (table_info_->table_->GetLayout() == TableLayout::PAX) {
+    // the tuples of a PAX table are put back together before they are viewed
+    if (tuple_pos_ == tuples_.size() && !NextPage()) {
+      return false;
+    }
+    std::vector<TupleView> views;
+    for (; views.size() < room && tuple_pos_ < tuples_.size(); tuple_pos_++) {
+      views.push_back(tuples_[tuple_pos_].GetView());
+    }
+    reader(views);
+    return true;
+  }
+  bool read = false;
+  while (!read) {
+    if (page_id_ == INVALID_PAGE_ID || page_id_ == stop_page_id_) {
+      if (!NextMorsel()) {
+        return false;
+      }
+      continue;
+    }
+    if (slot_ == 0 && CanSkipPage(page_id_)) {
+      pruned_pages_++;
+      zone_map_->AddPrunedPages(1);
+      page_id_ = table_info_->table_->GetNextPageId(page_id_);
+      continue;
+    }
+    auto page_reader = [&](const std::vector<TupleView> &views) {
+      if (!views.empty()) {
+        reader(views);
+        read = true;
+      }
+    };
+    page_id_ = table_info_->table_->ViewPage(page_id_, &slot_, room, filter_, page_reader,
+                                             exec_ctx_->GetTransaction());
+  }
+  return true;
+}
+
+bool SeqScanExecutor::ReadRows() {
+  table_batch_->Reset();
+  return NextViews(table_batch_->GetCapacity(), [&](const std::vector<TupleView> &views) {
+    for (const auto &view : views) {
+      table_batch_->Append(view, &column_mask_);
+    }
+  });
+}
+
+bool SeqScanExecutor::ReadColumns() {
+  table_batch_->Reset();
+  std::vector<uint32_t> slots;
+  while (!table_batch_->IsFull()) {
+    if (page_id_ == INVALID_PAGE_ID || page_id_ == stop_page_id_) {
+      if (!NextMorsel()) {
+        break;
+      }
+      continue;
+    }
+    if (slot_ == 0 && CanSkipPage(page_id_)) {
+      pruned_pages_++;
+      zone_map_->AddPrunedPages(1);
+      page_id_ = table_info_->table_->GetNextPageId(page_id_);
+      continue;
+    }
+    bool page_done = true;
+    auto reader = [&](PaxPage *page) {
+      // pick the live rows that fit in the batch, then copy them over a column at a time
+      slots.clear();
+      uint32_t room = table_batch_->GetCapacity() - table_batch_->GetRowCount();
+      for (; slots.size() < room && slot_ < page->GetTupleCount(); slot_++) {
+        if (page->IsLive(slot_)) {
+          slots.push_back(slot_);
+        }
+      }
+      page_done = slot_ == page->GetTupleCount();
+      if (filter_encoded_ && table_info_->schema_.GetColumn(prune_column_).GetType() == TypeId::VARCHAR) {
+        page->FilterStrings(prune_column_, filter_string_, filter_inside_, &slots);
+      } else if (filter_encoded_) {
+        page->FilterIntegers(prune_column_, filter_lo_, filter_hi_, filter_inside_, &slots);
+      }
+      uint32_t first_row = table_batch_->GetRowCount();
+      for (uint32_t slot : slots) {
+        table_batch_->AppendRow(RID(page_id_, slot));
+      }
+      for (uint32_t i = 0; i < column_mask_.size(); i++) {
+        if (!column_mask_[i]) {
+          continue;
+        }
+        ColumnVector &column = table_batch_->GetColumn(i);
+        char buffer[sizeof(int64_t)];
+        for (uint32_t j = 0; j < slots.size(); j++) {
+          column.Deserialize(first_row + j, page->GetValueData(i, slots[j], buffer));
+        }
+      }
+    };
+    page_id_t next_page_id = table_info_->table_->ReadPaxPage(page_id_, reader, exec_ctx_->GetTransaction());
+    if (page_done) {
+      page_id_ = next_page_id;
+      slot_ = 0;
+    }
+  }
+  return table_batch_->GetRowCount() > 0;
+}
+
+bool SeqScanExecutor::Next(Tuple *tuple, RID *rid) { return NextFromBatch(tuple, rid); }
+
+bool SeqScanExecutor::NextCompiledBatch(TupleBatch *batch) {
+  batch->Reset();
+  auto reader = [&](const std::vector<TupleView> &views) {
+    for (const auto &view : views) {
+      uint32_t row = batch->AppendRow(view.GetRid());
+      for (uint32_t i = 0; i < compiled_outputs_.size(); i++) {
+        compiled_outputs_[i]->EvaluateInto(view.GetData(), &batch->GetColumn(i), row);
+      }
+    }
+  };
+  while (!batch->IsFull() && NextViews(batch->GetCapacity() - batch->GetRowCount(), reader)) {
+  }
+  return batch->Size() > 0;
+}
+
+bool SeqScanExecutor::NextBatch(TupleBatch *batch) {
+  if (compiled_projection_) {
+    return NextCompiledBatch(batch);
+  }
+  if (table_batch_ == nullptr || table_batch_->GetCapacity() != batch->GetCapacity()) {
+    table_batch_ = std::make_unique<TupleBatch>(&table_info_->schema_, batch->GetCapacity());
+  }
+  // a predicate that did not compile, or that is not pushed into the pages, is evaluated over the batch instead
+  const AbstractExpression *predicate =
+      (compiled_predicate_ == nullptr || read_columns_) && !filter_encoded_ ? plan_->GetPredicate() : nullptr;
+  while (read_columns_ ? ReadColumns() : ReadRows()) {
+    if (predicate != nullptr) {
+      ColumnVector passed = predicate->EvaluateBatch(*table_batch_);
+      std::vector<uint32_t> selection;
+      selection.reserve(table_batch_->Size());
+      for (uint32_t row : table_batch_->GetSelection()) {
+        if (!passed.IsNull(row) && passed.GetIntegers()[row] != 0) {
+          selection.push_back(row);
+        }
+      }
+      table_batch_->SetSelection(std::move(selection));
+      if (table_batch_->Size() == 0) {
+        continue;
+      }
+    }
+
+    std::vector<ColumnVector> columns;
+    columns.reserve(GetOutputSchema()->GetColumnCount());
+    for (const auto &column : GetOutputSchema()->GetColumns()) {
+      columns.push_back(column.GetExpr()->EvaluateBatch(*table_batch_));
+    }
+    batch->Assign(*table_batch_, std::move(columns));
+    return true;
+  }
+  batch->Reset();
+  return false;
+}
+
+}  // namespace bustub
@@ -0,0 +1,170 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_executor.cpp
+//
+// Identification: src/execution/sort_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/sort_executor.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "storage/index/key_encoder.h"
+
+namespace bustub {
+
+namespace {
+
+/** Complement the bytes of key from start on, which reverses the memcmp order of a prefix-free encoding. */
+void Descend(std::string *key, size_t start) {
+  for (size_t i = start; i < key->size(); i++) {
+    (*key)[i] = static_cast<char>(~(*key)[i]);
+  }
+}
+
+}  // namespace
+
+SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
+                           std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)) {}
+
+void SortExecutor::EncodeKeys(const SortPlanNode *plan, const TupleBatch &batch, std::vector<std::string> *keys) {
+  keys->resize(batch.Size());
+  for (auto &key : *keys) {
+    key.clear();
+  }
+  for (const auto &[order_by_type, expr] : plan->GetOrderBys()) {
+    ColumnVector column = expr->EvaluateBatch(batch);
+    for (uint32_t i = 0; i < batch.Size(); i++) {
+      std::string &key = (*keys)[i];
+      size_t start = key.size();
+      KeyEncoder::EncodeValue(column.GetValue(batch.RowAt(i)), &key);
+      if (order_by_type == OrderByType::DESC) {
+        Descend(&key, start);
+      }
+    }
+  }
+}
+
+std::string SortExecutor::EncodeKey(const SortPlanNode *plan, const Tuple &tuple, const Schema *schema) {
+  std::string key;
+  for (const auto &[order_by_type, expr] : plan->GetOrderBys()) {
+    size_t start = key.size();
+    KeyEncoder::EncodeValue(expr->Evaluate(&tuple, schema), &key);
+    if (order_by_type == OrderByType::DESC) {
+      Descend(&key, start);
+    }
+  }
+  return key;
+}
+
+void SortExecutor::Init() {
+  child_->Init();
+  ResetRowBatch();
+  entries_.clear();
+  memory_usage_ = 0;
+  entry_pos_ = 0;
+  runs_.clear();
+  cursors_.clear();
+  heap_.clear();
+
+  TupleBatch batch(child_->GetOutputSchema());
+  std::vector<std::string> keys;
+  while (child_->NextBatch(&batch)) {
+    EncodeKeys(plan_, batch, &keys);
+    for (uint32_t i = 0; i < batch.Size(); i++) {
+      uint32_t row = batch.RowAt(i);
+      entries_.push_back(SortEntry{std::move(keys[i]), batch.GetTuple(row), batch.GetRid(row)});
+      memory_usage_ += sizeof(SortEntry) + entries_.back().key_.size() + entries_.back().tuple_.GetLength();
+      if (memory_usage_ > exec_ctx_->GetMemoryBudget()) {
+        SpillRun();
+      }
+    }
+  }
+
+  if (runs_.empty()) {
+    // equal keys keep the order of the child
+    std::stable_sort(entries_.begin(), entries_.end(),
+                     [](const SortEntry &lhs, const SortEntry &rhs) { return lhs.key_ < rhs.key_; });
+    return;
+  }
+  if (!entries_.empty()) {
+    SpillRun();
+  }
+  cursors_.resize(runs_.size());
+  for (size_t i = 0; i < runs_.size(); i++) {
+    cursors_[i].run_ = runs_[i].get();
+    if (Advance(&cursors_[i])) {
+      heap_.push_back(i);
+    }
+  }
+  auto after = [this](size_t lhs, size_t rhs) { return CursorAfter(lhs, rhs); };
+  std::make_heap(heap_.begin(), heap_.end(), after);
+}
+
+void SortExecutor::SpillRun() {
+  std::stable_sort(entries_.begin(), entries_.end(),
+                   [](const SortEntry &lhs, const SortEntry &rhs) { return lhs.key_ < rhs.key_; });
+  auto run = std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager());
+  for (const auto &entry : entries_) {
+    run->Append(entry.tuple_);
+  }
+  runs_.push_back(std::move(run));
+  std::vector<SortEntry>().swap(entries_);
+  memory_usage_ = 0;
+}
+
+bool SortExecutor::Advance(RunCursor *cursor) {
+  cursor->pos_++;
+  if (cursor->pos_ >= cursor->tuples_.size()) {
+    if (cursor->next_page_ == cursor->run_->GetPageCount()) {
+      return false;
+    }
+    cursor->tuples_.clear();
+    cursor->run_->ReadPage(cursor->next_page_++, &cursor->tuples_);
+    cursor->pos_ = 0;
+  }
+  // the key is not spilled with the tuple, it is computed again as the tuple is read back
+  cursor->key_ = EncodeKey(plan_, cursor->tuples_[cursor->pos_], child_->GetOutputSchema());
+  return true;
+}
+
+bool SortExecutor::CursorAfter(size_t lhs, size_t rhs) const {
+  // runs hold consecutive parts of the child, so the earlier run wins on equal keys
+  int cmp = cursors_[lhs].key_.compare(cursors_[rhs].key_);
+  return cmp > 0 || (cmp == 0 && lhs > rhs);
+}
+
+bool SortExecutor::Next(Tuple *tuple, RID *rid) { return NextFromBatch(tuple, rid); }
+
+bool SortExecutor::NextBatch(TupleBatch *batch) {
+  batch->Reset();
+  if (runs_.empty()) {
+    for (; !batch->IsFull() && entry_pos_ < entries_.size(); entry_pos_++) {
+      batch->Append(entries_[entry_pos_].tuple_, entries_[entry_pos_].rid_);
+    }
+    return batch->Size() > 0;
+  }
+
+  // k-way merge of the runs: the cursor with the smallest key is at the top of the heap
+  auto after = [this](size_t lhs, size_t rhs) { return CursorAfter(lhs, rhs); };
+  while (!batch->IsFull() && !heap_.empty()) {
+    std::pop_heap(heap_.begin(), heap_.end(), after);
+    RunCursor &cursor = cursors_[heap_.back()];
+    batch->Append(cursor.tuples_[cursor.pos_], RID());
+    if (Advance(&cursor)) {
+      std::push_heap(heap_.begin(), heap_.end(), after);
+    } else {
+      heap_.pop_back();
+    }
+  }
+  return batch->Size() > 0;
+}
+
+}  // namespace bustub
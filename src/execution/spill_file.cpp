@@ -0,0 +1,97 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// spill_file.cpp
+//
+// Identification: src/execution/spill_file.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/spill_file.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "common/exception.h"
+#include "storage/page/tmp_tuple_page.h"
+
+namespace bustub {
+
+SpillFile::~SpillFile() {
+  for (page_id_t page_id : page_ids_) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+void SpillFile::Append(const Tuple &tuple) {
+  BUSTUB_ASSERT(tuple.GetLength() <= TmpTuplePage::MaxTupleSize(), "tuple too large to spill");
+  TmpTuple out(INVALID_PAGE_ID, 0);
+  if (!page_ids_.empty()) {
+    auto *page = reinterpret_cast<TmpTuplePage *>(bpm_->FetchPage(page_ids_.back()));
+    BUSTUB_ASSERT(page != nullptr, "spill page could not be fetched");
+    bool inserted = page->Insert(tuple, &out);
+    bpm_->UnpinPage(page_ids_.back(), inserted);
+    if (inserted) {
+      size_++;
+      return;
+    }
+  }
+  page_id_t page_id;
+  auto *page = reinterpret_cast<TmpTuplePage *>(bpm_->NewPage(&page_id));
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "no free frame to spill to");
+  }
+  page->Init(page_id, PAGE_SIZE);
+  page->Insert(tuple, &out);
+  bpm_->UnpinPage(page_id, true);
+  page_ids_.push_back(page_id);
+  size_++;
+}
+
+void SpillFile::Splice(SpillFile *other) {
+  // the last page of this file stays partly empty
+  page_ids_.insert(page_ids_.end(), other->page_ids_.begin(), other->page_ids_.end());
+  size_ += other->size_;
+  other->page_ids_.clear();
+  other->size_ = 0;
+}
+
+void SpillFile::ReadPage(size_t page_idx, std::vector<Tuple> *tuples) const {
+  auto *page = reinterpret_cast<TmpTuplePage *>(bpm_->FetchPage(page_ids_[page_idx]));
+  BUSTUB_ASSERT(page != nullptr, "spill page could not be fetched");
+  // tuples are laid out from the end of the page, the first one inserted last
+  size_t first = tuples->size();
+  for (uint32_t offset = page->GetFreeSpacePointer(); offset < PAGE_SIZE;) {
+    Tuple tuple;
+    offset = page->Get(offset, &tuple);
+    tuples->push_back(std::move(tuple));
+  }
+  std::reverse(tuples->begin() + first, tuples->end());
+  bpm_->UnpinPage(page_ids_[page_idx], false);
+}
+
+void SpillFile::ViewPage(size_t page_idx,
+                         const std::function<void(const std::vector<TupleView> &views)> &reader) const {
+  auto *page = reinterpret_cast<TmpTuplePage *>(bpm_->FetchPage(page_ids_[page_idx]));
+  BUSTUB_ASSERT(page != nullptr, "spill page could not be fetched");
+  std::vector<TupleView> views;
+  for (uint32_t offset = page->GetFreeSpacePointer(); offset < PAGE_SIZE;) {
+    views.emplace_back();
+    offset = page->GetView(offset, &views.back());
+  }
+  std::reverse(views.begin(), views.end());
+  reader(views);
+  bpm_->UnpinPage(page_ids_[page_idx], false);
+}
+
+void SpillFile::ReadAll(std::vector<Tuple> *tuples) const {
+  tuples->reserve(tuples->size() + size_);
+  for (size_t i = 0; i < page_ids_.size(); i++) {
+    ReadPage(i, tuples);
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// topn_executor.cpp
+//
+// Identification: src/execution/topn_executor.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/topn_executor.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "execution/executors/sort_executor.h"
+
+namespace bustub {
+
+TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan, size_t n,
+                           std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), n_(n), child_(std::move(child)) {}
+
+void TopNExecutor::Init() {
+  child_->Init();
+  ResetRowBatch();
+  entries_.clear();
+  entry_pos_ = 0;
+  if (n_ == 0) {
+    return;
+  }
+
+  TupleBatch batch(child_->GetOutputSchema());
+  std::vector<std::string> keys;
+  size_t seq = 0;
+  while (child_->NextBatch(&batch)) {
+    SortExecutor::EncodeKeys(plan_, batch, &keys);
+    for (uint32_t i = 0; i < batch.Size(); i++, seq++) {
+      // a tuple only enters a full heap if it comes before the last of the first n
+      if (entries_.size() == n_) {
+        if (keys[i].compare(entries_.front().key_) >= 0) {
+          continue;
+        }
+        std::pop_heap(entries_.begin(), entries_.end());
+        entries_.pop_back();
+      }
+      uint32_t row = batch.RowAt(i);
+      entries_.push_back(TopNEntry{std::move(keys[i]), seq, batch.GetTuple(row), batch.GetRid(row)});
+      std::push_heap(entries_.begin(), entries_.end());
+    }
+  }
+  std::sort_heap(entries_.begin(), entries_.end());
+}
+
+bool TopNExecutor::Next(Tuple *tuple, RID *rid) { return NextFromBatch(tuple, rid); }
+
+bool TopNExecutor::NextBatch(TupleBatch *batch) {
+  batch->Reset();
+  for (; !batch->IsFull() && entry_pos_ < entries_.size(); entry_pos_++) {
+    batch->Append(entries_[entry_pos_].tuple_, entries_[entry_pos_].rid_);
+  }
+  return batch->Size() > 0;
+}
+
+}  // namespace bustub
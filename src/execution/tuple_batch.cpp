@@ -0,0 +1,298 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch.cpp
+//
+// Identification: src/execution/tuple_batch.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/tuple_batch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "common/macros.h"
+#include "type/limits.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+ColumnVector::ColumnVector(TypeId type, uint32_t capacity) : type_(type), nulls_(capacity) {
+  switch (type) {
+    case TypeId::DECIMAL:
+      decimals_.resize(capacity);
+      break;
+    case TypeId::VARCHAR:
+      strings_.resize(capacity);
+      break;
+    default:
+      integers_.resize(capacity);
+  }
+}
+
+Value ColumnVector::GetValue(uint32_t row, AbstractPool *pool) const {
+  if (IsNull(row)) {
+    return ValueFactory::GetNullValueByType(type_);
+  }
+  switch (type_) {
+    case TypeId::BOOLEAN:
+      return ValueFactory::GetBooleanValue(integers_[row] != 0);
+    case TypeId::TINYINT:
+      return ValueFactory::GetTinyIntValue(static_cast<int8_t>(integers_[row]));
+    case TypeId::SMALLINT:
+      return ValueFactory::GetSmallIntValue(static_cast<int16_t>(integers_[row]));
+    case TypeId::INTEGER:
+      return ValueFactory::GetIntegerValue(static_cast<int32_t>(integers_[row]));
+    case TypeId::BIGINT:
+      return ValueFactory::GetBigIntValue(integers_[row]);
+    case TypeId::TIMESTAMP:
+      return Value(TypeId::TIMESTAMP, static_cast<uint64_t>(integers_[row]));
+    case TypeId::DECIMAL:
+      return ValueFactory::GetDecimalValue(decimals_[row]);
+    case TypeId::VARCHAR:
+      return ValueFactory::GetVarcharValue(strings_[row], pool);
+    default:
+      UNREACHABLE("Unsupported column vector type.");
+  }
+}
+
+void ColumnVector::SetValue(uint32_t row, const Value &val) {
+  nulls_[row] = static_cast<uint8_t>(val.IsNull());
+  if (val.IsNull()) {
+    return;
+  }
+  if (val.GetTypeId() != type_) {
+    SetValue(row, val.CastAs(type_));
+    return;
+  }
+  switch (type_) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      integers_[row] = val.GetAs<int8_t>();
+      break;
+    case TypeId::SMALLINT:
+      integers_[row] = val.GetAs<int16_t>();
+      break;
+    case TypeId::INTEGER:
+      integers_[row] = val.GetAs<int32_t>();
+      break;
+    case TypeId::BIGINT:
+      integers_[row] = val.GetAs<int64_t>();
+      break;
+    case TypeId::TIMESTAMP:
+      integers_[row] = static_cast<int64_t>(val.GetAs<uint64_t>());
+      break;
+    case TypeId::DECIMAL:
+      decimals_[row] = val.GetAs<double>();
+      break;
+    case TypeId::VARCHAR:
+      // the stored length counts the trailing terminator
+      strings_[row].assign(val.GetData(), val.GetLength() - 1);
+      break;
+    default:
+      UNREACHABLE("Unsupported column vector type.");
+  }
+}
+
+void ColumnVector::Deserialize(uint32_t row, const char *data) {
+  bool is_null;
+  switch (type_) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT: {
+      int8_t val;
+      memcpy(&val, data, sizeof(val));
+      is_null = val == BUSTUB_INT8_NULL;
+      integers_[row] = val;
+      break;
+    }
+    case TypeId::SMALLINT: {
+      int16_t val;
+      memcpy(&val, data, sizeof(val));
+      is_null = val == BUSTUB_INT16_NULL;
+      integers_[row] = val;
+      break;
+    }
+    case TypeId::INTEGER: {
+      int32_t val;
+      memcpy(&val, data, sizeof(val));
+      is_null = val == BUSTUB_INT32_NULL;
+      integers_[row] = val;
+      break;
+    }
+    case TypeId::BIGINT: {
+      int64_t val;
+      memcpy(&val, data, sizeof(val));
+      is_null = val == BUSTUB_INT64_NULL;
+      integers_[row] = val;
+      break;
+    }
+    case TypeId::TIMESTAMP: {
+      uint64_t val;
+      memcpy(&val, data, sizeof(val));
+      is_null = val == BUSTUB_TIMESTAMP_NULL;
+      integers_[row] = static_cast<int64_t>(val);
+      break;
+    }
+    case TypeId::DECIMAL: {
+      double val;
+      memcpy(&val, data, sizeof(val));
+      is_null = val == BUSTUB_DECIMAL_NULL;
+      decimals_[row] = val;
+      break;
+    }
+    case TypeId::VARCHAR: {
+      uint32_t len;
+      memcpy(&len, data, sizeof(len));
+      is_null = len == BUSTUB_VALUE_NULL;
+      // the stored length counts the trailing terminator
+      if (!is_null) {
+        strings_[row].assign(data + sizeof(uint32_t), len > 0 ? len - 1 : 0);
+      }
+      break;
+    }
+    default:
+      UNREACHABLE("Unsupported column vector type.");
+  }
+  nulls_[row] = static_cast<uint8_t>(is_null);
+}
+
+void ColumnVector::SerializeTo(uint32_t row, char *data) const {
+  bool is_null = IsNull(row);
+  switch (type_) {
+    case TypeId::BOOLEAN: {
+      int8_t val = is_null ? BUSTUB_BOOLEAN_NULL : static_cast<int8_t>(integers_[row] != 0);
+      memcpy(data, &val, sizeof(val));
+      break;
+    }
+    case TypeId::TINYINT: {
+      int8_t val = is_null ? BUSTUB_INT8_NULL : static_cast<int8_t>(integers_[row]);
+      memcpy(data, &val, sizeof(val));
+      break;
+    }
+    case TypeId::SMALLINT: {
+      int16_t val = is_null ? BUSTUB_INT16_NULL : static_cast<int16_t>(integers_[row]);
+      memcpy(data, &val, sizeof(val));
+      break;
+    }
+    case TypeId::INTEGER: {
+      int32_t val = is_null ? BUSTUB_INT32_NULL : static_cast<int32_t>(integers_[row]);
+      memcpy(data, &val, sizeof(val));
+      break;
+    }
+    case TypeId::BIGINT: {
+      int64_t val = is_null ? BUSTUB_INT64_NULL : integers_[row];
+      memcpy(data, &val, sizeof(val));
+      break;
+    }
+    case TypeId::TIMESTAMP: {
+      uint64_t val = is_null ? BUSTUB_TIMESTAMP_NULL : static_cast<uint64_t>(integers_[row]);
+      memcpy(data, &val, sizeof(val));
+      break;
+    }
+    case TypeId::DECIMAL: {
+      double val = is_null ? BUSTUB_DECIMAL_NULL : decimals_[row];
+      memcpy(data, &val, sizeof(val));
+      break;
+    }
+    case TypeId::VARCHAR: {
+      uint32_t len = is_null ? BUSTUB_VALUE_NULL : static_cast<uint32_t>(strings_[row].size()) + 1;
+      memcpy(data, &len, sizeof(len));
+      if (!is_null) {
+        memcpy(data + sizeof(uint32_t), strings_[row].c_str(), len);
+      }
+      break;
+    }
+    default:
+      UNREACHABLE("Unsupported column vector type.");
+  }
+}
+
+TupleBatch::TupleBatch(const Schema *schema, uint32_t capacity)
+    : schema_(schema), capacity_(capacity), rids_(capacity) {
+  columns_.reserve(schema->GetColumnCount());
+  for (const auto &column : schema->GetColumns()) {
+    columns_.emplace_back(column.GetType(), capacity);
+  }
+  selection_.reserve(capacity);
+}
+
+void TupleBatch::Append(const Tuple &tuple, const RID &rid, const std::vector<bool> *column_mask) {
+  Append(TupleView(tuple.GetData(), tuple.GetLength(), rid), column_mask);
+}
+
+void TupleBatch::Append(const TupleView &view, const std::vector<bool> *column_mask) {
+  BUSTUB_ASSERT(!IsFull(), "batch is full");
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    if (column_mask == nullptr || (*column_mask)[i]) {
+      columns_[i].Deserialize(row_count_, view.GetDataPtr(schema_, i));
+    }
+  }
+  rids_[row_count_] = view.GetRid();
+  selection_.push_back(row_count_++);
+}
+
+void TupleBatch::Append(const std::vector<Value> &values, const RID &rid) {
+  BUSTUB_ASSERT(!IsFull(), "batch is full");
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    columns_[i].SetValue(row_count_, values[i]);
+  }
+  rids_[row_count_] = rid;
+  selection_.push_back(row_count_++);
+}
+
+uint32_t TupleBatch::AppendRow(const RID &rid) {
+  BUSTUB_ASSERT(!IsFull(), "batch is full");
+  rids_[row_count_] = rid;
+  selection_.push_back(row_count_);
+  return row_count_++;
+}
+
+void TupleBatch::Assign(const TupleBatch &source, std::vector<ColumnVector> &&columns) {
+  BUSTUB_ASSERT(columns.size() == columns_.size() && source.capacity_ == capacity_, "batch shapes do not match");
+  columns_ = std::move(columns);
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    // an expression may compute another type than its output column holds
+    TypeId type = schema_->GetColumn(i).GetType();
+    if (columns_[i].GetType() != type) {
+      ColumnVector cast(type, capacity_);
+      for (uint32_t row : source.selection_) {
+        cast.SetValue(row, columns_[i].GetValue(row));
+      }
+      columns_[i] = std::move(cast);
+    }
+  }
+  row_count_ = source.row_count_;
+  std::copy(source.rids_.begin(), source.rids_.begin() + source.row_count_, rids_.begin());
+  selection_ = source.selection_;
+}
+
+Tuple TupleBatch::GetTuple(uint32_t row, AbstractPool *pool) const {
+  // the columns are written straight into the tuple, laid out as the Tuple constructor lays out values
+  uint32_t size = schema_->GetLength();
+  for (uint32_t i : schema_->GetUnlinedColumns()) {
+    size += columns_[i].GetSerializedSize(row);
+  }
+  Tuple tuple;
+  tuple.allocated_ = pool == nullptr;
+  tuple.size_ = size;
+  tuple.data_ = tuple.allocated_ ? new char[size] : static_cast<char *>(pool->Allocate(size));
+  uint32_t offset = schema_->GetLength();
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    const auto &column = schema_->GetColumn(i);
+    if (column.IsInlined()) {
+      columns_[i].SerializeTo(row, tuple.data_ + column.GetOffset());
+      continue;
+    }
+    memcpy(tuple.data_ + column.GetOffset(), &offset, sizeof(uint32_t));
+    columns_[i].SerializeTo(row, tuple.data_ + offset);
+    offset += columns_[i].GetSerializedSize(row);
+  }
+  return tuple;
+}
+
+}  // namespace bustub
@@ -121,6 +121,15 @@ class BufferPoolManagerInstance : public BufferPoolManager {
    */
   void ValidatePageId(page_id_t page_id) const;
 
+  /**
+   * Pick a frame to hold a new page, from the free list first and the replacer otherwise.
+   * A victim taken from the replacer is written back if dirty and removed from the page table.
+   * Must be called with latch_ held.
+   * @param[out] frame_id the frame that is now free for use
+   * @return false if every frame is pinned
+   */
+  bool FindVictimFrame(frame_id_t *frame_id);
+
   /** Number of pages in the buffer pool. */
   const size_t pool_size_;
   /** How many instances are in the parallel BPM (if present, otherwise just 1 BPI) */
@@ -133,7 +142,7 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   /** Array of buffer pool pages. */
   Page *pages_;
   /** Pointer to the disk manager. */
-  DiskManager *disk_manager_ __attribute__((__unused__));
+  DiskManager *disk_manager_;
   /** Pointer to the log manager. */
   LogManager *log_manager_ __attribute__((__unused__));
   /** Page table for keeping track of buffer pool pages. */
@@ -142,7 +151,7 @@ class BufferPoolManagerInstance : public BufferPoolManager {
   Replacer *replacer_;
   /** List of free pages. */
   std::list<frame_id_t> free_list_;
-  /** This latch protects shared data structures. We recommend updating this comment to describe what it protects. */
+  /** This latch protects page_table_, free_list_ and the book-keeping fields of every page in pages_. */
   std::mutex latch_;
 };
 }  // namespace bustub
@@ -21,8 +21,12 @@
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
 #include "container/hash/hash_function.h"
+#include "storage/index/art_index.h"
+#include "storage/index/b_plus_tree_index.h"
 #include "storage/index/extendible_hash_table_index.h"
 #include "storage/index/index.h"
+#include "storage/index/key_encoder.h"
+#include "storage/index/linear_probe_hash_table_index.h"
 #include "storage/table/table_heap.h"
 
 namespace bustub {
@@ -34,6 +38,9 @@ using table_oid_t = uint32_t;
 using column_oid_t = uint32_t;
 using index_oid_t = uint32_t;
 
+/** The kinds of index that the catalog can build. */
+enum class IndexType { ExtendibleHashTableIndex, BPlusTreeIndex, LinearProbeHashTableIndex, ARTIndex };
+
 /**
  * The TableInfo class maintains metadata about a table.
  */
@@ -119,15 +126,21 @@ class Catalog {
    * @param txn The transaction in which the table is being created
    * @param table_name The name of the new table
    * @param schema The schema of the new table
+   * @param zone_map_columns The columns to keep a zone map of, none by default
+   * @param layout The layout of the pages of the table, slotted rows by default
    * @return A (non-owning) pointer to the metadata for the table
    */
-  TableInfo *CreateTable(Transaction *txn, const std::string &table_name, const Schema &schema) {
+  TableInfo *CreateTable(Transaction *txn, const std::string &table_name, const Schema &schema,
+                         const std::vector<uint32_t> &zone_map_columns = {}, TableLayout layout = TableLayout::ROW) {
     if (table_names_.count(table_name) != 0) {
       return NULL_TABLE_INFO;
     }
 
     // Construct the table heap
-    auto table = std::make_unique<TableHeap>(bpm_, lock_manager_, log_manager_, txn);
+    auto table = std::make_unique<TableHeap>(bpm_, lock_manager_, log_manager_, txn, schema, layout);
+    if (!zone_map_columns.empty()) {
+      table->CreateZoneMap(schema, zone_map_columns, txn);
+    }
 
     // Fetch the table OID for the new table
     const auto table_oid = next_table_oid_.fetch_add(1);
@@ -185,13 +198,23 @@ class Catalog {
    * @param key_schema The schema of the key
    * @param key_attrs Key attributes
    * @param keysize Size of the key
-   * @param hash_function The hash function for the index
+   * @param hash_function The hash function for the index, unused by ordered indexes
+   * @param index_type The kind of index to build
+   * @param include_attrs Non-key columns stored in every entry of a B+ tree index, so scans that only read
+   * key and included columns never touch the table heap
+   * @param filter_capacity Expected number of keys to size a Bloom filter for, so point lookups of absent keys skip
+   * the index; 0 for no filter. Only B+ tree and extendible hash indexes keep one
+   * @param normalized_keys Build keys in the binary-comparable encoding, so the index compares them with memcmp
+   * instead of one Value at a time; the longest encoding of the key schema must fit in keysize
    * @return A (non-owning) pointer to the metadata of the new table
    */
   template <class KeyType, class ValueType, class KeyComparator>
   IndexInfo *CreateIndex(Transaction *txn, const std::string &index_name, const std::string &table_name,
                          const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs,
-                         std::size_t keysize, HashFunction<KeyType> hash_function) {
+                         std::size_t keysize, HashFunction<KeyType> hash_function,
+                         IndexType index_type = IndexType::ExtendibleHashTableIndex,
+                         const std::vector<uint32_t> &include_attrs = {}, std::size_t filter_capacity = 0,
+                         bool normalized_keys = false) {
     // Reject the creation request for nonexistent table
     if (table_names_.find(table_name) == table_names_.end()) {
       return NULL_INDEX_INFO;
@@ -208,20 +231,64 @@ class Catalog {
     }
 
     // Construct index metdata
-    auto meta = std::make_unique<IndexMetadata>(index_name, table_name, &schema, key_attrs);
+    auto meta =
+        std::make_unique<IndexMetadata>(index_name, table_name, &schema, key_attrs, include_attrs, normalized_keys);
+
+    // Included columns only pay off in an ordered index, and the whole entry has to fit in the key
+    if (!include_attrs.empty() &&
+        (index_type != IndexType::BPlusTreeIndex || meta->GetKeySchema()->GetLength() > keysize)) {
+      return NULL_INDEX_INFO;
+    }
+
+    // Normalized keys must fit the key size even when every varchar is at its longest; a key whose varchars escape
+    // zero bytes or exceed their declared length may still not fit, and is rejected when it is inserted
+    if (normalized_keys && KeyEncoder::MaxEncodedLength(meta->GetKeySchema()) > keysize) {
+      return NULL_INDEX_INFO;
+    }
+
+    // Only the B+ tree and extendible hash indexes maintain a Bloom filter
+    if (filter_capacity > 0 && index_type != IndexType::BPlusTreeIndex &&
+        index_type != IndexType::ExtendibleHashTableIndex) {
+      return NULL_INDEX_INFO;
+    }
+
+    // Entries of a covering index are built from its own entry schema rather than the bare key schema
+    const Schema entry_schema = include_attrs.empty() ? key_schema : *meta->GetKeySchema();
+    const std::vector<uint32_t> entry_attrs = meta->GetKeyAttrs();
 
     // Construct the index, take ownership of metadata
-    // TODO(Kyle): We should update the API for CreateIndex
-    // to allow specification of the index type itself, not
-    // just the key, value, and comparator types
-    auto index = std::make_unique<ExtendibleHashTableIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_,
-                                                                                               hash_function);
+    std::unique_ptr<Index> index;
+    switch (index_type) {
+      case IndexType::BPlusTreeIndex: {
+        // Every B+ tree keeps its root page id in a header page of its own
+        page_id_t header_page_id;
+        if (bpm_->NewPage(&header_page_id) == nullptr) {
+          return NULL_INDEX_INFO;
+        }
+        bpm_->UnpinPage(header_page_id, true);
+        index = std::make_unique<BPlusTreeIndex<KeyType, ValueType, KeyComparator>>(std::move(meta), bpm_,
+                                                                                    header_page_id, filter_capacity);
+        break;
+      }
+      case IndexType::ExtendibleHashTableIndex:
+        index = std::make_unique<ExtendibleHashTableIndex<KeyType, ValueType, KeyComparator>>(
+            std::move(meta), bpm_, hash_function, filter_capacity);
+        break;
+      case IndexType::LinearProbeHashTableIndex:
+        index = std::make_unique<LinearProbeHashTableIndex<KeyType, ValueType, KeyComparator>>(
+            std::move(meta), bpm_, LINEAR_PROBE_INITIAL_SIZE, hash_function);
+        break;
+      case IndexType::ARTIndex:
+        // in memory only; keys are encoded from the key schema, so keysize and the comparator are unused
+        index = std::make_unique<ARTIndex>(std::move(meta));
+        break;
+    }
 
     // Populate the index with all tuples in table heap
     auto *table_meta = GetTable(table_name);
     auto *heap = table_meta->table_.get();
     for (auto tuple = heap->Begin(txn); tuple != heap->End(); ++tuple) {
-      index->InsertEntry(tuple->KeyFromTuple(schema, key_schema, key_attrs), tuple->GetRid(), txn);
+      index->InsertEntry(tuple->KeyFromTuple(schema, entry_schema, entry_attrs), tuple->GetRid(), txn);
     }
 
     // Get the next OID for the new index
@@ -229,7 +296,7 @@ class Catalog {
 
     // Construct index information; IndexInfo takes ownership of the Index itself
     auto index_info =
-        std::make_unique<IndexInfo>(key_schema, index_name, std::move(index), index_oid, table_name, keysize);
+        std::make_unique<IndexInfo>(entry_schema, index_name, std::move(index), index_oid, table_name, keysize);
     auto *tmp = index_info.get();
 
     // Update internal tracking
@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// barrier.h
+//
+// Identification: src/include/common/barrier.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <mutex>               // NOLINT
+
+#include "common/exception.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+/**
+ * Barrier blocks a fixed number of threads until all of them have arrived. A thread that cannot arrive, e.g. because
+ * it failed, cancels the barrier so that the others do not wait for it forever.
+ */
+class Barrier {
+ public:
+  /** @param count the number of threads that have to arrive */
+  explicit Barrier(size_t count) : count_(count) {}
+
+  DISALLOW_COPY(Barrier);
+
+  /**
+   * Arrive and wait for the other threads.
+   * @return true in exactly one of the threads, the last to arrive
+   * @throws Exception if the barrier is cancelled before every thread has arrived
+   */
+  bool ArriveAndWait() {
+    std::unique_lock<std::mutex> latch(mutex_);
+    if (!cancelled_ && ++arrived_ == count_) {
+      all_arrived_.notify_all();
+      return true;
+    }
+    all_arrived_.wait(latch, [this] { return cancelled_ || arrived_ == count_; });
+    if (arrived_ != count_) {
+      throw Exception("barrier cancelled before every thread arrived");
+    }
+    return false;
+  }
+
+  /** Release the threads waiting, and those to come, with an exception, unless every thread has arrived. */
+  void Cancel() {
+    std::scoped_lock latch(mutex_);
+    cancelled_ = true;
+    all_arrived_.notify_all();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable all_arrived_;
+  size_t count_;
+  size_t arrived_{0};
+  bool cancelled_{false};
+};
+
+}  // namespace bustub
@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <chrono>  // NOLINT
+#include <cstddef>
 #include <cstdint>
 
 namespace bustub {
@@ -35,6 +36,14 @@ static constexpr int PAGE_SIZE = 4096;                                        //
 static constexpr int BUFFER_POOL_SIZE = 10;                                   // size of buffer pool
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                        // size of extendible hash bucket
+static constexpr int LINEAR_PROBE_INITIAL_SIZE = 1024;                        // initial slots of linear probe index
+static constexpr int BLOOM_FILTER_BITS_PER_KEY = 10;                          // index filter bits per expected key
+static constexpr int BLOOM_FILTER_NUM_HASHES = 7;                             // bits set per key in an index filter
+static constexpr int BATCH_SIZE = 1024;                                       // rows per batch of vectorized execution
+static constexpr int MORSEL_SIZE = 16;                                        // table pages a worker claims at once
+static constexpr int HASH_JOIN_RADIX_BITS = 6;                                // log2 of the partitions of a hash join
+static constexpr int AGGREGATION_RADIX_BITS = 6;                              // log2 of the partitions of a group by
+static constexpr size_t QUERY_MEMORY_BUDGET = 256 << 20;                      // bytes a query may hold before spilling
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
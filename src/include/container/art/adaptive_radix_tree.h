@@ -0,0 +1,116 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// adaptive_radix_tree.h
+//
+// Identification: src/include/container/art/adaptive_radix_tree.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <mutex>  // NOLINT
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+struct ArtNode;
+
+/**
+ * In-memory adaptive radix tree (Leis et al., ICDE 2013) over binary-comparable byte string keys, such as those
+ * produced by KeyEncoder. Inner nodes grow through 4, 16, 48 and 256 children and store their compressed path
+ * prefix in full. Leaves hold the whole key and every value inserted under it.
+ *
+ * Concurrency follows optimistic lock coupling (Leis et al., DaMoN 2016): each node carries a version word with a
+ * lock and an obsolete bit. Readers never write tree nodes; they validate node versions after reading and restart
+ * on a conflict. Writers lock at most the node they change and its parent. Node prefixes are never modified in
+ * place, so a node whose prefix splits or that outgrows its type is replaced by a copy. The values of a leaf are
+ * added and removed in place under the lock of the leaf, and a leaf that runs out of room is replaced by a copy
+ * twice as large.
+ *
+ * Replaced nodes may still be read by concurrent operations, so they are retired and freed by epoch based
+ * reclamation: every operation runs inside the global epoch it read when it started, and a node retired in epoch e
+ * is freed once the global epoch reached e + 2, which it only does after every operation of epoch e finished.
+ * Removals drop leaves but never shrink or merge inner nodes.
+ *
+ * Keys must be prefix-free: no key may be a proper prefix of another.
+ */
+template <typename ValueType>
+class AdaptiveRadixTree {
+ public:
+  AdaptiveRadixTree();
+  ~AdaptiveRadixTree();
+
+  DISALLOW_COPY_AND_MOVE(AdaptiveRadixTree);
+
+  /**
+   * Performs a point lookup.
+   * @param key the encoded key
+   * @param[out] result the values stored under the key are appended here
+   * @return true if the key was found
+   */
+  bool GetValue(const std::string &key, std::vector<ValueType> *result);
+
+  /**
+   * Inserts a key-value pair; a key may hold several distinct values.
+   * @return false if the pair was already present
+   */
+  bool Insert(const std::string &key, const ValueType &value);
+
+  /**
+   * Removes a key-value pair.
+   * @return false if the pair was not present
+   */
+  bool Remove(const std::string &key, const ValueType &value);
+
+ private:
+  /* Single attempts of the operations; they set restart when a version check failed and must be retried. */
+  bool TryGetValue(const std::string &key, std::vector<ValueType> *result, bool *restart);
+  bool TryInsert(const std::string &key, const ValueType &value, bool *restart);
+  bool TryRemove(const std::string &key, const ValueType &value, bool *restart);
+
+  /** @return the epoch the calling operation runs in, to be handed to ExitEpoch when it finishes */
+  uint64_t EnterEpoch();
+
+  /** Ends an operation that entered epoch. */
+  void ExitEpoch(uint64_t epoch);
+
+  /** Hands a node no longer reachable from the root over to be freed once no operation can read it anymore. */
+  void Retire(ArtNode *node);
+
+  /** @return the slot of active_ the calling thread counts its operations in */
+  static size_t EpochShard();
+
+  /** Frees node and everything below it. */
+  void FreeSubtree(ArtNode *node);
+
+  /** Frees a single node of any type. */
+  static void FreeNode(ArtNode *node);
+
+  // 256-way root; it never fills up, so it is never replaced and every other node has a parent
+  ArtNode *root_;
+
+  // Operations count themselves in one of EPOCH_SHARDS counters of their epoch, chosen by thread to keep them apart
+  static constexpr size_t EPOCH_SHARDS = 16;
+  struct alignas(64) EpochCounter {
+    std::atomic<uint64_t> active_{0};
+  };
+  std::atomic<uint64_t> epoch_{0};
+  // Only the current epoch and the one before have operations running, indexed by epoch modulo 3
+  EpochCounter active_[3][EPOCH_SHARDS];
+
+  // Retired nodes with the epoch they were retired in, oldest first
+  std::mutex retired_latch_;
+  std::deque<std::pair<uint64_t, ArtNode *>> retired_;
+};
+
+}  // namespace bustub
@@ -121,6 +121,15 @@ class ExtendibleHashTable {
    */
   page_id_t KeyToPageId(KeyType key, HashTableDirectoryPage *dir_page);
 
+  /**
+   * Fetches a page from the buffer pool manager, pinned.
+   *
+   * @param page_id the page_id to fetch
+   * @return a pointer to the page
+   * @throws Exception if the buffer pool has no free frame
+   */
+  Page *FetchPage(page_id_t page_id);
+
   /**
    * Fetches the directory page from the buffer pool manager.
    *
@@ -170,7 +179,8 @@ class ExtendibleHashTable {
   BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
 
-  // Readers includes inserts and removes, writers are splits and merges
+  // Readers includes inserts and removes, writers are splits and merges. Readers of the directory latch the
+  // bucket page they touch: shared for lookups, exclusive for inserts and removes.
   ReaderWriterLatch table_latch_;
   HashFunction<KeyType> hash_fn_;
 };
@@ -26,12 +26,24 @@
 
 namespace bustub {
 
-#define HASH_TABLE_TYPE LinearProbeHashTable<KeyType, ValueType, KeyComparator>
+#define LINEAR_PROBE_HASH_TABLE_TYPE LinearProbeHashTable<KeyType, ValueType, KeyComparator>
 
 /**
  * Implementation of linear probing hash table that is backed by a buffer pool
  * manager. Non-unique keys are supported. Supports insert and delete. The
  * table dynamically grows once full.
+ *
+ * The slots are spread over block pages listed in the header page, and in the
+ * header pages chained to it once the first one is full. A probe walks them
+ * block by block until it reaches a slot that was never occupied.
+ * Removed entries leave tombstones behind so that probes keep going past them;
+ * they are dropped when the table is rehashed. Writers are serialized among
+ * themselves, while lookups only latch the block pages they read. A resize
+ * builds the new table next to the old one while lookups keep using the old
+ * table, and only takes the table latch exclusively to swap the header page.
+ * Inserts and removes do wait for the whole resize: rather than migrating the
+ * entries incrementally, which would have every operation probe both tables,
+ * the table keeps resizes rare by doubling its size each time.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class LinearProbeHashTable : public HashTable<KeyType, ValueType, KeyComparator> {
@@ -87,14 +99,69 @@ class LinearProbeHashTable : public HashTable<KeyType, ValueType, KeyComparator>
   size_t GetSize();
 
  private:
+  /**
+   * Allocates the header page and enough block pages for num_buckets slots.
+   * @param num_buckets the minimum number of slots, rounded up to whole blocks
+   * @return the page id of the new header page
+   */
+  page_id_t CreateTable(size_t num_buckets);
+
+  /**
+   * Looks up the page id of a block, following the chain of header pages if the block is not listed in the first one.
+   * @param header the first header page of the table
+   * @param block_idx the index of the block among all blocks of the table
+   * @return the page id of the block
+   */
+  page_id_t GetBlockPageId(HashTableHeaderPage *header, size_t block_idx);
+
+  /**
+   * Collects the pages of a table.
+   * @param header_page_id the first header page of the table
+   * @param[out] header_page_ids the header pages of the chain, in order
+   * @param[out] block_page_ids the block pages, in order
+   */
+  void GetTablePages(page_id_t header_page_id, std::vector<page_id_t> *header_page_ids,
+                     std::vector<page_id_t> *block_page_ids);
+
+  /**
+   * Builds a table of num_buckets slots holding every live entry of the current one, swaps it in and frees the old
+   * pages. The caller must hold write_latch_.
+   * @param num_buckets the minimum number of slots of the new table
+   */
+  void Rehash(size_t num_buckets);
+
+  /**
+   * Walks the slots of a table in probe order starting at the home slot of key, latching one block page at a time,
+   * until visit returns true or every slot was visited.
+   * @param header the header page of the table to probe
+   * @param key the key whose probe sequence to follow
+   * @param exclusive latch the block pages for writing rather than reading
+   * @param visit called as visit(block, slot offset, &dirty), returns true to stop the probe
+   */
+  template <typename Visitor>
+  void Probe(HashTableHeaderPage *header, const KeyType &key, bool exclusive, Visitor &&visit);
+
+  /**
+   * Fetches a page from the buffer pool manager, pinned.
+   * @throws Exception if the buffer pool has no free frame
+   */
+  Page *FetchPage(page_id_t page_id);
+
   // member variable
   page_id_t header_page_id_;
   BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
 
-  // Readers includes inserts and removes, writer is only resize
+  // Readers are lookups, writer is only the header swap at the end of a resize
   ReaderWriterLatch table_latch_;
 
+  // Held exclusively by inserts, removes and resizes, lookups never take it
+  ReaderWriterLatch write_latch_;
+
+  // Slots holding an entry or a tombstone, and slots holding an entry, guarded by write_latch_
+  size_t occupied_slots_{0};
+  size_t live_slots_{0};
+
   // Hash function
   HashFunction<KeyType> hash_fn_;
 };
@@ -0,0 +1,274 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregation_hash_table.h
+//
+// Identification: src/include/execution/aggregation_hash_table.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "common/util/hash_util.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/spill_file.h"
+#include "execution/tuple_batch.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * SimpleAggregationHashTable holds the groups of an aggregation, split into 2^AGGREGATION_RADIX_BITS partitions by
+ * the top bits of the group key hashes. Each partition indexes its groups with an open-addressing table of group
+ * positions probed on the precomputed hash, and keeps the running aggregates in a fixed-width layout: one 8-byte
+ * register per group and aggregate, an integer or a double, next to a null flag.
+ *
+ * COUNT counts every row. SUM, MIN and MAX are computed over numeric inputs and become null for good once they see a
+ * null. A SUM over integers smaller than BIGINT is an INTEGER, MIN and MAX keep the type of their input.
+ *
+ * The table keeps track of the memory its groups take. Whenever that exceeds its budget, the partial aggregates of
+ * the largest partition are written to a SpillFile and the partition starts over empty. Iterating merges every
+ * spilled partition with its groups in memory, one partition at a time, and drops it once past it. The partition is
+ * merged into a table of the next level, split by the next AGGREGATION_RADIX_BITS bits of the hashes and with a
+ * budget of its own, which spills in turn if the groups of the partition still do not fit.
+ */
+class SimpleAggregationHashTable {
+ public:
+  /** The number of partitions */
+  static constexpr uint32_t NUM_PARTITIONS = 1U << AGGREGATION_RADIX_BITS;
+  /** The deepest level, the last one that has bits of the hashes of its own */
+  static constexpr uint32_t MAX_LEVEL = 64 / AGGREGATION_RADIX_BITS - 1;
+
+  /**
+   * Construct a new SimpleAggregationHashTable instance.
+   * @param plan the aggregation plan, which gives the group-bys and the aggregates
+   * @param bpm the buffer pool manager spilled partitions are written to
+   * @param memory_budget the number of bytes the groups in memory may take
+   * @param level 0, or the level of the table a spilled partition is read back from plus one; the level picks the
+   * bits of the hashes the partitions are split by
+   */
+  SimpleAggregationHashTable(const AggregationPlanNode *plan, BufferPoolManager *bpm, size_t memory_budget,
+                             uint32_t level = 0);
+
+  DISALLOW_COPY_AND_MOVE(SimpleAggregationHashTable);
+
+  /** @return the level of the table */
+  uint32_t GetLevel() const { return level_; }
+
+  /** @return the partition of a key hash */
+  uint32_t PartitionOf(hash_t hash) const {
+    return static_cast<uint32_t>(hash >> (64 - (level_ + 1) * AGGREGATION_RADIX_BITS)) & (NUM_PARTITIONS - 1);
+  }
+
+  /** @return the hash of a group key, null values left out */
+  static hash_t HashKey(const AggregateKey &agg_key);
+
+  /**
+   * Inserts a value into the hash table and then combines it with the current aggregation.
+   * @param agg_key the key to be inserted
+   * @param agg_val the value to be inserted
+   */
+  void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val);
+
+  /**
+   * Combines every selected row of a batch into the aggregation. The group keys are hashed a column at a time and
+   * the aggregates are read from the columns unboxed. Without group-bys, nothing is hashed: every aggregate column is
+   * folded into the registers of the single group in one pass.
+   * @param batch the rows
+   * @param group_bys the group-by columns computed over batch
+   * @param aggregates the aggregate input columns computed over batch
+   */
+  void InsertCombine(const TupleBatch &batch, const std::vector<ColumnVector> &group_bys,
+                     const std::vector<ColumnVector> &aggregates);
+
+  /**
+   * Merges the groups of a hash table that aggregated another part of the input into this one, leaving it empty.
+   * Spilled partial aggregates are handed over without being read.
+   * @param other a hash table of the same aggregation
+   */
+  void Merge(SimpleAggregationHashTable *other);
+
+  /**
+   * Merges one partition of another hash table into the same partition of this one, leaving it empty. The partition
+   * is spilled if this table exceeds its budget afterwards. Merges of different partitions touch disjoint state, so
+   * they may run concurrently across any tables of the same aggregation.
+   * @param other a hash table of the same aggregation
+   * @param partition_idx the partition to merge
+   */
+  void MergePartition(SimpleAggregationHashTable *other, uint32_t partition_idx);
+
+  /** Exchange the groups of this hash table with the ones of other, a hash table of the same aggregation. */
+  void Swap(SimpleAggregationHashTable *other);
+
+  /** Drop every group. */
+  void Clear();
+
+  /** @return true if any partition has been spilled */
+  bool HasSpilled() const;
+
+  /** @return the number of bytes the groups in memory take */
+  size_t GetMemoryUsage() const { return memory_usage_; }
+
+  /** An iterator over the aggregation hash table */
+  class Iterator {
+   public:
+    /** Creates an iterator over no table, equal to nothing but itself. */
+    Iterator() = default;
+
+    /** @return The key of the iterator */
+    const AggregateKey &Key() const {
+      const Position &pos = path_.back();
+      return pos.table_->partitions_[pos.partition_].keys_[pos.group_];
+    }
+
+    /** @return The aggregates of the iterator, boxed */
+    AggregateValue Val() const {
+      const Position &pos = path_.back();
+      return pos.table_->GetAggregateValue(pos.partition_, pos.group_);
+    }
+
+    /** @return The iterator after it is incremented */
+    Iterator &operator++() {
+      path_.back().group_++;
+      Settle();
+      return *this;
+    }
+
+    /** @return `true` if both iterators are identical */
+    bool operator==(const Iterator &other) const { return path_ == other.path_; }
+
+    /** @return `true` if both iterators are different */
+    bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+   private:
+    friend class SimpleAggregationHashTable;
+
+    /** A group of a table */
+    struct Position {
+      SimpleAggregationHashTable *table_;
+      uint32_t partition_;
+      uint32_t group_;
+
+      bool operator==(const Position &other) const {
+        return table_ == other.table_ && partition_ == other.partition_ && group_ == other.group_;
+      }
+    };
+
+    Iterator(SimpleAggregationHashTable *table, uint32_t partition) : path_{Position{table, partition, 0}} {}
+
+    /**
+     * Move to the first group at or after the current position, reading spilled partitions back on the way and
+     * descending into the tables they are read back into.
+     */
+    void Settle();
+
+    /** The position in the table iterated over, then in the tables of the partitions read back, innermost last */
+    std::vector<Position> path_;
+  };
+
+  /** @return Iterator to the start of the hash table */
+  Iterator Begin() {
+    Iterator iter(this, 0);
+    iter.Settle();
+    return iter;
+  }
+
+  /** @return Iterator to the end of the hash table */
+  Iterator End() { return Iterator(this, NUM_PARTITIONS); }
+
+ private:
+  /** A running aggregate */
+  union Register {
+    int64_t integer_;
+    double decimal_;
+  };
+
+  struct Partition {
+    /** The key hashes, one per group */
+    std::vector<hash_t> hashes_;
+    /** The keys, one per group */
+    std::vector<AggregateKey> keys_;
+    /** The running aggregates, one row of registers per group */
+    std::vector<Register> registers_;
+    /** The null flags of registers_ */
+    std::vector<uint8_t> nulls_;
+    /** A power of two number of slots, each 0 or 1 + the position of a group */
+    std::vector<uint32_t> slots_;
+    /** The number of bytes the groups take */
+    size_t memory_usage_{0};
+    /** The partial aggregates written out, nullptr unless the partition has been spilled */
+    std::unique_ptr<SpillFile> spill_;
+    /** True if spill_ has been read back, the groups are dropped once iterated over */
+    bool reloaded_{false};
+    /** The table the groups have been read back into, if the partition had to be split again */
+    std::unique_ptr<SimpleAggregationHashTable> reloaded_table_;
+  };
+
+  /** @return the group of key in a partition, added with every aggregate at its initial state if it is new */
+  uint32_t FindOrInsert(Partition *partition, hash_t hash, const AggregateKey &agg_key);
+
+  /** Fold input into the i-th aggregate of a group, given as an integer or a double by the register type. */
+  void Combine(Register *reg, uint8_t *is_null, uint32_t i, bool input_null, int64_t integer, double decimal) const;
+
+  /** Fold the selected rows of column, the input of the i-th aggregate, into the i-th aggregate of a group. */
+  void CombineColumn(Register *reg, uint8_t *is_null, uint32_t i, const TupleBatch &batch,
+                     const ColumnVector &column) const;
+
+  /** Fold the i-th partial aggregate of another group into the i-th aggregate of a group. */
+  void MergeRegister(Register *reg, uint8_t *is_null, uint32_t i, const Register &partial, bool partial_null) const;
+
+  /** @return the i-th aggregate of a group, boxed */
+  Value GetRegisterValue(uint32_t i, const Register &reg, bool is_null) const;
+
+  /** @return the aggregates of a group, boxed */
+  AggregateValue GetAggregateValue(uint32_t partition, uint32_t group) const;
+
+  /** Write the groups of a partition out and empty it. */
+  void Spill(Partition *partition);
+
+  /** Spill the largest partitions until the groups fit in the budget. */
+  void Shrink();
+
+  /**
+   * Merge the partial aggregates spilled by a partition and its groups in memory into a table of the next level, or
+   * into the partition itself at the last level.
+   */
+  void Reload(Partition *partition);
+
+  /** Merge the partial aggregates of a group into its group in a partition, added if it is new. */
+  void MergeGroup(Partition *partition, hash_t hash, const AggregateKey &agg_key, const Register *partials,
+                  const uint8_t *partial_nulls);
+
+  /** Drop the groups of a partition. */
+  void Reset(Partition *partition);
+
+  /** The aggregation plan */
+  const AggregationPlanNode *plan_;
+  /** The aggregation types */
+  std::vector<AggregationType> agg_types_;
+  /** The type every aggregate is output as */
+  std::vector<TypeId> output_types_;
+  /** For every aggregate, true if its register is a double */
+  std::vector<bool> is_decimal_;
+  /** The layout of a spilled group: the group-bys, then one BIGINT or DECIMAL per register */
+  Schema spill_schema_;
+
+  BufferPoolManager *bpm_;
+  size_t memory_budget_;
+  uint32_t level_;
+  std::atomic<size_t> memory_usage_{0};
+  std::vector<Partition> partitions_;
+};
+
+}  // namespace bustub
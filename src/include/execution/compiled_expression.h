@@ -0,0 +1,136 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// compiled_expression.h
+//
+// Identification: src/include/execution/compiled_expression.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/tuple_batch.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * CompiledExpression is an expression tree flattened into a program of typed instructions over registers, one
+ * register per tree node. Columns are loaded straight from the bytes of a tuple, or from the column vectors of a
+ * batch, into unboxed registers, constants are loaded once when the program is compiled, and comparisons run on the
+ * registers: evaluating the program neither calls a virtual method nor builds a Value.
+ *
+ * Only column values, constants and comparisons of fixed-size types are compiled. Integer types compare with each
+ * other and with decimals, booleans and timestamps only with their own type. Any other tree is left to the
+ * interpreted AbstractExpression methods.
+ */
+class CompiledExpression {
+ public:
+  /**
+   * Compile an expression.
+   * @param expr the expression
+   * @param left_schema the schema of the tuples the expression is evaluated over, the left ones of a join
+   * @param right_schema the schema of the right tuples of a join, nullptr if the expression is not a join one
+   * @return the compiled expression, nullptr if expr cannot be compiled
+   */
+  static std::unique_ptr<CompiledExpression> Compile(const AbstractExpression *expr, const Schema *left_schema,
+                                                     const Schema *right_schema = nullptr);
+
+  /** @return the type of the values the expression computes */
+  TypeId GetReturnType() const { return return_type_; }
+
+  /** @return true if the predicate holds for the tuple stored in data: it is neither false nor null */
+  bool Test(const char *data) const {
+    Run(Side{data, nullptr, 0}, Side{});
+    return IsTrue();
+  }
+
+  /** @return true if the predicate holds for tuple */
+  bool Test(const Tuple &tuple) const { return Test(tuple.GetData()); }
+
+  /** @return true if the join predicate holds for a row of a batch of left tuples and a right tuple */
+  bool TestJoin(const TupleBatch &left_batch, uint32_t left_row, const Tuple &right_tuple) const {
+    Run(Side{nullptr, &left_batch, left_row}, Side{right_tuple.GetData(), nullptr, 0});
+    return IsTrue();
+  }
+
+  /**
+   * Evaluate the expression over the tuple stored in data and store the result unboxed in row of column, of the
+   * expression type.
+   */
+  void EvaluateInto(const char *data, ColumnVector *column, uint32_t row) const;
+
+  /** Evaluate the expression over tuple and store the result unboxed in row of column, of the expression type. */
+  void EvaluateInto(const Tuple &tuple, ColumnVector *column, uint32_t row) const {
+    EvaluateInto(tuple.GetData(), column, row);
+  }
+
+ private:
+  enum class OpCode : uint8_t { LoadColumn, Compare };
+
+  struct Instruction {
+    OpCode op_;
+    /** LoadColumn: the column type. Compare: DECIMAL if the operands are compared as doubles */
+    TypeId type_;
+    /** LoadColumn: 0 for the left tuple, 1 for the right one */
+    uint8_t side_;
+    /** LoadColumn: the column index, and its offset in the tuple bytes */
+    uint32_t col_idx_;
+    uint32_t offset_;
+    /** Compare: the comparison and the registers of its operands */
+    ComparisonType comp_type_;
+    uint32_t lhs_;
+    uint32_t rhs_;
+    /** The register the result is written to */
+    uint32_t dst_;
+  };
+
+  struct Register {
+    union {
+      int64_t integer_;
+      double decimal_;
+    };
+    bool is_null_;
+  };
+
+  /** Where a LoadColumn reads from: the bytes of a tuple, or a row of a batch */
+  struct Side {
+    const char *data_;
+    const TupleBatch *batch_;
+    uint32_t row_;
+  };
+
+  CompiledExpression() = default;
+
+  /** Append the instructions computing expr, @return its register or -1 if it cannot be compiled */
+  int CompileNode(const AbstractExpression *expr, const Schema *left_schema, const Schema *right_schema);
+
+  /** Run the program over a left and a right side. */
+  void Run(const Side &left, const Side &right) const;
+
+  /** Load a column into a register. */
+  static void Load(const Instruction &inst, const Side &side, Register *reg);
+
+  /** @return true if the result register holds true */
+  bool IsTrue() const { return !registers_[result_].is_null_ && registers_[result_].integer_ != 0; }
+
+  std::vector<Instruction> program_;
+  /** The registers, the ones of constants loaded at compile time; the program overwrites the others */
+  mutable std::vector<Register> registers_;
+  /** For every register, true if it holds a double */
+  std::vector<bool> is_decimal_;
+  uint32_t result_{0};
+  TypeId return_type_{TypeId::INVALID};
+};
+
+}  // namespace bustub
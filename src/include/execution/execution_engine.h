@@ -24,7 +24,8 @@
 namespace bustub {
 
 /**
- * The ExecutionEngine class executes query plans.
+ * The ExecutionEngine class executes query plans. A plan runs on the calling thread, except for its parallelizable
+ * parts when the executor context allows several workers (see ExecutorContext::SetWorkerCount and GatherExecutor).
  */
 class ExecutionEngine {
  public:
@@ -61,7 +62,9 @@ class ExecutionEngine {
       RID rid;
       while (executor->Next(&tuple, &rid)) {
         if (result_set != nullptr) {
+          // the tuples the root hands out are only valid until its next call, the result set outlives them
           result_set->push_back(tuple);
+          result_set->back().Materialize();
         }
       }
     } catch (Exception &e) {
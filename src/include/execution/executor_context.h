@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>  // NOLINT
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -21,6 +24,9 @@
 #include "storage/page/tmp_tuple_page.h"
 
 namespace bustub {
+
+class AbstractPlanNode;
+
 /**
  * ExecutorContext stores all the context necessary to run an executor.
  */
@@ -60,6 +66,35 @@ class ExecutorContext {
   /** @return the transaction manager */
   TransactionManager *GetTransactionManager() { return txn_mgr_; }
 
+  /** @return the number of threads a query may run on, 1 to run it on the calling thread only */
+  uint32_t GetWorkerCount() const { return worker_count_; }
+
+  /** Run the parallel parts of queries on worker_count threads. */
+  void SetWorkerCount(uint32_t worker_count) { worker_count_ = worker_count; }
+
+  /** @return the number of bytes an executor may hold in memory before it spills to temporary pages */
+  size_t GetMemoryBudget() const { return memory_budget_; }
+
+  /** Let every executor hold memory_budget bytes in memory before it spills to temporary pages. */
+  void SetMemoryBudget(size_t memory_budget) { memory_budget_ = memory_budget; }
+
+  /**
+   * @return the state the workers running plan in parallel share, nullptr if plan does not run in parallel
+   * @tparam T the type of the state, which the executor of plan knows
+   */
+  template <class T>
+  T *GetSharedState(const AbstractPlanNode *plan) {
+    std::scoped_lock latch(shared_states_latch_);
+    auto iter = shared_states_.find(plan);
+    return iter == shared_states_.end() ? nullptr : static_cast<T *>(iter->second.get());
+  }
+
+  /** Set the state the workers running plan in parallel share, replacing any previous one. */
+  void SetSharedState(const AbstractPlanNode *plan, std::shared_ptr<void> state) {
+    std::scoped_lock latch(shared_states_latch_);
+    shared_states_[plan] = std::move(state);
+  }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -71,6 +106,13 @@ class ExecutorContext {
   TransactionManager *txn_mgr_;
   /** The lock manager associated with this executor context */
   LockManager *lock_mgr_;
+  /** The number of threads a query may run on */
+  uint32_t worker_count_{1};
+  /** The number of bytes an executor may hold in memory */
+  size_t memory_budget_{QUERY_MEMORY_BUDGET};
+  /** The state shared by the workers of parallel plan nodes */
+  std::unordered_map<const AbstractPlanNode *, std::shared_ptr<void>> shared_states_;
+  std::mutex shared_states_latch_;
 };
 
 }  // namespace bustub
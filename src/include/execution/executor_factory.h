@@ -27,8 +27,11 @@ class ExecutorFactory {
    * Creates a new executor given the executor context and plan node.
    * @param exec_ctx The executor context for the created executor
    * @param plan The plan node that needs to be executed
+   * @param parallel If the context allows several workers, run the largest parallelizable subtrees of the plan that
+   * are executed only once under a GatherExecutor
    * @return An executor for the given plan in the provided context
    */
-  static std::unique_ptr<AbstractExecutor> CreateExecutor(ExecutorContext *exec_ctx, const AbstractPlanNode *plan);
+  static std::unique_ptr<AbstractExecutor> CreateExecutor(ExecutorContext *exec_ctx, const AbstractPlanNode *plan,
+                                                          bool parallel = true);
 };
 }  // namespace bustub
@@ -12,14 +12,24 @@
 
 #pragma once
 
+#include <memory>
+
 #include "execution/executor_context.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
+#include "type/arena_pool.h"
 
 namespace bustub {
 /**
  * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model.
  * This is the base class from which all executors in the BustTub execution
  * engine inherit, and defines the minimal interface that all executors support.
+ *
+ * Executors may also produce a batch of tuples per call through NextBatch.
+ * An executor implements either interface and gets the other one through an
+ * adapter: the default NextBatch fills a batch by calling Next, and an
+ * executor built on batches implements Next with NextFromBatch. A consumer
+ * uses one of the two interfaces between calls to Init.
  */
 class AbstractExecutor {
  public:
@@ -40,20 +50,85 @@ class AbstractExecutor {
 
   /**
    * Yield the next tuple from this executor.
-   * @param[out] tuple The next tuple produced by this executor
+   * @param[out] tuple The next tuple produced by this executor, which may refer to memory of the executor that is
+   * only valid until the next call to Next or Init: it has to be materialized to be kept longer
    * @param[out] rid The next tuple RID produced by this executor
    * @return `true` if a tuple was produced, `false` if there are no more tuples
    */
   virtual bool Next(Tuple *tuple, RID *rid) = 0;
 
+  /**
+   * Yield the next batch of tuples from this executor.
+   * @param[out] batch A batch of the output schema, refilled with at least one selected row
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  virtual bool NextBatch(TupleBatch *batch) {
+    batch->Reset();
+    Tuple tuple;
+    RID rid;
+    while (!batch->IsFull() && Next(&tuple, &rid)) {
+      batch->Append(tuple, rid);
+    }
+    return batch->Size() > 0;
+  }
+
   /** @return The schema of the tuples that this executor produces */
   virtual const Schema *GetOutputSchema() = 0;
 
   /** @return The executor context in which this executor runs */
   ExecutorContext *GetExecutorContext() { return exec_ctx_; }
 
+  /** @return the number of bytes held by the arena of the tuples this executor hands out */
+  size_t GetOutputArenaBytes() const { return output_arena_.GetReservedBytes(); }
+
  protected:
+  /**
+   * Yield the rows of NextBatch one at a time, for executors that implement Next on top of their batches. The
+   * tuples are allocated from the output arena.
+   */
+  bool NextFromBatch(Tuple *tuple, RID *rid) {
+    if (row_batch_ == nullptr) {
+      row_batch_ = std::make_unique<TupleBatch>(GetOutputSchema());
+    }
+    while (row_batch_pos_ >= row_batch_->Size()) {
+      row_batch_pos_ = 0;
+      if (!NextBatch(row_batch_.get())) {
+        return false;
+      }
+    }
+    uint32_t row = row_batch_->RowAt(row_batch_pos_++);
+    *tuple = row_batch_->GetTuple(row, NextOutputArena());
+    *rid = row_batch_->GetRid(row);
+    return true;
+  }
+
+  /**
+   * @return the arena to allocate the tuple handed out by the current call to Next from, emptied first: the tuple of
+   * the previous call is no longer in use, so the arena holds no more than one tuple however many are handed out.
+   * To be called at most once per call to Next.
+   */
+  ArenaPool *NextOutputArena() {
+    output_arena_.Reset();
+    return &output_arena_;
+  }
+
+  /** Drop the rows NextFromBatch has not handed out yet, to be called from Init. */
+  void ResetRowBatch() {
+    if (row_batch_ != nullptr) {
+      row_batch_->Reset();
+    }
+    row_batch_pos_ = 0;
+  }
+
   /** The executor context in which the executor runs */
   ExecutorContext *exec_ctx_;
+
+ private:
+  /** The batch NextFromBatch hands out rows from */
+  std::unique_ptr<TupleBatch> row_batch_;
+  /** The position of the next row of row_batch_ to hand out, among its selected rows */
+  uint32_t row_batch_pos_{0};
+  /** The memory of the tuple last handed out by Next */
+  ArenaPool output_arena_;
 };
 }  // namespace bustub
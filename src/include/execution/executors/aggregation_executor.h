@@ -12,13 +12,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "common/util/hash_util.h"
-#include "container/hash/hash_function.h"
+#include "common/barrier.h"
+#include "execution/aggregation_hash_table.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/expressions/abstract_expression.h"
@@ -29,132 +29,30 @@
 namespace bustub {
 
 /**
- * A simplified hash table that has all the necessary functionality for aggregations.
+ * The state the workers of a parallel aggregation share. Every worker aggregates the part of the input its child
+ * produces into its own hash table and publishes it in tables_. Once all of them have, every worker merges the
+ * partitions it owns, those whose index is its own modulo the number of workers, from every other table into its
+ * own, and once all merges are done outputs the groups left in its table.
  */
-class SimpleAggregationHashTable {
- public:
-  /**
-   * Construct a new SimpleAggregationHashTable instance.
-   * @param agg_exprs the aggregation expressions
-   * @param agg_types the types of aggregations
-   */
-  SimpleAggregationHashTable(const std::vector<const AbstractExpression *> &agg_exprs,
-                             const std::vector<AggregationType> &agg_types)
-      : agg_exprs_{agg_exprs}, agg_types_{agg_types} {}
-
-  /** @return The initial aggregrate value for this aggregation executor */
-  AggregateValue GenerateInitialAggregateValue() {
-    std::vector<Value> values{};
-    for (const auto &agg_type : agg_types_) {
-      switch (agg_type) {
-        case AggregationType::CountAggregate:
-          // Count starts at zero.
-          values.emplace_back(ValueFactory::GetIntegerValue(0));
-          break;
-        case AggregationType::SumAggregate:
-          // Sum starts at zero.
-          values.emplace_back(ValueFactory::GetIntegerValue(0));
-          break;
-        case AggregationType::MinAggregate:
-          // Min starts at INT_MAX.
-          values.emplace_back(ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX));
-          break;
-        case AggregationType::MaxAggregate:
-          // Max starts at INT_MIN.
-          values.emplace_back(ValueFactory::GetIntegerValue(BUSTUB_INT32_MIN));
-          break;
-      }
-    }
-    return {values};
-  }
-
-  /**
-   * Combines the input into the aggregation result.
-   * @param[out] result The output aggregate value
-   * @param input The input value
-   */
-  void CombineAggregateValues(AggregateValue *result, const AggregateValue &input) {
-    for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
-      switch (agg_types_[i]) {
-        case AggregationType::CountAggregate:
-          // Count increases by one.
-          result->aggregates_[i] = result->aggregates_[i].Add(ValueFactory::GetIntegerValue(1));
-          break;
-        case AggregationType::SumAggregate:
-          // Sum increases by addition.
-          result->aggregates_[i] = result->aggregates_[i].Add(input.aggregates_[i]);
-          break;
-        case AggregationType::MinAggregate:
-          // Min is just the min.
-          result->aggregates_[i] = result->aggregates_[i].Min(input.aggregates_[i]);
-          break;
-        case AggregationType::MaxAggregate:
-          // Max is just the max.
-          result->aggregates_[i] = result->aggregates_[i].Max(input.aggregates_[i]);
-          break;
-      }
-    }
-  }
-
-  /**
-   * Inserts a value into the hash table and then combines it with the current aggregation.
-   * @param agg_key the key to be inserted
-   * @param agg_val the value to be inserted
-   */
-  void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
-    if (ht_.count(agg_key) == 0) {
-      ht_.insert({agg_key, GenerateInitialAggregateValue()});
-    }
-    CombineAggregateValues(&ht_[agg_key], agg_val);
-  }
-
-  /** An iterator over the aggregation hash table */
-  class Iterator {
-   public:
-    /** Creates an iterator for the aggregate map. */
-    explicit Iterator(std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter) : iter_{iter} {}
-
-    /** @return The key of the iterator */
-    const AggregateKey &Key() { return iter_->first; }
-
-    /** @return The value of the iterator */
-    const AggregateValue &Val() { return iter_->second; }
-
-    /** @return The iterator before it is incremented */
-    Iterator &operator++() {
-      ++iter_;
-      return *this;
-    }
-
-    /** @return `true` if both iterators are identical */
-    bool operator==(const Iterator &other) { return this->iter_ == other.iter_; }
-
-    /** @return `true` if both iterators are different */
-    bool operator!=(const Iterator &other) { return this->iter_ != other.iter_; }
-
-   private:
-    /** Aggregates map */
-    std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter_;
-  };
-
-  /** @return Iterator to the start of the hash table */
-  Iterator Begin() { return Iterator{ht_.cbegin()}; }
-
-  /** @return Iterator to the end of the hash table */
-  Iterator End() { return Iterator{ht_.cend()}; }
-
- private:
-  /** The hash table is just a map from aggregate keys to aggregate values */
-  std::unordered_map<AggregateKey, AggregateValue> ht_{};
-  /** The aggregate expressions that we have */
-  const std::vector<const AbstractExpression *> &agg_exprs_;
-  /** The types of aggregations that we have */
-  const std::vector<AggregationType> &agg_types_;
+struct AggregationSharedState {
+  explicit AggregationSharedState(size_t worker_count)
+      : tables_(worker_count), published_(worker_count), merged_(worker_count) {}
+
+  /** The hash table of every worker, by worker index */
+  std::vector<SimpleAggregationHashTable *> tables_;
+  /** The next worker index to hand out */
+  std::atomic<size_t> next_worker_{0};
+  /** Waits for every worker to have published its table */
+  Barrier published_;
+  /** Waits for every worker to have merged its partitions */
+  Barrier merged_;
 };
 
 /**
  * AggregationExecutor executes an aggregation operation (e.g. COUNT, SUM, MIN, MAX)
- * over the tuples produced by a child executor.
+ * over the tuples produced by a child executor. The groups are held in a SimpleAggregationHashTable bounded by the
+ * memory budget of the executor context, which spills partial aggregates to temporary pages and merges them back
+ * while the groups are output.
  */
 class AggregationExecutor : public AbstractExecutor {
  public:
@@ -178,6 +76,13 @@ class AggregationExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch of groups from the aggregation.
+   * @param[out] batch The next batch of groups that satisfy the having clause
+   * @return `true` if a batch was produced, `false` if there are no more groups
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
   /** @return The output schema for the aggregation */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
 
@@ -209,8 +114,8 @@ class AggregationExecutor : public AbstractExecutor {
   /** The child executor that produces tuples over which the aggregation is computed */
   std::unique_ptr<AbstractExecutor> child_;
   /** Simple aggregation hash table */
-  // TODO(Student): Uncomment SimpleAggregationHashTable aht_;
+  std::unique_ptr<SimpleAggregationHashTable> aht_;
   /** Simple aggregation hash table iterator */
-  // TODO(Student): Uncomment SimpleAggregationHashTable::Iterator aht_iterator_;
+  SimpleAggregationHashTable::Iterator aht_iterator_;
 };
 }  // namespace bustub
@@ -0,0 +1,116 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.h
+//
+// Identification: src/include/execution/executors/gather_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/barrier.h"
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/**
+ * GatherExecutor runs a plan on several worker threads and merges the batches they produce, in no particular order.
+ * Every worker executes its own copy of the plan: the sequential scans at its leaves split their table into morsels
+ * among the workers, and the hash joins and aggregations in it combine the state the workers build, so that all the
+ * workers together produce the result of the plan exactly once.
+ *
+ * The ExecutorFactory puts a GatherExecutor above every largest subtree of a plan that IsParallelizable when the
+ * executor context allows more than one worker.
+ */
+class GatherExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new GatherExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The plan run by every worker
+   * @param worker_count The number of workers
+   */
+  GatherExecutor(ExecutorContext *exec_ctx, const AbstractPlanNode *plan, uint32_t worker_count);
+
+  /** Stop the workers. */
+  ~GatherExecutor() override;
+
+  /** Start the workers, stopping those of a previous run first */
+  void Init() override;
+
+  /**
+   * Yield the next tuple produced by any worker.
+   * @param[out] tuple The next tuple produced by the workers
+   * @param[out] rid The next tuple RID produced by the workers
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  /**
+   * Yield the next batch produced by any worker.
+   * @param[out] batch The next batch produced by the workers
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
+  /** @return The output schema of the plan */
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); }
+
+  /** @return true if every node of plan can run on several workers */
+  static bool IsParallelizable(const AbstractPlanNode *plan);
+
+ private:
+  /** Register the state the workers share for every node of plan in the executor context, or drop it. */
+  void ShareState(const AbstractPlanNode *plan, bool share);
+
+  /** Run executor to the end, queueing its batches. */
+  void RunWorker(AbstractExecutor *executor);
+
+  /** Make the workers quit and wait for them. */
+  void Stop();
+
+  /** Release the workers waiting at the barriers of the shared state, which throw out of their plan. */
+  void CancelBarriers();
+
+  /** The plan run by every worker */
+  const AbstractPlanNode *plan_;
+  /** The copy of the plan every worker runs */
+  std::vector<std::unique_ptr<AbstractExecutor>> workers_;
+  /** The threads running workers_ */
+  std::vector<std::thread> threads_;
+
+  /** Guards every member below */
+  std::mutex latch_;
+  /** Signaled when a batch is queued or a worker is done */
+  std::condition_variable has_batch_;
+  /** Signaled when a batch is dequeued or the workers have to stop */
+  std::condition_variable has_room_;
+  /** The batches produced but not yet consumed */
+  std::deque<std::unique_ptr<TupleBatch>> batches_;
+  /** Consumed batches the workers fill again */
+  std::vector<std::unique_ptr<TupleBatch>> spare_batches_;
+  /** The number of workers still running */
+  size_t running_{0};
+  /** True once the workers have to quit */
+  bool stopped_{false};
+  /** The first exception thrown by a worker, rethrown to the consumer */
+  std::exception_ptr error_;
+  /** The barriers of the shared state of this run, cancelled when a worker fails or the workers are stopped */
+  std::vector<Barrier *> barriers_;
+};
+
+}  // namespace bustub
@@ -13,17 +13,49 @@
 #pragma once
 
 #include <memory>
+#include <mutex>  // NOLINT
 #include <utility>
+#include <vector>
 
+#include "common/barrier.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/join_hash_table.h"
 #include "execution/plans/hash_join_plan.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * The state the workers of a parallel hash join share. Every worker builds the part of the left input its child
+ * produces into a table of its own and merges it into table_. The last worker to have merged indexes table_, which
+ * every worker then probes.
+ */
+struct HashJoinSharedState {
+  HashJoinSharedState(BufferPoolManager *bpm, size_t memory_budget, size_t worker_count)
+      : table_(bpm, memory_budget), merged_(worker_count), built_(worker_count) {}
+
+  /** The build side of the join */
+  JoinHashTable table_;
+  /** Serializes the merges into table_ */
+  std::mutex latch_;
+  /** Waits for every worker to have merged its part of the build */
+  Barrier merged_;
+  /** Waits for table_ to be indexed */
+  Barrier built_;
+};
+
+/**
+ * HashJoinExecutor executes an equi-JOIN on two tables with a radix-partitioned JoinHashTable. The left child is
+ * built into the table, then the right child probes it a batch at a time: the probe keys of a batch and their hashes
+ * are computed at once, and output columns that are plain column references are copied without boxing the probe row
+ * into a tuple.
+ *
+ * Probe rows that fall into a partition the table has spilled are spilled as well. Once the right child is
+ * exhausted, every spilled partition is read back, built into a table of its own and probed with its spilled rows.
+ * That table splits the partition by the next bits of the hashes and spills in turn if it still exceeds the budget,
+ * so partitions are joined recursively, depth first, until they fit.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -48,12 +80,90 @@ class HashJoinExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch of tuples from the join.
+   * @param[out] batch The next batch of joined tuples
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
   /** @return The output schema for the join */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
 
  private:
-  /** The NestedLoopJoin plan node to be executed. */
+  /** A partition whose build and probe rows have both been spilled, to be joined on its own */
+  struct SpilledPartition {
+    /** The level of the table the build rows are read back into */
+    uint32_t level_{0};
+    /** The build rows, owned by owned_build_ or by the table of the whole build side */
+    const SpillFile *build_{nullptr};
+    std::unique_ptr<SpillFile> owned_build_;
+    /** The probe rows */
+    std::unique_ptr<SpillFile> probe_;
+  };
+
+  /** Compute the hash of every selected, non-null key of batch into hashes */
+  static void HashKeys(const TupleBatch &batch, const ColumnVector &keys, std::vector<hash_t> *hashes);
+
+  /** Build the left child into hash_table_, or into the shared table of a parallel join, and point table_ at it */
+  void Build();
+
+  /** Fill probe_batch_ with the next right tuples, or spilled ones once the right child is exhausted */
+  bool NextProbeBatch();
+
+  /**
+   * Queue the partitions the table just probed has spilled, then load the next queued one into spilled_table_.
+   * @return false if there is none
+   */
+  bool NextSpilledPartition();
+
+  /** @return the output values joining left_tuple with row of the current probe batch */
+  std::vector<Value> JoinRow(const Tuple &left_tuple, uint32_t row) const;
+
+  /** The HashJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
+  /** The child executor that builds the hash table */
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  /** The child executor that probes the hash table */
+  std::unique_ptr<AbstractExecutor> right_executor_;
+  /** The build side of the join, or this worker's part of it in a parallel join */
+  std::unique_ptr<JoinHashTable> hash_table_;
+  /** The complete build side: hash_table_, or the table shared by the workers of a parallel join */
+  const JoinHashTable *table_{nullptr};
+  /** For every output column, the column it copies or nullptr if it is computed by EvaluateJoin */
+  std::vector<const ColumnValueExpression *> output_columns_;
+
+  /** The batch of right tuples being probed */
+  std::unique_ptr<TupleBatch> probe_batch_;
+  /** The join keys of probe_batch_ */
+  ColumnVector probe_keys_{TypeId::INTEGER, 0};
+  /** The hashes of probe_keys_ */
+  std::vector<hash_t> probe_hashes_;
+  /** The position of the next row of probe_batch_ to probe, among its selected rows */
+  uint32_t probe_pos_{0};
+  /** The row of probe_batch_ being joined */
+  uint32_t probe_row_{0};
+  /** The left tuples matching probe_row_ */
+  std::vector<const Tuple *> matches_;
+  /** The next tuple of matches_ to join */
+  size_t match_pos_{0};
+
+  /** The number of bytes a table of this executor may hold in memory */
+  size_t memory_budget_{0};
+  /** True once the right child is exhausted */
+  bool right_done_{false};
+  /** The probe rows of every partition the table being probed has spilled, nullptr for the others */
+  std::vector<std::unique_ptr<SpillFile>> probe_spills_;
+  /** The spilled partitions left to join, the last one next */
+  std::vector<SpilledPartition> spilled_partitions_;
+  /** The spilled partition being joined */
+  SpilledPartition spilled_partition_;
+  /** The build side of the spilled partition being joined */
+  std::unique_ptr<JoinHashTable> spilled_table_;
+  /** The next page of probe rows of the spilled partition to read */
+  size_t spill_page_{0};
+  /** The next probe row of page spill_page_ to probe */
+  size_t spill_tuple_pos_{0};
 };
 
 }  // namespace bustub
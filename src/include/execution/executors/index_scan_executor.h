@@ -12,18 +12,25 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "common/rid.h"
+#include "execution/compiled_expression.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/index_scan_plan.h"
+#include "storage/index/b_plus_tree_index.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * IndexScanExecutor executes an index scan over a table.
+ * IndexScanExecutor executes an index scan over a table. Key ranges, either given by the plan or derived from a
+ * simple comparison between the key column and a constant, are handed to the index iterator so only keys in range
+ * are ever visited. An index-only scan over a covering index reads every column it needs from the index entries
+ * and never fetches the tuples from the table heap. The scan supports B+ tree indexes on every key size the catalog
+ * builds them with (4, 8, 16, 32 and 64 bytes), so a covering index may carry as many columns as fit in 64 bytes.
  */
 
 class IndexScanExecutor : public AbstractExecutor {
@@ -42,7 +49,61 @@ class IndexScanExecutor : public AbstractExecutor {
   bool Next(Tuple *tuple, RID *rid) override;
 
  private:
+  /** The position of the scan inside a B+ tree index, whatever the size of its keys */
+  class Cursor {
+   public:
+    virtual ~Cursor() = default;
+    /** @return `true` if the scan is past its last entry */
+    virtual bool IsEnd() = 0;
+    /** @return the RID of the current entry */
+    virtual RID GetRid() = 0;
+    /** @return a tuple of the table schema rebuilt from the current entry, columns missing from it are zero */
+    virtual Tuple GetEntry() = 0;
+    /** Move to the next entry in scan order */
+    virtual void Advance() = 0;
+  };
+
+  /** The cursor of a B+ tree index on keys of KeySize bytes */
+  template <size_t KeySize>
+  class TreeCursor;
+
+  /**
+   * Open a cursor over the range of a B+ tree index on keys of KeySize bytes.
+   * @throw Exception if the index is not a B+ tree
+   */
+  template <size_t KeySize>
+  std::unique_ptr<Cursor> OpenCursor(const IndexScanRange &range) const;
+
+  /**
+   * Derive a key range from the plan predicate if it compares the key column of a single column index with a
+   * non-null constant that is exactly a value of the key type.
+   * @param[out] range the derived range
+   * @return `true` if the predicate is fully covered by the range
+   */
+  bool PushDownPredicate(IndexScanRange *range) const;
+
+  /** Build an index key from one value per key column */
+  template <size_t KeySize>
+  GenericKey<KeySize> MakeKey(const std::vector<Value> &values) const;
+
+  /** @return `true` if every column read by expr is stored in the index entries */
+  bool IsCovered(const AbstractExpression *expr) const;
+
+  /** Rebuild a tuple of the table schema from an index entry, columns missing from the entry are zero */
+  template <size_t KeySize>
+  Tuple TupleFromKey(const GenericKey<KeySize> &key) const;
+
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
+  /** The index being scanned */
+  IndexInfo *index_info_{nullptr};
+  /** The table the index refers to */
+  TableInfo *table_info_{nullptr};
+  /** The predicate still to be checked against every tuple, nullptr if it was pushed into the range */
+  const AbstractExpression *predicate_{nullptr};
+  /** predicate_ compiled, nullptr if it cannot be */
+  std::unique_ptr<CompiledExpression> compiled_predicate_;
+  /** The position of the scan inside the index */
+  std::unique_ptr<Cursor> cursor_;
 };
 }  // namespace bustub
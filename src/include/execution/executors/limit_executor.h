@@ -45,6 +45,13 @@ class LimitExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch of tuples from the limit, the child batch cut short once the limit is reached.
+   * @param[out] batch The next batch of tuples produced by the limit
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
   /** @return The output schema for the limit */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
 
@@ -53,5 +60,7 @@ class LimitExecutor : public AbstractExecutor {
   const LimitPlanNode *plan_;
   /** The child executor from which tuples are obtained */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  /** The number of tuples produced so far */
+  size_t emitted_{0};
 };
 }  // namespace bustub
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// merge_join_executor.h
+//
+// Identification: src/include/execution/executors/merge_join_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/merge_join_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * MergeJoinExecutor executes an equi-JOIN on two children ordered by their join key, in a single pass over each.
+ * The only tuples it holds are the current left tuple and the run of right tuples sharing the current key, which
+ * every left tuple with that key is joined with, so duplicate keys on both sides produce their cross product.
+ */
+class MergeJoinExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new MergeJoinExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The MergeJoin join plan to be executed
+   * @param left_child The child executor that produces tuples for the left side of join, ordered by key
+   * @param right_child The child executor that produces tuples for the right side of join, ordered by key
+   */
+  MergeJoinExecutor(ExecutorContext *exec_ctx, const MergeJoinPlanNode *plan,
+                    std::unique_ptr<AbstractExecutor> &&left_child, std::unique_ptr<AbstractExecutor> &&right_child);
+
+  /** Initialize the join */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the join.
+   * @param[out] tuple The next tuple produced by the join
+   * @param[out] rid The next tuple RID produced by the join
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  /** @return The output schema for the join */
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+ private:
+  /** Move to the next left tuple with a non-null key, @return false if the left child is exhausted */
+  bool AdvanceLeft();
+
+  /** Move to the next right tuple with a non-null key, @return false if the right child is exhausted */
+  bool AdvanceRight();
+
+  /** The MergeJoin plan node to be executed. */
+  const MergeJoinPlanNode *plan_;
+  /** The child executor that produces the left tuples */
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  /** The child executor that produces the right tuples */
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  /** The current left tuple and its key, valid while left_valid_ */
+  Tuple left_tuple_;
+  Value left_key_;
+  bool left_valid_{false};
+  /** The first right tuple past the run and its key, valid while right_valid_ */
+  Tuple right_tuple_;
+  Value right_key_;
+  bool right_valid_{false};
+
+  /** The right tuples sharing run_key_, which the current left tuple is joined with */
+  std::vector<Tuple> run_;
+  Value run_key_;
+  /** The next tuple of run_ to join, run_.size() once the left tuple is done with it */
+  size_t run_pos_{0};
+};
+
+}  // namespace bustub
@@ -14,16 +14,23 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "execution/compiled_expression.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/nested_loop_join_plan.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
- * NestedLoopJoinExecutor executes a nested-loop JOIN on two tables.
+ * NestedLoopJoinExecutor executes a block nested-loop JOIN on two tables. The left child is read a block at a time,
+ * as many batches as fit in the memory budget of the executor context, and the right child is scanned once per
+ * block instead of once per left tuple. Every right tuple is matched against a whole left batch at once, by the
+ * compiled predicate if it compiles and through EvaluateJoinBatch otherwise, so the join produces its tuples block
+ * by block, right tuple by right tuple.
  */
 class NestedLoopJoinExecutor : public AbstractExecutor {
  public:
@@ -49,12 +56,37 @@ class NestedLoopJoinExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
-  /** @return The output schema for the insert */
+  /** @return The output schema for the join */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
 
  private:
+  /** Read the next block of left batches, @return false if the left child is exhausted */
+  bool NextBlock();
+
+  /** Collect the rows of a left batch that join with the current right tuple into matches_. */
+  void Probe(const TupleBatch &left_batch);
+
   /** The NestedLoopJoin plan node to be executed. */
   const NestedLoopJoinPlanNode *plan_;
+  /** The child executor that produces the left tuples, read a block at a time */
+  std::unique_ptr<AbstractExecutor> left_executor_;
+  /** The child executor that produces the right tuples, scanned once per block */
+  std::unique_ptr<AbstractExecutor> right_executor_;
+
+  /** The predicate compiled, nullptr if there is none or it cannot be */
+  std::unique_ptr<CompiledExpression> compiled_predicate_;
+
+  /** The left batches of the current block */
+  std::vector<TupleBatch> block_;
+  /** The current right tuple, valid while right_valid_ */
+  Tuple right_tuple_;
+  bool right_valid_{false};
+  /** The next batch of block_ to probe with right_tuple_ */
+  size_t batch_idx_{0};
+  /** The rows of the last probed batch that join with right_tuple_ */
+  std::vector<uint32_t> matches_;
+  /** The next row of matches_ to output */
+  size_t match_pos_{0};
 };
 
 }  // namespace bustub
@@ -12,17 +12,35 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "execution/compiled_expression.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/morsel_queue.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "storage/table/table_heap.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
 
 namespace bustub {
 
 /**
- * The SeqScanExecutor executor executes a sequential table scan.
+ * The SeqScanExecutor executor executes a sequential table scan. It reads the table a batch at a time, unboxing
+ * only the columns its predicate and output expressions refer to, filters the batch by narrowing its selection
+ * vector and computes every output column over the whole batch. The tuples of a PAX table are not put back
+ * together: the minipages of the columns referred to are read straight into the batch, a column at a time, and a
+ * predicate comparing an integer or VARCHAR column with a constant runs on the encoded values of the page.
+ *
+ * The tuples of a row table are not copied out of their pages either: the scan reads them through TupleViews while
+ * their page is pinned and latched, for as long as it takes to fill the batch from that page, and resumes at the
+ * next slot on the next batch.
+ *
+ * When the scan runs on several workers in parallel, every worker scans the morsels of the table it claims from
+ * the MorselQueue its plan shares, instead of the whole table.
  */
 class SeqScanExecutor : public AbstractExecutor {
  public:
@@ -44,11 +62,97 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   bool Next(Tuple *tuple, RID *rid) override;
 
+  /**
+   * Yield the next batch of tuples from the sequential scan.
+   * @param[out] batch The next batch of tuples that satisfy the predicate
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
   /** @return The output schema for the sequential scan */
   const Schema *GetOutputSchema() override { return plan_->OutputSchema(); }
 
+  /** @return the number of pages this scan skipped since Init, as the zone map showed none of their tuples pass */
+  size_t GetPrunedPageCount() const { return pruned_pages_; }
+
  private:
+  /** Flag every column of the table that expr reads in column_mask_ */
+  void MarkColumns(const AbstractExpression *expr);
+
+  /** Point page_id_ at the next morsel of a parallel scan, @return false if there is none */
+  bool NextMorsel();
+
+  /** Read the tuples of the next page that has any passing the pushed-down filter, @return false at the end */
+  bool NextPage();
+
+  /**
+   * Hand views of at most room of the next tuples that pass the pushed-down filter to reader, all from one page and
+   * valid only during the call. @return false at the end
+   */
+  bool NextViews(size_t room, const std::function<void(const std::vector<TupleView> &views)> &reader);
+
+  /**
+   * Find a comparison of a column with a constant in the predicate, to prune pages with if the column is zone-mapped
+   * and to run on the encoded values of a PAX table if it is an integer or VARCHAR column
+   */
+  void PlanPruning();
+
+  /** @return true if the zone map shows that no tuple of a page passes the predicate */
+  bool CanSkipPage(page_id_t page_id) const;
+
+  /** Fill table_batch_ with the tuples of the next pages that have any passing filter_, @return false at the end */
+  bool ReadRows();
+
+  /** Fill table_batch_ with the referred columns of the next rows of a PAX table, @return false at the end */
+  bool ReadColumns();
+
+  /** Fill batch by running the compiled output expressions over the bytes of every tuple */
+  bool NextCompiledBatch(TupleBatch *batch);
+
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
+  /** The table being scanned */
+  TableInfo *table_info_;
+  /** The next page to read, and the page the scan or the current morsel stops before */
+  page_id_t page_id_{INVALID_PAGE_ID};
+  page_id_t stop_page_id_{INVALID_PAGE_ID};
+  /** The tuples of the last page read that passed filter_, for a PAX table read a row at a time */
+  std::vector<Tuple> tuples_;
+  /** The next tuple of tuples_ */
+  size_t tuple_pos_{0};
+  /** True if the table is PAX and its pages are read with ReadColumns */
+  bool read_columns_{false};
+  /** The next row of page page_id_ to read, 0 before the page is started */
+  uint32_t slot_{0};
+  /** The morsels shared with the other workers of a parallel scan, nullptr if the scan is not parallel */
+  MorselQueue *morsels_{nullptr};
+  /** The table columns read by the predicate or the output, the only ones unboxed */
+  std::vector<bool> column_mask_;
+  /** The rows of the table read by the current batch, before projection */
+  std::unique_ptr<TupleBatch> table_batch_;
+  /** The compiled predicate, nullptr if there is no predicate or it cannot be compiled */
+  std::unique_ptr<CompiledExpression> compiled_predicate_;
+  /** The compiled predicate run inside the pages, empty if there is none */
+  TupleFilter filter_;
+  /** The zone map of the table, nullptr if it has none or the predicate cannot be checked against it */
+  ZoneMap *zone_map_{nullptr};
+  /** The predicate as column prune_column_ compared with prune_constant_, the column on the left */
+  uint32_t prune_column_{0};
+  ComparisonType prune_comparison_{ComparisonType::Equal};
+  Value prune_constant_;
+  /** True if the predicate runs on the encoded values of the PAX pages, instead of over the batch */
+  bool filter_encoded_{false};
+  /** The predicate on an integer column, as its values within [filter_lo_, filter_hi_] or outside of it */
+  int64_t filter_lo_{0};
+  int64_t filter_hi_{0};
+  bool filter_inside_{true};
+  /** The predicate on a VARCHAR column, as its values equal to filter_string_ or different from it */
+  std::string filter_string_;
+  /** The number of pages skipped since Init */
+  size_t pruned_pages_{0};
+  /** True if every output column is compiled, in which case no table row is unboxed */
+  bool compiled_projection_{false};
+  /** The compiled expression of every output column */
+  std::vector<std::unique_ptr<CompiledExpression>> compiled_outputs_;
 };
 }  // namespace bustub
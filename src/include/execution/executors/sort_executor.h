@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_executor.h
+//
+// Identification: src/include/execution/executors/sort_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/spill_file.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * SortExecutor sorts the tuples of its child by the ORDER BY terms of a SortPlanNode. Every tuple gets a sort key,
+ * the KeyEncoder encodings of its terms with the bytes of descending ones complemented, so that tuples compare with
+ * a single memcmp of their keys.
+ *
+ * Tuples are sorted in memory as long as they fit in the memory budget of the executor context. Past it, every
+ * budget worth of tuples is sorted into a run written to a SpillFile, and the runs are merged a page of each at a
+ * time while the output is produced. Spilled tuples lose their RID.
+ */
+class SortExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new SortExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The sort plan to be executed
+   * @param child The child executor from which tuples are pulled
+   */
+  SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child);
+
+  /** Initialize the sort, which consumes the whole child */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the sort.
+   * @param[out] tuple The next tuple produced by the sort
+   * @param[out] rid The next tuple RID produced by the sort
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  /**
+   * Yield the next batch of sorted tuples.
+   * @param[out] batch The next batch of tuples produced by the sort
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
+  /** @return The output schema for the sort */
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+  /**
+   * Compute the sort key of every selected row of a batch.
+   * @param plan the plan giving the ORDER BY terms
+   * @param batch the rows
+   * @param[out] keys the key of the i-th selected row is appended to the i-th string, resized to the selected rows
+   */
+  static void EncodeKeys(const SortPlanNode *plan, const TupleBatch &batch, std::vector<std::string> *keys);
+
+  /** @return the sort key of a tuple laid out by schema */
+  static std::string EncodeKey(const SortPlanNode *plan, const Tuple &tuple, const Schema *schema);
+
+ private:
+  /** A tuple to sort */
+  struct SortEntry {
+    std::string key_;
+    Tuple tuple_;
+    RID rid_;
+  };
+
+  /** The position of the merge in a sorted run */
+  struct RunCursor {
+    const SpillFile *run_;
+    /** The next page of run_ to read */
+    size_t next_page_{0};
+    /** The tuples read from run_ and not yet produced */
+    std::vector<Tuple> tuples_;
+    /** The next tuple of tuples_ */
+    size_t pos_{0};
+    /** The sort key of tuples_[pos_] */
+    std::string key_;
+  };
+
+  /** Sort entries_ into a run written out, and empty it. */
+  void SpillRun();
+
+  /** Point cursor at the next tuple of its run, @return false if the run is exhausted */
+  bool Advance(RunCursor *cursor);
+
+  /** @return true if cursor lhs is behind cursor rhs in the merge heap: its key is larger, or it comes later on ties */
+  bool CursorAfter(size_t lhs, size_t rhs) const;
+
+  /** The sort plan node to be executed */
+  const SortPlanNode *plan_;
+  /** The child executor from which tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_;
+  /** The tuples in memory, sorted once the child is consumed */
+  std::vector<SortEntry> entries_;
+  /** The number of bytes entries_ take */
+  size_t memory_usage_{0};
+  /** The next entry to produce, if nothing has been spilled */
+  size_t entry_pos_{0};
+  /** The sorted runs written out, in the order they were produced */
+  std::vector<std::unique_ptr<SpillFile>> runs_;
+  /** The position of the merge in every run */
+  std::vector<RunCursor> cursors_;
+  /** A min-heap of the cursors that are not exhausted, by their current key */
+  std::vector<size_t> heap_;
+};
+
+}  // namespace bustub
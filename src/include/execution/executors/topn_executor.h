@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// topn_executor.h
+//
+// Identification: src/include/execution/executors/topn_executor.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/sort_plan.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TopNExecutor produces the first n tuples of its child in the order of the ORDER BY terms of a sort plan. It keeps
+ * a max-heap of the n smallest tuples seen so far, by the sort keys of SortExecutor, so it holds at most n tuples
+ * whatever the size of its child. It runs TopNPlanNodes and LimitPlanNodes over SortPlanNodes.
+ */
+class TopNExecutor : public AbstractExecutor {
+ public:
+  /**
+   * Construct a new TopNExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The plan giving the ORDER BY terms, a TopNPlanNode or the SortPlanNode under a limit
+   * @param n The number of tuples to produce
+   * @param child The child executor from which tuples are pulled
+   */
+  TopNExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan, size_t n,
+               std::unique_ptr<AbstractExecutor> &&child);
+
+  /** Initialize the top-n, which consumes the whole child */
+  void Init() override;
+
+  /**
+   * Yield the next tuple from the top-n.
+   * @param[out] tuple The next tuple produced by the top-n
+   * @param[out] rid The next tuple RID produced by the top-n
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  bool Next(Tuple *tuple, RID *rid) override;
+
+  /**
+   * Yield the next batch of the first tuples.
+   * @param[out] batch The next batch of tuples produced by the top-n
+   * @return `true` if a batch was produced, `false` if there are no more tuples
+   */
+  bool NextBatch(TupleBatch *batch) override;
+
+  /** @return The output schema for the top-n */
+  const Schema *GetOutputSchema() override { return plan_->OutputSchema(); };
+
+ private:
+  /** A tuple among the first n */
+  struct TopNEntry {
+    std::string key_;
+    /** The position of the tuple in the child output, which breaks ties */
+    size_t seq_;
+    Tuple tuple_;
+    RID rid_;
+
+    bool operator<(const TopNEntry &other) const {
+      int cmp = key_.compare(other.key_);
+      return cmp < 0 || (cmp == 0 && seq_ < other.seq_);
+    }
+  };
+
+  /** The plan giving the ORDER BY terms */
+  const SortPlanNode *plan_;
+  /** The number of tuples to produce */
+  size_t n_;
+  /** The child executor from which tuples are obtained */
+  std::unique_ptr<AbstractExecutor> child_;
+  /** A max-heap of the first tuples while the child is consumed, then those tuples in order */
+  std::vector<TopNEntry> entries_;
+  /** The next entry to produce */
+  size_t entry_pos_{0};
+};
+
+}  // namespace bustub
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -58,6 +59,40 @@ class AbstractExpression {
    */
   virtual Value EvaluateAggregate(const std::vector<Value> &group_bys, const std::vector<Value> &aggregates) const = 0;
 
+  /**
+   * Evaluates the expression over the selected rows of a batch at once.
+   * @param batch The batch, laid out by the schema Evaluate would be given
+   * @return A vector holding the result of every selected row in that same row
+   *
+   * The default boxes each selected row back into a tuple and calls Evaluate, expressions override it with loops
+   * over unboxed column vectors.
+   */
+  virtual ColumnVector EvaluateBatch(const TupleBatch &batch) const {
+    ColumnVector result(GetReturnType(), batch.GetCapacity());
+    for (uint32_t row : batch.GetSelection()) {
+      Tuple tuple = batch.GetTuple(row);
+      result.SetValue(row, Evaluate(&tuple, batch.GetSchema()));
+    }
+    return result;
+  }
+
+  /**
+   * Evaluates a JOIN of the selected rows of a batch of left tuples with a single right tuple at once.
+   * @param left_batch The left rows, laid out by the left schema EvaluateJoin would be given
+   * @param right_tuple The right tuple
+   * @param right_schema The right tuple's schema
+   * @return A vector holding the result of every selected left row in that same row
+   */
+  virtual ColumnVector EvaluateJoinBatch(const TupleBatch &left_batch, const Tuple *right_tuple,
+                                         const Schema *right_schema) const {
+    ColumnVector result(GetReturnType(), left_batch.GetCapacity());
+    for (uint32_t row : left_batch.GetSelection()) {
+      Tuple left_tuple = left_batch.GetTuple(row);
+      result.SetValue(row, EvaluateJoin(&left_tuple, left_batch.GetSchema(), right_tuple, right_schema));
+    }
+    return result;
+  }
+
   /** @return the child_idx'th child of this expression */
   const AbstractExpression *GetChildAt(uint32_t child_idx) const { return children_[child_idx]; }
 
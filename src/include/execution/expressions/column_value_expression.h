@@ -45,6 +45,22 @@ class ColumnValueExpression : public AbstractExpression {
     BUSTUB_ASSERT(false, "Aggregation should only refer to group-by and aggregates.");
   }
 
+  ColumnVector EvaluateBatch(const TupleBatch &batch) const override { return batch.GetColumn(col_idx_); }
+
+  ColumnVector EvaluateJoinBatch(const TupleBatch &left_batch, const Tuple *right_tuple,
+                                 const Schema *right_schema) const override {
+    if (tuple_idx_ == 0) {
+      return left_batch.GetColumn(col_idx_);
+    }
+    // a right column is the same for every left row
+    ColumnVector result(GetReturnType(), left_batch.GetCapacity());
+    Value val = right_tuple->GetValue(right_schema, col_idx_);
+    for (uint32_t row : left_batch.GetSelection()) {
+      result.SetValue(row, val);
+    }
+    return result;
+  }
+
   uint32_t GetTupleIdx() const { return tuple_idx_; }
   uint32_t GetColIdx() const { return col_idx_; }
 
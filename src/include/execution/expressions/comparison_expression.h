@@ -12,11 +12,14 @@
 
 #pragma once
 
+#include <functional>
 #include <utility>
 #include <vector>
 
 #include "catalog/schema.h"
 #include "execution/expressions/abstract_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/constant_value_expression.h"
 #include "storage/table/tuple.h"
 #include "type/value_factory.h"
 
@@ -53,7 +56,72 @@ class ComparisonExpression : public AbstractExpression {
     return ValueFactory::GetBooleanValue(PerformComparison(lhs, rhs));
   }
 
+  ColumnVector EvaluateBatch(const TupleBatch &batch) const override {
+    return CompareColumns(batch, GetChildAt(0)->EvaluateBatch(batch), GetChildAt(1)->EvaluateBatch(batch));
+  }
+
+  ColumnVector EvaluateJoinBatch(const TupleBatch &left_batch, const Tuple *right_tuple,
+                                 const Schema *right_schema) const override {
+    return CompareColumns(left_batch, GetChildAt(0)->EvaluateJoinBatch(left_batch, right_tuple, right_schema),
+                          GetChildAt(1)->EvaluateJoinBatch(left_batch, right_tuple, right_schema));
+  }
+
+  /** @return the type of comparison performed */
+  ComparisonType GetComparisonType() const { return comp_type_; }
+
+  /**
+   * Match a comparison between a column and a constant, on either side.
+   * @param[out] column the column compared
+   * @param[out] constant the constant it is compared with
+   * @param[out] type the comparison of the column with the constant, mirrored if the constant is on the left
+   * @return `false` if the comparison is not between a column and a constant
+   */
+  bool MatchColumnConstant(const ColumnValueExpression **column, const ConstantValueExpression **constant,
+                           ComparisonType *type) const {
+    *column = dynamic_cast<const ColumnValueExpression *>(GetChildAt(0));
+    *constant = dynamic_cast<const ConstantValueExpression *>(GetChildAt(1));
+    *type = comp_type_;
+    if (*column == nullptr) {
+      // constant on the left, mirror the comparison
+      *column = dynamic_cast<const ColumnValueExpression *>(GetChildAt(1));
+      *constant = dynamic_cast<const ConstantValueExpression *>(GetChildAt(0));
+      switch (comp_type_) {
+        case ComparisonType::LessThan:
+          *type = ComparisonType::GreaterThan;
+          break;
+        case ComparisonType::LessThanOrEqual:
+          *type = ComparisonType::GreaterThanOrEqual;
+          break;
+        case ComparisonType::GreaterThan:
+          *type = ComparisonType::LessThan;
+          break;
+        case ComparisonType::GreaterThanOrEqual:
+          *type = ComparisonType::LessThanOrEqual;
+          break;
+        default:
+          break;
+      }
+    }
+    return *column != nullptr && *constant != nullptr;
+  }
+
  private:
+  /** @return the comparison of the selected rows of two columns computed over batch */
+  ColumnVector CompareColumns(const TupleBatch &batch, const ColumnVector &lhs, const ColumnVector &rhs) const {
+    ColumnVector result(TypeId::BOOLEAN, batch.GetCapacity());
+    if (lhs.IsInteger() && rhs.IsInteger()) {
+      CompareBatch(batch, lhs, rhs, lhs.GetIntegers(), rhs.GetIntegers(), &result);
+    } else if (lhs.GetType() == TypeId::DECIMAL && rhs.GetType() == TypeId::DECIMAL) {
+      CompareBatch(batch, lhs, rhs, lhs.GetDecimals(), rhs.GetDecimals(), &result);
+    } else {
+      // varchars and mixed types go through Value, which knows how to cast between them
+      for (uint32_t row : batch.GetSelection()) {
+        result.SetValue(row, ValueFactory::GetBooleanValue(PerformComparison(lhs.GetValue(row), rhs.GetValue(row))));
+      }
+    }
+    return result;
+  }
+
   CmpBool PerformComparison(const Value &lhs, const Value &rhs) const {
     switch (comp_type_) {
       case ComparisonType::Equal:
@@ -73,6 +141,38 @@ class ComparisonExpression : public AbstractExpression {
     }
   }
 
+  template <typename T>
+  void CompareBatch(const TupleBatch &batch, const ColumnVector &lhs, const ColumnVector &rhs, const T *left,
+                    const T *right, ColumnVector *result) const {
+    switch (comp_type_) {
+      case ComparisonType::Equal:
+        return CompareBatch(batch, lhs, rhs, left, right, std::equal_to<T>(), result);
+      case ComparisonType::NotEqual:
+        return CompareBatch(batch, lhs, rhs, left, right, std::not_equal_to<T>(), result);
+      case ComparisonType::LessThan:
+        return CompareBatch(batch, lhs, rhs, left, right, std::less<T>(), result);
+      case ComparisonType::LessThanOrEqual:
+        return CompareBatch(batch, lhs, rhs, left, right, std::less_equal<T>(), result);
+      case ComparisonType::GreaterThan:
+        return CompareBatch(batch, lhs, rhs, left, right, std::greater<T>(), result);
+      case ComparisonType::GreaterThanOrEqual:
+        return CompareBatch(batch, lhs, rhs, left, right, std::greater_equal<T>(), result);
+      default:
+        BUSTUB_ASSERT(false, "Unsupported comparison type.");
+    }
+  }
+
+  /** The comparison loop over unboxed values; a null on either side makes the result null. */
+  template <typename T, typename Op>
+  static void CompareBatch(const TupleBatch &batch, const ColumnVector &lhs, const ColumnVector &rhs, const T *left,
+                           const T *right, Op op, ColumnVector *result) {
+    int64_t *out = result->GetIntegers();
+    for (uint32_t row : batch.GetSelection()) {
+      out[row] = static_cast<int64_t>(op(left[row], right[row]));
+      result->SetNull(row, lhs.IsNull(row) || rhs.IsNull(row));
+    }
+  }
+
   std::vector<const AbstractExpression *> children_;
   ComparisonType comp_type_;
 };
@@ -36,6 +36,19 @@ class ConstantValueExpression : public AbstractExpression {
     return val_;
   }
 
+  ColumnVector EvaluateBatch(const TupleBatch &batch) const override {
+    ColumnVector result(val_.GetTypeId(), batch.GetCapacity());
+    for (uint32_t row : batch.GetSelection()) {
+      result.SetValue(row, val_);
+    }
+    return result;
+  }
+
+  ColumnVector EvaluateJoinBatch(const TupleBatch &left_batch, const Tuple *right_tuple,
+                                 const Schema *right_schema) const override {
+    return EvaluateBatch(left_batch);
+  }
+
  private:
   Value val_;
 };
@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// join_hash_table.h
+//
+// Identification: src/include/execution/join_hash_table.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "common/util/hash_util.h"
+#include "execution/spill_file.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * JoinHashTable holds the build side of a hash join, split into 2^HASH_JOIN_RADIX_BITS partitions by the top bits
+ * of the key hashes so that every partition has a small table of its own. Once built, each partition is indexed by
+ * an open-addressing table of entry positions, probed with the low bits of the precomputed hash and compared on the
+ * full hash before the key is.
+ *
+ * The table keeps track of the memory its entries take. Whenever that exceeds its budget, the largest partition in
+ * memory is written to a SpillFile and every later tuple hashed to it follows; the join probes such a partition
+ * again after the build and probe sides of it have both been spilled (grace hash join). A spilled partition is read
+ * back into a table of the next level, split by the next HASH_JOIN_RADIX_BITS bits of the hashes, which spills in
+ * turn if the partition still exceeds the budget.
+ */
+class JoinHashTable {
+ public:
+  /** The number of partitions */
+  static constexpr uint32_t NUM_PARTITIONS = 1U << HASH_JOIN_RADIX_BITS;
+  /** The deepest level, the last one that has bits of the hashes of its own */
+  static constexpr uint32_t MAX_LEVEL = 64 / HASH_JOIN_RADIX_BITS - 1;
+
+  /**
+   * @param bpm the buffer pool manager spilled partitions are written to
+   * @param memory_budget the number of bytes the entries in memory may take
+   * @param level the level of the table, 0 for the whole build side and the level of the table it was spilled from
+   * plus one for a spilled partition read back; the level picks the bits of the hashes the partitions are split by
+   */
+  JoinHashTable(BufferPoolManager *bpm, size_t memory_budget, uint32_t level = 0);
+
+  DISALLOW_COPY_AND_MOVE(JoinHashTable);
+
+  /** @return the level of the table */
+  uint32_t GetLevel() const { return level_; }
+
+  /** @return the partition of a key hash */
+  uint32_t PartitionOf(hash_t hash) const {
+    return static_cast<uint32_t>(hash >> (64 - (level_ + 1) * HASH_JOIN_RADIX_BITS)) & (NUM_PARTITIONS - 1);
+  }
+
+  /** Insert a build tuple with its join key, which must not be null, and the hash of the key. */
+  void Insert(hash_t hash, Value key, Tuple tuple);
+
+  /** Move every tuple of other, which is left empty, into this table. Neither table can be built yet. */
+  void Merge(JoinHashTable *other);
+
+  /** Index the partitions in memory. No tuple may be inserted afterwards. */
+  void Build();
+
+  /** @return true if the partition has been spilled */
+  bool IsSpilled(uint32_t partition) const { return partitions_[partition].spill_ != nullptr; }
+
+  /** @return the spilled tuples of a partition */
+  const SpillFile &GetSpill(uint32_t partition) const { return *partitions_[partition].spill_; }
+
+  /** @return the spilled tuples of a partition, taken out of this table */
+  std::unique_ptr<SpillFile> TakeSpill(uint32_t partition) { return std::move(partitions_[partition].spill_); }
+
+  /** Drop the tuples in memory once the table is no longer probed, keeping the spilled ones. */
+  void ReleaseEntries();
+
+  /** @return true if any partition has been spilled */
+  bool HasSpilled() const;
+
+  /** @return the number of bytes the entries in memory take */
+  size_t GetMemoryUsage() const { return memory_usage_; }
+
+  /**
+   * Find the tuples matching a key in a partition in memory, after Build.
+   * @param hash the hash of key
+   * @param key the probe key
+   * @param[out] matches the matching tuples are appended to it
+   */
+  void Probe(hash_t hash, const Value &key, std::vector<const Tuple *> *matches) const;
+
+ private:
+  struct Entry {
+    hash_t hash_;
+    Value key_;
+    Tuple tuple_;
+  };
+
+  struct Partition {
+    /** The tuples in memory */
+    std::vector<Entry> entries_;
+    /** After Build, a power of two number of slots, each 0 or 1 + the position of an entry */
+    std::vector<uint32_t> slots_;
+    /** The number of bytes entries_ take */
+    size_t memory_usage_{0};
+    /** The tuples written out, nullptr unless the partition has been spilled */
+    std::unique_ptr<SpillFile> spill_;
+  };
+
+  /** @return the number of bytes an entry takes */
+  static size_t EntrySize(const Entry &entry);
+
+  /** Write a partition out, together with every tuple inserted into it later. */
+  void Spill(Partition *partition);
+
+  /** Spill the largest partitions in memory until the entries fit in the budget. */
+  void Shrink();
+
+  BufferPoolManager *bpm_;
+  size_t memory_budget_;
+  uint32_t level_;
+  size_t memory_usage_{0};
+  std::vector<Partition> partitions_;
+};
+
+}  // namespace bustub
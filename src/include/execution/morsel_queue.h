@@ -0,0 +1,56 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// morsel_queue.h
+//
+// Identification: src/include/execution/morsel_queue.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "storage/table/table_heap.h"
+
+namespace bustub {
+
+/**
+ * MorselQueue splits a TableHeap into morsels of consecutive pages and hands each of them out to exactly one of the
+ * workers of a parallel scan. Morsels are cut off the page chain as workers ask for them, so a fast worker simply
+ * claims more of them.
+ */
+class MorselQueue {
+ public:
+  /**
+   * @param table_heap the table to split
+   * @param bpm the buffer pool manager holding the pages of the table
+   * @param morsel_size the number of pages per morsel
+   */
+  MorselQueue(TableHeap *table_heap, BufferPoolManager *bpm, uint32_t morsel_size = MORSEL_SIZE)
+      : bpm_(bpm), morsel_size_(morsel_size), next_page_id_(table_heap->GetFirstPageId()) {}
+
+  DISALLOW_COPY_AND_MOVE(MorselQueue);
+
+  /**
+   * Claim the next morsel.
+   * @param[out] first_page_id the first page of the morsel
+   * @param[out] stop_page_id the page after the morsel, INVALID_PAGE_ID for the last one
+   * @return false if every page has been handed out
+   */
+  bool Next(page_id_t *first_page_id, page_id_t *stop_page_id);
+
+ private:
+  std::mutex latch_;
+  BufferPoolManager *bpm_;
+  uint32_t morsel_size_;
+  /** The first page not handed out yet */
+  page_id_t next_page_id_;
+};
+
+}  // namespace bustub
@@ -12,11 +12,31 @@
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include "catalog/catalog.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/abstract_plan.h"
 
 namespace bustub {
+/**
+ * IndexScanRange bounds the keys visited by an index scan. A bound holds one value per index key column; an
+ * empty bound leaves that side of the range open.
+ */
+struct IndexScanRange {
+  /** The lowest key of the range */
+  std::vector<Value> lower_;
+  /** Whether the lowest key itself is part of the range */
+  bool lower_inclusive_{true};
+  /** The highest key of the range */
+  std::vector<Value> upper_;
+  /** Whether the highest key itself is part of the range */
+  bool upper_inclusive_{true};
+  /** Produce tuples in descending key order */
+  bool reverse_{false};
+};
+
 /**
  * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
  */
@@ -32,6 +52,25 @@ class IndexScanPlanNode : public AbstractPlanNode {
   IndexScanPlanNode(const Schema *output, const AbstractExpression *predicate, index_oid_t index_oid)
       : AbstractPlanNode(output, {}), predicate_{predicate}, index_oid_(index_oid) {}
 
+  /**
+   * Creates a new index scan plan node that only visits the keys in range.
+   * @param output the output format of this scan plan node
+   * @param predicate the predicate to scan with, tuples are returned if predicate(tuple) == true or predicate ==
+   * nullptr
+   * @param index_oid the identifier of the index to be scanned
+   * @param range the key range pushed down into the index
+   * @param index_only answer the scan from the key and included columns of the index entries alone, without
+   * fetching the tuples from the table heap; the output and predicate may then only read those columns
+   */
+  IndexScanPlanNode(const Schema *output, const AbstractExpression *predicate, index_oid_t index_oid,
+                    IndexScanRange range, bool index_only = false)
+      : AbstractPlanNode(output, {}),
+        predicate_{predicate},
+        index_oid_(index_oid),
+        range_(std::move(range)),
+        has_range_(true),
+        index_only_(index_only) {}
+
   PlanType GetType() const override { return PlanType::IndexScan; }
 
   /** @return the predicate to test tuples against; tuples should only be returned if they evaluate to true */
@@ -40,11 +79,26 @@ class IndexScanPlanNode : public AbstractPlanNode {
   /** @return the identifier of the table that should be scanned */
   index_oid_t GetIndexOid() const { return index_oid_; }
 
+  /** @return true if the scan carries an explicit key range */
+  bool HasRange() const { return has_range_; }
+
+  /** @return the key range of the scan */
+  const IndexScanRange &GetRange() const { return range_; }
+
+  /** @return true if the scan never touches the table heap */
+  bool IsIndexOnly() const { return index_only_; }
+
  private:
   /** The predicate that all returned tuples must satisfy. */
   const AbstractExpression *predicate_;
   /** The table whose tuples should be scanned. */
   index_oid_t index_oid_;
+  /** The key range to scan, only meaningful if has_range_ is set. */
+  IndexScanRange range_;
+  /** Whether an explicit key range was given. */
+  bool has_range_{false};
+  /** Whether the scan is answered from the index entries alone. */
+  bool index_only_{false};
 };
 
 }  // namespace bustub
@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_plan.h
+//
+// Identification: src/include/execution/plans/sort_plan.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "execution/expressions/abstract_expression.h"
+#include "execution/plans/abstract_plan.h"
+
+namespace bustub {
+
+/** OrderByType is the direction an ORDER BY term sorts in */
+enum class OrderByType { ASC, DESC };
+
+/**
+ * SortPlanNode orders the tuples of its child by a list of ORDER BY terms, later terms breaking the ties of earlier
+ * ones, and tuples equal on every term keeping the order of the child. Nulls come first in ascending order. The
+ * output schema is the one of the child.
+ */
+class SortPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new SortPlanNode instance.
+   * @param output_schema The output schema, the one of the child
+   * @param child The child plan from which tuples are obtained
+   * @param order_bys The ORDER BY terms, each a direction and an expression over the child tuples
+   */
+  SortPlanNode(const Schema *output_schema, const AbstractPlanNode *child,
+               std::vector<std::pair<OrderByType, const AbstractExpression *>> &&order_bys)
+      : AbstractPlanNode(output_schema, {child}), order_bys_(std::move(order_bys)) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::Sort; }
+
+  /** @return The child plan node */
+  const AbstractPlanNode *GetChildPlan() const {
+    BUSTUB_ASSERT(GetChildren().size() == 1, "Sort should have exactly one child plan.");
+    return GetChildAt(0);
+  }
+
+  /** @return The ORDER BY terms */
+  const std::vector<std::pair<OrderByType, const AbstractExpression *>> &GetOrderBys() const { return order_bys_; }
+
+ private:
+  /** The ORDER BY terms */
+  std::vector<std::pair<OrderByType, const AbstractExpression *>> order_bys_;
+};
+
+}  // namespace bustub
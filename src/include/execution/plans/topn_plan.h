@@ -0,0 +1,50 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// topn_plan.h
+//
+// Identification: src/include/execution/plans/topn_plan.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "execution/plans/sort_plan.h"
+
+namespace bustub {
+
+/**
+ * TopNPlanNode produces the first n tuples of its child in the order a SortPlanNode with the same ORDER BY terms
+ * would, without sorting the others. A LimitPlanNode over a SortPlanNode runs the same way.
+ */
+class TopNPlanNode : public SortPlanNode {
+ public:
+  /**
+   * Construct a new TopNPlanNode instance.
+   * @param output_schema The output schema, the one of the child
+   * @param child The child plan from which tuples are obtained
+   * @param order_bys The ORDER BY terms, each a direction and an expression over the child tuples
+   * @param n The number of tuples to produce
+   */
+  TopNPlanNode(const Schema *output_schema, const AbstractPlanNode *child,
+               std::vector<std::pair<OrderByType, const AbstractExpression *>> &&order_bys, size_t n)
+      : SortPlanNode(output_schema, child, std::move(order_bys)), n_(n) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::TopN; }
+
+  /** @return The number of tuples to produce */
+  size_t GetN() const { return n_; }
+
+ private:
+  /** The number of tuples to produce */
+  size_t n_;
+};
+
+}  // namespace bustub
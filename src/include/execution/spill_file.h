@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// spill_file.h
+//
+// Identification: src/include/execution/spill_file.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
+
+namespace bustub {
+
+/**
+ * SpillFile holds tuples an executor moves out of memory, on TmpTuplePages of the buffer pool, which writes them to
+ * disk when it runs short of frames. No page stays pinned between calls. The pages are deleted with the file.
+ */
+class SpillFile {
+ public:
+  /** @param bpm the buffer pool manager to allocate the pages from */
+  explicit SpillFile(BufferPoolManager *bpm) : bpm_(bpm) {}
+
+  ~SpillFile();
+
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  /** Append a tuple, of at most TmpTuplePage::MaxTupleSize() bytes. */
+  void Append(const Tuple &tuple);
+
+  /** Move every tuple of other to the end of this file, leaving other empty. */
+  void Splice(SpillFile *other);
+
+  /** @return the number of tuples */
+  size_t Size() const { return size_; }
+
+  /** @return the number of pages */
+  size_t GetPageCount() const { return page_ids_.size(); }
+
+  /** Append the tuples of the page_idx-th page to tuples. */
+  void ReadPage(size_t page_idx, std::vector<Tuple> *tuples) const;
+
+  /** Append every tuple to tuples. */
+  void ReadAll(std::vector<Tuple> *tuples) const;
+
+  /**
+   * Hand views of the tuples of the page_idx-th page, in the order they were appended, to a reader while the page
+   * is pinned, so that it reads them in place instead of copying them out.
+   */
+  void ViewPage(size_t page_idx, const std::function<void(const std::vector<TupleView> &views)> &reader) const;
+
+ private:
+  BufferPoolManager *bpm_;
+  /** The pages, the last one being filled */
+  std::vector<page_id_t> page_ids_;
+  /** The number of tuples */
+  size_t size_{0};
+};
+
+}  // namespace bustub
@@ -0,0 +1,199 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch.h
+//
+// Identification: src/include/execution/tuple_batch.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
+#include "type/abstract_pool.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * ColumnVector holds the values of one column for every row of a batch, unboxed: integer types, booleans and
+ * timestamps widened to int64_t, decimals as doubles and varchars as strings, plus one null flag per row.
+ */
+class ColumnVector {
+ public:
+  /**
+   * Create a column vector.
+   * @param type the type of the values
+   * @param capacity the number of rows it holds
+   */
+  explicit ColumnVector(TypeId type, uint32_t capacity = BATCH_SIZE);
+
+  /** @return the type of the values */
+  TypeId GetType() const { return type_; }
+
+  /** @return true if the values are integers, booleans or timestamps, stored in GetIntegers() */
+  bool IsInteger() const { return type_ != TypeId::DECIMAL && type_ != TypeId::VARCHAR; }
+
+  /** @return the integer values, valid for integer, boolean and timestamp columns */
+  const int64_t *GetIntegers() const { return integers_.data(); }
+  int64_t *GetIntegers() { return integers_.data(); }
+
+  /** @return the decimal values, valid for decimal columns */
+  const double *GetDecimals() const { return decimals_.data(); }
+  double *GetDecimals() { return decimals_.data(); }
+
+  /** @return the string in row, valid for varchar columns */
+  const std::string &GetString(uint32_t row) const { return strings_[row]; }
+
+  /** @return true if the value in row is null */
+  bool IsNull(uint32_t row) const { return nulls_[row] != 0; }
+
+  /** Mark the value in row as null or not. */
+  void SetNull(uint32_t row, bool is_null) { nulls_[row] = static_cast<uint8_t>(is_null); }
+
+  /** @return the value in row, boxed; the bytes of a VARCHAR are allocated from pool if one is given */
+  Value GetValue(uint32_t row, AbstractPool *pool = nullptr) const;
+
+  /** Unbox val into row, cast to the type of this vector. */
+  void SetValue(uint32_t row, const Value &val);
+
+  /** Unbox into row the value at data, laid out as Value::SerializeTo writes a value of the type of this vector. */
+  void Deserialize(uint32_t row, const char *data);
+
+  /** @return the number of bytes SerializeTo writes for the value in row */
+  uint32_t GetSerializedSize(uint32_t row) const {
+    if (type_ != TypeId::VARCHAR) {
+      return static_cast<uint32_t>(Type::GetTypeSize(type_));
+    }
+    // the stored length counts the trailing terminator
+    return sizeof(uint32_t) + (IsNull(row) ? 0 : static_cast<uint32_t>(strings_[row].size()) + 1);
+  }
+
+  /** Write the value in row at data, laid out as Value::SerializeTo writes it. */
+  void SerializeTo(uint32_t row, char *data) const;
+
+ private:
+  TypeId type_;
+  std::vector<int64_t> integers_;
+  std::vector<double> decimals_;
+  std::vector<std::string> strings_;
+  std::vector<uint8_t> nulls_;
+};
+
+/**
+ * TupleBatch holds up to a fixed number of rows laid out by a schema, one ColumnVector per column, with the RID
+ * each row came from. A selection vector lists the rows still alive, in order: filters shrink it instead of moving
+ * data, and every consumer only looks at the selected rows.
+ */
+class TupleBatch {
+ public:
+  /**
+   * Create an empty batch.
+   * @param schema the schema of the rows
+   * @param capacity the maximum number of rows
+   */
+  explicit TupleBatch(const Schema *schema, uint32_t capacity = BATCH_SIZE);
+
+  /** @return the schema of the rows */
+  const Schema *GetSchema() const { return schema_; }
+
+  /** @return the maximum number of rows */
+  uint32_t GetCapacity() const { return capacity_; }
+
+  /** @return the number of rows filled, selected or not */
+  uint32_t GetRowCount() const { return row_count_; }
+
+  /** @return true if no more rows fit */
+  bool IsFull() const { return row_count_ == capacity_; }
+
+  /** @return the number of selected rows */
+  uint32_t Size() const { return static_cast<uint32_t>(selection_.size()); }
+
+  /** @return the row of the i-th selected row */
+  uint32_t RowAt(uint32_t i) const { return selection_[i]; }
+
+  /** @return the selected rows, in order */
+  const std::vector<uint32_t> &GetSelection() const { return selection_; }
+
+  /** Replace the selected rows, which must be a subsequence of the current selection. */
+  void SetSelection(std::vector<uint32_t> &&selection) { selection_ = std::move(selection); }
+
+  /** Keep only the first count selected rows. */
+  void Truncate(uint32_t count) {
+    if (count < selection_.size()) {
+      selection_.resize(count);
+    }
+  }
+
+  /** @return the column vector of column column_idx */
+  const ColumnVector &GetColumn(uint32_t column_idx) const { return columns_[column_idx]; }
+  ColumnVector &GetColumn(uint32_t column_idx) { return columns_[column_idx]; }
+
+  /** @return the RID of row */
+  const RID &GetRid(uint32_t row) const { return rids_[row]; }
+
+  /** Drop every row. */
+  void Reset() {
+    row_count_ = 0;
+    selection_.clear();
+  }
+
+  /**
+   * Append a row unboxed from tuple and select it.
+   * @param tuple a tuple laid out by the batch schema
+   * @param rid the RID of the tuple
+   * @param column_mask if given, only the columns flagged in it are filled, the others are left undefined
+   */
+  void Append(const Tuple &tuple, const RID &rid, const std::vector<bool> *column_mask = nullptr);
+
+  /**
+   * Append a row unboxed straight from the bytes a view points to, with the RID of the view, and select it.
+   * @param view a view of a tuple laid out by the batch schema
+   * @param column_mask if given, only the columns flagged in it are filled, the others are left undefined
+   */
+  void Append(const TupleView &view, const std::vector<bool> *column_mask = nullptr);
+
+  /** Append a row from one value per column and select it. */
+  void Append(const std::vector<Value> &values, const RID &rid = RID());
+
+  /**
+   * Append a row and select it, leaving its values for the caller to fill in the column vectors.
+   * @param rid the RID of the row
+   * @return the row
+   */
+  uint32_t AppendRow(const RID &rid);
+
+  /**
+   * Replace the content with the rows of source, given columns computed over them: the row count, RIDs and
+   * selection of source are taken over.
+   */
+  void Assign(const TupleBatch &source, std::vector<ColumnVector> &&columns);
+
+  /**
+   * @return row written back into a tuple of the batch schema, without boxing its values
+   * @param row the row
+   * @param pool if given, the tuple data is allocated from it, and the tuple does not own it
+   */
+  Tuple GetTuple(uint32_t row, AbstractPool *pool = nullptr) const;
+
+ private:
+  const Schema *schema_;
+  uint32_t capacity_;
+  uint32_t row_count_{0};
+  std::vector<ColumnVector> columns_;
+  std::vector<RID> rids_;
+  std::vector<uint32_t> selection_;
+};
+
+}  // namespace bustub
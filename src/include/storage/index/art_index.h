@@ -0,0 +1,44 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// art_index.h
+//
+// Identification: src/include/storage/index/art_index.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "container/art/adaptive_radix_tree.h"
+#include "storage/index/index.h"
+
+namespace bustub {
+
+/**
+ * In-memory index over an adaptive radix tree. Keys are encoded with KeyEncoder, so lookups neither pin pages nor
+ * dispatch on column types. The index lives only in memory and is rebuilt from the table heap when created.
+ */
+class ARTIndex : public Index {
+ public:
+  explicit ARTIndex(std::unique_ptr<IndexMetadata> &&metadata);
+
+  ~ARTIndex() override = default;
+
+  void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
+
+  void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
+
+ protected:
+  // container
+  AdaptiveRadixTree<RID> container_;
+};
+
+}  // namespace bustub
@@ -14,10 +14,12 @@
 #include <string>
 #include <vector>
 
+#include "common/rwlatch.h"
 #include "concurrency/transaction.h"
 #include "storage/index/index_iterator.h"
 #include "storage/page/b_plus_tree_internal_page.h"
 #include "storage/page/b_plus_tree_leaf_page.h"
+#include "storage/page/b_plus_tree_overflow_page.h"
 
 namespace bustub {
 
@@ -28,19 +30,23 @@ namespace bustub {
  *
  * Implementation of simple b+ tree data structure where internal pages direct
  * the search and leaf pages contain actual data.
- * (1) We only support unique key
+ * (1) Duplicate keys are supported: a leaf keeps one posting list of values per
+ *     key, and values of hot keys spill into chains of overflow pages
  * (2) support insert & remove
  * (3) The structure should shrink and grow dynamically
- * (4) Implement index iterator for range scan
+ * (4) Implement index iterator for range scan, forward and backward, with
+ *     optional bounds at either end
  */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTree {
   using InternalPage = BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator>;
   using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
+  using OverflowPage = BPlusTreeOverflowPage<ValueType>;
 
  public:
   explicit BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
-                     int leaf_max_size = LEAF_PAGE_SIZE, int internal_max_size = INTERNAL_PAGE_SIZE);
+                     int leaf_max_size = LEAF_PAGE_SIZE, int internal_max_size = INTERNAL_PAGE_SIZE - 1,
+                     page_id_t header_page_id = HEADER_PAGE_ID);
 
   // Returns true if this B+ tree has no keys and values.
   bool IsEmpty() const;
@@ -48,15 +54,25 @@ class BPlusTree {
   // Insert a key-value pair into this B+ tree.
   bool Insert(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
 
-  // Remove a key and its value from this B+ tree.
+  // Remove a key and all of its values from this B+ tree.
   void Remove(const KeyType &key, Transaction *transaction = nullptr);
 
-  // return the value associated with a given key
+  // Remove a single key-value pair from this B+ tree.
+  bool Remove(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
+
+  // return all the values associated with a given key
   bool GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction = nullptr);
 
   // index iterator
   INDEXITERATOR_TYPE Begin();
   INDEXITERATOR_TYPE Begin(const KeyType &key);
+  // forward scan over the keys between lower and upper, a nullptr bound leaves that side open; the bounds are
+  // compared with search_comparator if given, which may only look at a prefix of the key
+  INDEXITERATOR_TYPE Begin(const KeyType *lower, bool lower_inclusive, const KeyType *upper, bool upper_inclusive,
+                           const KeyComparator *search_comparator = nullptr);
+  // backward scan from upper down to lower, a nullptr bound leaves that side open
+  INDEXITERATOR_TYPE RBegin(const KeyType *lower = nullptr, bool lower_inclusive = true, const KeyType *upper = nullptr,
+                            bool upper_inclusive = true, const KeyComparator *search_comparator = nullptr);
   INDEXITERATOR_TYPE End();
 
   void Print(BufferPoolManager *bpm) {
@@ -82,6 +98,12 @@ class BPlusTree {
  private:
   void StartNewTree(const KeyType &key, const ValueType &value);
 
+  Page *FindRightmostLeafPage();
+
+  Page *FindBoundLeafPage(const KeyType &key, bool before, const KeyComparator &comparator);
+
+  void SetPrevLeafPageId(page_id_t page_id, page_id_t prev_page_id);
+
   bool InsertIntoLeaf(const KeyType &key, const ValueType &value, Transaction *transaction = nullptr);
 
   void InsertIntoParent(BPlusTreePage *old_node, const KeyType &key, BPlusTreePage *new_node,
@@ -102,6 +124,19 @@ class BPlusTree {
 
   bool AdjustRoot(BPlusTreePage *node);
 
+  void RemoveFromLeaf(Page *leaf_page, int index, Transaction *transaction);
+
+  // overflow chain helpers, the chain head is stored in the leaf entry
+  bool OverflowContains(page_id_t head_page_id, const ValueType &value);
+
+  void AppendToOverflow(LeafPage *leaf, int index, const ValueType &value);
+
+  bool RemoveFromOverflow(LeafPage *leaf, int index, const ValueType &value);
+
+  page_id_t PopFromOverflow(page_id_t head_page_id, ValueType *value);
+
+  void DeleteOverflowChain(page_id_t head_page_id);
+
   void UpdateRootPageId(int insert_record = 0);
 
   /* Debug Routines for FREE!! */
@@ -116,6 +151,9 @@ class BPlusTree {
   KeyComparator comparator_;
   int leaf_max_size_;
   int internal_max_size_;
+  // page holding the <index_name, root_page_id> record of this tree
+  page_id_t header_page_id_;
+  ReaderWriterLatch root_latch_;
 };
 
 }  // namespace bustub
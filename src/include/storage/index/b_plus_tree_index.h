@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "storage/index/b_plus_tree.h"
+#include "storage/index/bloom_filter.h"
 #include "storage/index/index.h"
 
 namespace bustub {
@@ -26,7 +27,13 @@ namespace bustub {
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeIndex : public Index {
  public:
-  BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager);
+  /**
+   * @param filter_capacity expected number of keys to size a Bloom filter for, 0 for no filter
+   * @param filter_page_id header page of a persisted filter to reattach instead of creating one
+   */
+  BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager,
+                 page_id_t header_page_id = HEADER_PAGE_ID, size_t filter_capacity = 0,
+                 page_id_t filter_page_id = INVALID_PAGE_ID);
 
   void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) override;
 
@@ -34,17 +41,30 @@ class BPlusTreeIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  BloomFilter *GetFilter() const override { return filter_.get(); }
+
   INDEXITERATOR_TYPE GetBeginIterator();
 
   INDEXITERATOR_TYPE GetBeginIterator(const KeyType &key);
 
+  // bounded scans compare the bounds on the indexed key only, so they may be built from the search key schema
+  INDEXITERATOR_TYPE GetBeginIterator(const KeyType *lower, bool lower_inclusive, const KeyType *upper,
+                                      bool upper_inclusive);
+
+  INDEXITERATOR_TYPE GetReverseBeginIterator(const KeyType *lower, bool lower_inclusive, const KeyType *upper,
+                                             bool upper_inclusive);
+
   INDEXITERATOR_TYPE GetEndIterator();
 
  protected:
   // comparator for key
   KeyComparator comparator_;
+  // comparator for the indexed key alone, ignores the included columns trailing each entry
+  KeyComparator search_comparator_;
   // container
   BPlusTree<KeyType, ValueType, KeyComparator> container_;
+  // screens point lookups of absent keys, on the indexed key only
+  std::unique_ptr<BloomFilter> filter_;
 };
 
 }  // namespace bustub
@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bloom_filter.h
+//
+// Identification: src/include/storage/index/bloom_filter.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "buffer/buffer_pool_manager.h"
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "common/util/hash_util.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * Blocked Bloom filter that lets an index answer definite misses without traversing its pages.
+ *
+ * Every key sets BLOOM_FILTER_NUM_HASHES bits inside a single 512-bit block (one cache line), so a probe touches one
+ * line and never the buffer pool. Keys cannot be removed; deleted keys keep their bits and show up as false
+ * positives, and inserting past the sized capacity raises the false positive rate.
+ *
+ * Lookups run on the in-memory bits. Inserts that set new bits write their block through to the filter's own pages,
+ * so the filter can be reattached from its header page id after a restart.
+ *
+ * Header page format (the bits follow on data pages of PAGE_SIZE bytes each):
+ *  ---------------------------------------------------------------------
+ * | NumBlocks (4) | NumHashes (4) | NumDataPages (4) | DataPageId(1) | ...
+ *  ---------------------------------------------------------------------
+ */
+class BloomFilter {
+ public:
+  /**
+   * Creates an empty filter sized for the expected number of keys at BLOOM_FILTER_BITS_PER_KEY bits per key, or
+   * reattaches the filter persisted under header_page_id.
+   * @param buffer_pool_manager the buffer pool holding the filter pages
+   * @param expected_keys the number of keys a new filter is sized for
+   * @param header_page_id the header page of an existing filter, INVALID_PAGE_ID to create one
+   */
+  BloomFilter(BufferPoolManager *buffer_pool_manager, size_t expected_keys, page_id_t header_page_id = INVALID_PAGE_ID);
+
+  /** @return the hash of the first column_count columns of key, laid out by schema */
+  static hash_t HashKey(const Tuple &key, const Schema *schema, uint32_t column_count);
+
+  /** Adds a key hash to the filter. */
+  void Insert(hash_t hash);
+
+  /** @return false if the key was definitely never inserted */
+  bool MayContain(hash_t hash);
+
+  /** Records that a probe passed the filter but the index held no entry. */
+  void RecordFalsePositive() { false_positives_.fetch_add(1, std::memory_order_relaxed); }
+
+  page_id_t GetHeaderPageId() const { return header_page_id_; }
+  size_t GetNumBits() const { return num_blocks_ * BLOCK_BITS; }
+  uint32_t GetNumHashes() const { return BLOOM_FILTER_NUM_HASHES; }
+  /** @return the number of inserts, estimated from the set bits for a reattached filter */
+  size_t GetNumInserted() const { return num_inserted_.load(std::memory_order_relaxed); }
+  uint64_t GetNumProbes() const { return probes_.load(std::memory_order_relaxed); }
+  /** @return the number of probes the filter answered as definite misses */
+  uint64_t GetNumNegatives() const { return negatives_.load(std::memory_order_relaxed); }
+  uint64_t GetNumFalsePositives() const { return false_positives_.load(std::memory_order_relaxed); }
+
+  /** @return the false positive rate expected from the current number of inserts */
+  double GetExpectedFalsePositiveRate() const;
+
+  /** @return the share of probes for absent keys that the filter failed to reject */
+  double GetObservedFalsePositiveRate() const;
+
+ private:
+  static constexpr size_t BLOCK_BITS = 512;
+  static constexpr size_t BLOCK_WORDS = BLOCK_BITS / 64;
+  static constexpr size_t BLOCKS_PER_PAGE = PAGE_SIZE * 8 / BLOCK_BITS;
+
+  /** @return the block a hash maps to */
+  size_t BlockOf(hash_t hash) const { return static_cast<size_t>((hash >> 32) * num_blocks_ >> 32); }
+
+  /** Allocates the header and data pages of a new filter. */
+  void Create(size_t expected_keys);
+
+  /** Loads the bits of a persisted filter. */
+  void Load();
+
+  /** Copies the in-memory block into its data page. */
+  void WriteBlock(size_t block);
+
+  BufferPoolManager *buffer_pool_manager_;
+  page_id_t header_page_id_;
+  size_t num_blocks_;
+  std::unique_ptr<page_id_t[]> data_page_ids_;
+  std::unique_ptr<std::atomic<uint64_t>[]> words_;
+  std::atomic<size_t> num_inserted_{0};
+  std::atomic<uint64_t> probes_{0};
+  std::atomic<uint64_t> negatives_{0};
+  std::atomic<uint64_t> false_positives_{0};
+};
+
+}  // namespace bustub
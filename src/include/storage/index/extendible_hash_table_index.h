@@ -19,6 +19,7 @@
 
 #include "container/hash/extendible_hash_table.h"
 #include "container/hash/hash_function.h"
+#include "storage/index/bloom_filter.h"
 #include "storage/index/index.h"
 
 namespace bustub {
@@ -28,8 +29,13 @@ namespace bustub {
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class ExtendibleHashTableIndex : public Index {
  public:
+  /**
+   * @param filter_capacity expected number of keys to size a Bloom filter for, 0 for no filter
+   * @param filter_page_id header page of a persisted filter to reattach instead of creating one
+   */
   ExtendibleHashTableIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager,
-                           const HashFunction<KeyType> &hash_fn);
+                           const HashFunction<KeyType> &hash_fn, size_t filter_capacity = 0,
+                           page_id_t filter_page_id = INVALID_PAGE_ID);
 
   ~ExtendibleHashTableIndex() override = default;
 
@@ -39,11 +45,15 @@ class ExtendibleHashTableIndex : public Index {
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
 
+  BloomFilter *GetFilter() const override { return filter_.get(); }
+
  protected:
   // comparator for key
   KeyComparator comparator_;
   // container
   ExtendibleHashTable<KeyType, ValueType, KeyComparator> container_;
+  // screens point lookups of absent keys
+  std::unique_ptr<BloomFilter> filter_;
 };
 
 }  // namespace bustub
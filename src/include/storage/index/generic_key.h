@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstring>
+#include <string>
 
+#include "common/macros.h"
+#include "storage/index/key_encoder.h"
 #include "storage/table/tuple.h"
 #include "type/value.h"
 
@@ -25,6 +29,11 @@ namespace bustub {
  * This key type uses an fixed length array to hold data for indexing
  * purposes, the actual size of which is specified and instantiated
  * with a template argument.
+ *
+ * A key is either a raw copy of the key tuple, whose columns are compared
+ * one Value at a time, or normalized: the binary-comparable encoding of
+ * KeyEncoder, zero-padded, which compares with a single memcmp. An index
+ * builds every key the same way, see IndexMetadata::IsNormalized.
  */
 template <size_t KeySize>
 class GenericKey {
@@ -35,6 +44,29 @@ class GenericKey {
     memcpy(data_, tuple.GetData(), tuple.GetLength());
   }
 
+  /**
+   * @return `false`, leaving the key unchanged, if the encoding does not fit in the key size: a cut off encoding
+   * would lose its varchar terminators and could not be decoded
+   */
+  inline bool SetFromNormalizedKey(const Tuple &tuple, const Schema *schema) {
+    std::string encoded = KeyEncoder::Encode(tuple, schema, schema->GetColumnCount());
+    if (encoded.size() > KeySize) {
+      return false;
+    }
+    memset(data_, 0, KeySize);
+    memcpy(data_, encoded.data(), encoded.size());
+    return true;
+  }
+
+  /** @return `false` if a normalized key does not fit in the key size, see SetFromNormalizedKey */
+  inline bool SetFromKey(const Tuple &tuple, const Schema *schema, bool normalized) {
+    if (normalized) {
+      return SetFromNormalizedKey(tuple, schema);
+    }
+    SetFromKey(tuple);
+    return true;
+  }
+
   // NOTE: for test purpose only
   inline void SetFromInteger(int64_t key) {
     memset(data_, 0, KeySize);
@@ -55,6 +87,11 @@ class GenericKey {
     return Value::DeserializeFrom(data_ptr, column_type);
   }
 
+  inline Value ToNormalizedValue(const Schema *schema, uint32_t column_idx) const {
+    const char *data_ptr = data_ + KeyEncoder::EncodedLength(data_, schema, column_idx);
+    return KeyEncoder::DecodeValue(&data_ptr, schema->GetColumn(column_idx).GetType());
+  }
+
   // NOTE: for test purpose only
   // interpret the first 8 bytes as int64_t from data vector
   inline int64_t ToString() const { return *reinterpret_cast<int64_t *>(const_cast<char *>(data_)); }
@@ -77,6 +114,17 @@ template <size_t KeySize>
 class GenericComparator {
  public:
   inline int operator()(const GenericKey<KeySize> &lhs, const GenericKey<KeySize> &rhs) const {
+    if (normalized_) {
+      // only the columns of the key schema count, a search key may be a prefix of the stored entries
+      size_t length = normalized_length_;
+      if (length == 0) {
+        length = std::min(KeyEncoder::EncodedLength(lhs.data_, key_schema_, key_schema_->GetColumnCount()),
+                          KeyEncoder::EncodedLength(rhs.data_, key_schema_, key_schema_->GetColumnCount()));
+      }
+      int cmp = memcmp(lhs.data_, rhs.data_, std::min(length, KeySize));
+      return (cmp > 0) - (cmp < 0);
+    }
+
     uint32_t column_count = key_schema_->GetColumnCount();
 
     for (uint32_t i = 0; i < column_count; i++) {
@@ -94,13 +142,22 @@ class GenericComparator {
     return 0;
   }
 
-  GenericComparator(const GenericComparator &other) : key_schema_{other.key_schema_} {}
+  GenericComparator(const GenericComparator &other)
+      : key_schema_{other.key_schema_},
+        normalized_{other.normalized_},
+        normalized_length_{other.normalized_length_} {}
 
-  // constructor
-  explicit GenericComparator(Schema *key_schema) : key_schema_(key_schema) {}
+  // constructor; a normalized comparator expects keys built by SetFromNormalizedKey
+  explicit GenericComparator(Schema *key_schema, bool normalized = false)
+      : key_schema_(key_schema),
+        normalized_(normalized),
+        normalized_length_(normalized ? KeyEncoder::FixedEncodedLength(key_schema) : 0) {}
 
  private:
   Schema *key_schema_;
+  bool normalized_;
+  // the encoded length of every key when the key schema holds no varchar, 0 otherwise
+  size_t normalized_length_;
 };
 
 }  // namespace bustub
@@ -23,6 +23,7 @@
 
 namespace bustub {
 
+class BloomFilter;
 class Transaction;
 
 /**
@@ -43,14 +44,27 @@ class IndexMetadata {
    * @param table_name The name of the table on which the index is created
    * @param tuple_schema The schema of the indexed key
    * @param key_attrs The mapping from indexed columns to base table columns
+   * @param include_attrs The base table columns carried in every index entry after the key columns, they are
+   * stored so that a scan can be answered from the index alone but are never searched on
+   * @param normalized_keys Whether index keys hold the binary-comparable encoding of KeyEncoder instead of a raw
+   * copy of the key tuple
    */
   IndexMetadata(std::string index_name, std::string table_name, const Schema *tuple_schema,
-                std::vector<uint32_t> key_attrs)
-      : name_(std::move(index_name)), table_name_(std::move(table_name)), key_attrs_(std::move(key_attrs)) {
+                const std::vector<uint32_t> &key_attrs, const std::vector<uint32_t> &include_attrs = {},
+                bool normalized_keys = false)
+      : name_(std::move(index_name)),
+        table_name_(std::move(table_name)),
+        key_attrs_(ConcatAttrs(key_attrs, include_attrs)),
+        index_column_count_(static_cast<uint32_t>(key_attrs.size())),
+        normalized_keys_(normalized_keys) {
     key_schema_ = Schema::CopySchema(tuple_schema, key_attrs_);
+    search_key_schema_ = Schema::CopySchema(tuple_schema, key_attrs);
   }
 
-  ~IndexMetadata() { delete key_schema_; }
+  ~IndexMetadata() {
+    delete key_schema_;
+    delete search_key_schema_;
+  }
 
   /** @return The name of the index */
   inline const std::string &GetName() const { return name_; }
@@ -58,20 +72,34 @@ class IndexMetadata {
   /** @return The name of the table on which the index is created */
   inline const std::string &GetTableName() { return table_name_; }
 
-  /** @return A schema object pointer that represents the indexed key */
+  /** @return A schema object pointer that represents an index entry: the indexed key, then the included columns */
   inline Schema *GetKeySchema() const { return key_schema_; }
 
+  /** @return A schema object pointer that represents the indexed key alone, a prefix of the key schema */
+  inline Schema *GetSearchKeySchema() const { return search_key_schema_; }
+
   /**
    * @return The number of columns inside index key (not in tuple key)
    *
    * NOTE: this must be defined inside the cpp source file because it
    * uses the member of catalog::Schema which is not known here.
    */
-  std::uint32_t GetIndexColumnCount() const { return static_cast<uint32_t>(key_attrs_.size()); }
+  std::uint32_t GetIndexColumnCount() const { return index_column_count_; }
 
-  /** @return The mapping relation between indexed columns and base table columns */
+  /** @return The mapping relation between index entry columns and base table columns */
   inline const std::vector<uint32_t> &GetKeyAttrs() const { return key_attrs_; }
 
+  /** @return The base table columns included in every index entry without being part of the indexed key */
+  std::vector<uint32_t> GetIncludeAttrs() const {
+    return std::vector<uint32_t>(key_attrs_.begin() + index_column_count_, key_attrs_.end());
+  }
+
+  /** @return true if every index entry carries included columns besides the indexed key */
+  inline bool HasIncludeAttrs() const { return key_attrs_.size() > index_column_count_; }
+
+  /** @return true if index keys are normalized, so that they compare with memcmp */
+  inline bool IsNormalized() const { return normalized_keys_; }
+
   /** @return A string representation for debugging */
   std::string ToString() const {
     std::stringstream os;
@@ -86,14 +114,27 @@ class IndexMetadata {
   }
 
  private:
+  static std::vector<uint32_t> ConcatAttrs(const std::vector<uint32_t> &key_attrs,
+                                           const std::vector<uint32_t> &include_attrs) {
+    std::vector<uint32_t> attrs(key_attrs);
+    attrs.insert(attrs.end(), include_attrs.begin(), include_attrs.end());
+    return attrs;
+  }
+
   /** The name of the index */
   std::string name_;
   /** The name of the table on which the index is created */
   std::string table_name_;
   /** The mapping relation between key schema and tuple schema */
   const std::vector<uint32_t> key_attrs_;
-  /** The schema of the indexed key */
+  /** The number of leading key attributes that make up the indexed key */
+  const uint32_t index_column_count_;
+  /** Whether index keys are binary-comparable encodings */
+  const bool normalized_keys_;
+  /** The schema of an index entry */
   Schema *key_schema_;
+  /** The schema of the indexed key */
+  Schema *search_key_schema_;
 };
 
 /////////////////////////////////////////////////////////////////////
@@ -136,9 +177,18 @@ class Index {
   /** @return The index key schema */
   Schema *GetKeySchema() const { return metadata_->GetKeySchema(); }
 
+  /** @return The schema of the indexed key without the included columns */
+  Schema *GetSearchKeySchema() const { return metadata_->GetSearchKeySchema(); }
+
   /** @return The index key attributes */
   const std::vector<uint32_t> &GetKeyAttrs() const { return metadata_->GetKeyAttrs(); }
 
+  /** @return true if the index builds normalized keys */
+  bool IsNormalized() const { return metadata_->IsNormalized(); }
+
+  /** @return the filter screening point lookups of this index, or nullptr if it has none */
+  virtual BloomFilter *GetFilter() const { return nullptr; }
+
   /** @return A string representation for debugging */
   std::string ToString() const {
     std::stringstream os;
@@ -156,6 +206,7 @@ class Index {
    * @param key The index key
    * @param rid The RID associated with the key (unused)
    * @param transaction The transaction context
+   * @throw Exception if the key is normalized and its encoding does not fit in the key size
    */
   virtual void InsertEntry(const Tuple &key, RID rid, Transaction *transaction) = 0;
 
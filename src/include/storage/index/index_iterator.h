@@ -13,17 +13,39 @@
  * For range scan of b+ tree
  */
 #pragma once
+#include <utility>
+#include <vector>
+
 #include "storage/page/b_plus_tree_leaf_page.h"
+#include "storage/page/b_plus_tree_overflow_page.h"
 
 namespace bustub {
 
 #define INDEXITERATOR_TYPE IndexIterator<KeyType, ValueType, KeyComparator>
 
+/**
+ * Walks the leaf level of a B+ tree in key order, or in reverse key order over
+ * the prev-leaf links, and yields one (key, value) pair per value, so a
+ * duplicate key is visited once for each value in its posting list including
+ * the ones in overflow pages. An optional stop key bounds the far end of the
+ * scan: the iterator turns into the end iterator as soon as it passes it, so
+ * callers never see keys outside their range. The iterator keeps its current
+ * leaf page pinned; an iterator without a page is the end iterator.
+ */
 INDEX_TEMPLATE_ARGUMENTS
 class IndexIterator {
+  using LeafPage = BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>;
+
  public:
-  // you may define your own constructor based on your member variables
   IndexIterator();
+  // takes over the pin of page, index is the key slot to start from
+  IndexIterator(BufferPoolManager *buffer_pool_manager, Page *page, int index, bool reverse = false,
+                const KeyComparator *comparator = nullptr, const KeyType *stop_key = nullptr,
+                bool stop_inclusive = true);
+  IndexIterator(const IndexIterator &other);
+  IndexIterator(IndexIterator &&other) noexcept;
+  IndexIterator &operator=(const IndexIterator &other);
+  IndexIterator &operator=(IndexIterator &&other) noexcept;
   ~IndexIterator();
 
   bool IsEnd();
@@ -32,12 +54,34 @@ class IndexIterator {
 
   IndexIterator &operator++();
 
-  bool operator==(const IndexIterator &itr) const { throw std::runtime_error("unimplemented"); }
+  bool operator==(const IndexIterator &itr) const {
+    if (page_ == nullptr || itr.page_ == nullptr) {
+      return page_ == itr.page_;
+    }
+    return page_->GetPageId() == itr.page_->GetPageId() && index_ == itr.index_ && offset_ == itr.offset_;
+  }
 
-  bool operator!=(const IndexIterator &itr) const { throw std::runtime_error("unimplemented"); }
+  bool operator!=(const IndexIterator &itr) const { return !(*this == itr); }
 
  private:
-  // add your own private member variables here
+  // move on to the first leaf slot that holds a key and load its values
+  void Settle();
+  // whether key lies beyond the stop key in scan direction
+  bool PastStop(const KeyType &key) const;
+  void Release();
+
+  BufferPoolManager *buffer_pool_manager_{nullptr};
+  Page *page_{nullptr};
+  int index_{0};
+  int offset_{0};
+  bool reverse_{false};
+  const KeyComparator *comparator_{nullptr};
+  bool has_stop_{false};
+  KeyType stop_key_;
+  bool stop_inclusive_{true};
+  // every value of the key at index_, inline ones first
+  std::vector<ValueType> values_;
+  MappingType item_;
 };
 
 }  // namespace bustub
@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// key_encoder.h
+//
+// Identification: src/include/storage/index/key_encoder.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+
+#include "catalog/schema.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * Encodes keys into binary-comparable byte strings: memcmp order of two encodings is the order of the keys, column
+ * by column, so radix structures and byte-wise comparators need no type dispatch.
+ *
+ *  - integers are written big-endian with the sign bit flipped, booleans as one byte
+ *  - timestamps are written big-endian plus one, so the null timestamp, the largest value, wraps around to zero
+ *  - decimals flip the sign bit of positive and every bit of negative doubles, -0.0 is written as 0.0
+ *  - varchars are written with 0x00 escaped as 0x00 0x01 and terminated by 0x00 0x00, after a 0x01 marker (0x00
+ *    marks a null varchar); the other fixed-width nulls already hold the smallest value of their type
+ *
+ * Every encoding is prefix-free for a given schema, so no key is a prefix of another, and keys zero-padded to a
+ * fixed size still compare correctly with memcmp.
+ */
+class KeyEncoder {
+ public:
+  /** Appends the encoding of val to out. */
+  static void EncodeValue(const Value &val, std::string *out);
+
+  /** @return the encoding of the first column_count columns of key, laid out by schema */
+  static std::string Encode(const Tuple &key, const Schema *schema, uint32_t column_count);
+
+  /** Decodes the value of the given type at *data and advances *data past it. */
+  static Value DecodeValue(const char **data, TypeId type);
+
+  /** @return the number of bytes the first column_count columns of an encoded key take */
+  static size_t EncodedLength(const char *data, const Schema *schema, uint32_t column_count);
+
+  /** @return the encoded size of every key of the schema, or 0 if it holds a varchar and varies by key */
+  static size_t FixedEncodedLength(const Schema *schema);
+
+  /**
+   * @return an upper bound of the encoded size of keys of the schema whose varchars hold no zero bytes and no more
+   * characters than declared; every zero byte takes one more byte, so other keys may exceed it
+   */
+  static size_t MaxEncodedLength(const Schema *schema);
+
+ private:
+  /** @return the encoded size of a fixed-width type, 0 for varchar */
+  static size_t EncodedWidth(TypeId type);
+};
+
+}  // namespace bustub
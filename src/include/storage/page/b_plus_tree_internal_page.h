@@ -44,6 +44,7 @@ class BPlusTreeInternalPage : public BPlusTreePage {
   ValueType ValueAt(int index) const;
 
   ValueType Lookup(const KeyType &key, const KeyComparator &comparator) const;
+  ValueType LookupBefore(const KeyType &key, const KeyComparator &comparator) const;
   void PopulateNewRoot(const ValueType &old_value, const KeyType &new_key, const ValueType &new_value);
   int InsertNodeAfter(const ValueType &old_value, const KeyType &new_key, const ValueType &new_value);
   void Remove(int index);
@@ -61,6 +62,7 @@ class BPlusTreeInternalPage : public BPlusTreePage {
   void CopyNFrom(MappingType *items, int size, BufferPoolManager *buffer_pool_manager);
   void CopyLastFrom(const MappingType &pair, BufferPoolManager *buffer_pool_manager);
   void CopyFirstFrom(const MappingType &pair, BufferPoolManager *buffer_pool_manager);
+  void Adopt(const ValueType &child, BufferPoolManager *buffer_pool_manager);
   MappingType array_[0];
 };
 }  // namespace bustub
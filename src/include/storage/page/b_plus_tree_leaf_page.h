@@ -10,6 +10,7 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -18,29 +19,48 @@
 namespace bustub {
 
 #define B_PLUS_TREE_LEAF_PAGE_TYPE BPlusTreeLeafPage<KeyType, ValueType, KeyComparator>
-#define LEAF_PAGE_HEADER_SIZE 28
-#define LEAF_PAGE_SIZE ((PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / sizeof(MappingType))
+#define LEAF_PAGE_HEADER_SIZE 36
+#define LEAF_PAGE_SIZE ((PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / (sizeof(BPlusTreeLeafEntry<KeyType>) + sizeof(ValueType)))
+// at most a quarter page of values is kept inline per key, the rest spills to overflow pages
+#define LEAF_POSTING_INLINE_MAX (static_cast<int>((PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / 4 / sizeof(ValueType)))
 
 /**
- * Store indexed key and record id(record id = page id combined with slot id,
- * see include/common/rid.h for detailed implementation) together within leaf
- * page. Only support unique key.
+ * One key slot of a leaf page. The inline values of the key occupy
+ * [start_, start_ + count_) of the page's value pool; values beyond
+ * LEAF_POSTING_INLINE_MAX live in a chain of overflow pages.
+ */
+template <typename KeyType>
+struct BPlusTreeLeafEntry {
+  KeyType key_;
+  uint16_t start_;
+  uint16_t count_;
+  page_id_t overflow_page_id_;
+};
+
+/**
+ * Store indexed key and the posting list of its record ids (record id = page
+ * id combined with slot id, see include/common/rid.h for detailed
+ * implementation) within leaf page. Duplicate keys are supported: each key is
+ * stored once, followed by every value inserted under it.
  *
- * Leaf page format (keys are stored in order):
- *  ----------------------------------------------------------------------
- * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
- *  ----------------------------------------------------------------------
+ * Leaf page format (keys are stored in order, the value pool grows from the end
+ * of the page towards the entries and keeps the postings in key order):
+ *  ----------------------------------------------------------------------------
+ * | HEADER | ENTRY(1) | ENTRY(2) | ... | ENTRY(n) | free | RIDS(1) | ... | RIDS(n) |
+ *  ----------------------------------------------------------------------------
  *
- *  Header format (size in byte, 28 bytes in total):
+ *  Header format (size in byte, 36 bytes in total):
  *  ---------------------------------------------------------------------
  * | PageType (4) | LSN (4) | CurrentSize (4) | MaxSize (4) |
  *  ---------------------------------------------------------------------
- *  -----------------------------------------------
- * | ParentPageId (4) | PageId (4) | NextPageId (4)
- *  -----------------------------------------------
+ *  -----------------------------------------------------------------------------------
+ * | ParentPageId (4) | PageId (4) | NextPageId (4) | PrevPageId (4) | ValueCount (4) |
+ *  -----------------------------------------------------------------------------------
  */
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeLeafPage : public BPlusTreePage {
+  using LeafEntry = BPlusTreeLeafEntry<KeyType>;
+
  public:
   // After creating a new leaf page from buffer pool, must call initialize
   // method to set default values
@@ -48,26 +68,49 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   // helper methods
   page_id_t GetNextPageId() const;
   void SetNextPageId(page_id_t next_page_id);
+  page_id_t GetPrevPageId() const;
+  void SetPrevPageId(page_id_t prev_page_id);
   KeyType KeyAt(int index) const;
   int KeyIndex(const KeyType &key, const KeyComparator &comparator) const;
-  const MappingType &GetItem(int index);
+  int UpperKeyIndex(const KeyType &key, const KeyComparator &comparator) const;
+
+  // posting list accessors
+  int ValueCountAt(int index) const;
+  ValueType ValueAt(int index, int offset) const;
+  int ValueIndexAt(int index, const ValueType &value) const;
+  page_id_t OverflowPageIdAt(int index) const;
+  void SetOverflowPageIdAt(int index, page_id_t overflow_page_id);
+
+  // space accounting
+  bool IsFull() const;
+  int EntryBytes(int index) const;
+  int FreeBytes() const;
 
   // insert and delete methods
   int Insert(const KeyType &key, const ValueType &value, const KeyComparator &comparator);
-  bool Lookup(const KeyType &key, ValueType *value, const KeyComparator &comparator) const;
+  bool AppendValue(int index, const ValueType &value);
+  bool Lookup(const KeyType &key, int *index, const KeyComparator &comparator) const;
+  void RemoveValue(int index, int offset);
   int RemoveAndDeleteRecord(const KeyType &key, const KeyComparator &comparator);
 
   // Split and Merge utility methods
+  bool CanAbsorb(const BPlusTreeLeafPage *other) const;
   void MoveHalfTo(BPlusTreeLeafPage *recipient);
   void MoveAllTo(BPlusTreeLeafPage *recipient);
   void MoveFirstToEndOf(BPlusTreeLeafPage *recipient);
   void MoveLastToFrontOf(BPlusTreeLeafPage *recipient);
 
  private:
-  void CopyNFrom(MappingType *items, int size);
-  void CopyLastFrom(const MappingType &item);
-  void CopyFirstFrom(const MappingType &item);
+  ValueType *ValuePool();
+  const ValueType *ValuePool() const;
+  void OpenValueGap(int offset, int count);
+  void CloseValueGap(int offset, int count);
+  void ShiftStarts(int from, int delta);
+  void CopyNFrom(const BPlusTreeLeafPage *src, int from, int size, int at);
+  void RemoveN(int from, int size);
   page_id_t next_page_id_;
-  MappingType array_[0];
+  page_id_t prev_page_id_;
+  int value_count_;
+  LeafEntry array_[0];
 };
 }  // namespace bustub
@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         CMU-DB Project (15-445/645)
+//                         ***DO NO SHARE PUBLICLY***
+//
+// Identification: src/include/page/b_plus_tree_overflow_page.h
+//
+// Copyright (c) 2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "common/rid.h"
+
+namespace bustub {
+
+#define B_PLUS_TREE_OVERFLOW_PAGE_TYPE BPlusTreeOverflowPage<ValueType>
+#define OVERFLOW_PAGE_HEADER_SIZE 16
+#define OVERFLOW_PAGE_SIZE ((PAGE_SIZE - OVERFLOW_PAGE_HEADER_SIZE) / sizeof(ValueType))
+
+/**
+ * Holds the values of a hot key that no longer fit in the key's inline posting
+ * list on its leaf page. Overflow pages of one key form a singly linked chain
+ * that starts at the leaf entry; values inside a page are unordered.
+ *
+ * Overflow page format:
+ *  ---------------------------------------------------------------------------
+ * | HEADER | VALUE(1) | VALUE(2) | ... | VALUE(n)
+ *  ---------------------------------------------------------------------------
+ *
+ *  Header format (size in byte, 16 bytes in total):
+ *  ---------------------------------------------------------------------
+ * | PageId (4) | LSN (4) | NextPageId (4) | CurrentSize (4) |
+ *  ---------------------------------------------------------------------
+ */
+template <typename ValueType>
+class BPlusTreeOverflowPage {
+ public:
+  // must call initialize method after "create" a new overflow page
+  void Init(page_id_t page_id, page_id_t next_page_id = INVALID_PAGE_ID);
+
+  page_id_t GetPageId() const { return page_id_; }
+  page_id_t GetNextPageId() const { return next_page_id_; }
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+  int GetSize() const { return size_; }
+  bool IsFull() const { return size_ >= static_cast<int>(OVERFLOW_PAGE_SIZE); }
+  ValueType ValueAt(int index) const { return array_[index]; }
+
+  /** @return index of the value in this page, or -1 if it is not stored here */
+  int ValueIndex(const ValueType &value) const;
+
+  /** @return false if the page is full */
+  bool Append(const ValueType &value);
+
+  /** Remove the value at index by moving the last value into its slot */
+  void RemoveAt(int index);
+
+  /** Remove and return the last value of this page */
+  ValueType PopBack();
+
+  /** Append every value of the chain starting at head_page_id to result */
+  static void ScanChain(BufferPoolManager *buffer_pool_manager, page_id_t head_page_id, std::vector<ValueType> *result);
+
+ private:
+  page_id_t page_id_;
+  lsn_t lsn_;
+  page_id_t next_page_id_;
+  int size_;
+  ValueType array_[0];
+};
+
+}  // namespace bustub
@@ -31,8 +31,14 @@ namespace bustub {
  *
  *  Here '+' means concatenation.
  *  The above format omits the space required for the occupied_ and
- *  readable_ arrays. More information is in storage/page/hash_table_page_defs.h.
+ *  readable_ arrays and the tags_ array holding a one byte fingerprint of the
+ *  hash of every slot's key. Lookups compare the fingerprints of 16 slots at
+ *  once and only call the comparator on slots whose fingerprint matches.
+ *  More information is in storage/page/hash_table_page_defs.h.
  *
+ *  Fingerprints are taken from the hash the caller computed for the key, see
+ *  Fingerprint(). A caller that never passes one leaves every tag at 0, which
+ *  still works but filters nothing.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class HashTableBucketPage {
@@ -40,12 +46,19 @@ class HashTableBucketPage {
   // Delete all constructor / destructor to ensure memory safety
   HashTableBucketPage() = delete;
 
+  /**
+   * @param hash the hash of a key
+   * @return the fingerprint stored for a key with the given hash
+   */
+  static uint8_t Fingerprint(uint32_t hash) { return static_cast<uint8_t>(hash >> 24); }
+
   /**
    * Scan the bucket and collect values that have the matching key
    *
+   * @param tag the fingerprint of the key
    * @return true if at least one key matched
    */
-  bool GetValue(KeyType key, KeyComparator cmp, std::vector<ValueType> *result);
+  bool GetValue(KeyType key, KeyComparator cmp, std::vector<ValueType> *result, uint8_t tag = 0);
 
   /**
    * Attempts to insert a key and value in the bucket.  Uses the occupied_
@@ -54,16 +67,18 @@ class HashTableBucketPage {
    *
    * @param key key to insert
    * @param value value to insert
+   * @param tag the fingerprint of the key
    * @return true if inserted, false if duplicate KV pair or bucket is full
    */
-  bool Insert(KeyType key, ValueType value, KeyComparator cmp);
+  bool Insert(KeyType key, ValueType value, KeyComparator cmp, uint8_t tag = 0);
 
   /**
    * Removes a key and value.
    *
+   * @param tag the fingerprint of the key
    * @return true if removed, false if not found
    */
-  bool Remove(KeyType key, ValueType value, KeyComparator cmp);
+  bool Remove(KeyType key, ValueType value, KeyComparator cmp, uint8_t tag = 0);
 
   /**
    * Gets the key at an index in the bucket.
@@ -81,6 +96,14 @@ class HashTableBucketPage {
    */
   ValueType ValueAt(uint32_t bucket_idx) const;
 
+  /**
+   * Gets the fingerprint at an index in the bucket.
+   *
+   * @param bucket_idx the index in the bucket to get the fingerprint at
+   * @return fingerprint at index bucket_idx of the bucket
+   */
+  uint8_t TagAt(uint32_t bucket_idx) const;
+
   /**
    * Remove the KV pair at bucket_idx
    */
@@ -139,10 +162,31 @@ class HashTableBucketPage {
   void PrintBucket();
 
  private:
+  /**
+   * @return the number of slots that were ever taken, all of them lie in front of the first unoccupied slot
+   */
+  uint32_t OccupiedCount() const;
+
+  /**
+   * Compare the fingerprints of BUCKET_TAG_LANES slots starting at start against tag.
+   *
+   * @param start first slot to compare, a multiple of BUCKET_TAG_LANES
+   * @param tag the fingerprint to look for
+   * @return a mask with bit i set if slot start + i is readable and carries the fingerprint
+   */
+  uint32_t MatchTags(uint32_t start, uint8_t tag) const;
+
+  static_assert(2 * ((BUCKET_ARRAY_SIZE - 1) / 8 + 1) + BUCKET_TAG_ARRAY_SIZE + 8 +
+                        BUCKET_ARRAY_SIZE * sizeof(MappingType) <=
+                    PAGE_SIZE,
+                "bucket page does not fit into a page");
+
   // For more on BUCKET_ARRAY_SIZE see storage/page/hash_table_page_defs.h
   char occupied_[(BUCKET_ARRAY_SIZE - 1) / 8 + 1];
   // 0 if tombstone/brand new (never occupied), 1 otherwise.
   char readable_[(BUCKET_ARRAY_SIZE - 1) / 8 + 1];
+  // One byte fingerprint per slot, padded to whole SIMD lanes.
+  uint8_t tags_[BUCKET_TAG_ARRAY_SIZE];
   // Do not add any members below array_, as they will overlap.
   MappingType array_[0];
 };
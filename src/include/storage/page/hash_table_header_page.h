@@ -26,10 +26,13 @@ namespace bustub {
  *
  * Header Page for linear probing hash table.
  *
- * Header format (size in byte, 16 bytes in total):
+ * Header format (size in byte, 20 bytes in total):
  * -------------------------------------------------------------
- * | LSN (4) | Size (4) | PageId(4) | NextBlockIndex(4)
+ * | LSN (4) | Size (4) | PageId(4) | NextBlockIndex(4) | NextPageId(4)
  * -------------------------------------------------------------
+ *
+ * A table with more blocks than fit in one header page lists the rest in a chain of header pages, each one linked
+ * from the previous one through NextPageId. Only the size of the first header page of a chain is meaningful.
  */
 class HashTableHeaderPage {
  public:
@@ -57,6 +60,18 @@ class HashTableHeaderPage {
    */
   void SetPageId(page_id_t page_id);
 
+  /**
+   * @return the page ID of the header page listing the blocks after the ones of this page, INVALID_PAGE_ID if none
+   */
+  page_id_t GetNextPageId() const;
+
+  /**
+   * Sets the page ID of the header page listing the blocks after the ones of this page
+   *
+   * @param next_page_id the page id for the next page id field to be set to
+   */
+  void SetNextPageId(page_id_t next_page_id);
+
   /**
    * @return the lsn of this page
    */
@@ -89,12 +104,18 @@ class HashTableHeaderPage {
    */
   size_t NumBlocks();
 
+  /**
+   * @return the number of block page_ids that fit into the header page
+   */
+  static size_t MaxBlocks();
+
  private:
-  __attribute__((unused)) lsn_t lsn_;
-  __attribute__((unused)) size_t size_;
-  __attribute__((unused)) page_id_t page_id_;
-  __attribute__((unused)) size_t next_ind_;
-  __attribute__((unused)) page_id_t block_page_ids_[0];
+  lsn_t lsn_;
+  size_t size_;
+  page_id_t page_id_;
+  size_t next_ind_;
+  page_id_t next_page_id_;
+  page_id_t block_page_ids_[0];
 };
 
 }  // namespace bustub
@@ -37,8 +37,16 @@
 /**
  * BUCKET_ARRAY_SIZE is the number of (key, value) pairs that can be stored in an extendible hashing bucket page.
  * It is an approximate calculation based on the size of MappingType (which is a std::pair of KeyType and ValueType).
- * For each key/value pair, we need two additional bits for occupied_ and readable_. 4 * (PAGE_SIZE - 4) / (4 * sizeof
- * (MappingType) + 1) = (PAGE_SIZE - 4)/(sizeof (MappingType) + 0.25) because 0.25 bytes = 2 bits is the space required
- * to maintain the occupied and readable flags for a key value pair.
+ * For each key/value pair, we need two additional bits for occupied_ and readable_ and one byte for its fingerprint
+ * in tags_. 4 * (PAGE_SIZE - 32) / (4 * sizeof (MappingType) + 5) = (PAGE_SIZE - 32)/(sizeof (MappingType) + 1.25)
+ * because 1.25 bytes = 10 bits is the space required to maintain the flags and the fingerprint of a key value pair.
+ * The 32 bytes held back cover tags_ being rounded up to whole SIMD lanes and the alignment of the pairs.
  */
-#define BUCKET_ARRAY_SIZE (4 * PAGE_SIZE / (4 * sizeof(MappingType) + 1))
+#define BUCKET_ARRAY_SIZE (4 * (PAGE_SIZE - 32) / (4 * sizeof(MappingType) + 5))
+
+/**
+ * Fingerprints are compared BUCKET_TAG_LANES at a time, so the tag array of a bucket page is padded to a multiple
+ * of it.
+ */
+#define BUCKET_TAG_LANES 16
+#define BUCKET_TAG_ARRAY_SIZE ((BUCKET_ARRAY_SIZE + BUCKET_TAG_LANES - 1) / BUCKET_TAG_LANES * BUCKET_TAG_LANES)
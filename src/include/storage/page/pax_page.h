@@ -0,0 +1,322 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_page.h
+//
+// Identification: src/include/storage/page/pax_page.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/rid.h"
+#include "concurrency/lock_manager.h"
+#include "recovery/log_manager.h"
+#include "storage/page/page.h"
+#include "storage/page/table_page.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/** How the values of a column are stored in the encoded rows of a PaxPage */
+enum class ColumnEncoding : uint8_t {
+  /** As they are inlined in a tuple; a VARCHAR as the offset of its length-prefixed bytes */
+  PLAIN,
+  /** Integers bit-packed as their distance to the smallest value of the page, plus one; 0 stands for null */
+  FRAME_OF_REFERENCE,
+  /** Runs of equal consecutive values, each stored once with the row it ends before */
+  RUN_LENGTH,
+  /** VARCHARs as bit-packed codes into a dictionary of the distinct values of the page */
+  DICTIONARY,
+};
+
+/**
+ * PAX (Partition Attributes Across) page format: the tuples of a page are split into one minipage per column, so
+ * that a scan reads the columns it needs without touching the bytes of the others.
+ *  -------------------------------------------------------------------------------------------------------------
+ *  | HEADER | COLUMNS | ROW STATUS | SEGMENTS | MINIPAGE 1 | ... | MINIPAGE n | ... FREE SPACE ... | VARLEN HEAP |
+ *  -------------------------------------------------------------------------------------------------------------
+ *                                                                             ^
+ *                                                                             free space pointer
+ *
+ *  Header format (size in bytes):
+ *  ----------------------------------------------------------------------------
+ *  | PageId (4)| LSN (4)| PrevPageId (4)| NextPageId (4)| FreeSpacePointer(4) |
+ *  ----------------------------------------------------------------------------
+ *  ------------------------------------------------------------------------------------------------------
+ *  | TupleCount (4) | Capacity (4) | TupleLength (4) | ColumnCount (4) | EncodedCount (4) | IsFull (4) |
+ *  ------------------------------------------------------------------------------------------------------
+ *  Column format (size in bytes), one per column:
+ *  -----------------------------------------------------------------------------------------------
+ *  | MinipageOffset (2) | Width (2) | TupleOffset (2) | SegmentOffset (2) | Type (1) | Encoding (1) |
+ *  -----------------------------------------------------------------------------------------------
+ *
+ * The header starts like the one of a TablePage, so the pages of a table are chained and walked the same way
+ * whatever their format. The page describes its own columns, and holds up to Capacity rows, each with a status
+ * byte: free, live or deleted.
+ *
+ * The first EncodedCount rows are compressed, one segment per column in the encoding that takes the least space
+ * for the values of the page. The rows after them are the tail, which takes the inserts: each has a Width-byte slot
+ * in every minipage holding the value as it is inlined in a tuple, and the slot of a VARCHAR holds the offset of its
+ * length-prefixed bytes in the variable-length heap, which grows down from the end of the page. When the tail runs
+ * out of rows or space, every row of the page is encoded again and a new tail is laid out in the space saved. The
+ * page is full once that leaves no room for a single row.
+ */
+class PaxPage : public Page {
+ public:
+  /**
+   * Initialize the PaxPage header and lay out the minipages of a schema.
+   * @param page_id the page ID of this page
+   * @param page_size the size of this page
+   * @param prev_page_id the previous table page ID
+   * @param schema the schema of the tuples of the table
+   */
+  void Init(page_id_t page_id, uint32_t page_size, page_id_t prev_page_id, const Schema &schema);
+
+  /** @return the page ID of this table page */
+  page_id_t GetTablePageId() { return *reinterpret_cast<page_id_t *>(GetData()); }
+
+  /** @return the page ID of the next table page */
+  page_id_t GetNextPageId() { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_NEXT_PAGE_ID); }
+
+  /** Set the page id of the next page in the table. */
+  void SetNextPageId(page_id_t next_page_id) {
+    memcpy(GetData() + OFFSET_NEXT_PAGE_ID, &next_page_id, sizeof(page_id_t));
+  }
+
+  /**
+   * Insert a tuple into the tail of the page, encoding the page again if the tail is out of room.
+   * @param tuple tuple to insert
+   * @param[out] rid rid of the inserted tuple
+   * @param txn transaction performing the insert
+   * @param lock_manager the lock manager
+   * @param log_manager the log manager
+   * @return true if the insert is successful (i.e. there is a free row and enough space)
+   */
+  bool InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn, LockManager *lock_manager, LogManager *log_manager);
+
+  /** Mark a tuple as deleted, see TablePage::MarkDelete. */
+  bool MarkDelete(const RID &rid, Transaction *txn, LockManager *lock_manager, LogManager *log_manager);
+
+  /** Update a tuple, see TablePage::UpdateTuple. An encoded tuple is updated by encoding the page again. */
+  bool UpdateTuple(const Tuple &new_tuple, Tuple *old_tuple, const RID &rid, Transaction *txn,
+                   LockManager *lock_manager, LogManager *log_manager);
+
+  /**
+   * To be called on commit or abort. Free the row of a deleted tuple or of a rolled back insert; the space of an
+   * encoded row is only given back when the page is encoded again.
+   */
+  void ApplyDelete(const RID &rid, Transaction *txn, LogManager *log_manager);
+
+  /** To be called on abort. Rollback a delete, i.e. this reverses a MarkDelete. */
+  void RollbackDelete(const RID &rid, Transaction *txn, LogManager *log_manager);
+
+  /**
+   * Read a tuple from the page, put back together from the minipages.
+   * @param rid rid of the tuple to read
+   * @param[out] tuple the tuple that was read
+   * @param txn transaction performing the read
+   * @param lock_manager the lock manager
+   * @return true if the read is successful (i.e. the tuple exists)
+   */
+  bool GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager);
+
+  /**
+   * Read every tuple of this page that passes a filter, see TablePage::ScanTuples. The filter runs on each tuple
+   * once it is put back together.
+   */
+  void ScanTuples(const TupleFilter &filter, Transaction *txn, LockManager *lock_manager, std::vector<Tuple> *tuples);
+
+  /**
+   * @param[out] first_rid the RID of the first tuple in this page
+   * @return true if the first tuple exists, false otherwise
+   */
+  bool GetFirstTupleRid(RID *first_rid);
+
+  /**
+   * @param cur_rid the RID of the current tuple
+   * @param[out] next_rid the RID of the tuple following the current tuple
+   * @return true if the next tuple exists, false otherwise
+   */
+  bool GetNextTupleRid(const RID &cur_rid, RID *next_rid);
+
+  /** @return the number of rows in use, live or not */
+  uint32_t GetTupleCount() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_TUPLE_COUNT); }
+
+  /** @return the number of encoded rows, which come first */
+  uint32_t GetEncodedCount() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_ENCODED_COUNT); }
+
+  /** @return true if row slot holds a tuple that is not deleted */
+  bool IsLive(uint32_t slot) { return GetStatus(slot) == ROW_LIVE; }
+
+  /** @return the encoding of the encoded rows of a column */
+  ColumnEncoding GetEncoding(uint32_t column_idx) {
+    return static_cast<ColumnEncoding>(GetColumnByte(column_idx, OFFSET_COLUMN_ENCODING));
+  }
+
+  /**
+   * @return the value of a column in a row, laid out as Value::SerializeTo writes it; a value that has to be decoded
+   * is written into buffer, which holds 8 bytes
+   */
+  const char *GetValueData(uint32_t column_idx, uint32_t slot, char *buffer) {
+    return IsInlined(column_idx) ? GetInlined(column_idx, slot, buffer) : GetVarlen(column_idx, slot);
+  }
+
+  /**
+   * Keep in slots the rows whose value of an integer column lies within [lo, hi], or outside of it if !inside. Null
+   * values never pass. The values are not decoded: a frame-of-reference column compares its codes with the bounds
+   * turned into codes, and a run-length column tests every run once.
+   * @param column_idx the column
+   * @param lo the lower bound
+   * @param hi the upper bound
+   * @param inside true to keep the values within the bounds, false to keep the others
+   * @param slots the rows to filter, in increasing order
+   */
+  void FilterIntegers(uint32_t column_idx, int64_t lo, int64_t hi, bool inside, std::vector<uint32_t> *slots);
+
+  /**
+   * Keep in slots the rows whose value of a VARCHAR column equals value, or differs from it if !equal. Null values
+   * never pass. A dictionary column looks value up once and compares the codes of the rows with its code.
+   */
+  void FilterStrings(uint32_t column_idx, const std::string &value, bool equal, std::vector<uint32_t> *slots);
+
+ private:
+  static_assert(sizeof(page_id_t) == 4);
+
+  static constexpr size_t OFFSET_PREV_PAGE_ID = 8;
+  static constexpr size_t OFFSET_NEXT_PAGE_ID = 12;
+  static constexpr size_t OFFSET_FREE_SPACE = 16;
+  static constexpr size_t OFFSET_TUPLE_COUNT = 20;
+  static constexpr size_t OFFSET_CAPACITY = 24;
+  static constexpr size_t OFFSET_TUPLE_LENGTH = 28;
+  static constexpr size_t OFFSET_COLUMN_COUNT = 32;
+  static constexpr size_t OFFSET_ENCODED_COUNT = 36;
+  static constexpr size_t OFFSET_IS_FULL = 40;
+  static constexpr size_t SIZE_PAX_PAGE_HEADER = 44;
+
+  static constexpr size_t SIZE_COLUMN = 10;
+  static constexpr size_t OFFSET_COLUMN_MINIPAGE = 0;
+  static constexpr size_t OFFSET_COLUMN_WIDTH = 2;
+  static constexpr size_t OFFSET_COLUMN_TUPLE_OFFSET = 4;
+  static constexpr size_t OFFSET_COLUMN_SEGMENT = 6;
+  static constexpr size_t OFFSET_COLUMN_TYPE = 8;
+  static constexpr size_t OFFSET_COLUMN_ENCODING = 9;
+
+  static constexpr uint8_t ROW_FREE = 0;
+  static constexpr uint8_t ROW_LIVE = 1;
+  static constexpr uint8_t ROW_DELETED = 2;
+
+  uint32_t GetHeaderField(size_t offset) { return *reinterpret_cast<uint32_t *>(GetData() + offset); }
+
+  void SetHeaderField(size_t offset, uint32_t value) { memcpy(GetData() + offset, &value, sizeof(uint32_t)); }
+
+  uint32_t GetFreeSpacePointer() { return GetHeaderField(OFFSET_FREE_SPACE); }
+
+  void SetFreeSpacePointer(uint32_t free_space_pointer) { SetHeaderField(OFFSET_FREE_SPACE, free_space_pointer); }
+
+  void SetTupleCount(uint32_t tuple_count) { SetHeaderField(OFFSET_TUPLE_COUNT, tuple_count); }
+
+  uint32_t GetCapacity() { return GetHeaderField(OFFSET_CAPACITY); }
+
+  /** @return the length of the inlined part of a tuple */
+  uint32_t GetTupleLength() { return GetHeaderField(OFFSET_TUPLE_LENGTH); }
+
+  uint32_t GetColumnCount() { return GetHeaderField(OFFSET_COLUMN_COUNT); }
+
+  /** @return true if the last time the page was encoded left no room for the tuple being inserted */
+  bool IsFull() { return GetHeaderField(OFFSET_IS_FULL) != 0; }
+
+  void SetFull(bool is_full) { SetHeaderField(OFFSET_IS_FULL, static_cast<uint32_t>(is_full)); }
+
+  /** @return the 2-byte field at offset in the description of a column */
+  uint16_t GetColumnField(uint32_t column_idx, size_t offset) {
+    return *reinterpret_cast<uint16_t *>(GetData() + SIZE_PAX_PAGE_HEADER + SIZE_COLUMN * column_idx + offset);
+  }
+
+  /** @return the 1-byte field at offset in the description of a column */
+  uint8_t GetColumnByte(uint32_t column_idx, size_t offset) {
+    return *reinterpret_cast<uint8_t *>(GetData() + SIZE_PAX_PAGE_HEADER + SIZE_COLUMN * column_idx + offset);
+  }
+
+  uint16_t GetWidth(uint32_t column_idx) { return GetColumnField(column_idx, OFFSET_COLUMN_WIDTH); }
+  uint16_t GetTupleOffset(uint32_t column_idx) { return GetColumnField(column_idx, OFFSET_COLUMN_TUPLE_OFFSET); }
+  TypeId GetType(uint32_t column_idx) { return static_cast<TypeId>(GetColumnByte(column_idx, OFFSET_COLUMN_TYPE)); }
+  bool IsInlined(uint32_t column_idx) { return GetType(column_idx) != TypeId::VARCHAR; }
+
+  /** @return the first byte of the segment of a column */
+  const char *GetSegment(uint32_t column_idx) {
+    return GetData() + GetColumnField(column_idx, OFFSET_COLUMN_SEGMENT);
+  }
+
+  /** @return the offset of the row status bytes */
+  uint32_t GetStatusOffset() { return SIZE_PAX_PAGE_HEADER + SIZE_COLUMN * GetColumnCount(); }
+
+  uint8_t GetStatus(uint32_t slot) { return *reinterpret_cast<uint8_t *>(GetData() + GetStatusOffset() + slot); }
+
+  void SetStatus(uint32_t slot, uint8_t status) {
+    *reinterpret_cast<uint8_t *>(GetData() + GetStatusOffset() + slot) = status;
+  }
+
+  /** @return the slot of tail row slot in the minipage of a column */
+  char *GetSlot(uint32_t column_idx, uint32_t slot) {
+    return GetData() + GetColumnField(column_idx, OFFSET_COLUMN_MINIPAGE) +
+           GetWidth(column_idx) * (slot - GetEncodedCount());
+  }
+
+  /** @return the offset of the end of the last minipage */
+  uint32_t GetMinipagesEnd();
+
+  /** @return the code of an encoded row in a frame-of-reference or dictionary segment */
+  uint64_t GetCode(uint32_t column_idx, uint32_t slot);
+
+  /** @return the run of a run-length segment that holds an encoded row */
+  uint32_t GetRun(uint32_t column_idx, uint32_t slot);
+
+  /**
+   * @return the bytes of the value of an inlined column in a row, as they are inlined in a tuple; a
+   * frame-of-reference value is decoded into buffer, which holds 8 bytes
+   */
+  const char *GetInlined(uint32_t column_idx, uint32_t slot, char *buffer);
+
+  /** @return the length-prefixed bytes of the value of a VARCHAR column in a row */
+  const char *GetVarlen(uint32_t column_idx, uint32_t slot);
+
+  /** @return the number of bytes the VARCHARs of a tuple take in the variable-length heap */
+  uint32_t GetVarlenSize(const Tuple &tuple);
+
+  /** Put the tuple in row slot back together into tuple. */
+  void ReadTuple(uint32_t slot, Tuple *tuple);
+
+  /** Split a tuple into tail row slot, its VARCHARs claimed from the free space, which must be large enough. */
+  void WriteTuple(const Tuple &tuple, uint32_t slot);
+
+  /** Give the variable-length heap bytes of tail row slot back to the free space. */
+  void FreeVarlen(uint32_t slot);
+
+  /**
+   * Lay the page out again with the given tuples as its encoded rows, and an empty tail in the space left.
+   * @param page_size the size of this page
+   * @param tuples one tuple per row in use, ignored for free rows
+   * @return false, leaving the page untouched, if the encoded rows do not fit in the page
+   */
+  bool Rebuild(uint32_t page_size, const std::vector<Tuple> &tuples);
+
+  /** @return the first free tail row, or the capacity if there is none */
+  uint32_t FindTailRow();
+
+  /** @return the number of bytes left between the minipages and the variable-length heap */
+  uint32_t GetFreeSpaceRemaining() { return GetFreeSpacePointer() - GetMinipagesEnd(); }
+
+  /** Put every row in use back together, into tuples indexed by row. */
+  void ReadRows(std::vector<Tuple> *tuples);
+};
+
+}  // namespace bustub
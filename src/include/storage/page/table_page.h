@@ -13,6 +13,8 @@
 #pragma once
 
 #include <cstring>
+#include <functional>
+#include <vector>
 
 #include "common/rid.h"
 #include "concurrency/lock_manager.h"
@@ -24,6 +26,9 @@ static constexpr uint64_t DELETE_MASK = (1U << (8 * sizeof(uint32_t) - 1));
 
 namespace bustub {
 
+/** A test on the bytes of a tuple, laid out by the schema of its table */
+using TupleFilter = std::function<bool(const char *data)>;
+
 /**
  * Slotted page format:
  *  ---------------------------------------------------------
@@ -122,6 +127,40 @@ class TablePage : public Page {
    */
   bool GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager);
 
+  /**
+   * Read every tuple of this page that passes a filter. The filter is run on the bytes of each tuple in place, once
+   * the tuple is locked so that it sees committed data, and only the tuples that pass are copied out.
+   * @param filter the filter, an empty one keeps every tuple
+   * @param txn transaction performing the read
+   * @param lock_manager the lock manager
+   * @param[out] tuples the tuples that passed are appended, with their RID
+   */
+  void ScanTuples(const TupleFilter &filter, Transaction *txn, LockManager *lock_manager, std::vector<Tuple> *tuples);
+
+  /**
+   * Get a view of a tuple in place, locked as GetTuple locks it. The view is valid while the page is pinned and
+   * latched.
+   * @param rid rid of the tuple to view
+   * @param[out] view the view of the tuple
+   * @param txn transaction performing the read
+   * @param lock_manager the lock manager
+   * @return true if the tuple exists
+   */
+  bool GetTupleView(const RID &rid, TupleView *view, Transaction *txn, LockManager *lock_manager);
+
+  /**
+   * Get views of the tuples of this page that pass a filter, in place, see ScanTuples and GetTupleView.
+   * @param first_slot the slot to start at
+   * @param max_views the most views to collect
+   * @param filter the filter, an empty one keeps every tuple
+   * @param txn transaction performing the read
+   * @param lock_manager the lock manager
+   * @param[out] views the views of the tuples that passed are appended
+   * @return the slot to resume at, after the last one looked at; 0 once every slot has been looked at
+   */
+  uint32_t ScanTupleViews(uint32_t first_slot, size_t max_views, const TupleFilter &filter, Transaction *txn,
+                          LockManager *lock_manager, std::vector<TupleView> *views);
+
   /** @return the rid of the first tuple in this page */
 
   /**
@@ -1,15 +1,14 @@
 #pragma once
 
+#include <cstring>
+
 #include "storage/page/page.h"
 #include "storage/table/tmp_tuple.h"
 #include "storage/table/tuple.h"
+#include "storage/table/tuple_view.h"
 
 namespace bustub {
 
-// To pass the test cases for this class, you must follow the existing TmpTuplePage format and implement the
-// existing functions exactly as they are! It may be helpful to look at TablePage.
-// Remember that this task is optional, you get full credit if you finish the next task.
-
 /**
  * TmpTuplePage format:
  *
@@ -17,17 +16,72 @@ namespace bustub {
  * | PageId (4) | LSN (4) | FreeSpace (4) | (free space) | TupleSize2 | TupleData2 | TupleSize1 | TupleData1 |
  *
  * We choose this format because DeserializeExpression expects to read Size followed by Data.
+ * FreeSpace is the offset of the last tuple inserted, tuples are read back from there up to the end of the page.
  */
 class TmpTuplePage : public Page {
  public:
-  void Init(page_id_t page_id, uint32_t page_size) {}
+  void Init(page_id_t page_id, uint32_t page_size) {
+    memcpy(GetData() + OFFSET_PAGE_START, &page_id, sizeof(page_id_t));
+    SetFreeSpacePointer(page_size);
+  }
+
+  page_id_t GetTablePageId() { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_PAGE_START); }
+
+  /**
+   * Insert a tuple in the page.
+   * @param tuple the tuple to insert
+   * @param[out] out where the tuple was inserted
+   * @return false if the page has no room for it
+   */
+  bool Insert(const Tuple &tuple, TmpTuple *out) {
+    uint32_t size = sizeof(uint32_t) + tuple.GetLength();
+    if (GetFreeSpacePointer() < SIZE_TMP_PAGE_HEADER + size) {
+      return false;
+    }
+    uint32_t offset = GetFreeSpacePointer() - size;
+    tuple.SerializeTo(GetData() + offset);
+    SetFreeSpacePointer(offset);
+    *out = TmpTuple(GetTablePageId(), offset);
+    return true;
+  }
 
-  page_id_t GetTablePageId() { return INVALID_PAGE_ID; }
+  /**
+   * Read back a tuple.
+   * @param offset the offset of the tuple in the page
+   * @param[out] tuple the tuple
+   * @return the offset of the tuple inserted before it
+   */
+  uint32_t Get(uint32_t offset, Tuple *tuple) {
+    tuple->DeserializeFrom(GetData() + offset);
+    return offset + sizeof(uint32_t) + tuple->GetLength();
+  }
 
-  bool Insert(const Tuple &tuple, TmpTuple *out) { return false; }
+  /**
+   * View a tuple in place, valid while the page is pinned.
+   * @param offset the offset of the tuple in the page
+   * @param[out] view the view of the tuple
+   * @return the offset of the tuple inserted before it
+   */
+  uint32_t GetView(uint32_t offset, TupleView *view) {
+    uint32_t size = *reinterpret_cast<uint32_t *>(GetData() + offset);
+    *view = TupleView(GetData() + offset + sizeof(uint32_t), size);
+    return offset + sizeof(uint32_t) + size;
+  }
+
+  /** @return the offset of the last tuple inserted, the page size if it is empty */
+  uint32_t GetFreeSpacePointer() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
+
+  /** @return the length of the largest tuple that fits in an empty page */
+  static constexpr uint32_t MaxTupleSize() { return PAGE_SIZE - SIZE_TMP_PAGE_HEADER - sizeof(uint32_t); }
 
  private:
+  void SetFreeSpacePointer(uint32_t free_space_pointer) {
+    memcpy(GetData() + OFFSET_FREE_SPACE, &free_space_pointer, sizeof(uint32_t));
+  }
+
   static_assert(sizeof(page_id_t) == 4);
+  static constexpr size_t SIZE_TMP_PAGE_HEADER = 12;
+  static constexpr size_t OFFSET_FREE_SPACE = 8;
 };
 
 }  // namespace bustub
@@ -12,17 +12,32 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include "buffer/buffer_pool_manager.h"
+#include "catalog/schema.h"
 #include "recovery/log_manager.h"
+#include "storage/page/pax_page.h"
 #include "storage/page/table_page.h"
 #include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
+#include "storage/table/zone_map.h"
 
 namespace bustub {
 
+/** How the pages of a table lay out their tuples */
+enum class TableLayout {
+  /** Slotted TablePages, one tuple after the other */
+  ROW,
+  /** PaxPages, one minipage per column */
+  PAX,
+};
+
 /**
  * TableHeap represents a physical table on disk.
- * This is just a doubly-linked list of pages.
+ * This is just a doubly-linked list of pages, all TablePages or all PaxPages as the layout of the table says.
  */
 class TableHeap {
   friend class TableIterator;
@@ -50,6 +65,18 @@ class TableHeap {
   TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
             Transaction *txn);
 
+  /**
+   * Create a table heap of a given layout with a transaction. (create table)
+   * @param buffer_pool_manager the buffer pool manager
+   * @param lock_manager the lock manager
+   * @param log_manager the log manager
+   * @param txn the creating transaction
+   * @param schema the schema of the tuples of the table, which PaxPages are laid out by
+   * @param layout the layout of the pages
+   */
+  TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
+            Transaction *txn, const Schema &schema, TableLayout layout);
+
   /**
    * Insert a tuple into the table. If the tuple is too large (>= page_size), return false.
    * @param tuple tuple to insert
@@ -99,9 +126,72 @@ class TableHeap {
    */
   bool GetTuple(const RID &rid, Tuple *tuple, Transaction *txn);
 
+  /**
+   * Read the tuples of one page of this table that pass a filter, run on their bytes while the page is pinned.
+   * @param page_id the page to read
+   * @param filter the filter, an empty one keeps every tuple
+   * @param[out] tuples the tuples that passed are appended, with their RID
+   * @param txn transaction performing the read
+   * @return the id of the page that follows, INVALID_PAGE_ID after the last one
+   */
+  page_id_t ScanPage(page_id_t page_id, const TupleFilter &filter, std::vector<Tuple> *tuples, Transaction *txn);
+
+  /**
+   * Hand views of the tuples of one page of a row table that pass a filter to a reader, while the page is pinned
+   * and latched, so that it reads them in place instead of copying them out.
+   * @param page_id the page to read
+   * @param[in,out] slot the slot to start at, set to the one to resume at: 0 once the page is done
+   * @param max_views the most tuples to hand over
+   * @param filter the filter, an empty one keeps every tuple
+   * @param reader the reader, called once even if no tuple passed
+   * @param txn transaction performing the read
+   * @return the page to read next: page_id if slot is not 0, else the page that follows, INVALID_PAGE_ID after
+   * the last one
+   */
+  page_id_t ViewPage(page_id_t page_id, uint32_t *slot, size_t max_views, const TupleFilter &filter,
+                     const std::function<void(const std::vector<TupleView> &views)> &reader, Transaction *txn);
+
+  /**
+   * Hand one page of a PAX table to a reader while it is pinned and latched, so that it reads the minipages of the
+   * columns it needs in place.
+   * @param page_id the page to read
+   * @param reader the reader
+   * @param txn transaction performing the read
+   * @return the id of the page that follows, INVALID_PAGE_ID after the last one
+   */
+  page_id_t ReadPaxPage(page_id_t page_id, const std::function<void(PaxPage *page)> &reader, Transaction *txn);
+
+  /**
+   * @return the id of the page that follows page_id, INVALID_PAGE_ID after the last one; read from the zone map if
+   * there is one, without fetching the page
+   */
+  page_id_t GetNextPageId(page_id_t page_id);
+
+  /**
+   * Start keeping a zone map of some columns of the table, built over the tuples already in it.
+   * @param schema the schema of the tuples of the table
+   * @param column_idxs the columns to summarize
+   * @param txn the transaction reading the table
+   */
+  void CreateZoneMap(const Schema &schema, std::vector<uint32_t> column_idxs, Transaction *txn);
+
+  /** @return the zone map of the table, nullptr if it has none */
+  ZoneMap *GetZoneMap() { return zone_map_.get(); }
+
+  /** @return the layout of the pages of this table */
+  TableLayout GetLayout() const { return layout_; }
+
   /** @return the begin iterator of this table */
   TableIterator Begin(Transaction *txn);
 
+  /**
+   * @return an iterator over the pages of this table from first_page_id up to, not including, stop_page_id
+   * @param txn the transaction scanning
+   * @param first_page_id the first page to scan
+   * @param stop_page_id the page to stop before, INVALID_PAGE_ID to scan to the end of the table
+   */
+  TableIterator Begin(Transaction *txn, page_id_t first_page_id, page_id_t stop_page_id);
+
   /** @return the end iterator of this table */
   TableIterator End();
 
@@ -109,10 +199,44 @@ class TableHeap {
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
  private:
+  /**
+   * @return the rid of the first tuple from page page_id on, up to, not including, stop_page_id; a RID with an
+   * invalid page id if there is none
+   * @param page_id the page to start at
+   * @param after if not nullptr, a tuple of page page_id, only the tuples after it are looked at
+   * @param stop_page_id the page to stop before, INVALID_PAGE_ID to look up to the end of the table
+   */
+  RID FindTuple(page_id_t page_id, const RID *after, page_id_t stop_page_id);
+
+  /** Initialize a new page of the table. */
+  void InitPage(Page *page, page_id_t page_id, page_id_t prev_page_id, Transaction *txn);
+
+  /** The implementations of the operations above over pages of type PageT, TablePage or PaxPage */
+  template <class PageT>
+  bool InsertTupleOn(const Tuple &tuple, RID *rid, Transaction *txn);
+  template <class PageT>
+  bool MarkDeleteOn(const RID &rid, Transaction *txn);
+  template <class PageT>
+  bool UpdateTupleOn(const Tuple &tuple, const RID &rid, Transaction *txn);
+  template <class PageT>
+  void ApplyDeleteOn(const RID &rid, Transaction *txn);
+  template <class PageT>
+  void RollbackDeleteOn(const RID &rid, Transaction *txn);
+  template <class PageT>
+  bool GetTupleOn(const RID &rid, Tuple *tuple, Transaction *txn);
+  template <class PageT>
+  page_id_t ScanPageOn(page_id_t page_id, const TupleFilter &filter, std::vector<Tuple> *tuples, Transaction *txn);
+  template <class PageT>
+  RID FindTupleOn(page_id_t page_id, const RID *after, page_id_t stop_page_id);
+
   BufferPoolManager *buffer_pool_manager_;
   LockManager *lock_manager_;
   LogManager *log_manager_;
   page_id_t first_page_id_{};
+  std::unique_ptr<ZoneMap> zone_map_;
+  TableLayout layout_{TableLayout::ROW};
+  /** The schema new PaxPages are laid out by, nullptr for a row table */
+  std::unique_ptr<Schema> schema_;
 };
 
 }  // namespace bustub
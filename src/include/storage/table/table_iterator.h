@@ -29,10 +29,19 @@ class TableIterator {
   friend class Cursor;
 
  public:
-  TableIterator(TableHeap *table_heap, RID rid, Transaction *txn);
+  /**
+   * @param table_heap the table to scan
+   * @param rid the RID of the first tuple
+   * @param txn the transaction scanning
+   * @param stop_page_id the page the scan stops before, INVALID_PAGE_ID to scan to the end of the table
+   */
+  TableIterator(TableHeap *table_heap, RID rid, Transaction *txn, page_id_t stop_page_id = INVALID_PAGE_ID);
 
   TableIterator(const TableIterator &other)
-      : table_heap_(other.table_heap_), tuple_(new Tuple(*other.tuple_)), txn_(other.txn_) {}
+      : table_heap_(other.table_heap_),
+        tuple_(new Tuple(*other.tuple_)),
+        txn_(other.txn_),
+        stop_page_id_(other.stop_page_id_) {}
 
   ~TableIterator() { delete tuple_; }
 
@@ -52,6 +61,7 @@ class TableIterator {
     table_heap_ = other.table_heap_;
     *tuple_ = *other.tuple_;
     txn_ = other.txn_;
+    stop_page_id_ = other.stop_page_id_;
     return *this;
   }
 
@@ -59,6 +69,7 @@ class TableIterator {
   TableHeap *table_heap_;
   Tuple *tuple_;
   Transaction *txn_;
+  page_id_t stop_page_id_;
 };
 
 }  // namespace bustub
@@ -17,6 +17,8 @@
 
 #include "catalog/schema.h"
 #include "common/rid.h"
+#include "storage/table/tuple_view.h"
+#include "type/abstract_pool.h"
 #include "type/value.h"
 
 namespace bustub {
@@ -29,8 +31,10 @@ namespace bustub {
  */
 class Tuple {
   friend class TablePage;
+  friend class PaxPage;
   friend class TableHeap;
   friend class TableIterator;
+  friend class TupleBatch;
 
  public:
   // Default constructor (to create a dummy tuple)
@@ -39,8 +43,12 @@ class Tuple {
   // constructor for table heap tuple
   explicit Tuple(RID rid) : rid_(rid) {}
 
-  // constructor for creating a new tuple based on input value
-  Tuple(std::vector<Value> values, const Schema *schema);
+  // constructor for creating a new tuple based on input value; the data is allocated from pool if one is given,
+  // in which case the tuple does not own it and copies of the tuple share it
+  Tuple(std::vector<Value> values, const Schema *schema, AbstractPool *pool = nullptr);
+
+  // constructor materializing the bytes a view points to, into memory from pool if one is given
+  explicit Tuple(const TupleView &view, AbstractPool *pool = nullptr);
 
   // copy constructor, deep copy
   Tuple(const Tuple &other);
@@ -58,8 +66,11 @@ class Tuple {
   // serialize tuple data
   void SerializeTo(char *storage) const;
 
-  // deserialize tuple data(deep copy)
-  void DeserializeFrom(const char *storage);
+  // deserialize tuple data(deep copy), into memory from pool if one is given
+  void DeserializeFrom(const char *storage, AbstractPool *pool = nullptr);
+
+  // copy data the tuple does not own, e.g. allocated from an arena, into memory it owns
+  void Materialize();
 
   // return RID of current tuple
   inline RID GetRid() const { return rid_; }
@@ -70,6 +81,9 @@ class Tuple {
   // Get length of the tuple, including varchar legth
   inline uint32_t GetLength() const { return size_; }
 
+  // Get a view of the tuple, valid as long as the tuple is
+  inline TupleView GetView() const { return TupleView(data_, size_, rid_); }
+
   // Get the value of a specified column (const)
   // checks the schema to see how to return the Value.
   Value GetValue(const Schema *schema, uint32_t column_idx) const;
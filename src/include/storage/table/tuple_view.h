@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_view.h
+//
+// Identification: src/include/storage/table/tuple_view.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "catalog/schema.h"
+#include "common/rid.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * TupleView is a non-owning view of the bytes of a tuple, laid out as in a Tuple, where they are stored: in a pinned
+ * TablePage or TmpTuplePage, or in a Tuple. It is only valid as long as the bytes stay where they are, i.e. while
+ * the page is pinned, and latched if others may write to it. Copying a view copies no bytes; a view is turned into
+ * a Tuple that owns its bytes when it has to outlive them.
+ */
+class TupleView {
+ public:
+  TupleView() = default;
+
+  /**
+   * Create a view.
+   * @param data the bytes of the tuple
+   * @param size the number of bytes, including the ones of its VARCHARs
+   * @param rid the RID of the tuple, if it comes from a table
+   */
+  TupleView(const char *data, uint32_t size, RID rid = RID()) : data_(data), size_(size), rid_(rid) {}
+
+  /** @return the RID of the tuple */
+  RID GetRid() const { return rid_; }
+
+  /** @return the bytes of the tuple */
+  const char *GetData() const { return data_; }
+
+  /** @return the length of the tuple, including the ones of its VARCHARs */
+  uint32_t GetLength() const { return size_; }
+
+  /** @return the bytes of the value of a column, laid out as Value::SerializeTo writes it */
+  const char *GetDataPtr(const Schema *schema, uint32_t column_idx) const {
+    const auto &column = schema->GetColumn(column_idx);
+    if (column.IsInlined()) {
+      return data_ + column.GetOffset();
+    }
+    return data_ + *reinterpret_cast<const uint32_t *>(data_ + column.GetOffset());
+  }
+
+  /** @return the value of a column, boxed */
+  Value GetValue(const Schema *schema, uint32_t column_idx) const {
+    return Value::DeserializeFrom(GetDataPtr(schema, column_idx), schema->GetColumn(column_idx).GetType());
+  }
+
+ private:
+  const char *data_{nullptr};
+  uint32_t size_{0};
+  RID rid_{};
+};
+
+}  // namespace bustub
@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// zone_map.h
+//
+// Identification: src/include/storage/table/zone_map.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "common/macros.h"
+#include "common/rwlatch.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * ZoneMap keeps, for every page of a TableHeap, the smallest and the largest non-null value of a few of its columns,
+ * along with the page that follows it. A scan checks the summary of a page against its predicate and skips the page
+ * without reading it when no value in the range can pass.
+ *
+ * Summaries only ever widen: a tuple inserted or updated into a page widens its bounds, a deleted one leaves them as
+ * they are. The bounds of a page hold every value it stores, possibly more. The zone map lives in memory next to the
+ * table heap and is built again when the table is opened.
+ */
+class ZoneMap {
+ public:
+  /**
+   * Create an empty zone map.
+   * @param schema the schema of the tuples of the table
+   * @param column_idxs the columns to summarize
+   */
+  ZoneMap(const Schema &schema, std::vector<uint32_t> column_idxs);
+
+  DISALLOW_COPY_AND_MOVE(ZoneMap);
+
+  /** @return true if column_idx is summarized */
+  bool HasColumn(uint32_t column_idx) const;
+
+  /** Record a page of the table and the page that follows it, INVALID_PAGE_ID for the last one. */
+  void Link(page_id_t page_id, page_id_t next_page_id);
+
+  /** Widen the summary of a page to the values of a tuple stored in it. */
+  void Insert(page_id_t page_id, const Tuple &tuple);
+
+  /**
+   * @param page_id a page of the table
+   * @param[out] next_page_id the page that follows it
+   * @return false if the page is not known to the zone map
+   */
+  bool GetNextPageId(page_id_t page_id, page_id_t *next_page_id) const;
+
+  /**
+   * Read the bounds of a column over a page.
+   * @param page_id a page of the table
+   * @param column_idx a summarized column
+   * @param[out] min the smallest value, null if the page holds no non-null value of the column
+   * @param[out] max the largest value, null if the page holds no non-null value of the column
+   * @return false if the page is not known to the zone map or the column is not summarized
+   */
+  bool GetBounds(page_id_t page_id, uint32_t column_idx, Value *min, Value *max) const;
+
+  /** Count pages skipped by a scan. */
+  void AddPrunedPages(size_t count) { pruned_pages_ += count; }
+
+  /** @return the number of pages scans have skipped thanks to the zone map */
+  size_t GetPrunedPageCount() const { return pruned_pages_; }
+
+ private:
+  struct PageZone {
+    page_id_t next_page_id_{INVALID_PAGE_ID};
+    /** The bounds of every summarized column, in the order of column_idxs_ */
+    std::vector<Value> min_;
+    std::vector<Value> max_;
+  };
+
+  /** @return the zone of a page, created empty if it is new; latch_ must be held in write mode */
+  PageZone *GetOrCreate(page_id_t page_id);
+
+  Schema schema_;
+  std::vector<uint32_t> column_idxs_;
+  std::unordered_map<page_id_t, PageZone> pages_;
+  mutable ReaderWriterLatch latch_;
+  std::atomic<size_t> pruned_pages_{0};
+};
+
+}  // namespace bustub
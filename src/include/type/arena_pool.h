@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena_pool.h
+//
+// Identification: src/include/type/arena_pool.h
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/macros.h"
+#include "type/abstract_pool.h"
+
+namespace bustub {
+
+/**
+ * ArenaPool hands out memory by bumping a pointer through large blocks, and never frees a chunk on its own: Free
+ * does nothing, and the memory of every chunk is released at once by Reset or when the pool is destroyed. Memory
+ * from an arena is not owned by the Tuples and Values built over it, so copying them copies no bytes.
+ *
+ * An ArenaPool is not thread-safe; every executor allocates the tuples it hands out from its own (see
+ * AbstractExecutor::NextOutputArena).
+ */
+class ArenaPool : public AbstractPool {
+ public:
+  /**
+   * Create an empty arena.
+   * @param block_size the size of the blocks the chunks are carved from; a larger chunk gets a block of its own
+   */
+  explicit ArenaPool(size_t block_size = DEFAULT_BLOCK_SIZE) : block_size_(block_size) {}
+
+  DISALLOW_COPY_AND_MOVE(ArenaPool);
+
+  ~ArenaPool() override = default;
+
+  /** @return a chunk of size bytes aligned on 8 bytes, valid until the next Reset */
+  void *Allocate(size_t size) override;
+
+  /** Chunks are not freed one by one. */
+  void Free(void *ptr) override {}
+
+  /** Release the memory of every chunk allocated so far, keeping one block to allocate from again. */
+  void Reset();
+
+  /** @return the number of bytes handed out since the last Reset */
+  size_t GetAllocatedBytes() const { return allocated_bytes_; }
+
+  /** @return the number of bytes of the blocks held */
+  size_t GetReservedBytes() const { return reserved_bytes_; }
+
+  /** The default size of the blocks, large enough to hold the rows of a few batches */
+  static constexpr size_t DEFAULT_BLOCK_SIZE = 64 << 10;
+
+ private:
+  static constexpr size_t ALIGNMENT = 8;
+
+  size_t block_size_;
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  /** The free bytes of the last block of the standard size */
+  char *cursor_{nullptr};
+  char *end_{nullptr};
+  size_t allocated_bytes_{0};
+  size_t reserved_bytes_{0};
+};
+
+}  // namespace bustub
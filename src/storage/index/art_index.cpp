@@ -0,0 +1,35 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// art_index.cpp
+//
+// Identification: src/storage/index/art_index.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/art_index.h"
+
+#include "storage/index/key_encoder.h"
+
+namespace bustub {
+/*
+ * Constructor
+ */
+ARTIndex::ARTIndex(std::unique_ptr<IndexMetadata> &&metadata) : Index(std::move(metadata)) {}
+
+void ARTIndex::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  container_.Insert(KeyEncoder::Encode(key, GetKeySchema(), GetIndexColumnCount()), rid);
+}
+
+void ARTIndex::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  container_.Remove(KeyEncoder::Encode(key, GetKeySchema(), GetIndexColumnCount()), rid);
+}
+
+void ARTIndex::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
+  container_.GetValue(KeyEncoder::Encode(key, GetKeySchema(), GetIndexColumnCount()), result);
+}
+
+}  // namespace bustub
@@ -19,30 +19,49 @@
 namespace bustub {
 INDEX_TEMPLATE_ARGUMENTS
 BPLUSTREE_TYPE::BPlusTree(std::string name, BufferPoolManager *buffer_pool_manager, const KeyComparator &comparator,
-                          int leaf_max_size, int internal_max_size)
+                          int leaf_max_size, int internal_max_size, page_id_t header_page_id)
     : index_name_(std::move(name)),
       root_page_id_(INVALID_PAGE_ID),
       buffer_pool_manager_(buffer_pool_manager),
       comparator_(comparator),
       leaf_max_size_(leaf_max_size),
-      internal_max_size_(internal_max_size) {}
+      internal_max_size_(internal_max_size),
+      header_page_id_(header_page_id) {}
 
 /*
  * Helper function to decide whether current b+tree is empty
  */
 INDEX_TEMPLATE_ARGUMENTS
-bool BPLUSTREE_TYPE::IsEmpty() const { return true; }
+bool BPLUSTREE_TYPE::IsEmpty() const { return root_page_id_ == INVALID_PAGE_ID; }
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
 /*
- * Return the only value that associated with input key
+ * Return all the values that associated with input key, inline ones first and
+ * then the ones kept in overflow pages
  * This method is used for point query
  * @return : true means key exists
  */
 INDEX_TEMPLATE_ARGUMENTS
 bool BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *transaction) {
-  return false;
+  root_latch_.RLock();
+  if (IsEmpty()) {
+    root_latch_.RUnlock();
+    return false;
+  }
+  Page *page = FindLeafPage(key);
+  auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  int index;
+  bool found = leaf->Lookup(key, &index, comparator_);
+  if (found) {
+    for (int i = 0; i < leaf->ValueCountAt(index); i++) {
+      result->push_back(leaf->ValueAt(index, i));
+    }
+    OverflowPage::ScanChain(buffer_pool_manager_, leaf->OverflowPageIdAt(index), result);
+  }
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  root_latch_.RUnlock();
+  return found;
 }
 
 /*****************************************************************************
@@ -52,11 +71,21 @@ bool BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
  * Insert constant key & value pair into b+ tree
  * if current tree is empty, start new tree, update root page id and insert
  * entry, otherwise insert into leaf page.
- * @return: since we only support unique key, if user try to insert duplicate
- * keys return false, otherwise return true.
+ * @return: false if the exact key & value pair is already present, otherwise
+ * return true.
  */
 INDEX_TEMPLATE_ARGUMENTS
-bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) { return false; }
+bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  root_latch_.WLock();
+  bool inserted = true;
+  if (IsEmpty()) {
+    StartNewTree(key, value);
+  } else {
+    inserted = InsertIntoLeaf(key, value, transaction);
+  }
+  root_latch_.WUnlock();
+  return inserted;
+}
 /*
  * Insert constant key & value pair into an empty tree
  * User needs to first ask for new page from buffer pool manager(NOTICE: throw
@@ -64,19 +93,54 @@ bool BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
  * tree's root page id and insert entry directly into leaf page.
  */
 INDEX_TEMPLATE_ARGUMENTS
-void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {}
+void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {
+  page_id_t page_id;
+  Page *page = buffer_pool_manager_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate new root page");
+  }
+  auto *root = reinterpret_cast<LeafPage *>(page->GetData());
+  root->Init(page_id, INVALID_PAGE_ID, leaf_max_size_);
+  root->Insert(key, value, comparator_);
+  root_page_id_ = page_id;
+  UpdateRootPageId(1);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+}
 
 /*
  * Insert constant key & value pair into leaf page
  * User needs to first find the right leaf page as insertion target, then look
- * through leaf page to see whether insert key exist or not. If exist, return
- * immdiately, otherwise insert entry. Remember to deal with split if necessary.
- * @return: since we only support unique key, if user try to insert duplicate
- * keys return false, otherwise return true.
+ * through leaf page to see whether insert key exist or not. If it exists, the
+ * value joins the key's posting list (spilling into overflow pages once the
+ * inline list is full), otherwise a new entry is created. Remember to deal
+ * with split if necessary.
+ * @return: false if the exact key & value pair is already present, otherwise
+ * return true.
  */
 INDEX_TEMPLATE_ARGUMENTS
 bool BPLUSTREE_TYPE::InsertIntoLeaf(const KeyType &key, const ValueType &value, Transaction *transaction) {
-  return false;
+  Page *page = FindLeafPage(key);
+  auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  int index;
+  if (leaf->Lookup(key, &index, comparator_)) {
+    if (leaf->ValueIndexAt(index, value) != -1 || OverflowContains(leaf->OverflowPageIdAt(index), value)) {
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      return false;
+    }
+    if (!leaf->AppendValue(index, value)) {
+      AppendToOverflow(leaf, index, value);
+    }
+  } else {
+    leaf->Insert(key, value, comparator_);
+  }
+
+  if (leaf->IsFull() && leaf->GetSize() > 1) {
+    LeafPage *new_leaf = Split(leaf);
+    InsertIntoParent(leaf, new_leaf->KeyAt(0), new_leaf, transaction);
+    buffer_pool_manager_->UnpinPage(new_leaf->GetPageId(), true);
+  }
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+  return true;
 }
 
 /*
@@ -89,7 +153,27 @@ bool BPLUSTREE_TYPE::InsertIntoLeaf(const KeyType &key, const ValueType &value,
 INDEX_TEMPLATE_ARGUMENTS
 template <typename N>
 N *BPLUSTREE_TYPE::Split(N *node) {
-  return nullptr;
+  page_id_t page_id;
+  Page *page = buffer_pool_manager_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate page for split");
+  }
+  auto *new_node = reinterpret_cast<N *>(page->GetData());
+  if (node->IsLeafPage()) {
+    auto *leaf = reinterpret_cast<LeafPage *>(node);
+    auto *new_leaf = reinterpret_cast<LeafPage *>(new_node);
+    new_leaf->Init(page_id, leaf->GetParentPageId(), leaf_max_size_);
+    leaf->MoveHalfTo(new_leaf);
+    if (new_leaf->GetNextPageId() != INVALID_PAGE_ID) {
+      SetPrevLeafPageId(new_leaf->GetNextPageId(), page_id);
+    }
+  } else {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    auto *new_internal = reinterpret_cast<InternalPage *>(new_node);
+    new_internal->Init(page_id, internal->GetParentPageId(), internal_max_size_);
+    internal->MoveHalfTo(new_internal, buffer_pool_manager_);
+  }
+  return new_node;
 }
 
 /*
@@ -103,20 +187,133 @@ N *BPLUSTREE_TYPE::Split(N *node) {
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::InsertIntoParent(BPlusTreePage *old_node, const KeyType &key, BPlusTreePage *new_node,
-                                      Transaction *transaction) {}
+                                      Transaction *transaction) {
+  if (old_node->IsRootPage()) {
+    page_id_t page_id;
+    Page *page = buffer_pool_manager_->NewPage(&page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate new root page");
+    }
+    auto *root = reinterpret_cast<InternalPage *>(page->GetData());
+    root->Init(page_id, INVALID_PAGE_ID, internal_max_size_);
+    root->PopulateNewRoot(old_node->GetPageId(), key, new_node->GetPageId());
+    old_node->SetParentPageId(page_id);
+    new_node->SetParentPageId(page_id);
+    root_page_id_ = page_id;
+    UpdateRootPageId(0);
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    return;
+  }
+
+  page_id_t parent_id = old_node->GetParentPageId();
+  Page *page = buffer_pool_manager_->FetchPage(parent_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch parent page");
+  }
+  auto *parent = reinterpret_cast<InternalPage *>(page->GetData());
+  new_node->SetParentPageId(parent_id);
+  parent->InsertNodeAfter(old_node->GetPageId(), key, new_node->GetPageId());
+  if (parent->GetSize() > parent->GetMaxSize()) {
+    InternalPage *new_parent = Split(parent);
+    InsertIntoParent(parent, new_parent->KeyAt(0), new_parent, transaction);
+    buffer_pool_manager_->UnpinPage(new_parent->GetPageId(), true);
+  }
+  buffer_pool_manager_->UnpinPage(parent_id, true);
+}
 
 /*****************************************************************************
  * REMOVE
  *****************************************************************************/
 /*
- * Delete key & value pair associated with input key
+ * Delete input key together with every value associated with it
  * If current tree is empty, return immdiately.
  * If not, User needs to first find the right leaf page as deletion target, then
  * delete entry from leaf page. Remember to deal with redistribute or merge if
  * necessary.
  */
 INDEX_TEMPLATE_ARGUMENTS
-void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {}
+void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {
+  root_latch_.WLock();
+  if (IsEmpty()) {
+    root_latch_.WUnlock();
+    return;
+  }
+  Page *page = FindLeafPage(key);
+  auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  int index;
+  if (!leaf->Lookup(key, &index, comparator_)) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    root_latch_.WUnlock();
+    return;
+  }
+  DeleteOverflowChain(leaf->OverflowPageIdAt(index));
+  RemoveFromLeaf(page, index, transaction);
+  root_latch_.WUnlock();
+}
+
+/*
+ * Delete a single key & value pair. The key itself disappears once its last
+ * value is gone. An inline slot freed while overflow values remain is refilled
+ * from the overflow chain, so a key never has an empty inline posting list.
+ * @return: true means the pair existed and has been removed
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::Remove(const KeyType &key, const ValueType &value, Transaction *transaction) {
+  root_latch_.WLock();
+  if (IsEmpty()) {
+    root_latch_.WUnlock();
+    return false;
+  }
+  Page *page = FindLeafPage(key);
+  auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  int index;
+  if (!leaf->Lookup(key, &index, comparator_)) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    root_latch_.WUnlock();
+    return false;
+  }
+
+  int offset = leaf->ValueIndexAt(index, value);
+  if (offset != -1) {
+    leaf->RemoveValue(index, offset);
+    if (leaf->OverflowPageIdAt(index) != INVALID_PAGE_ID) {
+      ValueType refill;
+      leaf->SetOverflowPageIdAt(index, PopFromOverflow(leaf->OverflowPageIdAt(index), &refill));
+      leaf->AppendValue(index, refill);
+    }
+  } else if (!RemoveFromOverflow(leaf, index, value)) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    root_latch_.WUnlock();
+    return false;
+  }
+
+  if (leaf->ValueCountAt(index) == 0) {
+    RemoveFromLeaf(page, index, transaction);
+  } else {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+  }
+  root_latch_.WUnlock();
+  return true;
+}
+
+/*
+ * Drop the entry at "index" of the pinned leaf page, rebalance the tree if the
+ * leaf underflows and release the leaf page.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::RemoveFromLeaf(Page *leaf_page, int index, Transaction *transaction) {
+  auto *leaf = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  leaf->RemoveAndDeleteRecord(leaf->KeyAt(index), comparator_);
+  bool should_delete = false;
+  if (leaf->IsRootPage() ? leaf->GetSize() == 0 : leaf->GetSize() < leaf->GetMinSize()) {
+    should_delete = CoalesceOrRedistribute(leaf, transaction);
+  }
+  page_id_t page_id = leaf_page->GetPageId();
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  if (should_delete) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+}
 
 /*
  * User needs to first find the sibling of input page. If sibling's size + input
@@ -128,6 +325,48 @@ void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *transaction) {}
 INDEX_TEMPLATE_ARGUMENTS
 template <typename N>
 bool BPLUSTREE_TYPE::CoalesceOrRedistribute(N *node, Transaction *transaction) {
+  if (node->IsRootPage()) {
+    return AdjustRoot(node);
+  }
+  page_id_t parent_id = node->GetParentPageId();
+  Page *parent_page = buffer_pool_manager_->FetchPage(parent_id);
+  if (parent_page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch parent page");
+  }
+  auto *parent = reinterpret_cast<InternalPage *>(parent_page->GetData());
+  int index = parent->ValueIndex(node->GetPageId());
+  page_id_t neighbor_id = parent->ValueAt(index == 0 ? 1 : index - 1);
+  Page *neighbor_page = buffer_pool_manager_->FetchPage(neighbor_id);
+  if (neighbor_page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch sibling page");
+  }
+  auto *neighbor = reinterpret_cast<N *>(neighbor_page->GetData());
+
+  bool can_merge;
+  if (node->IsLeafPage()) {
+    can_merge = reinterpret_cast<LeafPage *>(neighbor)->CanAbsorb(reinterpret_cast<LeafPage *>(node));
+  } else {
+    can_merge = node->GetSize() + neighbor->GetSize() <= node->GetMaxSize();
+  }
+
+  if (can_merge) {
+    bool parent_should_delete = Coalesce(&neighbor, &node, &parent, index, transaction);
+    buffer_pool_manager_->UnpinPage(parent_id, true);
+    if (parent_should_delete) {
+      buffer_pool_manager_->DeletePage(parent_id);
+    }
+    buffer_pool_manager_->UnpinPage(neighbor_id, true);
+    if (index == 0) {
+      // the right sibling was merged into node
+      buffer_pool_manager_->DeletePage(neighbor_id);
+      return false;
+    }
+    return true;
+  }
+
+  buffer_pool_manager_->UnpinPage(parent_id, false);
+  Redistribute(neighbor, node, index);
+  buffer_pool_manager_->UnpinPage(neighbor_id, true);
   return false;
 }
 
@@ -148,6 +387,25 @@ template <typename N>
 bool BPLUSTREE_TYPE::Coalesce(N **neighbor_node, N **node,
                               BPlusTreeInternalPage<KeyType, page_id_t, KeyComparator> **parent, int index,
                               Transaction *transaction) {
+  // always move the right page into the left one
+  N *left = index == 0 ? *node : *neighbor_node;
+  N *right = index == 0 ? *neighbor_node : *node;
+  int right_index = index == 0 ? 1 : index;
+  if (left->IsLeafPage()) {
+    auto *left_leaf = reinterpret_cast<LeafPage *>(left);
+    reinterpret_cast<LeafPage *>(right)->MoveAllTo(left_leaf);
+    if (left_leaf->GetNextPageId() != INVALID_PAGE_ID) {
+      SetPrevLeafPageId(left_leaf->GetNextPageId(), left_leaf->GetPageId());
+    }
+  } else {
+    reinterpret_cast<InternalPage *>(right)->MoveAllTo(reinterpret_cast<InternalPage *>(left),
+                                                       (*parent)->KeyAt(right_index), buffer_pool_manager_);
+  }
+  (*parent)->Remove(right_index);
+
+  if ((*parent)->IsRootPage() ? (*parent)->GetSize() == 1 : (*parent)->GetSize() < (*parent)->GetMinSize()) {
+    return CoalesceOrRedistribute(*parent, transaction);
+  }
   return false;
 }
 
@@ -155,14 +413,49 @@ bool BPLUSTREE_TYPE::Coalesce(N **neighbor_node, N **node,
  * Redistribute key & value pairs from one page to its sibling page. If index ==
  * 0, move sibling page's first key & value pair into end of input "node",
  * otherwise move sibling page's last key & value pair into head of input
- * "node".
+ * "node". A leaf only lends an entry if the receiving page can hold its
+ * posting list, otherwise the underflow is tolerated.
  * Using template N to represent either internal page or leaf page.
  * @param   neighbor_node      sibling page of input "node"
  * @param   node               input from method coalesceOrRedistribute()
  */
 INDEX_TEMPLATE_ARGUMENTS
 template <typename N>
-void BPLUSTREE_TYPE::Redistribute(N *neighbor_node, N *node, int index) {}
+void BPLUSTREE_TYPE::Redistribute(N *neighbor_node, N *node, int index) {
+  page_id_t parent_id = node->GetParentPageId();
+  Page *parent_page = buffer_pool_manager_->FetchPage(parent_id);
+  if (parent_page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch parent page");
+  }
+  auto *parent = reinterpret_cast<InternalPage *>(parent_page->GetData());
+  bool moved = true;
+  if (node->IsLeafPage()) {
+    auto *leaf = reinterpret_cast<LeafPage *>(node);
+    auto *neighbor = reinterpret_cast<LeafPage *>(neighbor_node);
+    int lend = index == 0 ? 0 : neighbor->GetSize() - 1;
+    moved = neighbor->GetSize() > neighbor->GetMinSize() &&
+            leaf->FreeBytes() - neighbor->EntryBytes(lend) >=
+                static_cast<int>(sizeof(BPlusTreeLeafEntry<KeyType>) + sizeof(ValueType));
+    if (moved && index == 0) {
+      neighbor->MoveFirstToEndOf(leaf);
+      parent->SetKeyAt(1, neighbor->KeyAt(0));
+    } else if (moved) {
+      neighbor->MoveLastToFrontOf(leaf);
+      parent->SetKeyAt(index, leaf->KeyAt(0));
+    }
+  } else {
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    auto *neighbor = reinterpret_cast<InternalPage *>(neighbor_node);
+    if (index == 0) {
+      neighbor->MoveFirstToEndOf(internal, parent->KeyAt(1), buffer_pool_manager_);
+      parent->SetKeyAt(1, neighbor->KeyAt(0));
+    } else {
+      neighbor->MoveLastToFrontOf(internal, parent->KeyAt(index), buffer_pool_manager_);
+      parent->SetKeyAt(index, internal->KeyAt(0));
+    }
+  }
+  buffer_pool_manager_->UnpinPage(parent_id, moved);
+}
 /*
  * Update root page if necessary
  * NOTE: size of root page can be less than min size and this method is only
@@ -174,7 +467,165 @@ void BPLUSTREE_TYPE::Redistribute(N *neighbor_node, N *node, int index) {}
  * happend
  */
 INDEX_TEMPLATE_ARGUMENTS
-bool BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root_node) { return false; }
+bool BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root_node) {
+  if (old_root_node->IsLeafPage()) {
+    if (old_root_node->GetSize() > 0) {
+      return false;
+    }
+    root_page_id_ = INVALID_PAGE_ID;
+    UpdateRootPageId(0);
+    return true;
+  }
+  if (old_root_node->GetSize() > 1) {
+    return false;
+  }
+  root_page_id_ = reinterpret_cast<InternalPage *>(old_root_node)->RemoveAndReturnOnlyChild();
+  UpdateRootPageId(0);
+  Page *page = buffer_pool_manager_->FetchPage(root_page_id_);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch new root page");
+  }
+  reinterpret_cast<BPlusTreePage *>(page->GetData())->SetParentPageId(INVALID_PAGE_ID);
+  buffer_pool_manager_->UnpinPage(root_page_id_, true);
+  return true;
+}
+
+/*****************************************************************************
+ * OVERFLOW PAGES
+ *****************************************************************************/
+/*
+ * @return : true if value is stored anywhere in the overflow chain
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::OverflowContains(page_id_t head_page_id, const ValueType &value) {
+  page_id_t page_id = head_page_id;
+  while (page_id != INVALID_PAGE_ID) {
+    Page *page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch overflow page");
+    }
+    auto *overflow = reinterpret_cast<OverflowPage *>(page->GetData());
+    bool found = overflow->ValueIndex(value) != -1;
+    page_id_t next_page_id = overflow->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    if (found) {
+      return true;
+    }
+    page_id = next_page_id;
+  }
+  return false;
+}
+
+/*
+ * Append value to the overflow chain of the key at "index". A new overflow page
+ * is linked in front of the chain when the head page is full.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::AppendToOverflow(LeafPage *leaf, int index, const ValueType &value) {
+  page_id_t head_page_id = leaf->OverflowPageIdAt(index);
+  if (head_page_id != INVALID_PAGE_ID) {
+    Page *page = buffer_pool_manager_->FetchPage(head_page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch overflow page");
+    }
+    bool appended = reinterpret_cast<OverflowPage *>(page->GetData())->Append(value);
+    buffer_pool_manager_->UnpinPage(head_page_id, appended);
+    if (appended) {
+      return;
+    }
+  }
+  page_id_t page_id;
+  Page *page = buffer_pool_manager_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate overflow page");
+  }
+  auto *overflow = reinterpret_cast<OverflowPage *>(page->GetData());
+  overflow->Init(page_id, head_page_id);
+  overflow->Append(value);
+  leaf->SetOverflowPageIdAt(index, page_id);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+}
+
+/*
+ * Remove value from the overflow chain of the key at "index", unlinking the
+ * overflow page that becomes empty.
+ * @return : false if value is not in the chain
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool BPLUSTREE_TYPE::RemoveFromOverflow(LeafPage *leaf, int index, const ValueType &value) {
+  page_id_t prev_page_id = INVALID_PAGE_ID;
+  page_id_t page_id = leaf->OverflowPageIdAt(index);
+  while (page_id != INVALID_PAGE_ID) {
+    Page *page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch overflow page");
+    }
+    auto *overflow = reinterpret_cast<OverflowPage *>(page->GetData());
+    page_id_t next_page_id = overflow->GetNextPageId();
+    int offset = overflow->ValueIndex(value);
+    if (offset == -1) {
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      prev_page_id = page_id;
+      page_id = next_page_id;
+      continue;
+    }
+    overflow->RemoveAt(offset);
+    bool empty = overflow->GetSize() == 0;
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    if (empty) {
+      if (prev_page_id == INVALID_PAGE_ID) {
+        leaf->SetOverflowPageIdAt(index, next_page_id);
+      } else {
+        Page *prev_page = buffer_pool_manager_->FetchPage(prev_page_id);
+        if (prev_page == nullptr) {
+          throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch overflow page");
+        }
+        reinterpret_cast<OverflowPage *>(prev_page->GetData())->SetNextPageId(next_page_id);
+        buffer_pool_manager_->UnpinPage(prev_page_id, true);
+      }
+      buffer_pool_manager_->DeletePage(page_id);
+    }
+    return true;
+  }
+  return false;
+}
+
+/*
+ * Take one value out of the head page of an overflow chain
+ * @return : new head of the chain
+ */
+INDEX_TEMPLATE_ARGUMENTS
+page_id_t BPLUSTREE_TYPE::PopFromOverflow(page_id_t head_page_id, ValueType *value) {
+  Page *page = buffer_pool_manager_->FetchPage(head_page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch overflow page");
+  }
+  auto *overflow = reinterpret_cast<OverflowPage *>(page->GetData());
+  *value = overflow->PopBack();
+  if (overflow->GetSize() > 0) {
+    buffer_pool_manager_->UnpinPage(head_page_id, true);
+    return head_page_id;
+  }
+  page_id_t next_page_id = overflow->GetNextPageId();
+  buffer_pool_manager_->UnpinPage(head_page_id, false);
+  buffer_pool_manager_->DeletePage(head_page_id);
+  return next_page_id;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::DeleteOverflowChain(page_id_t head_page_id) {
+  page_id_t page_id = head_page_id;
+  while (page_id != INVALID_PAGE_ID) {
+    Page *page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch overflow page");
+    }
+    page_id_t next_page_id = reinterpret_cast<OverflowPage *>(page->GetData())->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+    page_id = next_page_id;
+  }
+}
 
 /*****************************************************************************
  * INDEX ITERATOR
@@ -185,7 +636,12 @@ bool BPLUSTREE_TYPE::AdjustRoot(BPlusTreePage *old_root_node) { return false; }
  * @return : index iterator
  */
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin() { return INDEXITERATOR_TYPE(); }
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin() {
+  if (IsEmpty()) {
+    return End();
+  }
+  return INDEXITERATOR_TYPE(buffer_pool_manager_, FindLeafPage(KeyType(), true), 0);
+}
 
 /*
  * Input parameter is low key, find the leaf page that contains the input key
@@ -193,7 +649,66 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin() { return INDEXITERATOR_TYPE(); }
  * @return : index iterator
  */
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const KeyType &key) { return INDEXITERATOR_TYPE(); }
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const KeyType &key) {
+  if (IsEmpty()) {
+    return End();
+  }
+  Page *page = FindLeafPage(key);
+  int index = reinterpret_cast<LeafPage *>(page->GetData())->KeyIndex(key, comparator_);
+  return INDEXITERATOR_TYPE(buffer_pool_manager_, page, index);
+}
+
+/*
+ * Input parameters are the optional lower and upper bound of the scan. Find
+ * the leaf page that contains the lower bound first, then construct an index
+ * iterator that stops by itself once it passes the upper bound. The bounds
+ * are compared with search_comparator when given, so a bound may match a
+ * whole run of keys sharing the same prefix
+ * @return : index iterator
+ */
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::Begin(const KeyType *lower, bool lower_inclusive, const KeyType *upper,
+                                         bool upper_inclusive, const KeyComparator *search_comparator) {
+  if (IsEmpty()) {
+    return End();
+  }
+  const KeyComparator *comparator = search_comparator != nullptr ? search_comparator : &comparator_;
+  if (lower == nullptr) {
+    return INDEXITERATOR_TYPE(buffer_pool_manager_, FindLeafPage(KeyType(), true), 0, false, comparator, upper,
+                              upper_inclusive);
+  }
+  Page *page = FindBoundLeafPage(*lower, lower_inclusive, *comparator);
+  auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  int index = lower_inclusive ? leaf->KeyIndex(*lower, *comparator) : leaf->UpperKeyIndex(*lower, *comparator);
+  return INDEXITERATOR_TYPE(buffer_pool_manager_, page, index, false, comparator, upper, upper_inclusive);
+}
+
+/*
+ * Input parameters are the optional lower and upper bound of the scan. Find
+ * the leaf page that contains the upper bound first, then construct an index
+ * iterator walking backwards over the prev-leaf links until it passes the
+ * lower bound
+ * @return : index iterator
+ */
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_TYPE::RBegin(const KeyType *lower, bool lower_inclusive, const KeyType *upper,
+                                          bool upper_inclusive, const KeyComparator *search_comparator) {
+  if (IsEmpty()) {
+    return End();
+  }
+  const KeyComparator *comparator = search_comparator != nullptr ? search_comparator : &comparator_;
+  Page *page;
+  int index;
+  if (upper == nullptr) {
+    page = FindRightmostLeafPage();
+    index = reinterpret_cast<LeafPage *>(page->GetData())->GetSize() - 1;
+  } else {
+    page = FindBoundLeafPage(*upper, !upper_inclusive, *comparator);
+    auto *leaf = reinterpret_cast<LeafPage *>(page->GetData());
+    index = (upper_inclusive ? leaf->UpperKeyIndex(*upper, *comparator) : leaf->KeyIndex(*upper, *comparator)) - 1;
+  }
+  return INDEXITERATOR_TYPE(buffer_pool_manager_, page, index, true, comparator, lower, lower_inclusive);
+}
 
 /*
  * Input parameter is void, construct an index iterator representing the end
@@ -209,15 +724,92 @@ INDEXITERATOR_TYPE BPLUSTREE_TYPE::End() { return INDEXITERATOR_TYPE(); }
 /*
  * Find leaf page containing particular key, if leftMost flag == true, find
  * the left most leaf page
+ * @return : the leaf page, pinned, or nullptr if the tree is empty
  */
 INDEX_TEMPLATE_ARGUMENTS
 Page *BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, bool leftMost) {
-  throw Exception(ExceptionType::NOT_IMPLEMENTED, "Implement this for test");
+  if (IsEmpty()) {
+    return nullptr;
+  }
+  page_id_t page_id = root_page_id_;
+  while (true) {
+    Page *page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch tree page");
+    }
+    auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    if (node->IsLeafPage()) {
+      return page;
+    }
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    page_id_t child_id = leftMost ? internal->ValueAt(0) : internal->Lookup(key, comparator_);
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = child_id;
+  }
+}
+
+/*
+ * Find the right most leaf page, pinned
+ */
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::FindRightmostLeafPage() {
+  page_id_t page_id = root_page_id_;
+  while (true) {
+    Page *page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch tree page");
+    }
+    auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    if (node->IsLeafPage()) {
+      return page;
+    }
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    page_id_t child_id = internal->ValueAt(internal->GetSize() - 1);
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = child_id;
+  }
 }
 
 /*
- * Update/Insert root page id in header page(where page_id = 0, header_page is
- * defined under include/page/header_page.h)
+ * Find the leaf page holding the first key >= input key (before == true) or
+ * the last key <= input key (before == false) under the given comparator, pinned.
+ * The scan may still have to step to a sibling leaf from there
+ */
+INDEX_TEMPLATE_ARGUMENTS
+Page *BPLUSTREE_TYPE::FindBoundLeafPage(const KeyType &key, bool before, const KeyComparator &comparator) {
+  page_id_t page_id = root_page_id_;
+  while (true) {
+    Page *page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch tree page");
+    }
+    auto *node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    if (node->IsLeafPage()) {
+      return page;
+    }
+    auto *internal = reinterpret_cast<InternalPage *>(node);
+    page_id_t child_id = before ? internal->LookupBefore(key, comparator) : internal->Lookup(key, comparator);
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = child_id;
+  }
+}
+
+/*
+ * Point the back link of leaf page "page_id" to "prev_page_id"
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::SetPrevLeafPageId(page_id_t page_id, page_id_t prev_page_id) {
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch leaf page");
+  }
+  reinterpret_cast<LeafPage *>(page->GetData())->SetPrevPageId(prev_page_id);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+}
+
+/*
+ * Update/Insert root page id in header page(where page_id = header_page_id_,
+ * 0 unless given otherwise, header_page is defined under include/page/header_page.h)
  * Call this method everytime root page id is changed.
  * @parameter: insert_record      defualt value is false. When set to true,
  * insert a record <index_name, root_page_id> into header page instead of
@@ -225,15 +817,18 @@ Page *BPLUSTREE_TYPE::FindLeafPage(const KeyType &key, bool leftMost) {
  */
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::UpdateRootPageId(int insert_record) {
-  HeaderPage *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(HEADER_PAGE_ID));
+  HeaderPage *header_page = static_cast<HeaderPage *>(buffer_pool_manager_->FetchPage(header_page_id_));
   if (insert_record != 0) {
-    // create a new record<index_name + root_page_id> in header_page
-    header_page->InsertRecord(index_name_, root_page_id_);
+    // create a new record<index_name + root_page_id> in header_page, a tree
+    // that became empty and grows again already owns one
+    if (!header_page->InsertRecord(index_name_, root_page_id_)) {
+      header_page->UpdateRecord(index_name_, root_page_id_);
+    }
   } else {
     // update root_page_id in header_page
     header_page->UpdateRecord(index_name_, root_page_id_);
   }
-  buffer_pool_manager_->UnpinPage(HEADER_PAGE_ID, true);
+  buffer_pool_manager_->UnpinPage(header_page_id_, true);
 }
 
 /*
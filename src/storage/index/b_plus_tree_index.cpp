@@ -11,41 +11,76 @@
 
 #include "storage/index/b_plus_tree_index.h"
 
+#include "common/exception.h"
+
 namespace bustub {
 /*
  * Constructor
  */
 INDEX_TEMPLATE_ARGUMENTS
-BPLUSTREE_INDEX_TYPE::BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager)
+BPLUSTREE_INDEX_TYPE::BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager,
+                                     page_id_t header_page_id, size_t filter_capacity, page_id_t filter_page_id)
     : Index(std::move(metadata)),
-      comparator_(GetMetadata()->GetKeySchema()),
-      container_(GetMetadata()->GetName(), buffer_pool_manager, comparator_) {}
+      comparator_(GetMetadata()->GetKeySchema(), GetMetadata()->IsNormalized()),
+      search_comparator_(GetMetadata()->GetSearchKeySchema(), GetMetadata()->IsNormalized()),
+      container_(GetMetadata()->GetName(), buffer_pool_manager, comparator_, LEAF_PAGE_SIZE, INTERNAL_PAGE_SIZE - 1,
+                 header_page_id) {
+  if (filter_capacity > 0 || filter_page_id != INVALID_PAGE_ID) {
+    filter_ = std::make_unique<BloomFilter>(buffer_pool_manager, filter_capacity, filter_page_id);
+  }
+}
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
   // construct insert index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  if (!index_key.SetFromKey(key, GetKeySchema(), IsNormalized())) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "index key does not fit in the key size");
+  }
 
+  if (filter_ != nullptr) {
+    filter_->Insert(BloomFilter::HashKey(key, GetKeySchema(), GetIndexColumnCount()));
+  }
   container_.Insert(index_key, rid, transaction);
 }
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
-  // construct delete index key
+  // construct delete index key, a key too large for the index cannot be in it
   KeyType index_key;
-  index_key.SetFromKey(key);
+  if (!index_key.SetFromKey(key, GetKeySchema(), IsNormalized())) {
+    return;
+  }
 
-  container_.Remove(index_key, transaction);
+  container_.Remove(index_key, rid, transaction);
 }
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
-  // construct scan index key
+  // construct scan index key, a key too large for the index cannot be in it
   KeyType index_key;
-  index_key.SetFromKey(key);
+  if (!index_key.SetFromKey(key, GetSearchKeySchema(), IsNormalized())) {
+    return;
+  }
 
-  container_.GetValue(index_key, result, transaction);
+  // a definite miss of the filter skips the traversal
+  if (filter_ != nullptr &&
+      !filter_->MayContain(BloomFilter::HashKey(key, GetSearchKeySchema(), GetIndexColumnCount()))) {
+    return;
+  }
+  size_t found = result->size();
+  if (!GetMetadata()->HasIncludeAttrs()) {
+    container_.GetValue(index_key, result, transaction);
+  } else {
+    // entries differing only in their included columns are distinct keys, collect the whole run
+    for (auto iter = container_.Begin(&index_key, true, &index_key, true, &search_comparator_); !iter.IsEnd();
+         ++iter) {
+      result->push_back((*iter).second);
+    }
+  }
+  if (filter_ != nullptr && result->size() == found) {
+    filter_->RecordFalsePositive();
+  }
 }
 
 INDEX_TEMPLATE_ARGUMENTS
@@ -54,6 +89,18 @@ INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetBeginIterator() { return container_.
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetBeginIterator(const KeyType &key) { return container_.Begin(key); }
 
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetBeginIterator(const KeyType *lower, bool lower_inclusive,
+                                                          const KeyType *upper, bool upper_inclusive) {
+  return container_.Begin(lower, lower_inclusive, upper, upper_inclusive, &search_comparator_);
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetReverseBeginIterator(const KeyType *lower, bool lower_inclusive,
+                                                                 const KeyType *upper, bool upper_inclusive) {
+  return container_.RBegin(lower, lower_inclusive, upper, upper_inclusive, &search_comparator_);
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE BPLUSTREE_INDEX_TYPE::GetEndIterator() { return container_.End(); }
 
@@ -0,0 +1,190 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bloom_filter.cpp
+//
+// Identification: src/storage/index/bloom_filter.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/bloom_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+namespace {
+
+/** Layout of the filter header page */
+struct BloomFilterHeader {
+  uint32_t num_blocks_;
+  uint32_t num_hashes_;
+  uint32_t num_data_pages_;
+  page_id_t data_page_ids_[0];
+};
+
+constexpr size_t MAX_DATA_PAGES = (PAGE_SIZE - sizeof(BloomFilterHeader)) / sizeof(page_id_t);
+
+Page *FetchFilterPage(BufferPoolManager *buffer_pool_manager, page_id_t page_id) {
+  Page *page = buffer_pool_manager->FetchPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch bloom filter page");
+  }
+  return page;
+}
+
+Page *NewFilterPage(BufferPoolManager *buffer_pool_manager, page_id_t *page_id) {
+  Page *page = buffer_pool_manager->NewPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot allocate bloom filter page");
+  }
+  memset(page->GetData(), 0, PAGE_SIZE);
+  return page;
+}
+
+/** @return the in-block bit positions of a key, BLOOM_FILTER_NUM_HASHES slices of 9 bits from a remixed hash */
+inline uint64_t BitSlices(hash_t hash) { return static_cast<uint64_t>(hash) * 0x9e3779b97f4a7c15ULL; }
+
+}  // namespace
+
+BloomFilter::BloomFilter(BufferPoolManager *buffer_pool_manager, size_t expected_keys, page_id_t header_page_id)
+    : buffer_pool_manager_(buffer_pool_manager), header_page_id_(header_page_id) {
+  if (header_page_id_ == INVALID_PAGE_ID) {
+    Create(expected_keys);
+  } else {
+    Load();
+  }
+}
+
+void BloomFilter::Create(size_t expected_keys) {
+  size_t num_bits = std::max<size_t>(expected_keys, 1) * BLOOM_FILTER_BITS_PER_KEY;
+  num_blocks_ = std::min((num_bits + BLOCK_BITS - 1) / BLOCK_BITS, MAX_DATA_PAGES * BLOCKS_PER_PAGE);
+  size_t num_data_pages = (num_blocks_ + BLOCKS_PER_PAGE - 1) / BLOCKS_PER_PAGE;
+  words_ = std::make_unique<std::atomic<uint64_t>[]>(num_blocks_ * BLOCK_WORDS);
+  data_page_ids_ = std::make_unique<page_id_t[]>(num_data_pages);
+
+  Page *header_page = NewFilterPage(buffer_pool_manager_, &header_page_id_);
+  auto *header = reinterpret_cast<BloomFilterHeader *>(header_page->GetData());
+  header->num_blocks_ = num_blocks_;
+  header->num_hashes_ = BLOOM_FILTER_NUM_HASHES;
+  header->num_data_pages_ = num_data_pages;
+  for (size_t i = 0; i < num_data_pages; i++) {
+    NewFilterPage(buffer_pool_manager_, &data_page_ids_[i]);
+    buffer_pool_manager_->UnpinPage(data_page_ids_[i], true);
+    header->data_page_ids_[i] = data_page_ids_[i];
+  }
+  buffer_pool_manager_->UnpinPage(header_page_id_, true);
+}
+
+void BloomFilter::Load() {
+  Page *header_page = FetchFilterPage(buffer_pool_manager_, header_page_id_);
+  auto *header = reinterpret_cast<BloomFilterHeader *>(header_page->GetData());
+  BUSTUB_ASSERT(header->num_hashes_ == BLOOM_FILTER_NUM_HASHES, "filter was built with another hash count");
+  num_blocks_ = header->num_blocks_;
+  size_t num_data_pages = header->num_data_pages_;
+  words_ = std::make_unique<std::atomic<uint64_t>[]>(num_blocks_ * BLOCK_WORDS);
+  data_page_ids_ = std::make_unique<page_id_t[]>(num_data_pages);
+  std::copy(header->data_page_ids_, header->data_page_ids_ + num_data_pages, data_page_ids_.get());
+  buffer_pool_manager_->UnpinPage(header_page_id_, false);
+
+  size_t set_bits = 0;
+  for (size_t i = 0; i < num_data_pages; i++) {
+    Page *page = FetchFilterPage(buffer_pool_manager_, data_page_ids_[i]);
+    auto *data = reinterpret_cast<const uint64_t *>(page->GetData());
+    size_t begin = i * BLOCKS_PER_PAGE * BLOCK_WORDS;
+    size_t end = std::min(begin + BLOCKS_PER_PAGE * BLOCK_WORDS, num_blocks_ * BLOCK_WORDS);
+    for (size_t w = begin; w < end; w++) {
+      words_[w].store(data[w - begin], std::memory_order_relaxed);
+      set_bits += __builtin_popcountll(data[w - begin]);
+    }
+    buffer_pool_manager_->UnpinPage(data_page_ids_[i], false);
+  }
+
+  // the key count is not persisted; invert the expected fill ratio to estimate it
+  double m = static_cast<double>(GetNumBits());
+  double fill = std::min(static_cast<double>(set_bits) / m, 1.0 - 1e-9);
+  num_inserted_ = static_cast<size_t>(-m / BLOOM_FILTER_NUM_HASHES * std::log(1.0 - fill) + 0.5);
+}
+
+hash_t BloomFilter::HashKey(const Tuple &key, const Schema *schema, uint32_t column_count) {
+  bool inlined = true;
+  for (uint32_t i = 0; i < column_count; i++) {
+    inlined = inlined && schema->GetColumn(i).IsInlined();
+  }
+  if (inlined) {
+    // a key prefix of fixed-width columns is laid out the same in the entry and the search key schema
+    const Column &last = schema->GetColumn(column_count - 1);
+    return HashUtil::HashBytes(key.GetData(), last.GetOffset() + last.GetFixedLength());
+  }
+  hash_t hash = 0;
+  for (uint32_t i = 0; i < column_count; i++) {
+    Value val = key.GetValue(schema, i);
+    hash = HashUtil::CombineHashes(hash, val.IsNull() ? 0 : HashUtil::HashValue(&val));
+  }
+  return hash;
+}
+
+void BloomFilter::Insert(hash_t hash) {
+  std::atomic<uint64_t> *block = &words_[BlockOf(hash) * BLOCK_WORDS];
+  uint64_t slices = BitSlices(hash);
+  bool changed = false;
+  for (int i = 0; i < BLOOM_FILTER_NUM_HASHES; i++, slices >>= 9) {
+    uint64_t bit = slices & (BLOCK_BITS - 1);
+    uint64_t mask = 1ULL << (bit & 63);
+    if ((block[bit >> 6].load(std::memory_order_relaxed) & mask) == 0) {
+      block[bit >> 6].fetch_or(mask, std::memory_order_relaxed);
+      changed = true;
+    }
+  }
+  num_inserted_.fetch_add(1, std::memory_order_relaxed);
+  if (changed) {
+    WriteBlock(BlockOf(hash));
+  }
+}
+
+bool BloomFilter::MayContain(hash_t hash) {
+  probes_.fetch_add(1, std::memory_order_relaxed);
+  const std::atomic<uint64_t> *block = &words_[BlockOf(hash) * BLOCK_WORDS];
+  uint64_t slices = BitSlices(hash);
+  for (int i = 0; i < BLOOM_FILTER_NUM_HASHES; i++, slices >>= 9) {
+    uint64_t bit = slices & (BLOCK_BITS - 1);
+    if ((block[bit >> 6].load(std::memory_order_relaxed) & (1ULL << (bit & 63))) == 0) {
+      negatives_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  }
+  return true;
+}
+
+double BloomFilter::GetExpectedFalsePositiveRate() const {
+  double k = BLOOM_FILTER_NUM_HASHES;
+  return std::pow(1.0 - std::exp(-k * static_cast<double>(GetNumInserted()) / static_cast<double>(GetNumBits())), k);
+}
+
+double BloomFilter::GetObservedFalsePositiveRate() const {
+  uint64_t false_positives = GetNumFalsePositives();
+  uint64_t misses = GetNumNegatives() + false_positives;
+  return misses == 0 ? 0.0 : static_cast<double>(false_positives) / static_cast<double>(misses);
+}
+
+void BloomFilter::WriteBlock(size_t block) {
+  // concurrent writers of one page serialize on its latch; each copies the block after setting its own bits, so
+  // the last copy carries every bit set before it
+  Page *page = FetchFilterPage(buffer_pool_manager_, data_page_ids_[block / BLOCKS_PER_PAGE]);
+  page->WLatch();
+  auto *data = reinterpret_cast<uint64_t *>(page->GetData()) + (block % BLOCKS_PER_PAGE) * BLOCK_WORDS;
+  for (size_t w = 0; w < BLOCK_WORDS; w++) {
+    data[w] = words_[block * BLOCK_WORDS + w].load(std::memory_order_relaxed);
+  }
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+}
+
+}  // namespace bustub
@@ -1,5 +1,6 @@
 #include <vector>
 
+#include "common/exception.h"
 #include "storage/index/extendible_hash_table_index.h"
 
 namespace bustub {
@@ -9,36 +10,56 @@ namespace bustub {
 template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_INDEX_TYPE::ExtendibleHashTableIndex(std::unique_ptr<IndexMetadata> &&metadata,
                                                 BufferPoolManager *buffer_pool_manager,
-                                                const HashFunction<KeyType> &hash_fn)
+                                                const HashFunction<KeyType> &hash_fn, size_t filter_capacity,
+                                                page_id_t filter_page_id)
     : Index(std::move(metadata)),
-      comparator_(GetMetadata()->GetKeySchema()),
-      container_(GetMetadata()->GetName(), buffer_pool_manager, comparator_, hash_fn) {}
+      comparator_(GetMetadata()->GetKeySchema(), GetMetadata()->IsNormalized()),
+      container_(GetMetadata()->GetName(), buffer_pool_manager, comparator_, hash_fn) {
+  if (filter_capacity > 0 || filter_page_id != INVALID_PAGE_ID) {
+    filter_ = std::make_unique<BloomFilter>(buffer_pool_manager, filter_capacity, filter_page_id);
+  }
+}
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
   // construct insert index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  if (!index_key.SetFromKey(key, GetKeySchema(), IsNormalized())) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "index key does not fit in the key size");
+  }
 
+  if (filter_ != nullptr) {
+    filter_->Insert(BloomFilter::HashKey(key, GetKeySchema(), GetIndexColumnCount()));
+  }
   container_.Insert(transaction, index_key, rid);
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
-  // construct delete index key
+  // construct delete index key, a key too large for the index cannot be in it
   KeyType index_key;
-  index_key.SetFromKey(key);
+  if (!index_key.SetFromKey(key, GetKeySchema(), IsNormalized())) {
+    return;
+  }
 
   container_.Remove(transaction, index_key, rid);
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
-  // construct scan index key
+  // construct scan index key, a key too large for the index cannot be in it
   KeyType index_key;
-  index_key.SetFromKey(key);
+  if (!index_key.SetFromKey(key, GetKeySchema(), IsNormalized())) {
+    return;
+  }
 
-  container_.GetValue(transaction, index_key, result);
+  // a definite miss of the filter skips the directory and bucket pages
+  if (filter_ != nullptr && !filter_->MayContain(BloomFilter::HashKey(key, GetKeySchema(), GetIndexColumnCount()))) {
+    return;
+  }
+  if (!container_.GetValue(transaction, index_key, result) && filter_ != nullptr) {
+    filter_->RecordFalsePositive();
+  }
 }
 template class ExtendibleHashTableIndex<GenericKey<4>, RID, GenericComparator<4>>;
 template class ExtendibleHashTableIndex<GenericKey<8>, RID, GenericComparator<8>>;
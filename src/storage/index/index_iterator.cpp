@@ -1,30 +1,161 @@
 /**
  * index_iterator.cpp
  */
+#include <algorithm>
 #include <cassert>
+#include <utility>
 
 #include "storage/index/index_iterator.h"
 
 namespace bustub {
 
-/*
- * NOTE: you can change the destructor/constructor method here
- * set your own input parameters
- */
 INDEX_TEMPLATE_ARGUMENTS
 INDEXITERATOR_TYPE::IndexIterator() = default;
 
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE::~IndexIterator() = default;
+INDEXITERATOR_TYPE::IndexIterator(BufferPoolManager *buffer_pool_manager, Page *page, int index, bool reverse,
+                                  const KeyComparator *comparator, const KeyType *stop_key, bool stop_inclusive)
+    : buffer_pool_manager_(buffer_pool_manager),
+      page_(page),
+      index_(index),
+      reverse_(reverse),
+      comparator_(comparator),
+      has_stop_(stop_key != nullptr),
+      stop_inclusive_(stop_inclusive) {
+  if (has_stop_) {
+    stop_key_ = *stop_key;
+  }
+  Settle();
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::IndexIterator(const IndexIterator &other)
+    : buffer_pool_manager_(other.buffer_pool_manager_),
+      page_(other.page_),
+      index_(other.index_),
+      offset_(other.offset_),
+      reverse_(other.reverse_),
+      comparator_(other.comparator_),
+      has_stop_(other.has_stop_),
+      stop_key_(other.stop_key_),
+      stop_inclusive_(other.stop_inclusive_),
+      values_(other.values_) {
+  if (page_ != nullptr) {
+    // take a pin of our own on the same leaf
+    page_ = buffer_pool_manager_->FetchPage(page_->GetPageId());
+  }
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::IndexIterator(IndexIterator &&other) noexcept
+    : buffer_pool_manager_(other.buffer_pool_manager_),
+      page_(std::exchange(other.page_, nullptr)),
+      index_(other.index_),
+      offset_(other.offset_),
+      reverse_(other.reverse_),
+      comparator_(other.comparator_),
+      has_stop_(other.has_stop_),
+      stop_key_(other.stop_key_),
+      stop_inclusive_(other.stop_inclusive_),
+      values_(std::move(other.values_)) {}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator=(const IndexIterator &other) {
+  if (this != &other) {
+    *this = IndexIterator(other);
+  }
+  return *this;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator=(IndexIterator &&other) noexcept {
+  if (this != &other) {
+    Release();
+    buffer_pool_manager_ = other.buffer_pool_manager_;
+    page_ = std::exchange(other.page_, nullptr);
+    index_ = other.index_;
+    offset_ = other.offset_;
+    reverse_ = other.reverse_;
+    comparator_ = other.comparator_;
+    has_stop_ = other.has_stop_;
+    stop_key_ = other.stop_key_;
+    stop_inclusive_ = other.stop_inclusive_;
+    values_ = std::move(other.values_);
+  }
+  return *this;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE::~IndexIterator() { Release(); }
+
+INDEX_TEMPLATE_ARGUMENTS
+bool INDEXITERATOR_TYPE::IsEnd() { return page_ == nullptr; }
+
+INDEX_TEMPLATE_ARGUMENTS
+const MappingType &INDEXITERATOR_TYPE::operator*() {
+  item_ = {reinterpret_cast<LeafPage *>(page_->GetData())->KeyAt(index_), values_[offset_]};
+  return item_;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator++() {
+  if (++offset_ < static_cast<int>(values_.size())) {
+    return *this;
+  }
+  offset_ = 0;
+  index_ += reverse_ ? -1 : 1;
+  Settle();
+  return *this;
+}
 
 INDEX_TEMPLATE_ARGUMENTS
-bool INDEXITERATOR_TYPE::IsEnd() { throw std::runtime_error("unimplemented"); }
+void INDEXITERATOR_TYPE::Settle() {
+  while (page_ != nullptr) {
+    auto *leaf = reinterpret_cast<LeafPage *>(page_->GetData());
+    if (index_ >= 0 && index_ < leaf->GetSize()) {
+      if (PastStop(leaf->KeyAt(index_))) {
+        // early stop, nothing beyond this key can be in range
+        Release();
+        return;
+      }
+      values_.clear();
+      for (int i = 0; i < leaf->ValueCountAt(index_); i++) {
+        values_.push_back(leaf->ValueAt(index_, i));
+      }
+      BPlusTreeOverflowPage<ValueType>::ScanChain(buffer_pool_manager_, leaf->OverflowPageIdAt(index_), &values_);
+      if (reverse_) {
+        std::reverse(values_.begin(), values_.end());
+      }
+      return;
+    }
+    page_id_t sibling_page_id = reverse_ ? leaf->GetPrevPageId() : leaf->GetNextPageId();
+    Release();
+    if (sibling_page_id != INVALID_PAGE_ID) {
+      page_ = buffer_pool_manager_->FetchPage(sibling_page_id);
+      index_ = (reverse_ && page_ != nullptr) ? reinterpret_cast<LeafPage *>(page_->GetData())->GetSize() - 1 : 0;
+    }
+  }
+}
 
 INDEX_TEMPLATE_ARGUMENTS
-const MappingType &INDEXITERATOR_TYPE::operator*() { throw std::runtime_error("unimplemented"); }
+bool INDEXITERATOR_TYPE::PastStop(const KeyType &key) const {
+  if (!has_stop_) {
+    return false;
+  }
+  int cmp = (*comparator_)(key, stop_key_);
+  if (reverse_) {
+    cmp = -cmp;
+  }
+  return stop_inclusive_ ? cmp > 0 : cmp >= 0;
+}
 
 INDEX_TEMPLATE_ARGUMENTS
-INDEXITERATOR_TYPE &INDEXITERATOR_TYPE::operator++() { throw std::runtime_error("unimplemented"); }
+void INDEXITERATOR_TYPE::Release() {
+  if (page_ != nullptr) {
+    buffer_pool_manager_->UnpinPage(page_->GetPageId(), false);
+    page_ = nullptr;
+  }
+}
 
 template class IndexIterator<GenericKey<4>, RID, GenericComparator<4>>;
 
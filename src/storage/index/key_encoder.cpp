@@ -0,0 +1,206 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// key_encoder.cpp
+//
+// Identification: src/storage/index/key_encoder.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/index/key_encoder.h"
+
+#include <cstring>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+namespace {
+
+/** Appends the low width bytes of val, most significant first. */
+void AppendBigEndian(uint64_t val, int width, std::string *out) {
+  for (int shift = (width - 1) * 8; shift >= 0; shift -= 8) {
+    out->push_back(static_cast<char>((val >> shift) & 0xff));
+  }
+}
+
+/** Appends a signed integer of width bytes; flipping the sign bit makes negative numbers sort first. */
+void AppendSigned(int64_t val, int width, std::string *out) {
+  uint64_t sign = 1ULL << (width * 8 - 1);
+  AppendBigEndian(static_cast<uint64_t>(val) ^ sign, width, out);
+}
+
+uint64_t ReadBigEndian(const char **data, int width) {
+  uint64_t val = 0;
+  for (int i = 0; i < width; i++) {
+    val = (val << 8) | static_cast<uint8_t>((*data)[i]);
+  }
+  *data += width;
+  return val;
+}
+
+int64_t ReadSigned(const char **data, int width) {
+  uint64_t sign = 1ULL << (width * 8 - 1);
+  uint64_t val = ReadBigEndian(data, width) ^ sign;
+  // sign-extend back to 64 bits
+  return static_cast<int64_t>((val ^ sign) - sign);
+}
+
+}  // namespace
+
+void KeyEncoder::EncodeValue(const Value &val, std::string *out) {
+  switch (val.GetTypeId()) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      AppendSigned(val.GetAs<int8_t>(), 1, out);
+      break;
+    case TypeId::SMALLINT:
+      AppendSigned(val.GetAs<int16_t>(), 2, out);
+      break;
+    case TypeId::INTEGER:
+      AppendSigned(val.GetAs<int32_t>(), 4, out);
+      break;
+    case TypeId::BIGINT:
+      AppendSigned(val.GetAs<int64_t>(), 8, out);
+      break;
+    case TypeId::TIMESTAMP:
+      // the null timestamp is the largest value, adding one wraps it around to the smallest encoding
+      AppendBigEndian(val.GetAs<uint64_t>() + 1, 8, out);
+      break;
+    case TypeId::DECIMAL: {
+      // -0.0 equals 0.0, so both take the encoding of 0.0
+      double raw = val.GetAs<double>() == 0.0 ? 0.0 : val.GetAs<double>();
+      uint64_t bits;
+      memcpy(&bits, &raw, sizeof(bits));
+      bits = (bits >> 63) != 0 ? ~bits : bits ^ (1ULL << 63);
+      AppendBigEndian(bits, 8, out);
+      break;
+    }
+    case TypeId::VARCHAR: {
+      if (val.IsNull()) {
+        out->push_back('\0');
+        break;
+      }
+      out->push_back('\1');
+      // the stored length counts the trailing terminator
+      const char *data = val.GetData();
+      for (uint32_t i = 0; i + 1 < val.GetLength(); i++) {
+        out->push_back(data[i]);
+        if (data[i] == '\0') {
+          out->push_back('\1');
+        }
+      }
+      out->push_back('\0');
+      out->push_back('\0');
+      break;
+    }
+    default:
+      BUSTUB_ASSERT(false, "Unsupported key type.");
+  }
+}
+
+size_t KeyEncoder::EncodedWidth(TypeId type) {
+  switch (type) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      return 1;
+    case TypeId::SMALLINT:
+      return 2;
+    case TypeId::INTEGER:
+      return 4;
+    case TypeId::BIGINT:
+    case TypeId::TIMESTAMP:
+    case TypeId::DECIMAL:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+Value KeyEncoder::DecodeValue(const char **data, TypeId type) {
+  switch (type) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      return Value(type, static_cast<int8_t>(ReadSigned(data, 1)));
+    case TypeId::SMALLINT:
+      return Value(type, static_cast<int16_t>(ReadSigned(data, 2)));
+    case TypeId::INTEGER:
+      return Value(type, static_cast<int32_t>(ReadSigned(data, 4)));
+    case TypeId::BIGINT:
+      return Value(type, ReadSigned(data, 8));
+    case TypeId::TIMESTAMP:
+      return Value(type, ReadBigEndian(data, 8) - 1);
+    case TypeId::DECIMAL: {
+      uint64_t bits = ReadBigEndian(data, 8);
+      bits = (bits >> 63) != 0 ? bits ^ (1ULL << 63) : ~bits;
+      double raw;
+      memcpy(&raw, &bits, sizeof(raw));
+      return Value(type, raw);
+    }
+    case TypeId::VARCHAR: {
+      if (*(*data)++ == '\0') {
+        return Value(type, nullptr, 0, false);
+      }
+      std::string str;
+      const char *pos = *data;
+      while (pos[0] != '\0' || pos[1] != '\0') {
+        str.push_back(pos[0]);
+        pos += pos[0] == '\0' ? 2 : 1;
+      }
+      *data = pos + 2;
+      return Value(type, str);
+    }
+    default:
+      UNREACHABLE("Unsupported key type.");
+  }
+}
+
+size_t KeyEncoder::EncodedLength(const char *data, const Schema *schema, uint32_t column_count) {
+  const char *pos = data;
+  for (uint32_t i = 0; i < column_count; i++) {
+    TypeId type = schema->GetColumn(i).GetType();
+    if (type != TypeId::VARCHAR) {
+      pos += EncodedWidth(type);
+    } else if (*pos++ != '\0') {
+      while (pos[0] != '\0' || pos[1] != '\0') {
+        pos += pos[0] == '\0' ? 2 : 1;
+      }
+      pos += 2;
+    }
+  }
+  return pos - data;
+}
+
+size_t KeyEncoder::FixedEncodedLength(const Schema *schema) {
+  size_t length = 0;
+  for (const auto &column : schema->GetColumns()) {
+    if (!column.IsInlined()) {
+      return 0;
+    }
+    length += EncodedWidth(column.GetType());
+  }
+  return length;
+}
+
+size_t KeyEncoder::MaxEncodedLength(const Schema *schema) {
+  size_t length = 0;
+  for (const auto &column : schema->GetColumns()) {
+    // a varchar takes its marker, its characters and the two terminator bytes
+    length += column.IsInlined() ? EncodedWidth(column.GetType()) : column.GetVariableLength() + 3;
+  }
+  return length;
+}
+
+std::string KeyEncoder::Encode(const Tuple &key, const Schema *schema, uint32_t column_count) {
+  std::string out;
+  out.reserve(schema->GetLength() + 2);
+  for (uint32_t i = 0; i < column_count; i++) {
+    EncodeValue(key.GetValue(schema, i), &out);
+  }
+  return out;
+}
+
+}  // namespace bustub
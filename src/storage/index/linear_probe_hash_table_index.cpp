@@ -1,5 +1,6 @@
 #include <vector>
 
+#include "common/exception.h"
 #include "storage/index/linear_probe_hash_table_index.h"
 
 namespace bustub {
@@ -7,36 +8,43 @@ namespace bustub {
  * Constructor
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
-HASH_TABLE_INDEX_TYPE::LinearProbeHashTableIndex(std::unique_ptr<IndexMetadata> &&metadata,
-                                                 BufferPoolManager *buffer_pool_manager, size_t num_buckets,
-                                                 const HashFunction<KeyType> &hash_fn)
+LINEAR_PROBE_HASH_TABLE_INDEX_TYPE::LinearProbeHashTableIndex(std::unique_ptr<IndexMetadata> &&metadata,
+                                                              BufferPoolManager *buffer_pool_manager,
+                                                              size_t num_buckets, const HashFunction<KeyType> &hash_fn)
     : Index(std::move(metadata)),
-      comparator_(GetMetadata()->GetKeySchema()),
+      comparator_(GetMetadata()->GetKeySchema(), GetMetadata()->IsNormalized()),
       container_(GetMetadata()->GetName(), buffer_pool_manager, comparator_, num_buckets, hash_fn) {}
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
+void LINEAR_PROBE_HASH_TABLE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) {
   // construct insert index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  if (!index_key.SetFromKey(key, GetKeySchema(), IsNormalized())) {
+    throw Exception(ExceptionType::OUT_OF_RANGE, "index key does not fit in the key size");
+  }
 
   container_.Insert(transaction, index_key, rid);
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
-  // construct delete index key
+void LINEAR_PROBE_HASH_TABLE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
+  // construct delete index key, a key too large for the index cannot be in it
   KeyType index_key;
-  index_key.SetFromKey(key);
+  if (!index_key.SetFromKey(key, GetKeySchema(), IsNormalized())) {
+    return;
+  }
 
   container_.Remove(transaction, index_key, rid);
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
-  // construct scan index key
+void LINEAR_PROBE_HASH_TABLE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result,
+                                                 Transaction *transaction) {
+  // construct scan index key, a key too large for the index cannot be in it
   KeyType index_key;
-  index_key.SetFromKey(key);
+  if (!index_key.SetFromKey(key, GetKeySchema(), IsNormalized())) {
+    return;
+  }
 
   container_.GetValue(transaction, index_key, result);
 }
@@ -9,6 +9,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 #include "common/exception.h"
@@ -27,106 +29,318 @@ namespace bustub {
  * next page id and set max size
  */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_LEAF_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id, int max_size) {}
+void B_PLUS_TREE_LEAF_PAGE_TYPE::Init(page_id_t page_id, page_id_t parent_id, int max_size) {
+  SetPageType(IndexPageType::LEAF_PAGE);
+  SetLSN(INVALID_LSN);
+  SetSize(0);
+  SetPageId(page_id);
+  SetParentPageId(parent_id);
+  SetMaxSize(max_size);
+  next_page_id_ = INVALID_PAGE_ID;
+  prev_page_id_ = INVALID_PAGE_ID;
+  value_count_ = 0;
+}
 
 /**
- * Helper methods to set/get next page id
+ * Helper methods to set/get next and previous page id, the leaf level forms a
+ * doubly linked list so it can be scanned in both directions
  */
 INDEX_TEMPLATE_ARGUMENTS
-page_id_t B_PLUS_TREE_LEAF_PAGE_TYPE::GetNextPageId() const { return INVALID_PAGE_ID; }
+page_id_t B_PLUS_TREE_LEAF_PAGE_TYPE::GetNextPageId() const { return next_page_id_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+INDEX_TEMPLATE_ARGUMENTS
+page_id_t B_PLUS_TREE_LEAF_PAGE_TYPE::GetPrevPageId() const { return prev_page_id_; }
 
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_LEAF_PAGE_TYPE::SetNextPageId(page_id_t next_page_id) {}
+void B_PLUS_TREE_LEAF_PAGE_TYPE::SetPrevPageId(page_id_t prev_page_id) { prev_page_id_ = prev_page_id; }
 
 /**
  * Helper method to find the first index i so that array[i].first >= key
  * NOTE: This method is only used when generating index iterator
  */
 INDEX_TEMPLATE_ARGUMENTS
-int B_PLUS_TREE_LEAF_PAGE_TYPE::KeyIndex(const KeyType &key, const KeyComparator &comparator) const { return 0; }
+int B_PLUS_TREE_LEAF_PAGE_TYPE::KeyIndex(const KeyType &key, const KeyComparator &comparator) const {
+  int lo = 0;
+  int hi = GetSize();
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (comparator(array_[mid].key_, key) < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/*
+ * Helper method to find the first index i so that array[i].key > key
+ */
+INDEX_TEMPLATE_ARGUMENTS
+int B_PLUS_TREE_LEAF_PAGE_TYPE::UpperKeyIndex(const KeyType &key, const KeyComparator &comparator) const {
+  int lo = 0;
+  int hi = GetSize();
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (comparator(array_[mid].key_, key) <= 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
 
 /*
  * Helper method to find and return the key associated with input "index"(a.k.a
  * array offset)
  */
 INDEX_TEMPLATE_ARGUMENTS
-KeyType B_PLUS_TREE_LEAF_PAGE_TYPE::KeyAt(int index) const {
-  // replace with your own code
-  KeyType key{};
-  return key;
+KeyType B_PLUS_TREE_LEAF_PAGE_TYPE::KeyAt(int index) const { return array_[index].key_; }
+
+/*
+ * Helper methods to read the posting list of the key at "index". Only the
+ * inline values are visible here, the rest is reachable via the overflow chain.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+int B_PLUS_TREE_LEAF_PAGE_TYPE::ValueCountAt(int index) const { return array_[index].count_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+ValueType B_PLUS_TREE_LEAF_PAGE_TYPE::ValueAt(int index, int offset) const {
+  return ValuePool()[array_[index].start_ + offset];
 }
 
 /*
- * Helper method to find and return the key & value pair associated with input
- * "index"(a.k.a array offset)
+ * @return  offset of value inside the inline posting list of "index", -1 if absent
  */
 INDEX_TEMPLATE_ARGUMENTS
-const MappingType &B_PLUS_TREE_LEAF_PAGE_TYPE::GetItem(int index) {
-  // replace with your own code
-  return array_[0];
+int B_PLUS_TREE_LEAF_PAGE_TYPE::ValueIndexAt(int index, const ValueType &value) const {
+  const ValueType *values = ValuePool() + array_[index].start_;
+  for (int i = 0; i < array_[index].count_; i++) {
+    if (values[i] == value) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+page_id_t B_PLUS_TREE_LEAF_PAGE_TYPE::OverflowPageIdAt(int index) const { return array_[index].overflow_page_id_; }
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::SetOverflowPageIdAt(int index, page_id_t overflow_page_id) {
+  array_[index].overflow_page_id_ = overflow_page_id;
+}
+
+/*
+ * A leaf is full once it holds max size keys or can no longer take one more
+ * key with a single value. Both entries and posting lists share the page.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool B_PLUS_TREE_LEAF_PAGE_TYPE::IsFull() const {
+  return GetSize() >= GetMaxSize() || FreeBytes() < static_cast<int>(sizeof(LeafEntry) + sizeof(ValueType));
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+int B_PLUS_TREE_LEAF_PAGE_TYPE::EntryBytes(int index) const {
+  return static_cast<int>(sizeof(LeafEntry) + array_[index].count_ * sizeof(ValueType));
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+int B_PLUS_TREE_LEAF_PAGE_TYPE::FreeBytes() const {
+  return PAGE_SIZE - LEAF_PAGE_HEADER_SIZE - GetSize() * static_cast<int>(sizeof(LeafEntry)) -
+         value_count_ * static_cast<int>(sizeof(ValueType));
 }
 
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
 /*
- * Insert key & value pair into leaf page ordered by key
+ * Insert a new key with a single value into leaf page ordered by key. The
+ * caller must make sure that the key is not present yet.
  * @return  page size after insertion
  */
 INDEX_TEMPLATE_ARGUMENTS
 int B_PLUS_TREE_LEAF_PAGE_TYPE::Insert(const KeyType &key, const ValueType &value, const KeyComparator &comparator) {
-  return 0;
+  int index = KeyIndex(key, comparator);
+  int offset = index < GetSize() ? array_[index].start_ : value_count_;
+  OpenValueGap(offset, 1);
+  ValuePool()[offset] = value;
+  std::memmove(array_ + index + 1, array_ + index, (GetSize() - index) * sizeof(LeafEntry));
+  IncreaseSize(1);
+  ShiftStarts(index + 1, 1);
+  array_[index].key_ = key;
+  array_[index].start_ = offset;
+  array_[index].count_ = 1;
+  array_[index].overflow_page_id_ = INVALID_PAGE_ID;
+  return GetSize();
+}
+
+/*
+ * Append value to the inline posting list of the key at "index"
+ * @return  false if the posting list already holds LEAF_POSTING_INLINE_MAX
+ * values or the page has no room left, the value then belongs in overflow
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool B_PLUS_TREE_LEAF_PAGE_TYPE::AppendValue(int index, const ValueType &value) {
+  if (array_[index].count_ >= LEAF_POSTING_INLINE_MAX || FreeBytes() < static_cast<int>(sizeof(ValueType))) {
+    return false;
+  }
+  int offset = array_[index].start_ + array_[index].count_;
+  OpenValueGap(offset, 1);
+  ValuePool()[offset] = value;
+  array_[index].count_++;
+  ShiftStarts(index + 1, 1);
+  return true;
 }
 
 /*****************************************************************************
  * SPLIT
  *****************************************************************************/
 /*
- * Remove half of key & value pairs from this page to "recipient" page
+ * Remove half of key & value pairs from this page to "recipient" page, which
+ * is linked in right after me; the caller fixes the back link of the page
+ * that follows. The
+ * split point balances bytes rather than keys since posting lists differ in
+ * length, but each side keeps at least one key.
  */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveHalfTo(BPlusTreeLeafPage *recipient) {}
+void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveHalfTo(BPlusTreeLeafPage *recipient) {
+  int total = PAGE_SIZE - LEAF_PAGE_HEADER_SIZE - FreeBytes();
+  int used = 0;
+  int keep = 0;
+  while (keep < GetSize() - 1 && used + EntryBytes(keep) <= total / 2) {
+    used += EntryBytes(keep);
+    keep++;
+  }
+  keep = std::max(keep, 1);
+  recipient->CopyNFrom(this, keep, GetSize() - keep, recipient->GetSize());
+  RemoveN(keep, GetSize() - keep);
+  recipient->SetNextPageId(GetNextPageId());
+  recipient->SetPrevPageId(GetPageId());
+  SetNextPageId(recipient->GetPageId());
+}
 
 /*
- * Copy starting from items, and copy {size} number of elements into me.
+ * Copy {size} entries of "src" starting from "from", together with their
+ * inline posting lists, into me at position "at".
  */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_LEAF_PAGE_TYPE::CopyNFrom(MappingType *items, int size) {}
+void B_PLUS_TREE_LEAF_PAGE_TYPE::CopyNFrom(const BPlusTreeLeafPage *src, int from, int size, int at) {
+  if (size == 0) {
+    return;
+  }
+  int src_start = src->array_[from].start_;
+  int values = 0;
+  for (int i = from; i < from + size; i++) {
+    values += src->array_[i].count_;
+  }
+  int offset = at < GetSize() ? array_[at].start_ : value_count_;
+  OpenValueGap(offset, values);
+  std::memcpy(ValuePool() + offset, src->ValuePool() + src_start, values * sizeof(ValueType));
+  std::memmove(array_ + at + size, array_ + at, (GetSize() - at) * sizeof(LeafEntry));
+  IncreaseSize(size);
+  ShiftStarts(at + size, values);
+  for (int i = 0; i < size; i++) {
+    array_[at + i] = src->array_[from + i];
+    array_[at + i].start_ = offset + src->array_[from + i].start_ - src_start;
+  }
+}
 
 /*****************************************************************************
  * LOOKUP
  *****************************************************************************/
 /*
  * For the given key, check to see whether it exists in the leaf page. If it
- * does, then store its corresponding value in input "value" and return true.
+ * does, then store its array offset in input "index" and return true.
  * If the key does not exist, then return false
  */
 INDEX_TEMPLATE_ARGUMENTS
-bool B_PLUS_TREE_LEAF_PAGE_TYPE::Lookup(const KeyType &key, ValueType *value, const KeyComparator &comparator) const {
+bool B_PLUS_TREE_LEAF_PAGE_TYPE::Lookup(const KeyType &key, int *index, const KeyComparator &comparator) const {
+  int i = KeyIndex(key, comparator);
+  if (i < GetSize() && comparator(array_[i].key_, key) == 0) {
+    *index = i;
+    return true;
+  }
   return false;
 }
 
 /*****************************************************************************
  * REMOVE
  *****************************************************************************/
+/*
+ * Remove the value at "offset" from the inline posting list of "index". The
+ * key itself stays, even when its inline posting list becomes empty.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::RemoveValue(int index, int offset) {
+  CloseValueGap(array_[index].start_ + offset, 1);
+  array_[index].count_--;
+  ShiftStarts(index + 1, -1);
+}
+
 /*
  * First look through leaf page to see whether delete key exist or not. If
- * exist, perform deletion, otherwise return immediately.
+ * exist, delete the key and its whole inline posting list, otherwise return
+ * immediately. Overflow pages of the key are left to the caller.
  * NOTE: store key&value pair continuously after deletion
  * @return   page size after deletion
  */
 INDEX_TEMPLATE_ARGUMENTS
-int B_PLUS_TREE_LEAF_PAGE_TYPE::RemoveAndDeleteRecord(const KeyType &key, const KeyComparator &comparator) { return 0; }
+int B_PLUS_TREE_LEAF_PAGE_TYPE::RemoveAndDeleteRecord(const KeyType &key, const KeyComparator &comparator) {
+  int index;
+  if (Lookup(key, &index, comparator)) {
+    RemoveN(index, 1);
+  }
+  return GetSize();
+}
+
+/*
+ * Remove {size} entries starting from "from" together with their inline
+ * posting lists.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::RemoveN(int from, int size) {
+  if (size == 0) {
+    return;
+  }
+  int values = 0;
+  for (int i = from; i < from + size; i++) {
+    values += array_[i].count_;
+  }
+  CloseValueGap(array_[from].start_, values);
+  std::memmove(array_ + from, array_ + from + size, (GetSize() - from - size) * sizeof(LeafEntry));
+  IncreaseSize(-size);
+  ShiftStarts(from, -values);
+}
 
 /*****************************************************************************
  * MERGE
  *****************************************************************************/
+/*
+ * @return  true if every entry of "other" fits into me without making me full
+ */
+INDEX_TEMPLATE_ARGUMENTS
+bool B_PLUS_TREE_LEAF_PAGE_TYPE::CanAbsorb(const BPlusTreeLeafPage *other) const {
+  int other_bytes = PAGE_SIZE - LEAF_PAGE_HEADER_SIZE - other->FreeBytes();
+  return GetSize() + other->GetSize() < GetMaxSize() &&
+         FreeBytes() - other_bytes >= static_cast<int>(sizeof(LeafEntry) + sizeof(ValueType));
+}
+
 /*
  * Remove all of key & value pairs from this page to "recipient" page. Don't forget
- * to update the next_page id in the sibling page
+ * to update the next_page id in the sibling page; the back link of the page
+ * after me is left to the caller
  */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveAllTo(BPlusTreeLeafPage *recipient) {}
+void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveAllTo(BPlusTreeLeafPage *recipient) {
+  recipient->CopyNFrom(this, 0, GetSize(), recipient->GetSize());
+  recipient->SetNextPageId(GetNextPageId());
+  RemoveN(0, GetSize());
+}
 
 /*****************************************************************************
  * REDISTRIBUTE
@@ -135,25 +349,61 @@ void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveAllTo(BPlusTreeLeafPage *recipient) {}
  * Remove the first key & value pair from this page to "recipient" page.
  */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveFirstToEndOf(BPlusTreeLeafPage *recipient) {}
+void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveFirstToEndOf(BPlusTreeLeafPage *recipient) {
+  recipient->CopyNFrom(this, 0, 1, recipient->GetSize());
+  RemoveN(0, 1);
+}
 
 /*
- * Copy the item into the end of my item list. (Append item to my array)
+ * Remove the last key & value pair from this page to "recipient" page.
  */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_LEAF_PAGE_TYPE::CopyLastFrom(const MappingType &item) {}
+void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveLastToFrontOf(BPlusTreeLeafPage *recipient) {
+  recipient->CopyNFrom(this, GetSize() - 1, 1, 0);
+  RemoveN(GetSize() - 1, 1);
+}
 
+/*****************************************************************************
+ * VALUE POOL
+ *****************************************************************************/
 /*
- * Remove the last key & value pair from this page to "recipient" page.
+ * The value pool ends at the end of the page and grows downwards, offsets are
+ * counted from its current lowest address.
  */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_LEAF_PAGE_TYPE::MoveLastToFrontOf(BPlusTreeLeafPage *recipient) {}
+ValueType *B_PLUS_TREE_LEAF_PAGE_TYPE::ValuePool() {
+  return reinterpret_cast<ValueType *>(reinterpret_cast<char *>(this) + PAGE_SIZE) - value_count_;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+const ValueType *B_PLUS_TREE_LEAF_PAGE_TYPE::ValuePool() const {
+  return reinterpret_cast<const ValueType *>(reinterpret_cast<const char *>(this) + PAGE_SIZE) - value_count_;
+}
 
 /*
- * Insert item at the front of my items. Move items accordingly.
+ * Make room for {count} values at pool offset "offset", values before the gap
+ * move down so that the ones after it keep their address.
  */
 INDEX_TEMPLATE_ARGUMENTS
-void B_PLUS_TREE_LEAF_PAGE_TYPE::CopyFirstFrom(const MappingType &item) {}
+void B_PLUS_TREE_LEAF_PAGE_TYPE::OpenValueGap(int offset, int count) {
+  ValueType *pool = ValuePool();
+  std::memmove(pool - count, pool, offset * sizeof(ValueType));
+  value_count_ += count;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::CloseValueGap(int offset, int count) {
+  ValueType *pool = ValuePool();
+  std::memmove(pool + count, pool, offset * sizeof(ValueType));
+  value_count_ -= count;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void B_PLUS_TREE_LEAF_PAGE_TYPE::ShiftStarts(int from, int delta) {
+  for (int i = from; i < GetSize(); i++) {
+    array_[i].start_ += delta;
+  }
+}
 
 template class BPlusTreeLeafPage<GenericKey<4>, RID, GenericComparator<4>>;
 template class BPlusTreeLeafPage<GenericKey<8>, RID, GenericComparator<8>>;
@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         CMU-DB Project (15-445/645)
+//                         ***DO NO SHARE PUBLICLY***
+//
+// Identification: src/page/b_plus_tree_overflow_page.cpp
+//
+// Copyright (c) 2018, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/b_plus_tree_overflow_page.h"
+
+#include "common/exception.h"
+
+namespace bustub {
+
+template <typename ValueType>
+void B_PLUS_TREE_OVERFLOW_PAGE_TYPE::Init(page_id_t page_id, page_id_t next_page_id) {
+  page_id_ = page_id;
+  lsn_ = INVALID_LSN;
+  next_page_id_ = next_page_id;
+  size_ = 0;
+}
+
+template <typename ValueType>
+int B_PLUS_TREE_OVERFLOW_PAGE_TYPE::ValueIndex(const ValueType &value) const {
+  for (int i = 0; i < size_; i++) {
+    if (array_[i] == value) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+template <typename ValueType>
+bool B_PLUS_TREE_OVERFLOW_PAGE_TYPE::Append(const ValueType &value) {
+  if (IsFull()) {
+    return false;
+  }
+  array_[size_++] = value;
+  return true;
+}
+
+template <typename ValueType>
+void B_PLUS_TREE_OVERFLOW_PAGE_TYPE::RemoveAt(int index) {
+  array_[index] = array_[size_ - 1];
+  size_--;
+}
+
+template <typename ValueType>
+ValueType B_PLUS_TREE_OVERFLOW_PAGE_TYPE::PopBack() {
+  return array_[--size_];
+}
+
+template <typename ValueType>
+void B_PLUS_TREE_OVERFLOW_PAGE_TYPE::ScanChain(BufferPoolManager *buffer_pool_manager, page_id_t head_page_id,
+                                               std::vector<ValueType> *result) {
+  page_id_t page_id = head_page_id;
+  while (page_id != INVALID_PAGE_ID) {
+    Page *page = buffer_pool_manager->FetchPage(page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "cannot fetch overflow page");
+    }
+    auto *overflow = reinterpret_cast<BPlusTreeOverflowPage *>(page->GetData());
+    result->insert(result->end(), overflow->array_, overflow->array_ + overflow->size_);
+    page_id_t next_page_id = overflow->next_page_id_;
+    buffer_pool_manager->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+template class BPlusTreeOverflowPage<RID>;
+
+}  // namespace bustub
@@ -11,6 +11,13 @@
 //===----------------------------------------------------------------------===//
 
 #include "storage/page/hash_table_bucket_page.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+
 #include "common/logger.h"
 #include "common/util/hash_util.h"
 #include "storage/index/generic_key.h"
@@ -20,62 +27,163 @@
 namespace bustub {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-bool HASH_TABLE_BUCKET_TYPE::GetValue(KeyType key, KeyComparator cmp, std::vector<ValueType> *result) {
-  return false;
+bool HASH_TABLE_BUCKET_TYPE::GetValue(KeyType key, KeyComparator cmp, std::vector<ValueType> *result, uint8_t tag) {
+  bool found = false;
+  uint32_t occupied = OccupiedCount();
+  for (uint32_t start = 0; start < occupied; start += BUCKET_TAG_LANES) {
+    // only slots whose fingerprint matches are worth a key comparison
+    for (uint32_t mask = MatchTags(start, tag); mask != 0; mask &= mask - 1) {
+      uint32_t bucket_idx = start + __builtin_ctz(mask);
+      if (cmp(array_[bucket_idx].first, key) == 0) {
+        result->push_back(array_[bucket_idx].second);
+        found = true;
+      }
+    }
+  }
+  return found;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-bool HASH_TABLE_BUCKET_TYPE::Insert(KeyType key, ValueType value, KeyComparator cmp) {
-  return true;
+bool HASH_TABLE_BUCKET_TYPE::Insert(KeyType key, ValueType value, KeyComparator cmp, uint8_t tag) {
+  uint32_t occupied = OccupiedCount();
+  for (uint32_t start = 0; start < occupied; start += BUCKET_TAG_LANES) {
+    for (uint32_t mask = MatchTags(start, tag); mask != 0; mask &= mask - 1) {
+      uint32_t bucket_idx = start + __builtin_ctz(mask);
+      if (cmp(array_[bucket_idx].first, key) == 0 && array_[bucket_idx].second == value) {
+        return false;
+      }
+    }
+  }
+
+  // the first slot that is not readable is either a tombstone or has never been used
+  for (uint32_t byte_idx = 0; byte_idx < sizeof(readable_); byte_idx++) {
+    auto free_bits = static_cast<uint8_t>(~readable_[byte_idx]);
+    if (free_bits == 0) {
+      continue;
+    }
+    uint32_t bucket_idx = byte_idx * 8 + __builtin_ctz(free_bits);
+    if (bucket_idx >= BUCKET_ARRAY_SIZE) {
+      break;
+    }
+    array_[bucket_idx] = MappingType(key, value);
+    tags_[bucket_idx] = tag;
+    SetOccupied(bucket_idx);
+    SetReadable(bucket_idx);
+    return true;
+  }
+  return false;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-bool HASH_TABLE_BUCKET_TYPE::Remove(KeyType key, ValueType value, KeyComparator cmp) {
+bool HASH_TABLE_BUCKET_TYPE::Remove(KeyType key, ValueType value, KeyComparator cmp, uint8_t tag) {
+  uint32_t occupied = OccupiedCount();
+  for (uint32_t start = 0; start < occupied; start += BUCKET_TAG_LANES) {
+    for (uint32_t mask = MatchTags(start, tag); mask != 0; mask &= mask - 1) {
+      uint32_t bucket_idx = start + __builtin_ctz(mask);
+      if (cmp(array_[bucket_idx].first, key) == 0 && array_[bucket_idx].second == value) {
+        RemoveAt(bucket_idx);
+        return true;
+      }
+    }
+  }
   return false;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 KeyType HASH_TABLE_BUCKET_TYPE::KeyAt(uint32_t bucket_idx) const {
-  return {};
+  return array_[bucket_idx].first;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 ValueType HASH_TABLE_BUCKET_TYPE::ValueAt(uint32_t bucket_idx) const {
-  return {};
+  return array_[bucket_idx].second;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_BUCKET_TYPE::RemoveAt(uint32_t bucket_idx) {}
+uint8_t HASH_TABLE_BUCKET_TYPE::TagAt(uint32_t bucket_idx) const {
+  return tags_[bucket_idx];
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_BUCKET_TYPE::RemoveAt(uint32_t bucket_idx) {
+  // leave a tombstone, the slot stays occupied
+  readable_[bucket_idx / 8] &= static_cast<char>(~(1 << (bucket_idx % 8)));
+}
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_BUCKET_TYPE::IsOccupied(uint32_t bucket_idx) const {
-  return false;
+  return (occupied_[bucket_idx / 8] & (1 << (bucket_idx % 8))) != 0;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_BUCKET_TYPE::SetOccupied(uint32_t bucket_idx) {}
+void HASH_TABLE_BUCKET_TYPE::SetOccupied(uint32_t bucket_idx) {
+  occupied_[bucket_idx / 8] |= static_cast<char>(1 << (bucket_idx % 8));
+}
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_BUCKET_TYPE::IsReadable(uint32_t bucket_idx) const {
-  return false;
+  return (readable_[bucket_idx / 8] & (1 << (bucket_idx % 8))) != 0;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_BUCKET_TYPE::SetReadable(uint32_t bucket_idx) {}
+void HASH_TABLE_BUCKET_TYPE::SetReadable(uint32_t bucket_idx) {
+  readable_[bucket_idx / 8] |= static_cast<char>(1 << (bucket_idx % 8));
+}
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_BUCKET_TYPE::IsFull() {
-  return false;
+  return NumReadable() == BUCKET_ARRAY_SIZE;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 uint32_t HASH_TABLE_BUCKET_TYPE::NumReadable() {
-  return 0;
+  uint32_t count = 0;
+  for (auto byte : readable_) {
+    count += __builtin_popcount(static_cast<unsigned char>(byte));
+  }
+  return count;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 bool HASH_TABLE_BUCKET_TYPE::IsEmpty() {
-  return false;
+  for (auto byte : readable_) {
+    if (byte != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t HASH_TABLE_BUCKET_TYPE::OccupiedCount() const {
+  for (uint32_t byte_idx = 0; byte_idx < sizeof(occupied_); byte_idx++) {
+    auto free_bits = static_cast<uint8_t>(~occupied_[byte_idx]);
+    if (free_bits != 0) {
+      return std::min<uint32_t>(byte_idx * 8 + __builtin_ctz(free_bits), BUCKET_ARRAY_SIZE);
+    }
+  }
+  return BUCKET_ARRAY_SIZE;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+uint32_t HASH_TABLE_BUCKET_TYPE::MatchTags(uint32_t start, uint8_t tag) const {
+#if defined(__SSE2__)
+  static_assert(BUCKET_TAG_LANES == 16, "one SSE2 register holds 16 fingerprints");
+  __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tags_ + start));
+  __m128i matches = _mm_cmpeq_epi8(lanes, _mm_set1_epi8(static_cast<char>(tag)));
+  auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+#else
+  uint32_t mask = 0;
+  for (uint32_t i = 0; i < BUCKET_TAG_LANES; i++) {
+    mask |= static_cast<uint32_t>(tags_[start + i] == tag) << i;
+  }
+#endif
+  // tombstones and never used slots are not readable, which also masks out the padding past the last slot
+  uint32_t readable = static_cast<uint8_t>(readable_[start / 8]);
+  if (start / 8 + 1 < sizeof(readable_)) {
+    readable |= static_cast<uint32_t>(static_cast<uint8_t>(readable_[start / 8 + 1])) << 8;
+  }
+  return mask & readable;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
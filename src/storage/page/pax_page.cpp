@@ -0,0 +1,881 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_page.cpp
+//
+// Identification: src/storage/page/pax_page.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/pax_page.h"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "type/limits.h"
+
+namespace bustub {
+
+namespace {
+
+/** The bytes of the variable-length heap planned for every tail row and VARCHAR column when the tail is laid out */
+constexpr uint32_t VARLEN_RESERVE = 32;
+
+/** Segments and minipages start on multiples of this */
+constexpr uint32_t MINIPAGE_ALIGNMENT = 8;
+
+/** The size of the header of a frame-of-reference segment: the reference, then the code width */
+constexpr uint32_t SIZE_FOR_HEADER = 16;
+
+/** The size of the header of a run-length or dictionary segment: the number of runs or entries, then padding */
+constexpr uint32_t SIZE_RLE_HEADER = 8;
+constexpr uint32_t SIZE_DICTIONARY_HEADER = 8;
+
+/** The length-prefixed bytes of a null VARCHAR */
+constexpr uint32_t NULL_VARLEN = BUSTUB_VALUE_NULL;
+
+uint32_t AlignMinipage(uint32_t offset) {
+  return (offset + MINIPAGE_ALIGNMENT - 1) / MINIPAGE_ALIGNMENT * MINIPAGE_ALIGNMENT;
+}
+
+/** @return the size of the length-prefixed bytes of a VARCHAR at data */
+uint32_t VarlenItemSize(const char *data) {
+  uint32_t len = *reinterpret_cast<const uint32_t *>(data);
+  return sizeof(uint32_t) + (len == BUSTUB_VALUE_NULL ? 0 : len);
+}
+
+/** @return true if the values of type are integers, booleans or timestamps */
+bool IsIntegerType(TypeId type) { return type != TypeId::DECIMAL && type != TypeId::VARCHAR; }
+
+/** Widen the inlined integer, boolean or timestamp at data into value, @return false if it is null */
+bool ReadInteger(TypeId type, const char *data, int64_t *value) {
+  switch (type) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      *value = *reinterpret_cast<const int8_t *>(data);
+      return *value != BUSTUB_INT8_NULL;
+    case TypeId::SMALLINT:
+      *value = *reinterpret_cast<const int16_t *>(data);
+      return *value != BUSTUB_INT16_NULL;
+    case TypeId::INTEGER:
+      *value = *reinterpret_cast<const int32_t *>(data);
+      return *value != BUSTUB_INT32_NULL;
+    case TypeId::BIGINT:
+      *value = *reinterpret_cast<const int64_t *>(data);
+      return *value != BUSTUB_INT64_NULL;
+    case TypeId::TIMESTAMP:
+      *value = *reinterpret_cast<const int64_t *>(data);
+      return static_cast<uint64_t>(*value) != BUSTUB_TIMESTAMP_NULL;
+    default:
+      UNREACHABLE("Not an integer type.");
+  }
+}
+
+/** Narrow value back into the inlined layout of type at data, or write the null of type if is_null. */
+void WriteInteger(TypeId type, int64_t value, bool is_null, char *data) {
+  switch (type) {
+    case TypeId::BOOLEAN:
+    case TypeId::TINYINT:
+      *reinterpret_cast<int8_t *>(data) = is_null ? BUSTUB_INT8_NULL : static_cast<int8_t>(value);
+      break;
+    case TypeId::SMALLINT:
+      *reinterpret_cast<int16_t *>(data) = is_null ? BUSTUB_INT16_NULL : static_cast<int16_t>(value);
+      break;
+    case TypeId::INTEGER:
+      *reinterpret_cast<int32_t *>(data) = is_null ? BUSTUB_INT32_NULL : static_cast<int32_t>(value);
+      break;
+    case TypeId::BIGINT:
+      *reinterpret_cast<int64_t *>(data) = is_null ? BUSTUB_INT64_NULL : value;
+      break;
+    case TypeId::TIMESTAMP:
+      *reinterpret_cast<uint64_t *>(data) = is_null ? BUSTUB_TIMESTAMP_NULL : static_cast<uint64_t>(value);
+      break;
+    default:
+      UNREACHABLE("Not an integer type.");
+  }
+}
+
+/** Write the null of an inlined type at data. */
+void WriteNull(TypeId type, char *data) {
+  if (type == TypeId::DECIMAL) {
+    *reinterpret_cast<double *>(data) = BUSTUB_DECIMAL_NULL;
+  } else {
+    WriteInteger(type, 0, true, data);
+  }
+}
+
+/** @return the number of bits needed to write value */
+uint8_t BitsFor(uint64_t value) {
+  uint8_t bits = 0;
+  for (; value != 0; value >>= 1) {
+    bits++;
+  }
+  return bits;
+}
+
+/** @return the number of bytes n codes of the given width take, bit-packed into 64-bit words */
+uint32_t PackedSize(uint32_t n, uint8_t bits) {
+  return (static_cast<uint64_t>(n) * bits + 63) / 64 * sizeof(uint64_t);
+}
+
+/** Write the i-th code of the given width into the zeroed words. */
+void Pack(uint64_t *words, uint32_t i, uint8_t bits, uint64_t code) {
+  if (bits == 0) {
+    return;
+  }
+  uint64_t bit = static_cast<uint64_t>(i) * bits;
+  uint32_t shift = bit % 64;
+  words[bit / 64] |= code << shift;
+  if (shift + bits > 64) {
+    words[bit / 64 + 1] |= code >> (64 - shift);
+  }
+}
+
+/** @return the i-th code of the given width in the words */
+uint64_t Unpack(const uint64_t *words, uint32_t i, uint8_t bits) {
+  if (bits == 0) {
+    return 0;
+  }
+  uint64_t bit = static_cast<uint64_t>(i) * bits;
+  uint32_t shift = bit % 64;
+  uint64_t code = words[bit / 64] >> shift;
+  if (shift + bits > 64) {
+    code |= words[bit / 64 + 1] << (64 - shift);
+  }
+  return bits == 64 ? code : code & ((uint64_t{1} << bits) - 1);
+}
+
+/** Pad segment to a multiple of the alignment. */
+void PadSegment(std::string *segment) { segment->resize(AlignMinipage(segment->size()), '\0'); }
+
+/** @return the values, as they are inlined in a tuple, one after the other */
+std::string EncodePlain(const std::vector<const char *> &values, uint16_t width) {
+  std::string segment;
+  segment.reserve(width * values.size());
+  for (const char *value : values) {
+    segment.append(value, width);
+  }
+  return segment;
+}
+
+/** @return the offset of the length-prefixed bytes of every VARCHAR, then the bytes, one after the other */
+std::string EncodePlainVarlen(const std::vector<const char *> &items) {
+  std::string segment(sizeof(uint16_t) * items.size(), '\0');
+  for (uint32_t i = 0; i < items.size(); i++) {
+    auto offset = static_cast<uint16_t>(segment.size());
+    memcpy(segment.data() + sizeof(uint16_t) * i, &offset, sizeof(uint16_t));
+    segment.append(items[i], VarlenItemSize(items[i]));
+  }
+  return segment;
+}
+
+/**
+ * Encode integers as their distance to the smallest one, plus one, bit-packed with as many bits as the largest
+ * distance takes. Null values get code 0.
+ * @return false if the distances do not fit in 64 bits
+ */
+bool EncodeFrameOfReference(TypeId type, const std::vector<const char *> &values, std::string *segment) {
+  int64_t min = 0;
+  int64_t max = 0;
+  bool any = false;
+  for (const char *data : values) {
+    int64_t value;
+    if (ReadInteger(type, data, &value)) {
+      min = any ? std::min(min, value) : value;
+      max = any ? std::max(max, value) : value;
+      any = true;
+    }
+  }
+  uint64_t range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+  if (range == UINT64_MAX) {
+    return false;
+  }
+  uint8_t bits = any ? BitsFor(range + 1) : 0;
+  segment->assign(SIZE_FOR_HEADER + PackedSize(values.size(), bits), '\0');
+  memcpy(segment->data(), &min, sizeof(int64_t));
+  memcpy(segment->data() + sizeof(int64_t), &bits, sizeof(uint8_t));
+  auto *words = reinterpret_cast<uint64_t *>(segment->data() + SIZE_FOR_HEADER);
+  for (uint32_t i = 0; i < values.size(); i++) {
+    int64_t value;
+    if (ReadInteger(type, values[i], &value)) {
+      Pack(words, i, bits, static_cast<uint64_t>(value) - static_cast<uint64_t>(min) + 1);
+    }
+  }
+  return true;
+}
+
+/** @return the number of runs of equal values, the row every run ends before, then the value of every run */
+std::string EncodeRunLength(const std::vector<const char *> &values, uint16_t width) {
+  std::vector<uint32_t> ends;
+  std::string run_values;
+  for (uint32_t i = 0; i < values.size(); i++) {
+    if (i > 0 && memcmp(values[i], values[i - 1], width) == 0) {
+      ends.back() = i + 1;
+      continue;
+    }
+    ends.push_back(i + 1);
+    run_values.append(values[i], width);
+  }
+  auto runs = static_cast<uint32_t>(ends.size());
+  std::string segment(SIZE_RLE_HEADER + sizeof(uint32_t) * runs, '\0');
+  memcpy(segment.data(), &runs, sizeof(uint32_t));
+  memcpy(segment.data() + SIZE_RLE_HEADER, ends.data(), sizeof(uint32_t) * runs);
+  return segment + run_values;
+}
+
+/**
+ * @return the number of distinct VARCHARs and the width of their codes, the offset of every distinct VARCHAR, the
+ * code of every row bit-packed, then the distinct VARCHARs one after the other
+ */
+std::string EncodeDictionary(const std::vector<const char *> &items) {
+  std::unordered_map<std::string_view, uint32_t> codes;
+  std::vector<const char *> entries;
+  std::vector<uint64_t> row_codes;
+  row_codes.reserve(items.size());
+  for (const char *item : items) {
+    auto [it, inserted] = codes.emplace(std::string_view(item, VarlenItemSize(item)), entries.size());
+    if (inserted) {
+      entries.push_back(item);
+    }
+    row_codes.push_back(it->second);
+  }
+  auto entry_count = static_cast<uint32_t>(entries.size());
+  uint8_t bits = entry_count > 1 ? BitsFor(entry_count - 1) : 0;
+  uint32_t codes_offset = AlignMinipage(SIZE_DICTIONARY_HEADER + sizeof(uint16_t) * entry_count);
+  std::string segment(codes_offset + PackedSize(items.size(), bits), '\0');
+  memcpy(segment.data(), &entry_count, sizeof(uint32_t));
+  memcpy(segment.data() + sizeof(uint32_t), &bits, sizeof(uint8_t));
+  auto *words = reinterpret_cast<uint64_t *>(segment.data() + codes_offset);
+  for (uint32_t i = 0; i < row_codes.size(); i++) {
+    Pack(words, i, bits, row_codes[i]);
+  }
+  for (uint32_t i = 0; i < entry_count; i++) {
+    auto offset = static_cast<uint16_t>(segment.size());
+    memcpy(segment.data() + SIZE_DICTIONARY_HEADER + sizeof(uint16_t) * i, &offset, sizeof(uint16_t));
+    segment.append(entries[i], VarlenItemSize(entries[i]));
+  }
+  return segment;
+}
+
+/** @return the offset of the codes of a dictionary segment */
+uint32_t GetDictionaryCodesOffset(const char *segment) {
+  return AlignMinipage(SIZE_DICTIONARY_HEADER + sizeof(uint16_t) * *reinterpret_cast<const uint32_t *>(segment));
+}
+
+/** @return true if the length-prefixed VARCHAR at item is not null and equals value */
+bool VarlenEquals(const char *item, const std::string &value) {
+  uint32_t len = *reinterpret_cast<const uint32_t *>(item);
+  // the stored length counts the trailing terminator
+  return len != BUSTUB_VALUE_NULL && len == value.size() + 1 &&
+         memcmp(item + sizeof(uint32_t), value.data(), value.size()) == 0;
+}
+
+}  // namespace
+
+void PaxPage::Init(page_id_t page_id, uint32_t page_size, page_id_t prev_page_id, const Schema &schema) {
+  memcpy(GetData(), &page_id, sizeof(page_id));
+  memcpy(GetData() + OFFSET_PREV_PAGE_ID, &prev_page_id, sizeof(page_id_t));
+  SetNextPageId(INVALID_PAGE_ID);
+  SetFreeSpacePointer(page_size);
+  SetTupleCount(0);
+  SetHeaderField(OFFSET_CAPACITY, 0);
+  SetHeaderField(OFFSET_TUPLE_LENGTH, schema.GetLength());
+  SetHeaderField(OFFSET_COLUMN_COUNT, schema.GetColumnCount());
+  SetHeaderField(OFFSET_ENCODED_COUNT, 0);
+  SetFull(false);
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    const auto &column = schema.GetColumn(i);
+    char *field = GetData() + SIZE_PAX_PAGE_HEADER + SIZE_COLUMN * i;
+    uint16_t fields[] = {0, static_cast<uint16_t>(column.GetFixedLength()), static_cast<uint16_t>(column.GetOffset()),
+                         0};
+    memcpy(field, fields, sizeof(fields));
+    field[OFFSET_COLUMN_TYPE] = static_cast<char>(column.GetType());
+    field[OFFSET_COLUMN_ENCODING] = static_cast<char>(ColumnEncoding::PLAIN);
+  }
+  bool laid_out = Rebuild(page_size, {});
+  BUSTUB_ASSERT(laid_out && GetCapacity() > 0, "A row does not fit in a PAX page.");
+}
+
+bool PaxPage::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn, LockManager *lock_manager,
+                          LogManager *log_manager) {
+  BUSTUB_ASSERT(tuple.size_ > 0, "Cannot have empty tuples.");
+  if (IsFull()) {
+    return false;
+  }
+  uint32_t slot = FindTailRow();
+  if (slot == GetCapacity() || GetFreeSpaceRemaining() < GetVarlenSize(tuple)) {
+    // The tail is out of room: encode every row again to make some. The tuple fills a free encoded row if there is
+    // one, as encoded rows are never reused otherwise.
+    std::vector<Tuple> tuples;
+    ReadRows(&tuples);
+    slot = 0;
+    while (slot < GetEncodedCount() && GetStatus(slot) != ROW_FREE) {
+      slot++;
+    }
+    bool in_encoded_row = slot < GetEncodedCount();
+    if (in_encoded_row) {
+      tuples[slot] = tuple;
+      SetStatus(slot, ROW_LIVE);
+    }
+    if (!Rebuild(PAGE_SIZE, tuples)) {
+      if (in_encoded_row) {
+        SetStatus(slot, ROW_FREE);
+      }
+      SetFull(true);
+      return false;
+    }
+    if (!in_encoded_row) {
+      slot = FindTailRow();
+      if (slot == GetCapacity() || GetFreeSpaceRemaining() < GetVarlenSize(tuple)) {
+        SetFull(true);
+        return false;
+      }
+    }
+  }
+
+  if (slot >= GetEncodedCount()) {
+    WriteTuple(tuple, slot);
+    SetStatus(slot, ROW_LIVE);
+    if (slot == GetTupleCount()) {
+      SetTupleCount(GetTupleCount() + 1);
+    }
+  }
+  rid->Set(GetTablePageId(), slot);
+
+  // Lock the new tuple. The changes of a PAX page are not written to the log.
+  if (enable_logging) {
+    BUSTUB_ASSERT(!txn->IsSharedLocked(*rid) && !txn->IsExclusiveLocked(*rid), "A new tuple should not be locked.");
+    bool locked = lock_manager->LockExclusive(txn, *rid);
+    BUSTUB_ASSERT(locked, "Locking a new tuple should always work.");
+  }
+  return true;
+}
+
+bool PaxPage::MarkDelete(const RID &rid, Transaction *txn, LockManager *lock_manager, LogManager *log_manager) {
+  uint32_t slot_num = rid.GetSlotNum();
+  // If the tuple does not exist or is already deleted, abort the transaction.
+  if (slot_num >= GetTupleCount() || !IsLive(slot_num)) {
+    if (enable_logging) {
+      txn->SetState(TransactionState::ABORTED);
+    }
+    return false;
+  }
+
+  if (enable_logging) {
+    // Acquire an exclusive lock, upgrading from a shared lock if necessary.
+    if (txn->IsSharedLocked(rid)) {
+      if (!lock_manager->LockUpgrade(txn, rid)) {
+        return false;
+      }
+    } else if (!txn->IsExclusiveLocked(rid) && !lock_manager->LockExclusive(txn, rid)) {
+      return false;
+    }
+  }
+  SetStatus(slot_num, ROW_DELETED);
+  return true;
+}
+
+bool PaxPage::UpdateTuple(const Tuple &new_tuple, Tuple *old_tuple, const RID &rid, Transaction *txn,
+                          LockManager *lock_manager, LogManager *log_manager) {
+  BUSTUB_ASSERT(new_tuple.size_ > 0, "Cannot have empty tuples.");
+  uint32_t slot_num = rid.GetSlotNum();
+  // If the tuple does not exist or is deleted, abort the transaction.
+  if (slot_num >= GetTupleCount() || !IsLive(slot_num)) {
+    if (enable_logging) {
+      txn->SetState(TransactionState::ABORTED);
+    }
+    return false;
+  }
+  ReadTuple(slot_num, old_tuple);
+  old_tuple->rid_ = rid;
+  bool is_encoded = slot_num < GetEncodedCount();
+  // The VARCHARs of the old tuple are given back before the ones of the new tuple are claimed.
+  uint32_t old_varlen_size = old_tuple->size_ - GetTupleLength();
+  if (!is_encoded && GetFreeSpaceRemaining() + old_varlen_size < GetVarlenSize(new_tuple)) {
+    return false;
+  }
+
+  if (enable_logging) {
+    // Acquire an exclusive lock, upgrading from shared if necessary.
+    if (txn->IsSharedLocked(rid)) {
+      if (!lock_manager->LockUpgrade(txn, rid)) {
+        return false;
+      }
+    } else if (!txn->IsExclusiveLocked(rid) && !lock_manager->LockExclusive(txn, rid)) {
+      return false;
+    }
+  }
+
+  if (is_encoded) {
+    // An encoded value cannot be changed in place: every row is encoded again with the new tuple.
+    std::vector<Tuple> tuples;
+    ReadRows(&tuples);
+    tuples[slot_num] = new_tuple;
+    return Rebuild(PAGE_SIZE, tuples);
+  }
+  FreeVarlen(slot_num);
+  WriteTuple(new_tuple, slot_num);
+  return true;
+}
+
+void PaxPage::ApplyDelete(const RID &rid, Transaction *txn, LogManager *log_manager) {
+  uint32_t slot_num = rid.GetSlotNum();
+  BUSTUB_ASSERT(slot_num < GetTupleCount(), "Cannot have more slots than tuples.");
+  if (enable_logging) {
+    BUSTUB_ASSERT(txn->IsExclusiveLocked(rid), "We must own the exclusive lock!");
+  }
+  if (slot_num >= GetEncodedCount()) {
+    FreeVarlen(slot_num);
+  }
+  SetStatus(slot_num, ROW_FREE);
+  SetFull(false);
+}
+
+void PaxPage::RollbackDelete(const RID &rid, Transaction *txn, LogManager *log_manager) {
+  if (enable_logging) {
+    BUSTUB_ASSERT(txn->IsExclusiveLocked(rid), "We must own an exclusive lock on the RID.");
+  }
+  uint32_t slot_num = rid.GetSlotNum();
+  BUSTUB_ASSERT(slot_num < GetTupleCount(), "We can't have more slots than tuples.");
+  if (GetStatus(slot_num) == ROW_DELETED) {
+    SetStatus(slot_num, ROW_LIVE);
+  }
+}
+
+bool PaxPage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager) {
+  uint32_t slot_num = rid.GetSlotNum();
+  // If the tuple does not exist or is deleted, abort the transaction.
+  if (slot_num >= GetTupleCount() || !IsLive(slot_num)) {
+    if (enable_logging) {
+      txn->SetState(TransactionState::ABORTED);
+    }
+    return false;
+  }
+  // Otherwise we have a valid tuple, try to acquire at least a shared lock.
+  if (enable_logging) {
+    if (!txn->IsSharedLocked(rid) && !txn->IsExclusiveLocked(rid) && !lock_manager->LockShared(txn, rid)) {
+      return false;
+    }
+  }
+  ReadTuple(slot_num, tuple);
+  tuple->rid_ = rid;
+  return true;
+}
+
+void PaxPage::ScanTuples(const TupleFilter &filter, Transaction *txn, LockManager *lock_manager,
+                         std::vector<Tuple> *tuples) {
+  for (uint32_t i = 0; i < GetTupleCount(); ++i) {
+    if (!IsLive(i)) {
+      continue;
+    }
+    tuples->emplace_back();
+    if (!GetTuple(RID(GetTablePageId(), i), &tuples->back(), txn, lock_manager) ||
+        (filter && !filter(tuples->back().GetData()))) {
+      tuples->pop_back();
+    }
+  }
+}
+
+bool PaxPage::GetFirstTupleRid(RID *first_rid) {
+  for (uint32_t i = 0; i < GetTupleCount(); ++i) {
+    if (IsLive(i)) {
+      first_rid->Set(GetTablePageId(), i);
+      return true;
+    }
+  }
+  first_rid->Set(INVALID_PAGE_ID, 0);
+  return false;
+}
+
+bool PaxPage::GetNextTupleRid(const RID &cur_rid, RID *next_rid) {
+  BUSTUB_ASSERT(cur_rid.GetPageId() == GetTablePageId(), "Wrong table!");
+  for (auto i = cur_rid.GetSlotNum() + 1; i < GetTupleCount(); ++i) {
+    if (IsLive(i)) {
+      next_rid->Set(GetTablePageId(), i);
+      return true;
+    }
+  }
+  next_rid->Set(INVALID_PAGE_ID, 0);
+  return false;
+}
+
+void PaxPage::FilterIntegers(uint32_t column_idx, int64_t lo, int64_t hi, bool inside,
+                             std::vector<uint32_t> *slots) {
+  TypeId type = GetType(column_idx);
+  uint16_t width = GetWidth(column_idx);
+  ColumnEncoding encoding = GetEncoding(column_idx);
+  const char *segment = GetSegment(column_idx);
+  uint32_t encoded_count = GetEncodedCount();
+  auto passes = [&](const char *data) {
+    int64_t value;
+    return ReadInteger(type, data, &value) && (value >= lo && value <= hi) == inside;
+  };
+
+  // The bounds as frame-of-reference codes: the values within them have codes in [code_lo, code_hi].
+  int64_t ref = 0;
+  uint8_t bits = 0;
+  uint64_t code_lo = 1;
+  uint64_t code_hi = 0;
+  if (encoding == ColumnEncoding::FRAME_OF_REFERENCE) {
+    ref = *reinterpret_cast<const int64_t *>(segment);
+    bits = *reinterpret_cast<const uint8_t *>(segment + sizeof(int64_t));
+    if (hi >= ref && lo <= hi) {
+      code_lo = lo <= ref ? 1 : static_cast<uint64_t>(lo) - static_cast<uint64_t>(ref) + 1;
+      code_hi = static_cast<uint64_t>(hi) - static_cast<uint64_t>(ref) + 1;
+    }
+  }
+  const auto *words = reinterpret_cast<const uint64_t *>(segment + SIZE_FOR_HEADER);
+  // Every run is tested once, as the rows come in increasing order.
+  const uint32_t *run_ends = nullptr;
+  const char *run_values = nullptr;
+  if (encoding == ColumnEncoding::RUN_LENGTH) {
+    run_ends = reinterpret_cast<const uint32_t *>(segment + SIZE_RLE_HEADER);
+    run_values = segment + SIZE_RLE_HEADER + sizeof(uint32_t) * *reinterpret_cast<const uint32_t *>(segment);
+  }
+  uint32_t run = 0;
+  bool run_tested = false;
+  bool run_passes = false;
+
+  size_t kept = 0;
+  for (uint32_t slot : *slots) {
+    bool keep;
+    if (slot >= encoded_count) {
+      keep = passes(GetSlot(column_idx, slot));
+    } else if (encoding == ColumnEncoding::FRAME_OF_REFERENCE) {
+      uint64_t code = Unpack(words, slot, bits);
+      keep = code != 0 && (code >= code_lo && code <= code_hi) == inside;
+    } else if (encoding == ColumnEncoding::RUN_LENGTH) {
+      for (; run_ends[run] <= slot; run++) {
+        run_tested = false;
+      }
+      if (!run_tested) {
+        run_passes = passes(run_values + width * run);
+        run_tested = true;
+      }
+      keep = run_passes;
+    } else {
+      keep = passes(segment + width * slot);
+    }
+    if (keep) {
+      (*slots)[kept++] = slot;
+    }
+  }
+  slots->resize(kept);
+}
+
+void PaxPage::FilterStrings(uint32_t column_idx, const std::string &value, bool equal, std::vector<uint32_t> *slots) {
+  bool is_dictionary = GetEncoding(column_idx) == ColumnEncoding::DICTIONARY;
+  const char *segment = GetSegment(column_idx);
+  uint32_t encoded_count = GetEncodedCount();
+
+  // The value and null are looked up once in the dictionary, the codes of the rows are compared with theirs.
+  uint32_t value_code = UINT32_MAX;
+  uint32_t null_code = UINT32_MAX;
+  uint8_t bits = 0;
+  const uint64_t *words = nullptr;
+  if (is_dictionary) {
+    uint32_t entry_count = *reinterpret_cast<const uint32_t *>(segment);
+    bits = *reinterpret_cast<const uint8_t *>(segment + sizeof(uint32_t));
+    words = reinterpret_cast<const uint64_t *>(segment + GetDictionaryCodesOffset(segment));
+    const auto *offsets = reinterpret_cast<const uint16_t *>(segment + SIZE_DICTIONARY_HEADER);
+    for (uint32_t i = 0; i < entry_count; i++) {
+      const char *entry = segment + offsets[i];
+      if (VarlenEquals(entry, value)) {
+        value_code = i;
+      } else if (*reinterpret_cast<const uint32_t *>(entry) == BUSTUB_VALUE_NULL) {
+        null_code = i;
+      }
+    }
+  }
+
+  size_t kept = 0;
+  for (uint32_t slot : *slots) {
+    bool keep;
+    if (slot < encoded_count && is_dictionary) {
+      auto code = static_cast<uint32_t>(Unpack(words, slot, bits));
+      keep = code != null_code && (code == value_code) == equal;
+    } else {
+      const char *item = GetVarlen(column_idx, slot);
+      keep = *reinterpret_cast<const uint32_t *>(item) != BUSTUB_VALUE_NULL && VarlenEquals(item, value) == equal;
+    }
+    if (keep) {
+      (*slots)[kept++] = slot;
+    }
+  }
+  slots->resize(kept);
+}
+
+uint32_t PaxPage::GetMinipagesEnd() {
+  uint32_t column_count = GetColumnCount();
+  uint32_t tail_capacity = GetCapacity() - GetEncodedCount();
+  if (column_count == 0) {
+    return GetStatusOffset() + GetCapacity();
+  }
+  return GetColumnField(column_count - 1, OFFSET_COLUMN_MINIPAGE) + GetWidth(column_count - 1) * tail_capacity;
+}
+
+uint64_t PaxPage::GetCode(uint32_t column_idx, uint32_t slot) {
+  const char *segment = GetSegment(column_idx);
+  if (GetEncoding(column_idx) == ColumnEncoding::FRAME_OF_REFERENCE) {
+    auto bits = *reinterpret_cast<const uint8_t *>(segment + sizeof(int64_t));
+    return Unpack(reinterpret_cast<const uint64_t *>(segment + SIZE_FOR_HEADER), slot, bits);
+  }
+  auto bits = *reinterpret_cast<const uint8_t *>(segment + sizeof(uint32_t));
+  return Unpack(reinterpret_cast<const uint64_t *>(segment + GetDictionaryCodesOffset(segment)), slot, bits);
+}
+
+uint32_t PaxPage::GetRun(uint32_t column_idx, uint32_t slot) {
+  const char *segment = GetSegment(column_idx);
+  uint32_t runs = *reinterpret_cast<const uint32_t *>(segment);
+  const auto *ends = reinterpret_cast<const uint32_t *>(segment + SIZE_RLE_HEADER);
+  return std::upper_bound(ends, ends + runs, slot) - ends;
+}
+
+const char *PaxPage::GetInlined(uint32_t column_idx, uint32_t slot, char *buffer) {
+  if (slot >= GetEncodedCount()) {
+    return GetSlot(column_idx, slot);
+  }
+  const char *segment = GetSegment(column_idx);
+  uint16_t width = GetWidth(column_idx);
+  switch (GetEncoding(column_idx)) {
+    case ColumnEncoding::FRAME_OF_REFERENCE: {
+      uint64_t code = GetCode(column_idx, slot);
+      auto ref = *reinterpret_cast<const uint64_t *>(segment);
+      WriteInteger(GetType(column_idx), static_cast<int64_t>(ref + code - 1), code == 0, buffer);
+      return buffer;
+    }
+    case ColumnEncoding::RUN_LENGTH: {
+      uint32_t runs = *reinterpret_cast<const uint32_t *>(segment);
+      return segment + SIZE_RLE_HEADER + sizeof(uint32_t) * runs + width * GetRun(column_idx, slot);
+    }
+    default:
+      return segment + width * slot;
+  }
+}
+
+const char *PaxPage::GetVarlen(uint32_t column_idx, uint32_t slot) {
+  if (slot >= GetEncodedCount()) {
+    return GetData() + *reinterpret_cast<uint32_t *>(GetSlot(column_idx, slot));
+  }
+  const char *segment = GetSegment(column_idx);
+  if (GetEncoding(column_idx) == ColumnEncoding::DICTIONARY) {
+    uint64_t code = GetCode(column_idx, slot);
+    return segment + reinterpret_cast<const uint16_t *>(segment + SIZE_DICTIONARY_HEADER)[code];
+  }
+  return segment + reinterpret_cast<const uint16_t *>(segment)[slot];
+}
+
+uint32_t PaxPage::GetVarlenSize(const Tuple &tuple) {
+  uint32_t size = 0;
+  for (uint32_t i = 0; i < GetColumnCount(); i++) {
+    if (!IsInlined(i)) {
+      size += VarlenItemSize(tuple.data_ + *reinterpret_cast<const uint32_t *>(tuple.data_ + GetTupleOffset(i)));
+    }
+  }
+  return size;
+}
+
+uint32_t PaxPage::FindTailRow() {
+  for (uint32_t i = GetEncodedCount(); i < GetTupleCount(); i++) {
+    if (GetStatus(i) == ROW_FREE) {
+      return i;
+    }
+  }
+  return GetTupleCount();
+}
+
+void PaxPage::ReadRows(std::vector<Tuple> *tuples) {
+  tuples->resize(GetTupleCount());
+  for (uint32_t i = 0; i < GetTupleCount(); i++) {
+    if (GetStatus(i) != ROW_FREE) {
+      ReadTuple(i, &(*tuples)[i]);
+    }
+  }
+}
+
+void PaxPage::ReadTuple(uint32_t slot, Tuple *tuple) {
+  uint32_t tuple_length = GetTupleLength();
+  uint32_t size = tuple_length;
+  for (uint32_t i = 0; i < GetColumnCount(); i++) {
+    if (!IsInlined(i)) {
+      size += VarlenItemSize(GetVarlen(i, slot));
+    }
+  }
+  if (tuple->allocated_) {
+    delete[] tuple->data_;
+  }
+  tuple->size_ = size;
+  tuple->data_ = new char[size];
+  tuple->allocated_ = true;
+  memset(tuple->data_, 0, tuple_length);
+
+  // VARCHARs follow the inlined part in column order, as the Tuple constructor lays them out.
+  uint32_t varlen_offset = tuple_length;
+  char buffer[sizeof(int64_t)];
+  for (uint32_t i = 0; i < GetColumnCount(); i++) {
+    char *inlined = tuple->data_ + GetTupleOffset(i);
+    if (IsInlined(i)) {
+      memcpy(inlined, GetInlined(i, slot, buffer), GetWidth(i));
+      continue;
+    }
+    const char *item = GetVarlen(i, slot);
+    uint32_t item_size = VarlenItemSize(item);
+    memcpy(tuple->data_ + varlen_offset, item, item_size);
+    memcpy(inlined, &varlen_offset, sizeof(uint32_t));
+    varlen_offset += item_size;
+  }
+}
+
+void PaxPage::WriteTuple(const Tuple &tuple, uint32_t slot) {
+  for (uint32_t i = 0; i < GetColumnCount(); i++) {
+    const char *inlined = tuple.data_ + GetTupleOffset(i);
+    if (IsInlined(i)) {
+      memcpy(GetSlot(i, slot), inlined, GetWidth(i));
+      continue;
+    }
+    const char *item = tuple.data_ + *reinterpret_cast<const uint32_t *>(inlined);
+    uint32_t item_size = VarlenItemSize(item);
+    uint32_t item_offset = GetFreeSpacePointer() - item_size;
+    memcpy(GetData() + item_offset, item, item_size);
+    memcpy(GetSlot(i, slot), &item_offset, sizeof(uint32_t));
+    SetFreeSpacePointer(item_offset);
+  }
+}
+
+void PaxPage::FreeVarlen(uint32_t slot) {
+  for (uint32_t i = 0; i < GetColumnCount(); i++) {
+    if (IsInlined(i)) {
+      continue;
+    }
+    uint32_t item_offset = *reinterpret_cast<uint32_t *>(GetSlot(i, slot));
+    uint32_t item_size = VarlenItemSize(GetData() + item_offset);
+    uint32_t free_space_pointer = GetFreeSpacePointer();
+    BUSTUB_ASSERT(item_offset >= free_space_pointer, "Offset should appear after current free space position.");
+    memmove(GetData() + free_space_pointer + item_size, GetData() + free_space_pointer,
+            item_offset - free_space_pointer);
+    SetFreeSpacePointer(free_space_pointer + item_size);
+
+    // Every VARCHAR of the tail stored below the freed one has moved up.
+    for (uint32_t row = GetEncodedCount(); row < GetTupleCount(); row++) {
+      if (GetStatus(row) == ROW_FREE) {
+        continue;
+      }
+      for (uint32_t j = 0; j < GetColumnCount(); j++) {
+        auto *offset = reinterpret_cast<uint32_t *>(GetSlot(j, row));
+        if (!IsInlined(j) && *offset < item_offset) {
+          *offset += item_size;
+        }
+      }
+    }
+  }
+}
+
+bool PaxPage::Rebuild(uint32_t page_size, const std::vector<Tuple> &tuples) {
+  uint32_t column_count = GetColumnCount();
+  uint32_t status_offset = GetStatusOffset();
+  // Free rows at the end are dropped, the ones before them stay free.
+  uint32_t count = GetTupleCount();
+  while (count > 0 && GetStatus(count - 1) == ROW_FREE) {
+    count--;
+  }
+
+  // Encode every column in the encoding that takes the least space.
+  std::vector<std::string> segments(column_count);
+  std::vector<ColumnEncoding> encodings(column_count, ColumnEncoding::PLAIN);
+  uint32_t segments_size = 0;
+  uint32_t row_size = 1;
+  for (uint32_t i = 0; i < column_count; i++) {
+    TypeId type = GetType(i);
+    uint16_t width = GetWidth(i);
+    row_size += width + (IsInlined(i) ? 0 : VARLEN_RESERVE);
+    char null_inlined[sizeof(int64_t)];
+    if (IsInlined(i)) {
+      WriteNull(type, null_inlined);
+    }
+    // A free row repeats the value before it, or the first value of the page, so that it costs no run, no code
+    // range and no dictionary entry of its own.
+    auto value_of = [&](uint32_t row) {
+      const char *data = tuples[row].data_;
+      return IsInlined(i) ? data + GetTupleOffset(i)
+                          : data + *reinterpret_cast<const uint32_t *>(data + GetTupleOffset(i));
+    };
+    const char *last = IsInlined(i) ? null_inlined : reinterpret_cast<const char *>(&NULL_VARLEN);
+    for (uint32_t row = 0; row < count; row++) {
+      if (GetStatus(row) != ROW_FREE) {
+        last = value_of(row);
+        break;
+      }
+    }
+    std::vector<const char *> values(count);
+    for (uint32_t row = 0; row < count; row++) {
+      if (GetStatus(row) != ROW_FREE) {
+        last = value_of(row);
+      }
+      values[row] = last;
+    }
+
+    auto consider = [&](ColumnEncoding encoding, std::string &&segment) {
+      if (segment.size() < segments[i].size()) {
+        segments[i] = std::move(segment);
+        encodings[i] = encoding;
+      }
+    };
+    if (IsInlined(i)) {
+      segments[i] = EncodePlain(values, width);
+      consider(ColumnEncoding::RUN_LENGTH, EncodeRunLength(values, width));
+      std::string segment;
+      if (IsIntegerType(type) && EncodeFrameOfReference(type, values, &segment)) {
+        consider(ColumnEncoding::FRAME_OF_REFERENCE, std::move(segment));
+      }
+    } else {
+      segments[i] = EncodePlainVarlen(values);
+      consider(ColumnEncoding::DICTIONARY, EncodeDictionary(values));
+    }
+    PadSegment(&segments[i]);
+    segments_size += segments[i].size();
+  }
+
+  // The tail takes the space left, every tail row with its status byte, its slots and a share of the heap.
+  // Every minipage may lose up to MINIPAGE_ALIGNMENT - 1 bytes to its alignment, and so may the segments.
+  uint32_t fixed_size = status_offset + count + MINIPAGE_ALIGNMENT * (column_count + 1) + segments_size;
+  if (fixed_size > page_size) {
+    return false;
+  }
+  uint32_t tail_capacity = (page_size - fixed_size) / row_size;
+  uint32_t capacity = count + tail_capacity;
+
+  // Lay the page out in a scratch copy, as the tuples may point into this page.
+  std::vector<char> scratch(page_size, 0);
+  memcpy(scratch.data(), GetData(), status_offset);
+  memcpy(scratch.data() + status_offset, GetData() + status_offset, count);
+  uint32_t header[] = {page_size, count, capacity};
+  memcpy(scratch.data() + OFFSET_FREE_SPACE, header, sizeof(header));
+  uint32_t encoded[] = {count, 0};
+  memcpy(scratch.data() + OFFSET_ENCODED_COUNT, encoded, sizeof(encoded));
+  uint32_t offset = AlignMinipage(status_offset + capacity);
+  for (uint32_t i = 0; i < column_count; i++) {
+    char *field = scratch.data() + SIZE_PAX_PAGE_HEADER + SIZE_COLUMN * i;
+    auto segment_offset = static_cast<uint16_t>(offset);
+    memcpy(field + OFFSET_COLUMN_SEGMENT, &segment_offset, sizeof(uint16_t));
+    field[OFFSET_COLUMN_ENCODING] = static_cast<char>(encodings[i]);
+    memcpy(scratch.data() + offset, segments[i].data(), segments[i].size());
+    offset += segments[i].size();
+  }
+  for (uint32_t i = 0; i < column_count; i++) {
+    offset = AlignMinipage(offset);
+    auto minipage_offset = static_cast<uint16_t>(offset);
+    memcpy(scratch.data() + SIZE_PAX_PAGE_HEADER + SIZE_COLUMN * i + OFFSET_COLUMN_MINIPAGE, &minipage_offset,
+           sizeof(uint16_t));
+    offset += GetWidth(i) * tail_capacity;
+  }
+  BUSTUB_ASSERT(offset <= page_size, "The minipages overflow the page.");
+  memcpy(GetData(), scratch.data(), page_size);
+  return true;
+}
+
+}  // namespace bustub
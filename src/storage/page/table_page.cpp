@@ -266,6 +266,23 @@ void TablePage::RollbackDelete(const RID &rid, Transaction *txn, LogManager *log
 }
 
 bool TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockManager *lock_manager) {
+  TupleView view;
+  if (!GetTupleView(rid, &view, txn, lock_manager)) {
+    return false;
+  }
+  // At this point, we have at least a shared lock on the RID. Copy the tuple data into our result.
+  tuple->size_ = view.GetLength();
+  if (tuple->allocated_) {
+    delete[] tuple->data_;
+  }
+  tuple->data_ = new char[tuple->size_];
+  memcpy(tuple->data_, view.GetData(), tuple->size_);
+  tuple->rid_ = rid;
+  tuple->allocated_ = true;
+  return true;
+}
+
+bool TablePage::GetTupleView(const RID &rid, TupleView *view, Transaction *txn, LockManager *lock_manager) {
   // Get the current slot number.
   uint32_t slot_num = rid.GetSlotNum();
   // If somehow we have more slots than tuples, abort the transaction.
@@ -291,18 +308,41 @@ bool TablePage::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn, LockMan
       return false;
     }
   }
+  *view = TupleView(GetData() + GetTupleOffsetAtSlot(slot_num), tuple_size, rid);
+  return true;
+}
+
+void TablePage::ScanTuples(const TupleFilter &filter, Transaction *txn, LockManager *lock_manager,
+                           std::vector<Tuple> *tuples) {
+  std::vector<TupleView> views;
+  ScanTupleViews(0, GetTupleCount(), filter, txn, lock_manager, &views);
+  tuples->reserve(tuples->size() + views.size());
+  for (const auto &view : views) {
+    tuples->emplace_back(view);
+  }
+}
 
-  // At this point, we have at least a shared lock on the RID. Copy the tuple data into our result.
-  uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
-  tuple->size_ = tuple_size;
-  if (tuple->allocated_) {
-    delete[] tuple->data_;
+uint32_t TablePage::ScanTupleViews(uint32_t first_slot, size_t max_views, const TupleFilter &filter, Transaction *txn,
+                                   LockManager *lock_manager, std::vector<TupleView> *views) {
+  size_t count = 0;
+  uint32_t i = first_slot;
+  for (; i < GetTupleCount() && count < max_views; ++i) {
+    if (IsDeleted(GetTupleSize(i))) {
+      continue;
+    }
+    views->emplace_back();
+    if (!GetTupleView(RID(GetTablePageId(), i), &views->back(), txn, lock_manager)) {
+      views->pop_back();
+      continue;
+    }
+    // the filter only runs under the row lock, so it never rejects a row based on uncommitted data
+    if (filter && !filter(GetData() + GetTupleOffsetAtSlot(i))) {
+      views->pop_back();
+      continue;
+    }
+    count++;
   }
-  tuple->data_ = new char[tuple->size_];
-  memcpy(tuple->data_, GetData() + tuple_offset, tuple->size_);
-  tuple->rid_ = rid;
-  tuple->allocated_ = true;
-  return true;
+  return i < GetTupleCount() ? i : 0;
 }
 
 bool TablePage::GetFirstTupleRid(RID *first_rid) {
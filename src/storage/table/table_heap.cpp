@@ -28,30 +28,108 @@ TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_m
                      Transaction *txn)
     : buffer_pool_manager_(buffer_pool_manager), lock_manager_(lock_manager), log_manager_(log_manager) {
   // Initialize the first table page.
-  auto first_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(&first_page_id_));
+  auto first_page = buffer_pool_manager_->NewPage(&first_page_id_);
   BUSTUB_ASSERT(first_page != nullptr, "Couldn't create a page for the table heap.");
   first_page->WLatch();
-  first_page->Init(first_page_id_, PAGE_SIZE, INVALID_LSN, log_manager_, txn);
+  InitPage(first_page, first_page_id_, INVALID_LSN, txn);
   first_page->WUnlatch();
   buffer_pool_manager_->UnpinPage(first_page_id_, true);
 }
 
+TableHeap::TableHeap(BufferPoolManager *buffer_pool_manager, LockManager *lock_manager, LogManager *log_manager,
+                     Transaction *txn, const Schema &schema, TableLayout layout)
+    : buffer_pool_manager_(buffer_pool_manager),
+      lock_manager_(lock_manager),
+      log_manager_(log_manager),
+      layout_(layout),
+      schema_(layout == TableLayout::PAX ? std::make_unique<Schema>(schema) : nullptr) {
+  auto first_page = buffer_pool_manager_->NewPage(&first_page_id_);
+  BUSTUB_ASSERT(first_page != nullptr, "Couldn't create a page for the table heap.");
+  first_page->WLatch();
+  InitPage(first_page, first_page_id_, INVALID_LSN, txn);
+  first_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(first_page_id_, true);
+}
+
+void TableHeap::InitPage(Page *page, page_id_t page_id, page_id_t prev_page_id, Transaction *txn) {
+  if (layout_ == TableLayout::PAX) {
+    reinterpret_cast<PaxPage *>(page)->Init(page_id, PAGE_SIZE, prev_page_id, *schema_);
+  } else {
+    reinterpret_cast<TablePage *>(page)->Init(page_id, PAGE_SIZE, prev_page_id, log_manager_, txn);
+  }
+}
+
 bool TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) {
+  return layout_ == TableLayout::PAX ? InsertTupleOn<PaxPage>(tuple, rid, txn)
+                                     : InsertTupleOn<TablePage>(tuple, rid, txn);
+}
+
+bool TableHeap::MarkDelete(const RID &rid, Transaction *txn) {
+  return layout_ == TableLayout::PAX ? MarkDeleteOn<PaxPage>(rid, txn) : MarkDeleteOn<TablePage>(rid, txn);
+}
+
+bool TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn) {
+  return layout_ == TableLayout::PAX ? UpdateTupleOn<PaxPage>(tuple, rid, txn)
+                                     : UpdateTupleOn<TablePage>(tuple, rid, txn);
+}
+
+void TableHeap::ApplyDelete(const RID &rid, Transaction *txn) {
+  if (layout_ == TableLayout::PAX) {
+    ApplyDeleteOn<PaxPage>(rid, txn);
+  } else {
+    ApplyDeleteOn<TablePage>(rid, txn);
+  }
+}
+
+void TableHeap::RollbackDelete(const RID &rid, Transaction *txn) {
+  if (layout_ == TableLayout::PAX) {
+    RollbackDeleteOn<PaxPage>(rid, txn);
+  } else {
+    RollbackDeleteOn<TablePage>(rid, txn);
+  }
+}
+
+bool TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn) {
+  return layout_ == TableLayout::PAX ? GetTupleOn<PaxPage>(rid, tuple, txn)
+                                     : GetTupleOn<TablePage>(rid, tuple, txn);
+}
+
+page_id_t TableHeap::ScanPage(page_id_t page_id, const TupleFilter &filter, std::vector<Tuple> *tuples,
+                              Transaction *txn) {
+  return layout_ == TableLayout::PAX ? ScanPageOn<PaxPage>(page_id, filter, tuples, txn)
+                                     : ScanPageOn<TablePage>(page_id, filter, tuples, txn);
+}
+
+RID TableHeap::FindTuple(page_id_t page_id, const RID *after, page_id_t stop_page_id) {
+  return layout_ == TableLayout::PAX ? FindTupleOn<PaxPage>(page_id, after, stop_page_id)
+                                     : FindTupleOn<TablePage>(page_id, after, stop_page_id);
+}
+
+template <class PageT>
+bool TableHeap::InsertTupleOn(const Tuple &tuple, RID *rid, Transaction *txn) {
   if (tuple.size_ + 32 > PAGE_SIZE) {  // larger than one page size
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
 
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(first_page_id_));
+  auto cur_page = static_cast<PageT *>(buffer_pool_manager_->FetchPage(first_page_id_));
   if (cur_page == nullptr) {
     txn->SetState(TransactionState::ABORTED);
     return false;
   }
 
   cur_page->WLatch();
+  bool is_new_page = false;
   // Insert into the first page with enough space. If no such page exists, create a new page and insert into that.
   // INVARIANT: cur_page is WLatched if you leave the loop normally.
   while (!cur_page->InsertTuple(tuple, rid, txn, lock_manager_, log_manager_)) {
+    // The variable-length data of a tuple may not fit even in an empty PaxPage.
+    if (is_new_page) {
+      cur_page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
+      txn->SetState(TransactionState::ABORTED);
+      return false;
+    }
     auto next_page_id = cur_page->GetNextPageId();
     // If the next page is a valid page,
     if (next_page_id != INVALID_PAGE_ID) {
@@ -59,11 +137,11 @@ bool TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) {
       cur_page->WUnlatch();
       buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), false);
       // And repeat the process with the next page.
-      cur_page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
+      cur_page = static_cast<PageT *>(buffer_pool_manager_->FetchPage(next_page_id));
       cur_page->WLatch();
     } else {
       // Otherwise we have run out of valid pages. We need to create a new page.
-      auto new_page = static_cast<TablePage *>(buffer_pool_manager_->NewPage(&next_page_id));
+      auto new_page = static_cast<PageT *>(buffer_pool_manager_->NewPage(&next_page_id));
       // If we could not create a new page,
       if (new_page == nullptr) {
         // Then life sucks and we abort the transaction.
@@ -75,12 +153,20 @@ bool TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) {
       // Otherwise we were able to create a new page. We initialize it now.
       new_page->WLatch();
       cur_page->SetNextPageId(next_page_id);
-      new_page->Init(next_page_id, PAGE_SIZE, cur_page->GetTablePageId(), log_manager_, txn);
+      InitPage(new_page, next_page_id, cur_page->GetTablePageId(), txn);
+      if (zone_map_ != nullptr) {
+        zone_map_->Link(cur_page->GetTablePageId(), next_page_id);
+      }
       cur_page->WUnlatch();
       buffer_pool_manager_->UnpinPage(cur_page->GetTablePageId(), true);
       cur_page = new_page;
+      is_new_page = true;
     }
   }
+  // The summary is widened before the page is unlatched, so that no scan sees the tuple but not its summary.
+  if (zone_map_ != nullptr) {
+    zone_map_->Insert(rid->GetPageId(), tuple);
+  }
   // This line has caused most of us to double-take and "whoa double unlatch".
   // We are not, in fact, double unlatching. See the invariant above.
   cur_page->WUnlatch();
@@ -90,10 +176,11 @@ bool TableHeap::InsertTuple(const Tuple &tuple, RID *rid, Transaction *txn) {
   return true;
 }
 
-bool TableHeap::MarkDelete(const RID &rid, Transaction *txn) {
+template <class PageT>
+bool TableHeap::MarkDeleteOn(const RID &rid, Transaction *txn) {
   // TODO(Amadou): remove empty page
   // Find the page which contains the tuple.
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  auto page = reinterpret_cast<PageT *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   // If the page could not be found, then abort the transaction.
   if (page == nullptr) {
     txn->SetState(TransactionState::ABORTED);
@@ -109,9 +196,10 @@ bool TableHeap::MarkDelete(const RID &rid, Transaction *txn) {
   return true;
 }
 
-bool TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn) {
+template <class PageT>
+bool TableHeap::UpdateTupleOn(const Tuple &tuple, const RID &rid, Transaction *txn) {
   // Find the page which contains the tuple.
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  auto page = reinterpret_cast<PageT *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   // If the page could not be found, then abort the transaction.
   if (page == nullptr) {
     txn->SetState(TransactionState::ABORTED);
@@ -121,6 +209,9 @@ bool TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn
   Tuple old_tuple;
   page->WLatch();
   bool is_updated = page->UpdateTuple(tuple, &old_tuple, rid, txn, lock_manager_, log_manager_);
+  if (is_updated && zone_map_ != nullptr) {
+    zone_map_->Insert(rid.GetPageId(), tuple);
+  }
   page->WUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), is_updated);
   // Update the transaction's write set.
@@ -130,9 +221,10 @@ bool TableHeap::UpdateTuple(const Tuple &tuple, const RID &rid, Transaction *txn
   return is_updated;
 }
 
-void TableHeap::ApplyDelete(const RID &rid, Transaction *txn) {
+template <class PageT>
+void TableHeap::ApplyDeleteOn(const RID &rid, Transaction *txn) {
   // Find the page which contains the tuple.
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  auto page = reinterpret_cast<PageT *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   BUSTUB_ASSERT(page != nullptr, "Couldn't find a page containing that RID.");
   // Delete the tuple from the page.
   page->WLatch();
@@ -142,9 +234,10 @@ void TableHeap::ApplyDelete(const RID &rid, Transaction *txn) {
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
 }
 
-void TableHeap::RollbackDelete(const RID &rid, Transaction *txn) {
+template <class PageT>
+void TableHeap::RollbackDeleteOn(const RID &rid, Transaction *txn) {
   // Find the page which contains the tuple.
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  auto page = reinterpret_cast<PageT *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   BUSTUB_ASSERT(page != nullptr, "Couldn't find a page containing that RID.");
   // Rollback the delete.
   page->WLatch();
@@ -153,9 +246,10 @@ void TableHeap::RollbackDelete(const RID &rid, Transaction *txn) {
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
 }
 
-bool TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn) {
+template <class PageT>
+bool TableHeap::GetTupleOn(const RID &rid, Tuple *tuple, Transaction *txn) {
   // Find the page which contains the tuple.
-  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  auto page = static_cast<PageT *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   // If the page could not be found, then abort the transaction.
   if (page == nullptr) {
     txn->SetState(TransactionState::ABORTED);
@@ -169,24 +263,116 @@ bool TableHeap::GetTuple(const RID &rid, Tuple *tuple, Transaction *txn) {
   return res;
 }
 
+template <class PageT>
+page_id_t TableHeap::ScanPageOn(page_id_t page_id, const TupleFilter &filter, std::vector<Tuple> *tuples,
+                                Transaction *txn) {
+  auto page = static_cast<PageT *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    txn->SetState(TransactionState::ABORTED);
+    return INVALID_PAGE_ID;
+  }
+  page->RLatch();
+  page->ScanTuples(filter, txn, lock_manager_, tuples);
+  page_id_t next_page_id = page->GetNextPageId();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return next_page_id;
+}
+
+page_id_t TableHeap::ViewPage(page_id_t page_id, uint32_t *slot, size_t max_views, const TupleFilter &filter,
+                              const std::function<void(const std::vector<TupleView> &views)> &reader,
+                              Transaction *txn) {
+  BUSTUB_ASSERT(layout_ == TableLayout::ROW, "The tuples of a PAX table are not stored whole, to be viewed.");
+  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    txn->SetState(TransactionState::ABORTED);
+    *slot = 0;
+    return INVALID_PAGE_ID;
+  }
+  page->RLatch();
+  std::vector<TupleView> views;
+  *slot = page->ScanTupleViews(*slot, max_views, filter, txn, lock_manager_, &views);
+  reader(views);
+  page_id_t next_page_id = *slot == 0 ? page->GetNextPageId() : page_id;
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return next_page_id;
+}
+
+page_id_t TableHeap::ReadPaxPage(page_id_t page_id, const std::function<void(PaxPage *page)> &reader,
+                                 Transaction *txn) {
+  BUSTUB_ASSERT(layout_ == TableLayout::PAX, "Only the pages of a PAX table are read a column at a time.");
+  auto page = static_cast<PaxPage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    txn->SetState(TransactionState::ABORTED);
+    return INVALID_PAGE_ID;
+  }
+  page->RLatch();
+  reader(page);
+  page_id_t next_page_id = page->GetNextPageId();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return next_page_id;
+}
+
+page_id_t TableHeap::GetNextPageId(page_id_t page_id) {
+  page_id_t next_page_id;
+  if (zone_map_ != nullptr && zone_map_->GetNextPageId(page_id, &next_page_id)) {
+    return next_page_id;
+  }
+  // PaxPages start with the header of a TablePage, which has the id of the next page.
+  auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  BUSTUB_ASSERT(page != nullptr, "table page could not be fetched");
+  page->RLatch();
+  next_page_id = page->GetNextPageId();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return next_page_id;
+}
+
+void TableHeap::CreateZoneMap(const Schema &schema, std::vector<uint32_t> column_idxs, Transaction *txn) {
+  auto zone_map = std::make_unique<ZoneMap>(schema, std::move(column_idxs));
+  std::vector<Tuple> tuples;
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    tuples.clear();
+    page_id_t next_page_id = ScanPage(page_id, TupleFilter{}, &tuples, txn);
+    zone_map->Link(page_id, next_page_id);
+    for (const auto &tuple : tuples) {
+      zone_map->Insert(page_id, tuple);
+    }
+    page_id = next_page_id;
+  }
+  zone_map_ = std::move(zone_map);
+}
+
 TableIterator TableHeap::Begin(Transaction *txn) {
   // Start an iterator from the first page.
+  return Begin(txn, first_page_id_, INVALID_PAGE_ID);
+}
+
+TableIterator TableHeap::Begin(Transaction *txn, page_id_t first_page_id, page_id_t stop_page_id) {
   // TODO(Wuwen): Hacky fix for now. Removing empty pages is a better way to handle this.
+  return TableIterator(this, FindTuple(first_page_id, nullptr, stop_page_id), txn, stop_page_id);
+}
+
+template <class PageT>
+RID TableHeap::FindTupleOn(page_id_t page_id, const RID *after, page_id_t stop_page_id) {
   RID rid;
-  auto page_id = first_page_id_;
-  while (page_id != INVALID_PAGE_ID) {
-    auto page = static_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  while (page_id != INVALID_PAGE_ID && page_id != stop_page_id) {
+    auto page = static_cast<PageT *>(buffer_pool_manager_->FetchPage(page_id));
     page->RLatch();
-    // If this fails because there is no tuple, then RID will be the default-constructed value, which means EOF.
-    auto found_tuple = page->GetFirstTupleRid(&rid);
+    // If this fails because there is no tuple, then RID will be invalid, which means EOF.
+    auto found_tuple = after != nullptr ? page->GetNextTupleRid(*after, &rid) : page->GetFirstTupleRid(&rid);
+    auto next_page_id = page->GetNextPageId();
     page->RUnlatch();
     buffer_pool_manager_->UnpinPage(page_id, false);
     if (found_tuple) {
-      break;
+      return rid;
     }
-    page_id = page->GetNextPageId();
+    after = nullptr;
+    page_id = next_page_id;
   }
-  return TableIterator(this, rid, txn);
+  return RID(INVALID_PAGE_ID, 0);
 }
 
 TableIterator TableHeap::End() { return TableIterator(this, RID(INVALID_PAGE_ID, 0), nullptr); }
@@ -16,8 +16,8 @@
 
 namespace bustub {
 
-TableIterator::TableIterator(TableHeap *table_heap, RID rid, Transaction *txn)
-    : table_heap_(table_heap), tuple_(new Tuple(rid)), txn_(txn) {
+TableIterator::TableIterator(TableHeap *table_heap, RID rid, Transaction *txn, page_id_t stop_page_id)
+    : table_heap_(table_heap), tuple_(new Tuple(rid)), txn_(txn), stop_page_id_(stop_page_id) {
   if (rid.GetPageId() != INVALID_PAGE_ID) {
     table_heap_->GetTuple(tuple_->rid_, tuple_, txn_);
   }
@@ -34,33 +34,11 @@ Tuple *TableIterator::operator->() {
 }
 
 TableIterator &TableIterator::operator++() {
-  BufferPoolManager *buffer_pool_manager = table_heap_->buffer_pool_manager_;
-  auto cur_page = static_cast<TablePage *>(buffer_pool_manager->FetchPage(tuple_->rid_.GetPageId()));
-  cur_page->RLatch();
-  assert(cur_page != nullptr);  // all pages are pinned
-
-  RID next_tuple_rid;
-  if (!cur_page->GetNextTupleRid(tuple_->rid_,
-                                 &next_tuple_rid)) {  // end of this page
-    while (cur_page->GetNextPageId() != INVALID_PAGE_ID) {
-      auto next_page = static_cast<TablePage *>(buffer_pool_manager->FetchPage(cur_page->GetNextPageId()));
-      cur_page->RUnlatch();
-      buffer_pool_manager->UnpinPage(cur_page->GetTablePageId(), false);
-      cur_page = next_page;
-      cur_page->RLatch();
-      if (cur_page->GetFirstTupleRid(&next_tuple_rid)) {
-        break;
-      }
-    }
-  }
-  tuple_->rid_ = next_tuple_rid;
-
+  RID cur_rid = tuple_->rid_;
+  tuple_->rid_ = table_heap_->FindTuple(cur_rid.GetPageId(), &cur_rid, stop_page_id_);
   if (*this != table_heap_->End()) {
     table_heap_->GetTuple(tuple_->rid_, tuple_, txn_);
   }
-  // release until copy the tuple
-  cur_page->RUnlatch();
-  buffer_pool_manager->UnpinPage(cur_page->GetTablePageId(), false);
   return *this;
 }
 
@@ -21,7 +21,7 @@
 namespace bustub {
 
 // TODO(Amadou): It does not look like nulls are supported. Add a null bitmap?
-Tuple::Tuple(std::vector<Value> values, const Schema *schema) : allocated_(true) {
+Tuple::Tuple(std::vector<Value> values, const Schema *schema, AbstractPool *pool) : allocated_(pool == nullptr) {
   assert(values.size() == schema->GetColumnCount());
 
   // 1. Calculate the size of the tuple.
@@ -32,7 +32,7 @@ Tuple::Tuple(std::vector<Value> values, const Schema *schema) : allocated_(true)
 
   // 2. Allocate memory.
   size_ = tuple_size;
-  data_ = new char[size_];
+  data_ = allocated_ ? new char[size_] : static_cast<char *>(pool->Allocate(size_));
   std::memset(data_, 0, size_);
 
   // 3. Serialize each attribute based on the input value.
@@ -53,6 +53,12 @@ Tuple::Tuple(std::vector<Value> values, const Schema *schema) : allocated_(true)
   }
 }
 
+Tuple::Tuple(const TupleView &view, AbstractPool *pool)
+    : allocated_(pool == nullptr), rid_(view.GetRid()), size_(view.GetLength()) {
+  data_ = allocated_ ? new char[size_] : static_cast<char *>(pool->Allocate(size_));
+  memcpy(data_, view.GetData(), size_);
+}
+
 Tuple::Tuple(const Tuple &other) : allocated_(other.allocated_), rid_(other.rid_), size_(other.size_) {
   if (allocated_) {
     delete[] data_;
@@ -150,16 +156,26 @@ void Tuple::SerializeTo(char *storage) const {
   memcpy(storage + sizeof(int32_t), data_, size_);
 }
 
-void Tuple::DeserializeFrom(const char *storage) {
+void Tuple::DeserializeFrom(const char *storage, AbstractPool *pool) {
   uint32_t size = *reinterpret_cast<const uint32_t *>(storage);
   // Construct a tuple.
   this->size_ = size;
   if (this->allocated_) {
     delete[] this->data_;
   }
-  this->data_ = new char[this->size_];
+  this->allocated_ = pool == nullptr;
+  this->data_ = this->allocated_ ? new char[this->size_] : static_cast<char *>(pool->Allocate(this->size_));
   memcpy(this->data_, storage + sizeof(int32_t), this->size_);
-  this->allocated_ = true;
+}
+
+void Tuple::Materialize() {
+  if (allocated_ || data_ == nullptr) {
+    return;
+  }
+  char *data = new char[size_];
+  memcpy(data, data_, size_);
+  data_ = data;
+  allocated_ = true;
 }
 
 }  // namespace bustub
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// zone_map.cpp
+//
+// Identification: src/storage/table/zone_map.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/zone_map.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "type/value_factory.h"
+
+namespace bustub {
+
+ZoneMap::ZoneMap(const Schema &schema, std::vector<uint32_t> column_idxs)
+    : schema_(schema), column_idxs_(std::move(column_idxs)) {}
+
+bool ZoneMap::HasColumn(uint32_t column_idx) const {
+  return std::find(column_idxs_.begin(), column_idxs_.end(), column_idx) != column_idxs_.end();
+}
+
+ZoneMap::PageZone *ZoneMap::GetOrCreate(page_id_t page_id) {
+  auto [iter, inserted] = pages_.try_emplace(page_id);
+  if (inserted) {
+    for (uint32_t column_idx : column_idxs_) {
+      TypeId type = schema_.GetColumn(column_idx).GetType();
+      iter->second.min_.push_back(ValueFactory::GetNullValueByType(type));
+      iter->second.max_.push_back(ValueFactory::GetNullValueByType(type));
+    }
+  }
+  return &iter->second;
+}
+
+void ZoneMap::Link(page_id_t page_id, page_id_t next_page_id) {
+  latch_.WLock();
+  GetOrCreate(page_id)->next_page_id_ = next_page_id;
+  if (next_page_id != INVALID_PAGE_ID) {
+    GetOrCreate(next_page_id);
+  }
+  latch_.WUnlock();
+}
+
+void ZoneMap::Insert(page_id_t page_id, const Tuple &tuple) {
+  latch_.WLock();
+  PageZone *zone = GetOrCreate(page_id);
+  for (uint32_t i = 0; i < column_idxs_.size(); i++) {
+    Value val = tuple.GetValue(&schema_, column_idxs_[i]);
+    if (val.IsNull()) {
+      continue;
+    }
+    if (zone->min_[i].IsNull() || val.CompareLessThan(zone->min_[i]) == CmpBool::CmpTrue) {
+      zone->min_[i] = val;
+    }
+    if (zone->max_[i].IsNull() || val.CompareGreaterThan(zone->max_[i]) == CmpBool::CmpTrue) {
+      zone->max_[i] = val;
+    }
+  }
+  latch_.WUnlock();
+}
+
+bool ZoneMap::GetNextPageId(page_id_t page_id, page_id_t *next_page_id) const {
+  latch_.RLock();
+  auto iter = pages_.find(page_id);
+  bool found = iter != pages_.end();
+  if (found) {
+    *next_page_id = iter->second.next_page_id_;
+  }
+  latch_.RUnlock();
+  return found;
+}
+
+bool ZoneMap::GetBounds(page_id_t page_id, uint32_t column_idx, Value *min, Value *max) const {
+  auto column = std::find(column_idxs_.begin(), column_idxs_.end(), column_idx);
+  if (column == column_idxs_.end()) {
+    return false;
+  }
+  size_t i = column - column_idxs_.begin();
+  latch_.RLock();
+  auto iter = pages_.find(page_id);
+  bool found = iter != pages_.end();
+  if (found) {
+    *min = iter->second.min_[i];
+    *max = iter->second.max_[i];
+  }
+  latch_.RUnlock();
+  return found;
+}
+
+}  // namespace bustub
@@ -0,0 +1,57 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena_pool.cpp
+//
+// Identification: src/type/arena_pool.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "type/arena_pool.h"
+
+#include <utility>
+
+namespace bustub {
+
+void *ArenaPool::Allocate(size_t size) {
+  size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  allocated_bytes_ += size;
+  if (size > block_size_ / 4) {
+    // A large chunk gets a block of its own, put before the current one so that its free bytes are not wasted.
+    std::unique_ptr<char[]> block(new char[size]);
+    char *chunk = block.get();
+    blocks_.insert(cursor_ == nullptr ? blocks_.end() : blocks_.end() - 1, std::move(block));
+    reserved_bytes_ += size;
+    return chunk;
+  }
+  if (cursor_ == nullptr || static_cast<size_t>(end_ - cursor_) < size) {
+    blocks_.emplace_back(new char[block_size_]);
+    reserved_bytes_ += block_size_;
+    cursor_ = blocks_.back().get();
+    end_ = cursor_ + block_size_;
+  }
+  char *chunk = cursor_;
+  cursor_ += size;
+  return chunk;
+}
+
+void ArenaPool::Reset() {
+  allocated_bytes_ = 0;
+  if (cursor_ == nullptr) {
+    blocks_.clear();
+    reserved_bytes_ = 0;
+    return;
+  }
+  // The current block is the last one, and the only one kept.
+  std::unique_ptr<char[]> block = std::move(blocks_.back());
+  blocks_.clear();
+  cursor_ = block.get();
+  end_ = cursor_ + block_size_;
+  blocks_.push_back(std::move(block));
+  reserved_bytes_ = block_size_;
+}
+
+}  // namespace bustub
@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// barrier_test.cpp
+//
+// Identification: test/common/barrier_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/barrier.h"
+#include "common/exception.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(BarrierTest, ArriveTest) {
+  const int num_threads = 4;
+  Barrier barrier(num_threads);
+  std::atomic<int> leaders{0};
+  std::atomic<int> arrived{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back([&] {
+      arrived++;
+      if (barrier.ArriveAndWait()) {
+        leaders++;
+      }
+      // nobody gets past the barrier before everyone has arrived
+      EXPECT_EQ(arrived, num_threads);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(leaders, 1);
+}
+
+// NOLINTNEXTLINE
+TEST(BarrierTest, CancelTest) {
+  const int num_threads = 3;
+  Barrier barrier(num_threads + 1);
+  std::atomic<int> cancelled{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back([&] {
+      try {
+        barrier.ArriveAndWait();
+      } catch (Exception &e) {
+        cancelled++;
+      }
+    });
+  }
+  // the last thread never arrives, the waiting ones are released
+  barrier.Cancel();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(cancelled, num_threads);
+  // a thread arriving after the cancellation does not wait either
+  EXPECT_THROW(barrier.ArriveAndWait(), Exception);
+}
+
+}  // namespace bustub
@@ -0,0 +1,142 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_util_test.cpp
+//
+// Identification: test/common/hash_util_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "common/util/hash_util.h"
+#include "gtest/gtest.h"
+#include "murmur3/MurmurHash3.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+static hash_t HashOf(const Value &val) { return HashUtil::HashValue(&val); }
+
+// NOLINTNEXTLINE
+TEST(HashUtilTest, HashValueTest) {
+  // integers of every width hash the same when they hold the same value
+  for (int v : {0, 1, -1, 100}) {
+    hash_t hash = HashOf(ValueFactory::GetBigIntValue(v));
+    EXPECT_EQ(hash, HashOf(ValueFactory::GetTinyIntValue(static_cast<int8_t>(v))));
+    EXPECT_EQ(hash, HashOf(ValueFactory::GetSmallIntValue(static_cast<int16_t>(v))));
+    EXPECT_EQ(hash, HashOf(ValueFactory::GetIntegerValue(v)));
+  }
+
+  // no collisions among nearby integers and short strings, and strings are hashed by content
+  std::unordered_set<hash_t> hashes;
+  for (int i = 0; i < 10000; i++) {
+    hashes.insert(HashOf(ValueFactory::GetIntegerValue(i)));
+  }
+  for (int i = 0; i < 10000; i++) {
+    hashes.insert(HashOf(ValueFactory::GetVarcharValue(std::to_string(i))));
+  }
+  EXPECT_EQ(20000, hashes.size());
+  std::string str(100, 'x');
+  EXPECT_EQ(HashOf(ValueFactory::GetVarcharValue(str)), HashOf(ValueFactory::GetVarcharValue(std::string(str))));
+
+  // combining is order sensitive
+  EXPECT_NE(HashUtil::CombineHashes(1, 2), HashUtil::CombineHashes(2, 1));
+}
+
+// NOLINTNEXTLINE
+TEST(HashUtilTest, HashColumnTest) {
+  std::vector<Value> ints;
+  std::vector<Value> strs;
+  std::vector<int64_t> raw;
+  for (int i = 0; i < 100; i++) {
+    ints.push_back(ValueFactory::GetIntegerValue(i * 7));
+    strs.push_back(ValueFactory::GetVarcharValue("key" + std::to_string(i)));
+    raw.push_back(i * 7);
+  }
+
+  // the batched paths agree with hashing one value at a time
+  std::vector<hash_t> hashes(ints.size());
+  std::vector<hash_t> raw_hashes(ints.size());
+  HashUtil::HashValues(ints.data(), ints.size(), hashes.data());
+  HashUtil::HashInts(raw.data(), raw.size(), raw_hashes.data());
+  for (size_t i = 0; i < ints.size(); i++) {
+    EXPECT_EQ(HashUtil::HashValue(&ints[i]), hashes[i]);
+    EXPECT_EQ(hashes[i], raw_hashes[i]);
+  }
+
+  // combining a second column matches combining the two hashes row by row
+  HashUtil::CombineHashValues(strs.data(), strs.size(), hashes.data());
+  for (size_t i = 0; i < ints.size(); i++) {
+    EXPECT_EQ(HashUtil::CombineHashes(HashUtil::HashValue(&ints[i]), HashUtil::HashValue(&strs[i])), hashes[i]);
+  }
+}
+
+// Compares HashBytes against the byte-at-a-time loop it replaced and against MurmurHash3_x64_128 over key lengths
+// typical of join and aggregation keys, plus the integer fast path and the batched column API.
+// NOLINTNEXTLINE
+TEST(HashUtilTest, DISABLED_HashBenchmark) {
+  const int num_keys = 1 << 16;
+  const int rounds = 64;
+  auto byte_loop = [](const char *bytes, size_t length) {
+    hash_t hash = length;
+    for (size_t i = 0; i < length; ++i) {
+      hash = ((hash << 5) ^ (hash >> 27)) ^ bytes[i];
+    }
+    return hash;
+  };
+  auto murmur = [](const char *bytes, size_t length) {
+    uint64_t hash[2];
+    murmur3::MurmurHash3_x64_128(bytes, static_cast<int>(length), 0, hash);
+    return hash[0];
+  };
+  auto run = [&](const char *name, size_t length, auto &&hash_fn) {
+    std::vector<char> data(num_keys * length);
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i] = static_cast<char>(i * 131);
+    }
+    hash_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (int i = 0; i < num_keys; i++) {
+        sink += hash_fn(&data[i * length], length);
+      }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printf("%-10s %4zu bytes  %8.2f Mhash/s  (%zx)\n", name, length, num_keys * rounds / elapsed.count() / 1e6, sink);
+  };
+  for (size_t length : {4, 8, 16, 32, 64, 256}) {
+    run("byte loop", length, byte_loop);
+    run("murmur3", length, murmur);
+    run("wyhash", length, HashUtil::HashBytes);
+  }
+
+  std::vector<Value> column;
+  for (int i = 0; i < num_keys; i++) {
+    column.push_back(ValueFactory::GetIntegerValue(i));
+  }
+  std::vector<hash_t> hashes(num_keys);
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (int i = 0; i < num_keys; i++) {
+      hashes[i] = HashUtil::HashValue(&column[i]);
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  printf("HashValue  integer      %8.2f Mhash/s\n", num_keys * rounds / elapsed.count() / 1e6);
+  start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    HashUtil::HashValues(column.data(), column.size(), hashes.data());
+  }
+  elapsed = std::chrono::steady_clock::now() - start;
+  printf("HashValues integer      %8.2f Mhash/s\n", num_keys * rounds / elapsed.count() / 1e6);
+}
+
+}  // namespace bustub
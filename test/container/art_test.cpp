@@ -0,0 +1,165 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// art_test.cpp
+//
+// Identification: test/container/art_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "container/art/adaptive_radix_tree.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// fixed-width big-endian keys are prefix-free and share long prefixes, like encoded integer keys
+static std::string IntKey(uint32_t key) {
+  std::string out(4, '\0');
+  for (int i = 0; i < 4; i++) {
+    out[i] = static_cast<char>(key >> (24 - 8 * i));
+  }
+  return out;
+}
+
+// NOLINTNEXTLINE
+TEST(ARTTest, SampleTest) {
+  AdaptiveRadixTree<int> art;
+
+  // dense keys fill nodes up to 256 children, sparse ones split compressed paths
+  std::vector<uint32_t> keys;
+  for (uint32_t i = 0; i < 1000; i++) {
+    keys.push_back(i);
+    keys.push_back(i * 7919 + (1U << 30));
+  }
+  for (uint32_t key : keys) {
+    EXPECT_TRUE(art.Insert(IntKey(key), static_cast<int>(key)));
+  }
+  for (uint32_t key : keys) {
+    std::vector<int> res;
+    EXPECT_TRUE(art.GetValue(IntKey(key), &res));
+    ASSERT_EQ(1, res.size()) << "Failed to find " << key;
+    EXPECT_EQ(static_cast<int>(key), res[0]);
+  }
+  std::vector<int> res;
+  EXPECT_FALSE(art.GetValue(IntKey(5000), &res));
+  EXPECT_FALSE(art.GetValue(IntKey(0xffffffff), &res));
+
+  // duplicate keys keep every distinct value
+  EXPECT_FALSE(art.Insert(IntKey(3), 3));
+  EXPECT_TRUE(art.Insert(IntKey(3), 4));
+  res.clear();
+  art.GetValue(IntKey(3), &res);
+  EXPECT_EQ(2, res.size());
+
+  // remove every other key
+  EXPECT_TRUE(art.Remove(IntKey(3), 4));
+  EXPECT_FALSE(art.Remove(IntKey(3), 4));
+  for (size_t i = 0; i < keys.size(); i += 2) {
+    EXPECT_TRUE(art.Remove(IntKey(keys[i]), static_cast<int>(keys[i])));
+  }
+  for (size_t i = 0; i < keys.size(); i++) {
+    res.clear();
+    EXPECT_EQ(i % 2 == 1, art.GetValue(IntKey(keys[i]), &res)) << "Wrong result for " << keys[i];
+  }
+
+  // variable length keys that diverge deep inside a long shared prefix
+  std::string base(40, 'x');
+  EXPECT_TRUE(art.Insert(base + "a" + std::string(1, '\0'), 1));
+  EXPECT_TRUE(art.Insert(base + "b" + std::string(1, '\0'), 2));
+  EXPECT_TRUE(art.Insert(base.substr(0, 20) + "y" + std::string(1, '\0'), 3));
+  res.clear();
+  EXPECT_TRUE(art.GetValue(base + "b" + std::string(1, '\0'), &res));
+  EXPECT_TRUE(art.GetValue(base.substr(0, 20) + "y" + std::string(1, '\0'), &res));
+  EXPECT_FALSE(art.GetValue(base + "c" + std::string(1, '\0'), &res));
+  EXPECT_EQ((std::vector<int>{2, 3}), res);
+}
+
+// NOLINTNEXTLINE
+TEST(ARTTest, ConcurrentTest) {
+  AdaptiveRadixTree<int> art;
+  const int num_threads = 4;
+  const int keys_per_thread = 5000;
+
+  // writers grow and split nodes under each other while readers check keys that are already in place
+  for (int i = 0; i < keys_per_thread; i++) {
+    art.Insert(IntKey(i * 2 + 1), i);
+  }
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&art, t] {
+      for (int i = 0; i < keys_per_thread; i++) {
+        uint32_t key = (t * keys_per_thread + i) * 2;
+        EXPECT_TRUE(art.Insert(IntKey(key), static_cast<int>(key)));
+        std::vector<int> res;
+        EXPECT_TRUE(art.GetValue(IntKey(i * 2 + 1), &res));
+        EXPECT_TRUE(art.GetValue(IntKey(key), &res));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (uint32_t key = 0; key < num_threads * keys_per_thread * 2; key += 2) {
+    std::vector<int> res;
+    EXPECT_TRUE(art.GetValue(IntKey(key), &res)) << "Lost " << key;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(ARTTest, DuplicateKeyTest) {
+  AdaptiveRadixTree<int> art;
+  const int num_threads = 4;
+  const int values_per_thread = 2000;
+  const int num_stable = 100;
+
+  // every writer adds and drops values under the same key, growing its leaf and filling holes in place, while
+  // readers must always see the values that stay
+  for (int i = 0; i < num_stable; i++) {
+    EXPECT_TRUE(art.Insert(IntKey(7), -1 - i));
+  }
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&art, t] {
+      for (int i = 0; i < values_per_thread; i++) {
+        int value = t * values_per_thread + i;
+        EXPECT_TRUE(art.Insert(IntKey(7), value));
+        if (i % 2 == 0) {
+          EXPECT_TRUE(art.Remove(IntKey(7), value));
+        }
+      }
+    });
+    threads.emplace_back([&art, num_stable] {
+      for (int round = 0; round < 200; round++) {
+        std::vector<int> res;
+        EXPECT_TRUE(art.GetValue(IntKey(7), &res));
+        EXPECT_GE(res.size(), num_stable);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::vector<int> res;
+  EXPECT_TRUE(art.GetValue(IntKey(7), &res));
+  EXPECT_EQ(num_stable + num_threads * values_per_thread / 2, res.size());
+  for (int t = 0; t < num_threads; t++) {
+    for (int i = 1; i < values_per_thread; i += 2) {
+      EXPECT_TRUE(art.Remove(IntKey(7), t * values_per_thread + i));
+    }
+  }
+  for (int i = 0; i < num_stable; i++) {
+    EXPECT_TRUE(art.Remove(IntKey(7), -1 - i));
+  }
+  EXPECT_FALSE(art.GetValue(IntKey(7), &res));
+}
+
+}  // namespace bustub
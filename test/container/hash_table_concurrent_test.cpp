@@ -0,0 +1,150 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// hash_table_concurrent_test.cpp
+//
+// Identification: test/container/hash_table_concurrent_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "container/hash/extendible_hash_table.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+// helper function to launch multiple threads
+template <typename... Args>
+void LaunchParallelTest(uint64_t num_threads, Args &&... args) {
+  std::vector<std::thread> thread_group;
+
+  // Launch a group of threads
+  for (uint64_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
+    thread_group.push_back(std::thread(args..., thread_itr));
+  }
+
+  // Join the threads with the main thread
+  for (uint64_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
+    thread_group[thread_itr].join();
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableConcurrentTest, InsertTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  ExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+  const int num_threads = 4;
+  const int keys_per_thread = 2000;
+
+  // every thread inserts its own keys, enough to split buckets and grow the directory while the others read
+  LaunchParallelTest(num_threads, [&](uint64_t thread_itr) {
+    for (int i = 0; i < keys_per_thread; i++) {
+      int key = static_cast<int>(thread_itr) * keys_per_thread + i;
+      EXPECT_TRUE(ht.Insert(nullptr, key, key));
+      std::vector<int> res;
+      EXPECT_TRUE(ht.GetValue(nullptr, key, &res));
+    }
+  });
+  ht.VerifyIntegrity();
+  EXPECT_GT(ht.GetGlobalDepth(), 0);
+
+  for (int key = 0; key < num_threads * keys_per_thread; key++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, key, &res);
+    ASSERT_EQ(1, res.size()) << "Failed to keep " << key;
+    EXPECT_EQ(key, res[0]);
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(HashTableConcurrentTest, MixedTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  ExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+  const int num_keys = 4000;
+  for (int key = 0; key < num_keys; key++) {
+    ht.Insert(nullptr, key, key);
+  }
+
+  // even threads remove their half of the keys, merging buckets, while odd threads keep reading the other half
+  LaunchParallelTest(4, [&](uint64_t thread_itr) {
+    for (int key = static_cast<int>(thread_itr % 2); key < num_keys; key += 2) {
+      if (thread_itr % 2 == 0) {
+        if (key % 4 == static_cast<int>(thread_itr)) {
+          EXPECT_TRUE(ht.Remove(nullptr, key, key));
+        }
+      } else {
+        std::vector<int> res;
+        EXPECT_TRUE(ht.GetValue(nullptr, key, &res)) << "Lost " << key;
+      }
+    }
+  });
+  ht.VerifyIntegrity();
+
+  for (int key = 0; key < num_keys; key++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, key, &res);
+    EXPECT_EQ(key % 2 == 0 ? 0 : 1, res.size()) << "Wrong result for " << key;
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// Measures point lookup throughput as the number of reader threads grows. Lookups only share the directory latch
+// and latch their bucket page for reading, so throughput should grow with the thread count up to the core count.
+// NOLINTNEXTLINE
+TEST(HashTableConcurrentTest, DISABLED_ReadScalingBenchmark) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(256, disk_manager);
+  ExtendibleHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), HashFunction<int>());
+  const int num_keys = 20000;
+  const int lookups_per_thread = 200000;
+  for (int key = 0; key < num_keys; key++) {
+    ht.Insert(nullptr, key, key);
+  }
+
+  double base_throughput = 0;
+  for (uint64_t num_threads = 1; num_threads <= std::thread::hardware_concurrency() && num_threads <= 16;
+       num_threads *= 2) {
+    auto start = std::chrono::steady_clock::now();
+    LaunchParallelTest(num_threads, [&](uint64_t thread_itr) {
+      std::vector<int> res;
+      uint32_t key = thread_itr * 7919;
+      for (int i = 0; i < lookups_per_thread; i++) {
+        res.clear();
+        key = (key * 1103515245 + 12345) % num_keys;
+        ht.GetValue(nullptr, static_cast<int>(key), &res);
+      }
+    });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double throughput = num_threads * lookups_per_thread / elapsed.count();
+    if (num_threads == 1) {
+      base_throughput = throughput;
+    }
+    printf("threads: %2lu  lookups/s: %12.0f  speedup: %5.2fx\n", num_threads, throughput,
+           throughput / base_throughput);
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+}  // namespace bustub
@@ -114,4 +114,51 @@ TEST(HashTablePageTest, DISABLED_BucketPageSampleTest) {
   delete bpm;
 }
 
+// NOLINTNEXTLINE
+TEST(HashTablePageTest, BucketPageFingerprintTest) {
+  DiskManager *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(5, disk_manager);
+  page_id_t bucket_page_id = INVALID_PAGE_ID;
+  using BucketPage = HashTableBucketPage<int, int, IntComparator>;
+  auto bucket_page = reinterpret_cast<BucketPage *>(bpm->NewPage(&bucket_page_id, nullptr)->GetData());
+  auto tag_of = [](int key) { return BucketPage::Fingerprint(static_cast<uint32_t>(key % 7) << 24); };
+
+  // fill the whole bucket, many keys share a fingerprint
+  int capacity = 0;
+  while (bucket_page->Insert(capacity, capacity, IntComparator(), tag_of(capacity))) {
+    EXPECT_EQ(tag_of(capacity), bucket_page->TagAt(capacity));
+    capacity++;
+  }
+  EXPECT_GT(capacity, 400);
+  EXPECT_TRUE(bucket_page->IsFull());
+  EXPECT_FALSE(bucket_page->Insert(capacity - 1, capacity - 1, IntComparator(), tag_of(capacity - 1)));
+
+  for (int i = 0; i < capacity; i++) {
+    std::vector<int> res;
+    ASSERT_TRUE(bucket_page->GetValue(i, IntComparator(), &res, tag_of(i)));
+    ASSERT_EQ(1, res.size());
+    EXPECT_EQ(i, res[0]);
+    // a key is never compared against slots carrying another fingerprint
+    res.clear();
+    EXPECT_FALSE(bucket_page->GetValue(i, IntComparator(), &res, tag_of(i + 1)));
+  }
+
+  // tombstones are skipped by lookups and reused by the next insert, which takes the new fingerprint
+  ASSERT_TRUE(bucket_page->Remove(3, 3, IntComparator(), tag_of(3)));
+  EXPECT_FALSE(bucket_page->Remove(3, 3, IntComparator(), tag_of(3)));
+  std::vector<int> res;
+  EXPECT_FALSE(bucket_page->GetValue(3, IntComparator(), &res, tag_of(3)));
+  ASSERT_TRUE(bucket_page->Insert(3, 42, IntComparator(), tag_of(3)));
+  EXPECT_TRUE(bucket_page->GetValue(3, IntComparator(), &res, tag_of(3)));
+  ASSERT_EQ(1, res.size());
+  EXPECT_EQ(42, res[0]);
+  EXPECT_EQ(42, bucket_page->ValueAt(3));
+
+  bpm->UnpinPage(bucket_page_id, true, nullptr);
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
 }  // namespace bustub
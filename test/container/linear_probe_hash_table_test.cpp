@@ -0,0 +1,183 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// linear_probe_hash_table_test.cpp
+//
+// Identification: test/container/linear_probe_hash_table_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "container/hash/linear_probe_hash_table.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, SampleTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 10, HashFunction<int>());
+
+  // insert a few values
+  for (int i = 0; i < 5; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+    std::vector<int> res;
+    EXPECT_TRUE(ht.GetValue(nullptr, i, &res));
+    ASSERT_EQ(1, res.size()) << "Failed to insert " << i;
+    EXPECT_EQ(i, res[0]);
+  }
+
+  // duplicate key/value pairs are rejected, duplicate keys with other values are kept
+  for (int i = 0; i < 5; i++) {
+    EXPECT_FALSE(ht.Insert(nullptr, i, i));
+    EXPECT_TRUE(ht.Insert(nullptr, i, 2 * i + 1));
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(2, res.size()) << "Failed to keep duplicates of " << i;
+  }
+
+  // removals leave tombstones that lookups probe past
+  for (int i = 0; i < 5; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+    EXPECT_FALSE(ht.Remove(nullptr, i, i));
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    ASSERT_EQ(1, res.size());
+    EXPECT_EQ(2 * i + 1, res[0]);
+  }
+  std::vector<int> res;
+  EXPECT_FALSE(ht.GetValue(nullptr, 20, &res));
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, GrowTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 10, HashFunction<int>());
+  size_t initial_size = ht.GetSize();
+  EXPECT_GE(initial_size, 10);
+
+  // inserting past three quarters of the slots grows the table
+  const int num_keys = static_cast<int>(initial_size) * 2;
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+  }
+  EXPECT_GT(ht.GetSize(), initial_size);
+
+  // with a quarter of the slots live, churning removes and inserts fills the table with tombstones, which a
+  // rehash drops without growing
+  size_t grown_size = ht.GetSize();
+  for (int i = 0; i < num_keys / 2; i++) {
+    EXPECT_TRUE(ht.Remove(nullptr, i, i));
+  }
+  for (int round = 0; round < 4; round++) {
+    for (int i = num_keys / 2; i < num_keys; i++) {
+      EXPECT_TRUE(ht.Remove(nullptr, i, i));
+      EXPECT_TRUE(ht.Insert(nullptr, i, i));
+    }
+  }
+  EXPECT_EQ(grown_size, ht.GetSize());
+
+  ht.Resize(grown_size);
+  EXPECT_GE(ht.GetSize(), 2 * grown_size);
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    ASSERT_EQ(i < num_keys / 2 ? 0 : 1, res.size()) << "Wrong result for " << i;
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, ChainedHeaderTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 10, HashFunction<int>());
+
+  // more blocks than one header page lists, so the rest go to a chained header page
+  const size_t block_slots = 4 * PAGE_SIZE / (4 * sizeof(std::pair<int, int>) + 1);
+  const size_t initial_size = HashTableHeaderPage::MaxBlocks() * block_slots;
+  ht.Resize(initial_size);
+  EXPECT_GE(ht.GetSize(), 2 * initial_size);
+  const int num_keys = 20000;
+  for (int i = 0; i < num_keys; i++) {
+    EXPECT_TRUE(ht.Insert(nullptr, i, i));
+  }
+
+  // a rehash reads every block of the chain, then frees it
+  ht.Resize(initial_size);
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    ASSERT_EQ(1, res.size()) << "Wrong result for " << i;
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+// NOLINTNEXTLINE
+TEST(LinearProbeHashTableTest, ConcurrentResizeTest) {
+  auto *disk_manager = new DiskManager("test.db");
+  auto *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  LinearProbeHashTable<int, int, IntComparator> ht("blah", bpm, IntComparator(), 10, HashFunction<int>());
+  const int num_readable = 200;
+  const int num_keys = 4000;
+  for (int i = 0; i < num_readable; i++) {
+    ht.Insert(nullptr, i, i);
+  }
+
+  // the writer keeps growing the table while the readers must never miss the keys that were there before
+  std::vector<std::thread> threads;
+  threads.emplace_back([&] {
+    for (int i = num_readable; i < num_keys; i++) {
+      EXPECT_TRUE(ht.Insert(nullptr, i, i));
+    }
+  });
+  for (int t = 0; t < 2; t++) {
+    threads.emplace_back([&] {
+      for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < num_readable; i++) {
+          std::vector<int> res;
+          EXPECT_TRUE(ht.GetValue(nullptr, i, &res)) << "Lost " << i;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < num_keys; i++) {
+    std::vector<int> res;
+    ht.GetValue(nullptr, i, &res);
+    EXPECT_EQ(1, res.size()) << "Wrong result for " << i;
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete disk_manager;
+  delete bpm;
+}
+
+}  // namespace bustub
@@ -10,30 +10,45 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdio>
 #include <memory>
+#include <set>
 #include <string>
+#include <tuple>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "buffer/buffer_pool_manager_instance.h"
 #include "concurrency/transaction_manager.h"
+#include "execution/compiled_expression.h"
 #include "execution/execution_engine.h"
 #include "execution/executor_context.h"
+#include "execution/executor_factory.h"
 #include "execution/executors/aggregation_executor.h"
 #include "execution/executors/insert_executor.h"
 #include "execution/executors/nested_loop_join_executor.h"
+#include "execution/executors/seq_scan_executor.h"
 #include "execution/expressions/aggregate_value_expression.h"
 #include "execution/expressions/column_value_expression.h"
 #include "execution/expressions/comparison_expression.h"
 #include "execution/expressions/constant_value_expression.h"
+#include "execution/join_hash_table.h"
 #include "execution/plans/delete_plan.h"
+#include "execution/plans/hash_join_plan.h"
+#include "execution/plans/index_scan_plan.h"
 #include "execution/plans/limit_plan.h"
+#include "execution/plans/merge_join_plan.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "execution/plans/sort_plan.h"
+#include "execution/plans/topn_plan.h"
 #include "executor_test_util.h"  // NOLINT
 #include "gtest/gtest.h"
 #include "storage/table/tuple.h"
 #include "test_util.h"  // NOLINT
+#include "type/arena_pool.h"
 #include "type/value_factory.h"
 
 namespace bustub {
@@ -45,7 +60,7 @@ using ComparatorType = GenericComparator<8>;
 using HashFunctionType = HashFunction<KeyType>;
 
 // SELECT col_a, col_b FROM test_1 WHERE col_a < 500
-TEST_F(ExecutorTest, DISABLED_SimpleSeqScanTest) {
+TEST_F(ExecutorTest, SimpleSeqScanTest) {
   // Construct query plan
   TableInfo *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
   const Schema &schema = table_info->schema_;
@@ -274,7 +289,7 @@ TEST_F(ExecutorTest, DISABLED_SimpleDeleteTest) {
 }
 
 // SELECT test_1.col_a, test_1.col_b, test_2.col1, test_2.col3 FROM test_1 JOIN test_2 ON test_1.col_a = test_2.col1
-TEST_F(ExecutorTest, DISABLED_SimpleNestedLoopJoinTest) {
+TEST_F(ExecutorTest, SimpleNestedLoopJoinTest) {
   const Schema *out_schema1;
   std::unique_ptr<AbstractPlanNode> scan_plan1;
   {
@@ -318,7 +333,7 @@ TEST_F(ExecutorTest, DISABLED_SimpleNestedLoopJoinTest) {
 }
 
 // SELECT COUNT(col_a), SUM(col_a), min(col_a), max(col_a) from test_1;
-TEST_F(ExecutorTest, DISABLED_SimpleAggregationTest) {
+TEST_F(ExecutorTest, SimpleAggregationTest) {
   const Schema *scan_schema;
   std::unique_ptr<AbstractPlanNode> scan_plan;
   {
@@ -368,7 +383,7 @@ TEST_F(ExecutorTest, DISABLED_SimpleAggregationTest) {
 }
 
 // SELECT count(col_a), col_b, sum(col_c) FROM test_1 Group By col_b HAVING count(col_a) > 100;
-TEST_F(ExecutorTest, DISABLED_SimpleGroupByAggregation) {
+TEST_F(ExecutorTest, SimpleGroupByAggregation) {
   const Schema *scan_schema;
   std::unique_ptr<AbstractPlanNode> scan_plan;
   {
@@ -420,4 +435,1332 @@ TEST_F(ExecutorTest, DISABLED_SimpleGroupByAggregation) {
   }
 }
 
+// SELECT col_a, col_b FROM test_1 WHERE col_a BETWEEN 100 AND 199, through a B+ tree index on col_a
+TEST_F(ExecutorTest, IndexScanRangeTest) {
+  auto table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto key_schema = ParseCreateStatement("a bigint");
+  auto *index_info = GetExecutorContext()->GetCatalog()->CreateIndex<KeyType, ValueType, ComparatorType>(
+      GetTxn(), "index1", "test_1", schema, *key_schema, {0}, 8, HashFunctionType{}, IndexType::BPlusTreeIndex);
+  ASSERT_NE(index_info, Catalog::NULL_INDEX_INFO);
+
+  auto col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto out_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+
+  // explicit range, both ends inclusive
+  IndexScanRange range;
+  range.lower_ = {ValueFactory::GetIntegerValue(100)};
+  range.upper_ = {ValueFactory::GetIntegerValue(199)};
+  IndexScanPlanNode range_plan{out_schema, nullptr, index_info->index_oid_, range};
+  std::vector<Tuple> result_set{};
+  GetExecutionEngine()->Execute(&range_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), 100);
+  for (size_t i = 0; i < result_set.size(); i++) {
+    ASSERT_EQ(result_set[i].GetValue(out_schema, 0).GetAs<int32_t>(), static_cast<int32_t>(100 + i));
+  }
+
+  // reverse scan with an exclusive upper bound
+  range.upper_inclusive_ = false;
+  range.reverse_ = true;
+  IndexScanPlanNode reverse_plan{out_schema, nullptr, index_info->index_oid_, range};
+  result_set.clear();
+  GetExecutionEngine()->Execute(&reverse_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), 99);
+  for (size_t i = 0; i < result_set.size(); i++) {
+    ASSERT_EQ(result_set[i].GetValue(out_schema, 0).GetAs<int32_t>(), static_cast<int32_t>(198 - i));
+  }
+
+  // a comparison on the key column is turned into a range
+  auto const_990 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(990));
+  auto predicate = MakeComparisonExpression(col_a, const_990, ComparisonType::GreaterThanOrEqual);
+  IndexScanPlanNode predicate_plan{out_schema, predicate, index_info->index_oid_};
+  result_set.clear();
+  GetExecutionEngine()->Execute(&predicate_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), 10);
+  for (size_t i = 0; i < result_set.size(); i++) {
+    ASSERT_EQ(result_set[i].GetValue(out_schema, 0).GetAs<int32_t>(), static_cast<int32_t>(990 + i));
+  }
+
+  // a decimal bound is not rounded to a key, so 989 does not pass
+  auto const_decimal = MakeConstantValueExpression(ValueFactory::GetDecimalValue(989.5));
+  auto decimal_predicate = MakeComparisonExpression(col_a, const_decimal, ComparisonType::GreaterThanOrEqual);
+  IndexScanPlanNode decimal_plan{out_schema, decimal_predicate, index_info->index_oid_};
+  result_set.clear();
+  GetExecutionEngine()->Execute(&decimal_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), 10);
+  ASSERT_EQ(result_set[0].GetValue(out_schema, 0).GetAs<int32_t>(), 990);
+
+  // nothing equals a null, not even the keys it is stored as
+  auto const_null = MakeConstantValueExpression(ValueFactory::GetNullValueByType(TypeId::BIGINT));
+  auto null_predicate = MakeComparisonExpression(col_a, const_null, ComparisonType::Equal);
+  IndexScanPlanNode null_plan{out_schema, null_predicate, index_info->index_oid_};
+  result_set.clear();
+  GetExecutionEngine()->Execute(&null_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_TRUE(result_set.empty());
+}
+
+// SELECT col_b, col_a FROM test_1 WHERE col_b = 3, answered by a B+ tree index on col_b that includes col_a
+TEST_F(ExecutorTest, CoveringIndexScanTest) {
+  auto table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto key_schema = ParseCreateStatement("b int");
+  // index on colB, which holds duplicates, carrying colA in every entry
+  auto *index_info = GetExecutorContext()->GetCatalog()->CreateIndex<KeyType, ValueType, ComparatorType>(
+      GetTxn(), "covering1", "test_1", schema, *key_schema, {1}, 8, HashFunctionType{}, IndexType::BPlusTreeIndex,
+      {0});
+  ASSERT_NE(index_info, Catalog::NULL_INDEX_INFO);
+  ASSERT_EQ(index_info->index_->GetIndexColumnCount(), 1);
+  ASSERT_EQ(index_info->key_schema_.GetColumnCount(), 2);
+
+  std::vector<int32_t> expected;
+  std::vector<int32_t> expected_c;
+  for (auto iter = table_info->table_->Begin(GetTxn()); iter != table_info->table_->End(); ++iter) {
+    if (iter->GetValue(&schema, 1).GetAs<int32_t>() == 3) {
+      expected.push_back(iter->GetValue(&schema, 0).GetAs<int32_t>());
+      expected_c.push_back(iter->GetValue(&schema, 2).GetAs<int32_t>());
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+
+  // a point lookup on the key finds every entry regardless of its included column
+  std::vector<RID> rids;
+  Tuple probe({ValueFactory::GetIntegerValue(3)}, index_info->index_->GetSearchKeySchema());
+  index_info->index_->ScanKey(probe, &rids, GetTxn());
+  ASSERT_EQ(rids.size(), expected.size());
+
+  // the index-only scan returns entries ordered by key, then by the included column
+  auto col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto out_schema = MakeOutputSchema({{"colB", col_b}, {"colA", col_a}});
+  IndexScanRange range;
+  range.lower_ = {ValueFactory::GetIntegerValue(3)};
+  range.upper_ = {ValueFactory::GetIntegerValue(3)};
+  IndexScanPlanNode plan{out_schema, nullptr, index_info->index_oid_, range, true};
+  std::vector<Tuple> result_set{};
+  GetExecutionEngine()->Execute(&plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), expected.size());
+  for (size_t i = 0; i < result_set.size(); i++) {
+    ASSERT_EQ(result_set[i].GetValue(out_schema, 0).GetAs<int32_t>(), 3);
+    ASSERT_EQ(result_set[i].GetValue(out_schema, 1).GetAs<int32_t>(), expected[i]);
+  }
+
+  // an exclusive bound skips the whole run of entries sharing the key
+  range.lower_ = {ValueFactory::GetIntegerValue(2)};
+  range.lower_inclusive_ = false;
+  range.reverse_ = true;
+  IndexScanPlanNode reverse_plan{out_schema, nullptr, index_info->index_oid_, range, true};
+  result_set.clear();
+  GetExecutionEngine()->Execute(&reverse_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), expected.size());
+  for (size_t i = 0; i < result_set.size(); i++) {
+    ASSERT_EQ(result_set[i].GetValue(out_schema, 1).GetAs<int32_t>(), expected[expected.size() - 1 - i]);
+  }
+
+  // reading a column the index does not store is rejected
+  auto col_c = MakeColumnValueExpression(schema, 0, "colC");
+  auto uncovered_schema = MakeOutputSchema({{"colC", col_c}});
+  IndexScanPlanNode uncovered_plan{uncovered_schema, nullptr, index_info->index_oid_, range, true};
+  EXPECT_THROW(GetExecutionEngine()->Execute(&uncovered_plan, &result_set, GetTxn(), GetExecutorContext()),
+               Exception);
+
+  // an entry wider than 8 bytes takes a wider key, which the index-only scan reads all the same
+  auto *wide_info = GetExecutorContext()->GetCatalog()->CreateIndex<GenericKey<16>, ValueType, GenericComparator<16>>(
+      GetTxn(), "covering3", "test_1", schema, *key_schema, {1}, 16, HashFunction<GenericKey<16>>{},
+      IndexType::BPlusTreeIndex, {0, 2});
+  ASSERT_NE(wide_info, Catalog::NULL_INDEX_INFO);
+  auto wide_c = MakeColumnValueExpression(schema, 0, "colC");
+  auto wide_schema = MakeOutputSchema({{"colA", col_a}, {"colC", wide_c}});
+  range.lower_inclusive_ = true;
+  range.lower_ = {ValueFactory::GetIntegerValue(3)};
+  range.reverse_ = false;
+  IndexScanPlanNode wide_plan{wide_schema, nullptr, wide_info->index_oid_, range, true};
+  result_set.clear();
+  GetExecutionEngine()->Execute(&wide_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), expected.size());
+  for (size_t i = 0; i < result_set.size(); i++) {
+    ASSERT_EQ(result_set[i].GetValue(wide_schema, 0).GetAs<int32_t>(), expected[i]);
+    ASSERT_EQ(result_set[i].GetValue(wide_schema, 1).GetAs<int32_t>(), expected_c[i]);
+  }
+
+  // an entry that does not fit in the key is rejected
+  EXPECT_EQ(Catalog::NULL_INDEX_INFO,
+            (GetExecutorContext()->GetCatalog()->CreateIndex<KeyType, ValueType, ComparatorType>(
+                GetTxn(), "covering4", "test_1", schema, *key_schema, {1}, 8, HashFunctionType{},
+                IndexType::BPlusTreeIndex, {0, 2})));
+
+  // included columns are only accepted by ordered indexes
+  EXPECT_EQ(Catalog::NULL_INDEX_INFO,
+            (GetExecutorContext()->GetCatalog()->CreateIndex<KeyType, ValueType, ComparatorType>(
+                GetTxn(), "covering2", "test_1", schema, *key_schema, {1}, 8, HashFunctionType{},
+                IndexType::ExtendibleHashTableIndex, {0})));
+}
+
+// SELECT test_1.colA, test_2.col1 FROM test_1 JOIN test_2 ON test_1.colB < test_2.col1, a block of test_1 at a time
+TEST_F(ExecutorTest, BlockNestedLoopJoinTest) {
+  auto *left_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto *right_info = GetExecutorContext()->GetCatalog()->GetTable("test_2");
+  auto col_a = MakeColumnValueExpression(left_info->schema_, 0, "colA");
+  auto col_b = MakeColumnValueExpression(left_info->schema_, 0, "colB");
+  auto col1 = MakeColumnValueExpression(right_info->schema_, 0, "col1");
+  auto left_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+  auto right_schema = MakeOutputSchema({{"col1", col1}});
+  SeqScanPlanNode left_scan{left_schema, nullptr, left_info->oid_};
+  SeqScanPlanNode right_scan{right_schema, nullptr, right_info->oid_};
+
+  std::vector<std::pair<int32_t, int32_t>> expected;
+  for (auto left = left_info->table_->Begin(GetTxn()); left != left_info->table_->End(); ++left) {
+    for (auto right = right_info->table_->Begin(GetTxn()); right != right_info->table_->End(); ++right) {
+      int32_t c1 = right->GetValue(&right_info->schema_, 0).GetAs<int16_t>();
+      if (left->GetValue(&left_info->schema_, 1).GetAs<int32_t>() < c1) {
+        expected.emplace_back(left->GetValue(&left_info->schema_, 0).GetAs<int32_t>(), c1);
+      }
+    }
+  }
+  std::sort(expected.begin(), expected.end());
+  ASSERT_FALSE(expected.empty());
+
+  auto join_a = MakeColumnValueExpression(*left_schema, 0, "colA");
+  auto join_b = MakeColumnValueExpression(*left_schema, 0, "colB");
+  auto join_c1 = MakeColumnValueExpression(*right_schema, 1, "col1");
+  auto predicate = MakeComparisonExpression(join_b, join_c1, ComparisonType::LessThan);
+  auto out_schema = MakeOutputSchema({{"colA", join_a}, {"col1", join_c1}});
+  auto run = [&](const AbstractExpression *join_predicate, size_t memory_budget) {
+    NestedLoopJoinPlanNode join_plan{out_schema, {&left_scan, &right_scan}, join_predicate};
+    GetExecutorContext()->SetMemoryBudget(memory_budget);
+    std::vector<Tuple> result_set;
+    GetExecutionEngine()->Execute(&join_plan, &result_set, GetTxn(), GetExecutorContext());
+    GetExecutorContext()->SetMemoryBudget(QUERY_MEMORY_BUDGET);
+    std::vector<std::pair<int32_t, int32_t>> rows;
+    for (const auto &tuple : result_set) {
+      rows.emplace_back(tuple.GetValue(out_schema, 0).GetAs<int32_t>(), tuple.GetValue(out_schema, 1).GetAs<int16_t>());
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  };
+
+  // the whole of test_1 in a single block, then a single batch per block and one scan of test_2 for each
+  ASSERT_EQ(run(predicate, QUERY_MEMORY_BUDGET), expected);
+  ASSERT_EQ(run(predicate, 1), expected);
+  ASSERT_EQ(run(nullptr, 1).size(), TEST1_SIZE * TEST2_SIZE);
+}
+
+// SELECT test_1.colA, test_1.colB, test_2.col1, test_2.col3 FROM test_1 JOIN test_2 ON test_1.colA = test_2.col1
+TEST_F(ExecutorTest, SimpleHashJoinTest) {
+  const Schema *out_schema1;
+  std::unique_ptr<AbstractPlanNode> scan_plan1;
+  {
+    auto table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+    auto &schema = table_info->schema_;
+    auto col_a = MakeColumnValueExpression(schema, 0, "colA");
+    auto col_b = MakeColumnValueExpression(schema, 0, "colB");
+    out_schema1 = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+    scan_plan1 = std::make_unique<SeqScanPlanNode>(out_schema1, nullptr, table_info->oid_);
+  }
+
+  const Schema *out_schema2;
+  std::unique_ptr<AbstractPlanNode> scan_plan2;
+  {
+    auto table_info = GetExecutorContext()->GetCatalog()->GetTable("test_2");
+    auto &schema = table_info->schema_;
+    auto col1 = MakeColumnValueExpression(schema, 0, "col1");
+    auto col3 = MakeColumnValueExpression(schema, 0, "col3");
+    out_schema2 = MakeOutputSchema({{"col1", col1}, {"col3", col3}});
+    scan_plan2 = std::make_unique<SeqScanPlanNode>(out_schema2, nullptr, table_info->oid_);
+  }
+
+  const Schema *out_final;
+  std::unique_ptr<HashJoinPlanNode> join_plan;
+  {
+    auto col_a = MakeColumnValueExpression(*out_schema1, 0, "colA");
+    auto col_b = MakeColumnValueExpression(*out_schema1, 0, "colB");
+    auto col1 = MakeColumnValueExpression(*out_schema2, 1, "col1");
+    auto col3 = MakeColumnValueExpression(*out_schema2, 1, "col3");
+    out_final = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}, {"col1", col1}, {"col3", col3}});
+    join_plan = std::make_unique<HashJoinPlanNode>(
+        out_final, std::vector<const AbstractPlanNode *>{scan_plan1.get(), scan_plan2.get()}, col_a, col1);
+  }
+
+  std::vector<Tuple> result_set{};
+  GetExecutionEngine()->Execute(join_plan.get(), &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), 100);
+  std::unordered_set<int32_t> encountered{};
+  for (const auto &tuple : result_set) {
+    auto col_a = tuple.GetValue(out_final, 0).GetAs<int32_t>();
+    ASSERT_EQ(col_a, tuple.GetValue(out_final, 2).GetAs<int16_t>());
+    encountered.insert(col_a);
+  }
+  ASSERT_EQ(encountered.size(), 100);
+}
+
+// SELECT colA, colB FROM test_1 WHERE colB = 3, pulled a batch at a time
+TEST_F(ExecutorTest, BatchExecutionTest) {
+  auto table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto const3 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(3));
+  auto predicate = MakeComparisonExpression(col_b, const3, ComparisonType::Equal);
+  auto out_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+  SeqScanPlanNode scan_plan{out_schema, predicate, table_info->oid_};
+
+  std::vector<Tuple> result_set{};
+  GetExecutionEngine()->Execute(&scan_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_FALSE(result_set.empty());
+
+  // batches hold the same rows in the same order, only the selected ones of each batch
+  auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &scan_plan);
+  executor->Init();
+  TupleBatch batch(out_schema, 64);
+  size_t produced = 0;
+  while (executor->NextBatch(&batch)) {
+    ASSERT_GT(batch.Size(), 0);
+    ASSERT_LE(batch.GetRowCount(), 64);
+    for (uint32_t i = 0; i < batch.Size(); i++) {
+      uint32_t row = batch.RowAt(i);
+      ASSERT_EQ(batch.GetColumn(1).GetIntegers()[row], 3);
+      ASSERT_EQ(batch.GetColumn(0).GetIntegers()[row],
+                result_set[produced].GetValue(out_schema, 0).GetAs<int32_t>());
+      produced++;
+    }
+  }
+  ASSERT_EQ(produced, result_set.size());
+
+  // a limit cuts the last batch short, through either interface
+  LimitPlanNode limit_plan{out_schema, &scan_plan, 70};
+  result_set.clear();
+  GetExecutionEngine()->Execute(&limit_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), 70);
+  executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &limit_plan);
+  executor->Init();
+  produced = 0;
+  while (executor->NextBatch(&batch)) {
+    produced += batch.Size();
+  }
+  ASSERT_EQ(produced, 70);
+
+  // comparisons against a null are never true
+  auto null_const = MakeConstantValueExpression(ValueFactory::GetNullValueByType(TypeId::INTEGER));
+  SeqScanPlanNode null_plan{out_schema, MakeComparisonExpression(col_b, null_const, ComparisonType::NotEqual),
+                            table_info->oid_};
+  result_set.clear();
+  GetExecutionEngine()->Execute(&null_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_TRUE(result_set.empty());
+}
+
+// Runs scans, a hash join, aggregations and a limit on four workers and compares them with serial runs
+TEST_F(ExecutorTest, ParallelExecutionTest) {
+  // a table spanning many morsels
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::INTEGER)});
+  auto *table_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "parallel", schema);
+  const int num_rows = 20000;
+  for (int i = 0; i < num_rows; i++) {
+    RID rid;
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetIntegerValue(i % 10)}, &schema);
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+
+  auto col_a = MakeColumnValueExpression(schema, 0, "a");
+  auto col_b = MakeColumnValueExpression(schema, 0, "b");
+  auto scan_schema = MakeOutputSchema({{"a", col_a}, {"b", col_b}});
+  auto predicate = MakeComparisonExpression(col_a, MakeConstantValueExpression(ValueFactory::GetIntegerValue(15000)),
+                                            ComparisonType::LessThan);
+  SeqScanPlanNode scan_plan{scan_schema, predicate, table_info->oid_};
+
+  // SELECT parallel.a, test_1.colB FROM parallel JOIN test_1 ON parallel.a = test_1.colA WHERE parallel.a < 15000
+  auto *test_1 = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto col_a_1 = MakeColumnValueExpression(test_1->schema_, 0, "colA");
+  auto col_b_1 = MakeColumnValueExpression(test_1->schema_, 0, "colB");
+  auto scan_schema_1 = MakeOutputSchema({{"colA", col_a_1}, {"colB", col_b_1}});
+  SeqScanPlanNode scan_plan_1{scan_schema_1, nullptr, test_1->oid_};
+  auto join_schema = MakeOutputSchema({{"a", MakeColumnValueExpression(*scan_schema, 0, "a")},
+                                       {"colB", MakeColumnValueExpression(*scan_schema_1, 1, "colB")}});
+  HashJoinPlanNode join_plan{join_schema,
+                             {&scan_plan, &scan_plan_1},
+                             MakeColumnValueExpression(*scan_schema, 0, "a"),
+                             MakeColumnValueExpression(*scan_schema_1, 1, "colA")};
+
+  // SELECT b, COUNT(a), SUM(a), MIN(a), MAX(a) FROM parallel WHERE a < 15000 GROUP BY b
+  auto groupby_b = MakeAggregateValueExpression(true, 0);
+  auto agg_schema = MakeOutputSchema({{"b", groupby_b},
+                                      {"count", MakeAggregateValueExpression(false, 0)},
+                                      {"sum", MakeAggregateValueExpression(false, 1)},
+                                      {"min", MakeAggregateValueExpression(false, 2)},
+                                      {"max", MakeAggregateValueExpression(false, 3)}});
+  auto scan_a = MakeColumnValueExpression(*scan_schema, 0, "a");
+  AggregationPlanNode agg_plan{agg_schema,
+                               &scan_plan,
+                               nullptr,
+                               {MakeColumnValueExpression(*scan_schema, 0, "b")},
+                               {scan_a, scan_a, scan_a, scan_a},
+                               {AggregationType::CountAggregate, AggregationType::SumAggregate,
+                                AggregationType::MinAggregate, AggregationType::MaxAggregate}};
+
+  // SELECT COUNT(a), SUM(a), MIN(a), MAX(a) FROM parallel WHERE a < 15000
+  auto global_schema = MakeOutputSchema({{"count", MakeAggregateValueExpression(false, 0)},
+                                         {"sum", MakeAggregateValueExpression(false, 1)},
+                                         {"min", MakeAggregateValueExpression(false, 2)},
+                                         {"max", MakeAggregateValueExpression(false, 3)}});
+  AggregationPlanNode global_plan{global_schema,
+                                  &scan_plan,
+                                  nullptr,
+                                  {},
+                                  {scan_a, scan_a, scan_a, scan_a},
+                                  {AggregationType::CountAggregate, AggregationType::SumAggregate,
+                                   AggregationType::MinAggregate, AggregationType::MaxAggregate}};
+
+  auto run = [&](const AbstractPlanNode *plan, uint32_t worker_count) {
+    GetExecutorContext()->SetWorkerCount(worker_count);
+    std::vector<Tuple> result_set;
+    GetExecutionEngine()->Execute(plan, &result_set, GetTxn(), GetExecutorContext());
+    GetExecutorContext()->SetWorkerCount(1);
+    std::vector<std::string> rows;
+    for (const auto &tuple : result_set) {
+      rows.push_back(tuple.ToString(plan->OutputSchema()));
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  };
+
+  for (const AbstractPlanNode *plan :
+       std::vector<const AbstractPlanNode *>{&scan_plan, &join_plan, &agg_plan, &global_plan}) {
+    auto serial = run(plan, 1);
+    ASSERT_FALSE(serial.empty());
+    ASSERT_EQ(serial, run(plan, 4));
+  }
+  ASSERT_EQ(run(&scan_plan, 4).size(), 15000);
+  ASSERT_EQ(run(&join_plan, 4).size(), 1000);
+  ASSERT_EQ(run(&agg_plan, 4).size(), 10);
+  std::vector<Tuple> global_result;
+  GetExecutorContext()->SetWorkerCount(4);
+  GetExecutionEngine()->Execute(&global_plan, &global_result, GetTxn(), GetExecutorContext());
+  GetExecutorContext()->SetWorkerCount(1);
+  ASSERT_EQ(global_result.size(), 1);
+  ASSERT_EQ(global_result[0].GetValue(global_schema, 0).GetAs<int32_t>(), 15000);
+  ASSERT_EQ(global_result[0].GetValue(global_schema, 1).GetAs<int32_t>(), 15000 * 14999 / 2);
+  ASSERT_EQ(global_result[0].GetValue(global_schema, 2).GetAs<int32_t>(), 0);
+  ASSERT_EQ(global_result[0].GetValue(global_schema, 3).GetAs<int32_t>(), 14999);
+
+  // a limit above the parallel scan stops the workers early
+  LimitPlanNode limit_plan{scan_schema, &scan_plan, 100};
+  ASSERT_EQ(run(&limit_plan, 4).size(), 100);
+}
+
+// Joins with a memory budget too small for the build side, which spills partitions and joins them afterwards
+TEST_F(ExecutorTest, HashJoinSpillTest) {
+  Schema build_schema({Column("a", TypeId::INTEGER), Column("pad", TypeId::VARCHAR, 32)});
+  Schema probe_schema({Column("b", TypeId::BIGINT)});
+  auto *build_table = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "build", build_schema);
+  auto *probe_table = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "probe", probe_schema);
+  RID rid;
+  for (int i = 0; i < 5000; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(i % 2500), ValueFactory::GetVarcharValue(std::string(24, 'x'))},
+                &build_schema);
+    ASSERT_TRUE(build_table->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+  for (int i = 0; i < 3000; i++) {
+    ASSERT_TRUE(probe_table->table_->InsertTuple(Tuple({ValueFactory::GetBigIntValue(i)}, &probe_schema), &rid,
+                                                 GetTxn()));
+  }
+
+  // SELECT build.a, probe.b FROM build JOIN probe ON build.a = probe.b
+  auto build_a = MakeColumnValueExpression(build_schema, 0, "a");
+  auto build_out = MakeOutputSchema({{"a", build_a}, {"pad", MakeColumnValueExpression(build_schema, 0, "pad")}});
+  SeqScanPlanNode build_scan{build_out, nullptr, build_table->oid_};
+  auto probe_out = MakeOutputSchema({{"b", MakeColumnValueExpression(probe_schema, 0, "b")}});
+  SeqScanPlanNode probe_scan{probe_out, nullptr, probe_table->oid_};
+  auto join_a = MakeColumnValueExpression(*build_out, 0, "a");
+  auto join_b = MakeColumnValueExpression(*probe_out, 1, "b");
+  auto join_schema = MakeOutputSchema({{"a", join_a}, {"b", join_b}});
+  HashJoinPlanNode join_plan{join_schema, {&build_scan, &probe_scan}, join_a, join_b};
+
+  auto run = [&](size_t memory_budget, uint32_t worker_count) {
+    GetExecutorContext()->SetMemoryBudget(memory_budget);
+    GetExecutorContext()->SetWorkerCount(worker_count);
+    std::vector<Tuple> result_set;
+    GetExecutionEngine()->Execute(&join_plan, &result_set, GetTxn(), GetExecutorContext());
+    GetExecutorContext()->SetMemoryBudget(QUERY_MEMORY_BUDGET);
+    GetExecutorContext()->SetWorkerCount(1);
+    std::vector<std::pair<int32_t, int64_t>> rows;
+    for (const auto &tuple : result_set) {
+      rows.emplace_back(tuple.GetValue(join_schema, 0).GetAs<int32_t>(),
+                        tuple.GetValue(join_schema, 1).GetAs<int64_t>());
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  };
+
+  auto in_memory = run(QUERY_MEMORY_BUDGET, 1);
+  ASSERT_EQ(in_memory.size(), 5000);
+  for (size_t i = 0; i < in_memory.size(); i++) {
+    ASSERT_EQ(in_memory[i].first, in_memory[i].second);
+    ASSERT_EQ(in_memory[i].first, i / 2);
+  }
+  ASSERT_EQ(in_memory, run(32 << 10, 1));
+  ASSERT_EQ(in_memory, run(32 << 10, 4));
+  // a spilled partition does not fit in the budget either, and is split again when read back
+  ASSERT_EQ(in_memory, run(4 << 10, 1));
+  ASSERT_EQ(in_memory, run(4 << 10, 4));
+
+  // the budget holds a few partitions, the others are written out
+  JoinHashTable table(GetBPM(), 32 << 10);
+  for (int i = 0; i < 5000; i++) {
+    Value key = ValueFactory::GetIntegerValue(i);
+    table.Insert(HashUtil::HashValue(&key), key, Tuple({key, ValueFactory::GetVarcharValue("x")}, &build_schema));
+  }
+  ASSERT_TRUE(table.HasSpilled());
+  ASSERT_LE(table.GetMemoryUsage(), 32 << 10);
+  table.Build();
+  size_t found = 0;
+  for (int i = 0; i < 5000; i++) {
+    Value key = ValueFactory::GetIntegerValue(i);
+    hash_t hash = HashUtil::HashValue(&key);
+    std::vector<const Tuple *> matches;
+    table.Probe(hash, key, &matches);
+    if (table.IsSpilled(table.PartitionOf(hash))) {
+      ASSERT_TRUE(matches.empty());
+      continue;
+    }
+    ASSERT_EQ(matches.size(), 1);
+    ASSERT_EQ(matches[0]->GetValue(&build_schema, 0).GetAs<int32_t>(), i);
+    found++;
+  }
+  ASSERT_GT(found, 0);
+  ASSERT_LT(found, 5000);
+
+  // a spilled partition read back with a smaller budget is split by the next bits of the hashes
+  uint32_t spilled = 0;
+  while (!table.IsSpilled(spilled)) {
+    spilled++;
+  }
+  JoinHashTable next_level(GetBPM(), 1 << 10, table.GetLevel() + 1);
+  std::vector<Tuple> tuples;
+  table.GetSpill(spilled).ReadAll(&tuples);
+  ASSERT_GT(tuples.size(), 20);
+  std::set<uint32_t> partitions;
+  for (auto &tuple : tuples) {
+    Value key = tuple.GetValue(&build_schema, 0);
+    hash_t hash = HashUtil::HashValue(&key);
+    ASSERT_EQ(table.PartitionOf(hash), spilled);
+    partitions.insert(next_level.PartitionOf(hash));
+    next_level.Insert(hash, key, std::move(tuple));
+  }
+  ASSERT_GT(partitions.size(), 1);
+  ASSERT_TRUE(next_level.HasSpilled());
+  ASSERT_LE(next_level.GetMemoryUsage(), 1 << 10);
+}
+
+// Groups with a memory budget too small for every group, which spills partial aggregates and merges them afterwards
+TEST_F(ExecutorTest, AggregationSpillTest) {
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::INTEGER)});
+  auto *table_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "groups", schema);
+  RID rid;
+  for (int i = 0; i < 20000; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(i % 4000), ValueFactory::GetIntegerValue(i)}, &schema);
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+
+  // SELECT a, COUNT(b), SUM(b), MIN(b), MAX(b) FROM groups GROUP BY a
+  auto col_a = MakeColumnValueExpression(schema, 0, "a");
+  auto col_b = MakeColumnValueExpression(schema, 0, "b");
+  auto scan_schema = MakeOutputSchema({{"a", col_a}, {"b", col_b}});
+  SeqScanPlanNode scan_plan{scan_schema, nullptr, table_info->oid_};
+  auto agg_schema = MakeOutputSchema({{"a", MakeAggregateValueExpression(true, 0)},
+                                      {"count", MakeAggregateValueExpression(false, 0)},
+                                      {"sum", MakeAggregateValueExpression(false, 1)},
+                                      {"min", MakeAggregateValueExpression(false, 2)},
+                                      {"max", MakeAggregateValueExpression(false, 3)}});
+  auto scan_b = MakeColumnValueExpression(*scan_schema, 0, "b");
+  AggregationPlanNode agg_plan{agg_schema,
+                               &scan_plan,
+                               nullptr,
+                               {MakeColumnValueExpression(*scan_schema, 0, "a")},
+                               {scan_b, scan_b, scan_b, scan_b},
+                               {AggregationType::CountAggregate, AggregationType::SumAggregate,
+                                AggregationType::MinAggregate, AggregationType::MaxAggregate}};
+
+  auto run = [&](size_t memory_budget, uint32_t worker_count) {
+    GetExecutorContext()->SetMemoryBudget(memory_budget);
+    GetExecutorContext()->SetWorkerCount(worker_count);
+    std::vector<Tuple> result_set;
+    GetExecutionEngine()->Execute(&agg_plan, &result_set, GetTxn(), GetExecutorContext());
+    GetExecutorContext()->SetMemoryBudget(QUERY_MEMORY_BUDGET);
+    GetExecutorContext()->SetWorkerCount(1);
+    std::vector<std::string> rows;
+    for (const auto &tuple : result_set) {
+      rows.push_back(tuple.ToString(agg_schema));
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  };
+
+  auto in_memory = run(QUERY_MEMORY_BUDGET, 1);
+  ASSERT_EQ(in_memory.size(), 4000);
+  ASSERT_EQ(in_memory, run(32 << 10, 1));
+  ASSERT_EQ(in_memory, run(32 << 10, 4));
+  // a spilled partition does not fit in the budget either, and is split again when read back
+  ASSERT_EQ(in_memory, run(4 << 10, 1));
+  ASSERT_EQ(in_memory, run(4 << 10, 4));
+
+  // every group holds the five rows a, a + 4000, ..., a + 16000
+  GetExecutorContext()->SetMemoryBudget(32 << 10);
+  auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &agg_plan);
+  executor->Init();
+  GetExecutorContext()->SetMemoryBudget(QUERY_MEMORY_BUDGET);
+  Tuple tuple;
+  size_t groups = 0;
+  while (executor->Next(&tuple, &rid)) {
+    int32_t a = tuple.GetValue(agg_schema, 0).GetAs<int32_t>();
+    ASSERT_EQ(tuple.GetValue(agg_schema, 1).GetAs<int32_t>(), 5);
+    ASSERT_EQ(tuple.GetValue(agg_schema, 2).GetAs<int32_t>(), 5 * a + 40000);
+    ASSERT_EQ(tuple.GetValue(agg_schema, 3).GetAs<int32_t>(), a);
+    ASSERT_EQ(tuple.GetValue(agg_schema, 4).GetAs<int32_t>(), a + 16000);
+    groups++;
+  }
+  ASSERT_EQ(groups, 4000);
+
+  // the budget holds a few partitions, the others are written out
+  SimpleAggregationHashTable aht(&agg_plan, GetBPM(), 32 << 10);
+  for (int i = 0; i < 20000; i++) {
+    aht.InsertCombine({{ValueFactory::GetIntegerValue(i % 4000)}},
+                      {std::vector<Value>(4, ValueFactory::GetIntegerValue(i))});
+  }
+  ASSERT_TRUE(aht.HasSpilled());
+  ASSERT_LE(aht.GetMemoryUsage(), 32 << 10);
+  groups = 0;
+  for (auto iter = aht.Begin(); iter != aht.End(); ++iter) {
+    ASSERT_EQ(iter.Val().aggregates_[1].GetAs<int32_t>(), 5 * iter.Key().group_bys_[0].GetAs<int32_t>() + 40000);
+    groups++;
+  }
+  ASSERT_EQ(groups, 4000);
+
+  // the groups of a partition do not fit in the budget either, they are split again as they are read back
+  SimpleAggregationHashTable small(&agg_plan, GetBPM(), 1 << 10);
+  for (int i = 0; i < 20000; i++) {
+    small.InsertCombine({{ValueFactory::GetIntegerValue(i % 4000)}},
+                        {std::vector<Value>(4, ValueFactory::GetIntegerValue(i))});
+  }
+  std::set<int32_t> keys;
+  for (auto iter = small.Begin(); iter != small.End(); ++iter) {
+    int32_t a = iter.Key().group_bys_[0].GetAs<int32_t>();
+    ASSERT_EQ(iter.Val().aggregates_[0].GetAs<int32_t>(), 5);
+    ASSERT_EQ(iter.Val().aggregates_[1].GetAs<int32_t>(), 5 * a + 40000);
+    ASSERT_TRUE(keys.insert(a).second);
+  }
+  ASSERT_EQ(keys.size(), 4000);
+}
+
+// Sorts in memory and through spilled runs, and keeps the first tuples of the order with a top-n
+TEST_F(ExecutorTest, SortTest) {
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 16)});
+  auto *table_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "unsorted", schema);
+  const int num_rows = 5000;
+  std::vector<std::pair<int32_t, std::string>> expected;
+  RID rid;
+  for (int i = 0; i < num_rows; i++) {
+    int32_t a = (i * 7919) % 1000 - 500;
+    std::string b = std::to_string(i % 7);
+    Tuple tuple({ValueFactory::GetIntegerValue(a), ValueFactory::GetVarcharValue(b)}, &schema);
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+    expected.emplace_back(a, b);
+  }
+  // ORDER BY a ASC, b DESC
+  std::stable_sort(expected.begin(), expected.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second > rhs.second);
+  });
+
+  auto col_a = MakeColumnValueExpression(schema, 0, "a");
+  auto col_b = MakeColumnValueExpression(schema, 0, "b");
+  auto out_schema = MakeOutputSchema({{"a", col_a}, {"b", col_b}});
+  SeqScanPlanNode scan_plan{out_schema, nullptr, table_info->oid_};
+  SortPlanNode sort_plan{out_schema, &scan_plan, {{OrderByType::ASC, col_a}, {OrderByType::DESC, col_b}}};
+
+  auto run = [&](const AbstractPlanNode *plan, size_t memory_budget) {
+    GetExecutorContext()->SetMemoryBudget(memory_budget);
+    std::vector<Tuple> result_set;
+    GetExecutionEngine()->Execute(plan, &result_set, GetTxn(), GetExecutorContext());
+    GetExecutorContext()->SetMemoryBudget(QUERY_MEMORY_BUDGET);
+    std::vector<std::pair<int32_t, std::string>> rows;
+    for (const auto &tuple : result_set) {
+      rows.emplace_back(tuple.GetValue(out_schema, 0).GetAs<int32_t>(), tuple.GetValue(out_schema, 1).ToString());
+    }
+    return rows;
+  };
+
+  ASSERT_EQ(run(&sort_plan, QUERY_MEMORY_BUDGET), expected);
+  // a few dozen sorted runs merged
+  ASSERT_EQ(run(&sort_plan, 16 << 10), expected);
+
+  std::vector<std::pair<int32_t, std::string>> first(expected.begin(), expected.begin() + 10);
+  TopNPlanNode topn_plan{out_schema, &scan_plan, {{OrderByType::ASC, col_a}, {OrderByType::DESC, col_b}}, 10};
+  ASSERT_EQ(run(&topn_plan, QUERY_MEMORY_BUDGET), first);
+  LimitPlanNode limit_plan{out_schema, &sort_plan, 10};
+  ASSERT_EQ(run(&limit_plan, QUERY_MEMORY_BUDGET), first);
+  TopNPlanNode all_plan{out_schema, &scan_plan, {{OrderByType::ASC, col_a}, {OrderByType::DESC, col_b}}, 2 * num_rows};
+  ASSERT_EQ(run(&all_plan, QUERY_MEMORY_BUDGET), expected);
+}
+
+// SELECT l.k, l.v, r.k, r.v FROM l JOIN r ON l.k = r.k, both sides read in key order from B+ tree indexes
+TEST_F(ExecutorTest, MergeJoinTest) {
+  Schema schema({Column("k", TypeId::INTEGER), Column("v", TypeId::INTEGER)});
+  auto key_schema = ParseCreateStatement("k int");
+  // keys 0..39 on the left and multiples of 3 on the right, with a few duplicates of each on both sides
+  auto make_side = [&](const std::string &name, int num_rows, int stride, int copies) {
+    auto *table_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), name, schema);
+    auto *index_info = GetExecutorContext()->GetCatalog()->CreateIndex<KeyType, ValueType, ComparatorType>(
+        GetTxn(), name + "_k", name, schema, *key_schema, {0}, 8, HashFunctionType{}, IndexType::BPlusTreeIndex,
+        {1});
+    std::vector<std::pair<int32_t, int32_t>> rows;
+    RID rid;
+    // inserted out of key order, so that only the index scan produces them sorted
+    for (int i = num_rows - 1; i >= 0; i--) {
+      for (int c = 0; c < copies + i % 2; c++) {
+        int32_t k = i * stride;
+        int32_t v = i * 100 + c;
+        Tuple tuple({ValueFactory::GetIntegerValue(k), ValueFactory::GetIntegerValue(v)}, &schema);
+        EXPECT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+        index_info->index_->InsertEntry(tuple.KeyFromTuple(schema, index_info->key_schema_,
+                                                           index_info->index_->GetKeyAttrs()),
+                                        rid, GetTxn());
+        rows.emplace_back(k, v);
+      }
+    }
+    return std::make_pair(index_info, rows);
+  };
+  auto [left_index, left_rows] = make_side("l", 40, 1, 2);
+  auto [right_index, right_rows] = make_side("r", 20, 3, 1);
+
+  std::vector<std::tuple<int32_t, int32_t, int32_t, int32_t>> expected;
+  for (const auto &[lk, lv] : left_rows) {
+    for (const auto &[rk, rv] : right_rows) {
+      if (lk == rk) {
+        expected.emplace_back(lk, lv, rk, rv);
+      }
+    }
+  }
+  std::sort(expected.begin(), expected.end());
+  ASSERT_FALSE(expected.empty());
+
+  auto col_k = MakeColumnValueExpression(schema, 0, "k");
+  auto col_v = MakeColumnValueExpression(schema, 0, "v");
+  auto side_schema = MakeOutputSchema({{"k", col_k}, {"v", col_v}});
+  IndexScanPlanNode left_scan{side_schema, nullptr, left_index->index_oid_, IndexScanRange{}, true};
+  IndexScanPlanNode right_scan{side_schema, nullptr, right_index->index_oid_, IndexScanRange{}, true};
+
+  auto left_k = MakeColumnValueExpression(*side_schema, 0, "k");
+  auto left_v = MakeColumnValueExpression(*side_schema, 0, "v");
+  auto right_k = MakeColumnValueExpression(*side_schema, 1, "k");
+  auto right_v = MakeColumnValueExpression(*side_schema, 1, "v");
+  auto out_schema = MakeOutputSchema({{"lk", left_k}, {"lv", left_v}, {"rk", right_k}, {"rv", right_v}});
+  auto run = [&](const AbstractPlanNode *plan) {
+    std::vector<Tuple> result_set;
+    GetExecutionEngine()->Execute(plan, &result_set, GetTxn(), GetExecutorContext());
+    std::vector<std::tuple<int32_t, int32_t, int32_t, int32_t>> rows;
+    for (const auto &tuple : result_set) {
+      rows.emplace_back(tuple.GetValue(out_schema, 0).GetAs<int32_t>(), tuple.GetValue(out_schema, 1).GetAs<int32_t>(),
+                        tuple.GetValue(out_schema, 2).GetAs<int32_t>(), tuple.GetValue(out_schema, 3).GetAs<int32_t>());
+    }
+    return rows;
+  };
+
+  // the join streams out in key order, left duplicates each meeting the whole run of right duplicates
+  MergeJoinPlanNode join_plan{out_schema, {&left_scan, &right_scan}, left_k, right_k};
+  ASSERT_EQ(run(&join_plan), expected);
+
+  // any children ordered by key will do, such as sorts over sequential scans
+  SeqScanPlanNode left_seq{side_schema, nullptr, GetExecutorContext()->GetCatalog()->GetTable("l")->oid_};
+  SeqScanPlanNode right_seq{side_schema, nullptr, GetExecutorContext()->GetCatalog()->GetTable("r")->oid_};
+  SortPlanNode left_sort{side_schema, &left_seq, {{OrderByType::ASC, col_k}, {OrderByType::ASC, col_v}}};
+  SortPlanNode right_sort{side_schema, &right_seq, {{OrderByType::ASC, col_k}, {OrderByType::ASC, col_v}}};
+  MergeJoinPlanNode sorted_join_plan{out_schema, {&left_sort, &right_sort}, left_k, right_k};
+  ASSERT_EQ(run(&sorted_join_plan), expected);
+}
+
+// Compiled predicates over the bytes of test_2 tuples agree with the interpreted ones, nulls and mixed types included
+TEST_F(ExecutorTest, CompiledExpressionTest) {
+  auto *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_2");
+  auto &schema = table_info->schema_;
+  auto col1 = MakeColumnValueExpression(schema, 0, "col1");
+  auto col2 = MakeColumnValueExpression(schema, 0, "col2");
+  auto col3 = MakeColumnValueExpression(schema, 0, "col3");
+  auto col4 = MakeColumnValueExpression(schema, 0, "col4");
+  std::vector<const AbstractExpression *> predicates{
+      MakeComparisonExpression(col2, MakeConstantValueExpression(ValueFactory::GetIntegerValue(5)),
+                               ComparisonType::LessThan),
+      MakeComparisonExpression(col1, col3, ComparisonType::GreaterThanOrEqual),
+      MakeComparisonExpression(col4, MakeConstantValueExpression(ValueFactory::GetDecimalValue(1000.5)),
+                               ComparisonType::GreaterThan),
+      MakeComparisonExpression(col2, MakeConstantValueExpression(ValueFactory::GetNullValueByType(TypeId::INTEGER)),
+                               ComparisonType::NotEqual),
+      MakeComparisonExpression(
+          MakeComparisonExpression(col1, MakeConstantValueExpression(ValueFactory::GetSmallIntValue(50)),
+                                   ComparisonType::LessThan),
+          MakeConstantValueExpression(ValueFactory::GetBooleanValue(false)), ComparisonType::Equal)};
+
+  for (const auto *predicate : predicates) {
+    auto compiled = CompiledExpression::Compile(predicate, &schema);
+    ASSERT_NE(compiled, nullptr);
+    ColumnVector column(TypeId::BOOLEAN, 1);
+    for (auto iter = table_info->table_->Begin(GetTxn()); iter != table_info->table_->End(); ++iter) {
+      Value expected = predicate->Evaluate(&*iter, &schema);
+      compiled->EvaluateInto(*iter, &column, 0);
+      ASSERT_EQ(column.IsNull(0), expected.IsNull());
+      if (!expected.IsNull()) {
+        ASSERT_EQ(column.GetIntegers()[0] != 0, expected.GetAs<bool>());
+      }
+      ASSERT_EQ(compiled->Test(*iter), !expected.IsNull() && expected.GetAs<bool>());
+    }
+  }
+
+  // varchars are left to the interpreter
+  Schema varchar_schema({Column("s", TypeId::VARCHAR, 8)});
+  auto col_s = MakeColumnValueExpression(varchar_schema, 0, "s");
+  auto varchar_predicate =
+      MakeComparisonExpression(col_s, MakeConstantValueExpression(ValueFactory::GetVarcharValue("a")),
+                               ComparisonType::Equal);
+  ASSERT_EQ(CompiledExpression::Compile(varchar_predicate, &varchar_schema), nullptr);
+}
+
+// SELECT a, s FROM pushdown WHERE a % 10 < 3, with the predicate run on the bytes of the tuples inside the pages
+TEST_F(ExecutorTest, PredicatePushdownTest) {
+  Schema schema({Column("a", TypeId::INTEGER), Column("s", TypeId::VARCHAR, 16)});
+  auto *table_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "pushdown", schema);
+  const int num_rows = 3000;
+  RID rid;
+  for (int i = 0; i < num_rows; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(i % 10), ValueFactory::GetVarcharValue(std::to_string(i))}, &schema);
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+
+  auto col_a = MakeColumnValueExpression(schema, 0, "a");
+  auto col_s = MakeColumnValueExpression(schema, 0, "s");
+  auto const3 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(3));
+  auto predicate = MakeComparisonExpression(col_a, const3, ComparisonType::LessThan);
+
+  // a page only hands out the tuples that pass the filter
+  auto compiled = CompiledExpression::Compile(predicate, &schema);
+  ASSERT_NE(compiled, nullptr);
+  TupleFilter filter = [&](const char *data) { return compiled->Test(data); };
+  size_t passed = 0;
+  size_t pages = 0;
+  for (page_id_t page_id = table_info->table_->GetFirstPageId(); page_id != INVALID_PAGE_ID; pages++) {
+    std::vector<Tuple> tuples;
+    page_id = table_info->table_->ScanPage(page_id, filter, &tuples, GetTxn());
+    for (const auto &tuple : tuples) {
+      ASSERT_LT(tuple.GetValue(&schema, 0).GetAs<int32_t>(), 3);
+      Tuple stored;
+      ASSERT_TRUE(table_info->table_->GetTuple(tuple.GetRid(), &stored, GetTxn()));
+      ASSERT_EQ(stored.GetValue(&schema, 1).ToString(), tuple.GetValue(&schema, 1).ToString());
+    }
+    passed += tuples.size();
+  }
+  ASSERT_GT(pages, 1);
+  ASSERT_EQ(passed, num_rows * 3 / 10);
+
+  // the varchar output is not compiled, the pushed-down predicate still is
+  auto out_schema = MakeOutputSchema({{"a", col_a}, {"s", col_s}});
+  SeqScanPlanNode scan_plan{out_schema, predicate, table_info->oid_};
+  std::vector<Tuple> result_set;
+  GetExecutionEngine()->Execute(&scan_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), passed);
+  for (const auto &tuple : result_set) {
+    int32_t a = tuple.GetValue(out_schema, 0).GetAs<int32_t>();
+    ASSERT_LT(a, 3);
+    ASSERT_EQ(std::stoi(tuple.GetValue(out_schema, 1).ToString()) % 10, a);
+  }
+}
+
+// SELECT ts, v FROM events WHERE ts >= 2900, over a table ordered by ts with a zone map on it
+TEST_F(ExecutorTest, ZoneMapTest) {
+  Schema schema({Column("ts", TypeId::BIGINT), Column("v", TypeId::INTEGER)});
+  auto *table_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "events", schema, {0});
+  ZoneMap *zone_map = table_info->table_->GetZoneMap();
+  ASSERT_NE(zone_map, nullptr);
+  const int num_rows = 3000;
+  std::vector<RID> rids;
+  RID rid;
+  for (int i = 0; i < num_rows; i++) {
+    Tuple tuple({ValueFactory::GetBigIntValue(i), ValueFactory::GetIntegerValue(i % 7)}, &schema);
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+    rids.push_back(rid);
+  }
+  size_t pages = 0;
+  for (page_id_t page_id = table_info->table_->GetFirstPageId(); page_id != INVALID_PAGE_ID; pages++) {
+    page_id = table_info->table_->GetNextPageId(page_id);
+  }
+  ASSERT_GT(pages, 2);
+  Value min;
+  Value max;
+  ASSERT_TRUE(zone_map->GetBounds(rids[0].GetPageId(), 0, &min, &max));
+  ASSERT_EQ(min.GetAs<int64_t>(), 0);
+  ASSERT_FALSE(zone_map->GetBounds(rids[0].GetPageId(), 1, &min, &max));
+
+  auto col_ts = MakeColumnValueExpression(schema, 0, "ts");
+  auto col_v = MakeColumnValueExpression(schema, 0, "v");
+  auto out_schema = MakeOutputSchema({{"ts", col_ts}, {"v", col_v}});
+  auto run = [&](const AbstractExpression *predicate) {
+    SeqScanPlanNode scan_plan{out_schema, predicate, table_info->oid_};
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &scan_plan);
+    executor->Init();
+    std::vector<int64_t> rows;
+    Tuple tuple;
+    while (executor->Next(&tuple, &rid)) {
+      rows.push_back(tuple.GetValue(out_schema, 0).GetAs<int64_t>());
+    }
+    return std::make_pair(rows, dynamic_cast<SeqScanExecutor *>(executor.get())->GetPrunedPageCount());
+  };
+
+  // only the last page is read
+  auto late = MakeComparisonExpression(col_ts, MakeConstantValueExpression(ValueFactory::GetBigIntValue(2900)),
+                                       ComparisonType::GreaterThanOrEqual);
+  auto [rows, pruned] = run(late);
+  ASSERT_EQ(rows.size(), 100);
+  ASSERT_EQ(rows.front(), 2900);
+  ASSERT_EQ(pruned, pages - 1);
+  ASSERT_EQ(zone_map->GetPrunedPageCount(), pages - 1);
+
+  // a constant on the left is mirrored, and a point lookup reads the page that holds it
+  auto point = MakeComparisonExpression(MakeConstantValueExpression(ValueFactory::GetIntegerValue(5)), col_ts,
+                                        ComparisonType::Equal);
+  std::tie(rows, pruned) = run(point);
+  ASSERT_EQ(rows, std::vector<int64_t>{5});
+  ASSERT_EQ(pruned, pages - 1);
+
+  // an update widens the summary of its page, which is no longer pruned
+  Tuple moved({ValueFactory::GetBigIntValue(100000), ValueFactory::GetIntegerValue(0)}, &schema);
+  ASSERT_TRUE(table_info->table_->UpdateTuple(moved, rids[0], GetTxn()));
+  auto future = MakeComparisonExpression(col_ts, MakeConstantValueExpression(ValueFactory::GetBigIntValue(50000)),
+                                         ComparisonType::GreaterThan);
+  std::tie(rows, pruned) = run(future);
+  ASSERT_EQ(rows, std::vector<int64_t>{100000});
+  ASSERT_EQ(pruned, pages - 1);
+
+  // predicates on columns without a summary read every page
+  auto other = MakeComparisonExpression(col_v, MakeConstantValueExpression(ValueFactory::GetIntegerValue(0)),
+                                        ComparisonType::LessThan);
+  std::tie(rows, pruned) = run(other);
+  ASSERT_TRUE(rows.empty());
+  ASSERT_EQ(pruned, 0);
+}
+
+TEST_F(ExecutorTest, PaxTableTest) {
+  Schema schema({Column("id", TypeId::INTEGER), Column("name", TypeId::VARCHAR, 32),
+                 Column("score", TypeId::DECIMAL), Column("tag", TypeId::VARCHAR, 32)});
+  auto *catalog = GetExecutorContext()->GetCatalog();
+  auto *rows = catalog->CreateTable(GetTxn(), "rows", schema);
+  auto *pax = catalog->CreateTable(GetTxn(), "pax", schema, {}, TableLayout::PAX);
+  ASSERT_EQ(pax->table_->GetLayout(), TableLayout::PAX);
+  auto make_tuple = [&](int i, const std::string &name) {
+    return Tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(name),
+                  ValueFactory::GetDecimalValue(i * 0.5), ValueFactory::GetVarcharValue(std::to_string(i % 10))},
+                 &schema);
+  };
+  const int num_rows = 2000;
+  std::vector<RID> row_rids;
+  std::vector<RID> pax_rids;
+  RID rid;
+  for (int i = 0; i < num_rows; i++) {
+    Tuple tuple = make_tuple(i, std::string(i % 17, 'a' + i % 26));
+    ASSERT_TRUE(rows->table_->InsertTuple(tuple, &rid, GetTxn()));
+    row_rids.push_back(rid);
+    ASSERT_TRUE(pax->table_->InsertTuple(tuple, &rid, GetTxn()));
+    pax_rids.push_back(rid);
+  }
+  ASSERT_NE(pax_rids.front().GetPageId(), pax_rids.back().GetPageId());
+
+  // committed deletes free rows for later inserts, updates move the VARCHARs of their page around
+  Transaction *delete_txn = GetTxnManager()->Begin();
+  for (int i = 0; i < num_rows; i += 3) {
+    ASSERT_TRUE(rows->table_->MarkDelete(row_rids[i], delete_txn));
+    ASSERT_TRUE(pax->table_->MarkDelete(pax_rids[i], delete_txn));
+  }
+  GetTxnManager()->Commit(delete_txn);
+  delete delete_txn;
+  for (int i = 1; i < num_rows; i += 7) {
+    if (i % 3 == 0) {
+      continue;
+    }
+    Tuple tuple = make_tuple(-i, std::string(i % 31, 'z'));
+    ASSERT_TRUE(rows->table_->UpdateTuple(tuple, row_rids[i], GetTxn()));
+    ASSERT_TRUE(pax->table_->UpdateTuple(tuple, pax_rids[i], GetTxn()));
+  }
+  Tuple tuple;
+  ASSERT_FALSE(pax->table_->GetTuple(pax_rids[0], &tuple, GetTxn()));
+  ASSERT_TRUE(pax->table_->GetTuple(pax_rids[1], &tuple, GetTxn()));
+  ASSERT_EQ(tuple.GetValue(&schema, 1).ToString(), "z");
+  for (int i = 0; i < 100; i++) {
+    tuple = make_tuple(num_rows + i, "new");
+    ASSERT_TRUE(rows->table_->InsertTuple(tuple, &rid, GetTxn()));
+    ASSERT_TRUE(pax->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+
+  // iterators put the tuples of both layouts back together the same way
+  auto contents = [&](TableInfo *table_info) {
+    std::multiset<std::string> result;
+    for (auto iter = table_info->table_->Begin(GetTxn()); iter != table_info->table_->End(); ++iter) {
+      result.insert(iter->ToString(&schema));
+    }
+    return result;
+  };
+  auto expected = contents(rows);
+  ASSERT_EQ(expected.size(), num_rows - (num_rows + 2) / 3 + 100);
+  ASSERT_EQ(contents(pax), expected);
+
+  // scans read only the minipages of the columns they refer to
+  auto col_id = MakeColumnValueExpression(schema, 0, "id");
+  auto col_name = MakeColumnValueExpression(schema, 0, "name");
+  auto predicate = MakeComparisonExpression(col_id, MakeConstantValueExpression(ValueFactory::GetIntegerValue(1000)),
+                                            ComparisonType::LessThan);
+  auto out_schema = MakeOutputSchema({{"name", col_name}, {"id", col_id}});
+  auto scan = [&](TableInfo *table_info) {
+    SeqScanPlanNode scan_plan{out_schema, predicate, table_info->oid_};
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &scan_plan);
+    executor->Init();
+    std::multiset<std::string> result;
+    while (executor->Next(&tuple, &rid)) {
+      result.insert(tuple.ToString(out_schema));
+    }
+    return result;
+  };
+  auto scanned = scan(rows);
+  ASSERT_FALSE(scanned.empty());
+  ASSERT_EQ(scan(pax), scanned);
+}
+
+// A PAX table picks the encoding of every column per page, and scans filter its rows on the encoded values.
+TEST_F(ExecutorTest, ColumnCompressionTest) {
+  Schema schema({Column("id", TypeId::INTEGER), Column("region", TypeId::VARCHAR, 16),
+                 Column("batch", TypeId::SMALLINT), Column("score", TypeId::DECIMAL)});
+  auto *catalog = GetExecutorContext()->GetCatalog();
+  auto *rows = catalog->CreateTable(GetTxn(), "rows", schema);
+  auto *pax = catalog->CreateTable(GetTxn(), "pax", schema, {}, TableLayout::PAX);
+  const std::vector<std::string> regions{"north", "south", "east", "west", "central"};
+  auto make_tuple = [&](int i) {
+    return Tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(regions[i * 7 % 5]),
+                  ValueFactory::GetSmallIntValue(static_cast<int16_t>(i / 500)), ValueFactory::GetDecimalValue(i % 13)},
+                 &schema);
+  };
+  const int num_rows = 5000;
+  std::vector<RID> row_rids;
+  std::vector<RID> pax_rids;
+  RID rid;
+  for (int i = 0; i < num_rows; i++) {
+    Tuple tuple = make_tuple(i);
+    ASSERT_TRUE(rows->table_->InsertTuple(tuple, &rid, GetTxn()));
+    row_rids.push_back(rid);
+    ASSERT_TRUE(pax->table_->InsertTuple(tuple, &rid, GetTxn()));
+    pax_rids.push_back(rid);
+  }
+
+  // sorted ids are bit-packed, the few regions go in a dictionary and the long runs of batches are stored once
+  auto count_pages = [](TableInfo *table_info) {
+    size_t pages = 0;
+    for (page_id_t page_id = table_info->table_->GetFirstPageId(); page_id != INVALID_PAGE_ID; pages++) {
+      page_id = table_info->table_->GetNextPageId(page_id);
+    }
+    return pages;
+  };
+  ASSERT_LT(count_pages(pax) * 2, count_pages(rows));
+  pax->table_->ReadPaxPage(
+      pax_rids[0].GetPageId(),
+      [](PaxPage *page) {
+        ASSERT_GT(page->GetEncodedCount(), 0);
+        ASSERT_EQ(page->GetEncoding(0), ColumnEncoding::FRAME_OF_REFERENCE);
+        ASSERT_EQ(page->GetEncoding(1), ColumnEncoding::DICTIONARY);
+        ASSERT_EQ(page->GetEncoding(2), ColumnEncoding::RUN_LENGTH);
+      },
+      GetTxn());
+
+  auto col_id = MakeColumnValueExpression(schema, 0, "id");
+  auto col_region = MakeColumnValueExpression(schema, 0, "region");
+  auto col_batch = MakeColumnValueExpression(schema, 0, "batch");
+  auto col_score = MakeColumnValueExpression(schema, 0, "score");
+  auto out_schema = MakeOutputSchema({{"id", col_id}, {"region", col_region}, {"score", col_score}});
+  std::vector<const AbstractExpression *> predicates{
+      MakeComparisonExpression(col_region, MakeConstantValueExpression(ValueFactory::GetVarcharValue("east")),
+                               ComparisonType::Equal),
+      MakeComparisonExpression(col_region, MakeConstantValueExpression(ValueFactory::GetVarcharValue("east")),
+                               ComparisonType::NotEqual),
+      MakeComparisonExpression(col_region, MakeConstantValueExpression(ValueFactory::GetVarcharValue("nowhere")),
+                               ComparisonType::Equal),
+      MakeComparisonExpression(col_id, MakeConstantValueExpression(ValueFactory::GetIntegerValue(1234)),
+                               ComparisonType::LessThan),
+      MakeComparisonExpression(MakeConstantValueExpression(ValueFactory::GetIntegerValue(4000)), col_id,
+                               ComparisonType::LessThanOrEqual),
+      MakeComparisonExpression(col_batch, MakeConstantValueExpression(ValueFactory::GetIntegerValue(3)),
+                               ComparisonType::Equal),
+      MakeComparisonExpression(col_batch, MakeConstantValueExpression(ValueFactory::GetIntegerValue(3)),
+                               ComparisonType::GreaterThan),
+      MakeComparisonExpression(col_score, MakeConstantValueExpression(ValueFactory::GetDecimalValue(4)),
+                               ComparisonType::LessThan)};
+  auto scan = [&](TableInfo *table_info, const AbstractExpression *predicate) {
+    SeqScanPlanNode scan_plan{out_schema, predicate, table_info->oid_};
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &scan_plan);
+    executor->Init();
+    std::multiset<std::string> result;
+    Tuple tuple;
+    while (executor->Next(&tuple, &rid)) {
+      result.insert(tuple.ToString(out_schema));
+    }
+    return result;
+  };
+  auto check_scans = [&]() {
+    for (const auto *predicate : predicates) {
+      ASSERT_EQ(scan(pax, predicate), scan(rows, predicate));
+    }
+  };
+  check_scans();
+  ASSERT_EQ(scan(pax, predicates[0]).size(), num_rows / 5);
+  ASSERT_TRUE(scan(pax, predicates[2]).empty());
+  // a VARCHAR predicate, which does not compile, still filters a scan whose projection does
+  auto id_schema = MakeOutputSchema({{"id", col_id}});
+  SeqScanPlanNode id_plan{id_schema, predicates[0], rows->oid_};
+  auto id_executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &id_plan);
+  id_executor->Init();
+  size_t id_count = 0;
+  for (Tuple tuple; id_executor->Next(&tuple, &rid);) {
+    id_count++;
+  }
+  ASSERT_EQ(id_count, num_rows / 5);
+
+  // encoded rows are updated by encoding their page again, and deleted ones are filled by later inserts
+  Transaction *delete_txn = GetTxnManager()->Begin();
+  for (int i = 0; i < num_rows; i += 4) {
+    ASSERT_TRUE(rows->table_->MarkDelete(row_rids[i], delete_txn));
+    ASSERT_TRUE(pax->table_->MarkDelete(pax_rids[i], delete_txn));
+  }
+  GetTxnManager()->Commit(delete_txn);
+  delete delete_txn;
+  for (int i = 1; i < num_rows; i += 9) {
+    if (i % 4 == 0) {
+      continue;
+    }
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue("east"),
+                 ValueFactory::GetSmallIntValue(static_cast<int16_t>(i / 500)), ValueFactory::GetDecimalValue(-1)},
+                &schema);
+    ASSERT_TRUE(rows->table_->UpdateTuple(tuple, row_rids[i], GetTxn()));
+    ASSERT_TRUE(pax->table_->UpdateTuple(tuple, pax_rids[i], GetTxn()));
+  }
+  Tuple tuple;
+  ASSERT_FALSE(pax->table_->GetTuple(pax_rids[0], &tuple, GetTxn()));
+  ASSERT_TRUE(pax->table_->GetTuple(pax_rids[10], &tuple, GetTxn()));
+  ASSERT_EQ(tuple.GetValue(&schema, 1).ToString(), "east");
+  ASSERT_EQ(tuple.GetValue(&schema, 3).GetAs<double>(), -1);
+  size_t pax_pages = count_pages(pax);
+  for (int i = 0; i < num_rows / 4; i += 4) {
+    tuple = make_tuple(i);
+    ASSERT_TRUE(rows->table_->InsertTuple(tuple, &rid, GetTxn()));
+    ASSERT_TRUE(pax->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+  ASSERT_EQ(count_pages(pax), pax_pages);
+  check_scans();
+}
+
+// Executors hand out tuples allocated from an arena of their own, recycled as they hand out the next one.
+TEST_F(ExecutorTest, QueryArenaTest) {
+  TableInfo *table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  const Schema &schema = table_info->schema_;
+  auto *col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto *col_b = MakeColumnValueExpression(schema, 0, "colB");
+  auto *predicate = MakeComparisonExpression(col_a, MakeConstantValueExpression(ValueFactory::GetIntegerValue(500)),
+                                             ComparisonType::LessThan);
+  auto *out_schema = MakeOutputSchema({{"colA", col_a}, {"colB", col_b}});
+  SeqScanPlanNode plan{out_schema, predicate, table_info->oid_};
+
+  auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &plan);
+  executor->Init();
+  std::vector<Tuple> kept;
+  Tuple tuple;
+  RID rid;
+  int32_t produced = 0;
+  while (executor->Next(&tuple, &rid)) {
+    ASSERT_FALSE(tuple.IsAllocated());
+    ASSERT_EQ(tuple.GetValue(out_schema, 0).GetAs<int32_t>(), produced++);
+    // the arena of the scan is recycled on every call, a tuple is materialized to be kept
+    ASSERT_EQ(executor->GetOutputArenaBytes(), ArenaPool::DEFAULT_BLOCK_SIZE);
+    kept.push_back(tuple);
+    kept.back().Materialize();
+  }
+  ASSERT_EQ(produced, 500);
+  for (uint32_t i = 0; i < kept.size(); i++) {
+    ASSERT_EQ(kept[i].GetValue(out_schema, 0).GetAs<int32_t>(), static_cast<int32_t>(i));
+  }
+
+  // so is the result set of the engine
+  std::vector<Tuple> result_set;
+  GetExecutionEngine()->Execute(&plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(result_set.size(), 500);
+  for (uint32_t i = 0; i < result_set.size(); i++) {
+    ASSERT_TRUE(result_set[i].IsAllocated());
+    ASSERT_EQ(result_set[i].GetValue(out_schema, 0).GetAs<int32_t>(), static_cast<int32_t>(i));
+  }
+}
+
+// SELECT a, s FROM views WHERE a < 3, read through views of the pages in batches smaller than a page
+TEST_F(ExecutorTest, ZeroCopyScanTest) {
+  Schema schema({Column("a", TypeId::INTEGER), Column("s", TypeId::VARCHAR, 16)});
+  auto *table_info = GetExecutorContext()->GetCatalog()->CreateTable(GetTxn(), "views", schema);
+  const int num_rows = 3000;
+  RID rid;
+  for (int i = 0; i < num_rows; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(i % 10), ValueFactory::GetVarcharValue(std::to_string(i))}, &schema);
+    ASSERT_TRUE(table_info->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+
+  auto col_a = MakeColumnValueExpression(schema, 0, "a");
+  auto col_s = MakeColumnValueExpression(schema, 0, "s");
+  auto const3 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(3));
+  auto predicate = MakeComparisonExpression(col_a, const3, ComparisonType::LessThan);
+
+  // a page hands out at most 7 views at a time, and the next call resumes past them
+  auto compiled = CompiledExpression::Compile(predicate, &schema);
+  ASSERT_NE(compiled, nullptr);
+  TupleFilter filter = [&](const char *data) { return compiled->Test(data); };
+  std::vector<Tuple> copies;
+  page_id_t page_id = table_info->table_->GetFirstPageId();
+  uint32_t slot = 0;
+  while (page_id != INVALID_PAGE_ID) {
+    auto reader = [&](const std::vector<TupleView> &views) {
+      ASSERT_LE(views.size(), 7);
+      for (const auto &view : views) {
+        ASSERT_LT(view.GetValue(&schema, 0).GetAs<int32_t>(), 3);
+        copies.emplace_back(view);
+      }
+    };
+    page_id = table_info->table_->ViewPage(page_id, &slot, 7, filter, reader, GetTxn());
+  }
+  ASSERT_EQ(copies.size(), num_rows * 3 / 10);
+  for (auto &copy : copies) {
+    ASSERT_TRUE(copy.IsAllocated());
+    Tuple stored;
+    ASSERT_TRUE(table_info->table_->GetTuple(copy.GetRid(), &stored, GetTxn()));
+    ASSERT_EQ(stored.GetLength(), copy.GetLength());
+    ASSERT_EQ(stored.GetValue(&schema, 1).ToString(), copy.GetValue(&schema, 1).ToString());
+  }
+
+  // the integer output is compiled and runs over the views, the varchar one is unboxed from them into the batch
+  for (auto *out_schema : {MakeOutputSchema({{"a", col_a}}), MakeOutputSchema({{"a", col_a}, {"s", col_s}})}) {
+    SeqScanPlanNode scan_plan{out_schema, predicate, table_info->oid_};
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &scan_plan);
+    executor->Init();
+    TupleBatch batch(out_schema, 7);
+    size_t produced = 0;
+    while (executor->NextBatch(&batch)) {
+      for (uint32_t i = 0; i < batch.Size(); i++) {
+        Tuple tuple = batch.GetTuple(batch.RowAt(i));
+        ASSERT_EQ(batch.GetRid(batch.RowAt(i)), copies[produced].GetRid());
+        ASSERT_EQ(tuple.GetValue(out_schema, 0).GetAs<int32_t>(),
+                  copies[produced].GetValue(&schema, 0).GetAs<int32_t>());
+        if (out_schema->GetColumnCount() == 2) {
+          ASSERT_EQ(tuple.GetValue(out_schema, 1).ToString(), copies[produced].GetValue(&schema, 1).ToString());
+        }
+        produced++;
+      }
+    }
+    ASSERT_EQ(produced, copies.size());
+  }
+}
+
+// Compares a scan that evaluates its predicate and output tuple by tuple with the batched scan, over test_1.
+TEST_F(ExecutorTest, DISABLED_BatchScanBenchmark) {
+  const int rounds = 200;
+  auto table_info = GetExecutorContext()->GetCatalog()->GetTable("test_1");
+  auto &schema = table_info->schema_;
+  auto col_a = MakeColumnValueExpression(schema, 0, "colA");
+  auto col_c = MakeColumnValueExpression(schema, 0, "colC");
+  auto const5000 = MakeConstantValueExpression(ValueFactory::GetIntegerValue(5000));
+  auto predicate = MakeComparisonExpression(col_c, const5000, ComparisonType::LessThan);
+  auto out_schema = MakeOutputSchema({{"colA", col_a}, {"colC", col_c}});
+  SeqScanPlanNode scan_plan{out_schema, predicate, table_info->oid_};
+
+  int64_t row_sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++) {
+    for (auto iter = table_info->table_->Begin(GetTxn()); iter != table_info->table_->End(); ++iter) {
+      if (predicate->Evaluate(&*iter, &schema).GetAs<bool>()) {
+        std::vector<Value> values{col_a->Evaluate(&*iter, &schema), col_c->Evaluate(&*iter, &schema)};
+        row_sum += Tuple(values, out_schema).GetValue(out_schema, 0).GetAs<int32_t>();
+      }
+    }
+  }
+  std::chrono::duration<double> row_elapsed = std::chrono::steady_clock::now() - start;
+
+  int64_t batch_sum = 0;
+  auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &scan_plan);
+  TupleBatch batch(out_schema);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++) {
+    executor->Init();
+    while (executor->NextBatch(&batch)) {
+      const int64_t *col = batch.GetColumn(0).GetIntegers();
+      for (uint32_t row : batch.GetSelection()) {
+        batch_sum += col[row];
+      }
+    }
+  }
+  std::chrono::duration<double> batch_elapsed = std::chrono::steady_clock::now() - start;
+
+  ASSERT_EQ(row_sum, batch_sum);
+  printf("row at a time: %8.3fs, batched: %8.3fs\n", row_elapsed.count(), batch_elapsed.count());
+}
+
+// Compares the pages a row table and a PAX table take over the same data, and the time of a scan filtering on the
+// encoded values of the PAX table with the same scan of the row table.
+TEST_F(ExecutorTest, DISABLED_ColumnCompressionBenchmark) {
+  const int num_rows = 20000;
+  const int rounds = 50;
+  Schema schema({Column("id", TypeId::INTEGER), Column("region", TypeId::VARCHAR, 16),
+                 Column("batch", TypeId::SMALLINT), Column("score", TypeId::DECIMAL)});
+  auto *catalog = GetExecutorContext()->GetCatalog();
+  auto *rows = catalog->CreateTable(GetTxn(), "rows", schema);
+  auto *pax = catalog->CreateTable(GetTxn(), "pax", schema, {}, TableLayout::PAX);
+  const std::vector<std::string> regions{"north", "south", "east", "west", "central"};
+  RID rid;
+  for (int i = 0; i < num_rows; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(regions[i * 7 % 5]),
+                 ValueFactory::GetSmallIntValue(static_cast<int16_t>(i / 500)), ValueFactory::GetDecimalValue(i % 13)},
+                &schema);
+    ASSERT_TRUE(rows->table_->InsertTuple(tuple, &rid, GetTxn()));
+    ASSERT_TRUE(pax->table_->InsertTuple(tuple, &rid, GetTxn()));
+  }
+
+  auto col_id = MakeColumnValueExpression(schema, 0, "id");
+  auto col_region = MakeColumnValueExpression(schema, 0, "region");
+  auto predicate = MakeComparisonExpression(
+      col_region, MakeConstantValueExpression(ValueFactory::GetVarcharValue("east")), ComparisonType::Equal);
+  auto out_schema = MakeOutputSchema({{"id", col_id}});
+  auto run = [&](TableInfo *table_info, size_t *pages, int64_t *sum) {
+    *pages = 0;
+    for (page_id_t page_id = table_info->table_->GetFirstPageId(); page_id != INVALID_PAGE_ID; (*pages)++) {
+      page_id = table_info->table_->GetNextPageId(page_id);
+    }
+    SeqScanPlanNode scan_plan{out_schema, predicate, table_info->oid_};
+    auto executor = ExecutorFactory::CreateExecutor(GetExecutorContext(), &scan_plan);
+    TupleBatch batch(out_schema);
+    *sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+      executor->Init();
+      while (executor->NextBatch(&batch)) {
+        const int64_t *col = batch.GetColumn(0).GetIntegers();
+        for (uint32_t row : batch.GetSelection()) {
+          *sum += col[row];
+        }
+      }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  };
+
+  size_t row_pages;
+  size_t pax_pages;
+  int64_t row_sum;
+  int64_t pax_sum;
+  double row_elapsed = run(rows, &row_pages, &row_sum);
+  double pax_elapsed = run(pax, &pax_pages, &pax_sum);
+  ASSERT_EQ(row_sum, pax_sum);
+  printf("row pages: %zu, pax pages: %zu (%.2fx)\n", row_pages, pax_pages, static_cast<double>(row_pages) / pax_pages);
+  printf("row scan: %8.3fs, compressed pax scan: %8.3fs\n", row_elapsed, pax_elapsed);
+}
+
 }  // namespace bustub
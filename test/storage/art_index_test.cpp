@@ -0,0 +1,141 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// art_index_test.cpp
+//
+// Identification: test/storage/art_index_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "catalog/catalog.h"
+#include "gtest/gtest.h"
+#include "storage/index/key_encoder.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+static std::string EncodeOne(const Value &val) {
+  std::string out;
+  KeyEncoder::EncodeValue(val, &out);
+  return out;
+}
+
+// NOLINTNEXTLINE
+TEST(ARTIndexTest, KeyEncoderTest) {
+  // byte order matches value order for every type
+  std::vector<std::vector<Value>> sorted{
+      {ValueFactory::GetTinyIntValue(-100), ValueFactory::GetTinyIntValue(-1), ValueFactory::GetTinyIntValue(0),
+       ValueFactory::GetTinyIntValue(100)},
+      {ValueFactory::GetIntegerValue(-70000), ValueFactory::GetIntegerValue(-1), ValueFactory::GetIntegerValue(0),
+       ValueFactory::GetIntegerValue(255), ValueFactory::GetIntegerValue(256)},
+      {ValueFactory::GetBigIntValue(-(1LL << 40)), ValueFactory::GetBigIntValue(-3), ValueFactory::GetBigIntValue(7),
+       ValueFactory::GetBigIntValue(1LL << 40)},
+      {ValueFactory::GetDecimalValue(-1e10), ValueFactory::GetDecimalValue(-0.5), ValueFactory::GetDecimalValue(0),
+       ValueFactory::GetDecimalValue(0.25), ValueFactory::GetDecimalValue(3e8)},
+      {ValueFactory::GetVarcharValue(""), ValueFactory::GetVarcharValue("a"), ValueFactory::GetVarcharValue("ab"),
+       ValueFactory::GetVarcharValue("b")},
+  };
+  for (const auto &values : sorted) {
+    for (size_t i = 1; i < values.size(); i++) {
+      EXPECT_LT(EncodeOne(values[i - 1]), EncodeOne(values[i])) << values[i].ToString();
+    }
+  }
+
+  // multi-column keys order by the first column, then the next
+  Schema schema({Column("a", TypeId::VARCHAR, 8), Column("b", TypeId::INTEGER)});
+  Tuple lo({ValueFactory::GetVarcharValue("a"), ValueFactory::GetIntegerValue(9)}, &schema);
+  Tuple hi({ValueFactory::GetVarcharValue("ab"), ValueFactory::GetIntegerValue(1)}, &schema);
+  EXPECT_LT(KeyEncoder::Encode(lo, &schema, 2), KeyEncoder::Encode(hi, &schema, 2));
+}
+
+// NOLINTNEXTLINE
+TEST(ARTIndexTest, CatalogTest) {
+  auto disk_manager = std::make_unique<DiskManager>("test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(50, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  Transaction txn(0);
+
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 16)});
+  auto *table_info = catalog->CreateTable(&txn, "t", schema);
+  for (int i = 0; i < 500; i++) {
+    RID rid;
+    Tuple tuple({ValueFactory::GetIntegerValue(i % 250), ValueFactory::GetVarcharValue(std::to_string(i))}, &schema);
+    table_info->table_->InsertTuple(tuple, &rid, &txn);
+  }
+
+  // the index is populated from the heap, and every key holds the rows it was seen in
+  Schema key_schema({Column("a", TypeId::INTEGER)});
+  auto *index_info = catalog->CreateIndex<GenericKey<8>, RID, GenericComparator<8>>(
+      &txn, "art", "t", schema, key_schema, {0}, 8, HashFunction<GenericKey<8>>(), IndexType::ARTIndex);
+  ASSERT_NE(Catalog::NULL_INDEX_INFO, index_info);
+  for (int i = 0; i < 260; i++) {
+    std::vector<RID> rids;
+    index_info->index_->ScanKey(Tuple({ValueFactory::GetIntegerValue(i)}, &key_schema), &rids, &txn);
+    EXPECT_EQ(i < 250 ? 2 : 0, rids.size()) << "Wrong result for " << i;
+  }
+
+  // the index follows deletes
+  std::vector<RID> rids;
+  Tuple key({ValueFactory::GetIntegerValue(7)}, &key_schema);
+  index_info->index_->ScanKey(key, &rids, &txn);
+  index_info->index_->DeleteEntry(key, rids[0], &txn);
+  rids.clear();
+  index_info->index_->ScanKey(key, &rids, &txn);
+  EXPECT_EQ(1, rids.size());
+
+  remove("test.db");
+}
+
+// Compares point lookup throughput of an ART index against a B+ tree index over the same integer keys.
+// NOLINTNEXTLINE
+TEST(ARTIndexTest, DISABLED_PointLookupBenchmark) {
+  auto disk_manager = std::make_unique<DiskManager>("test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(1024, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  Transaction txn(0);
+  const int num_keys = 100000;
+  const int num_lookups = 1000000;
+
+  Schema schema({Column("a", TypeId::INTEGER)});
+  catalog->CreateTable(&txn, "t", schema);
+  std::vector<IndexInfo *> indexes;
+  for (auto type : {IndexType::BPlusTreeIndex, IndexType::ARTIndex}) {
+    indexes.push_back(catalog->CreateIndex<GenericKey<8>, RID, GenericComparator<8>>(
+        &txn, type == IndexType::ARTIndex ? "art" : "tree", "t", schema, schema, {0}, 8,
+        HashFunction<GenericKey<8>>(), type));
+  }
+  std::vector<Tuple> keys;
+  for (int i = 0; i < num_keys; i++) {
+    keys.emplace_back(std::vector<Value>{ValueFactory::GetIntegerValue(i)}, &schema);
+    for (auto *index_info : indexes) {
+      index_info->index_->InsertEntry(keys.back(), RID(i, 0), &txn);
+    }
+  }
+
+  for (auto *index_info : indexes) {
+    std::vector<RID> rids;
+    uint32_t key = 12345;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_lookups; i++) {
+      rids.clear();
+      key = (key * 1103515245 + 12345) % num_keys;
+      index_info->index_->ScanKey(keys[key], &rids, &txn);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printf("%-5s lookups/s: %12.0f\n", index_info->name_.c_str(), num_lookups / elapsed.count());
+  }
+
+  remove("test.db");
+}
+
+}  // namespace bustub
@@ -0,0 +1,233 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_duplicate_test.cpp
+//
+// Identification: test/storage/b_plus_tree_duplicate_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <map>
+#include <random>
+#include <set>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+TEST(BPlusTreeTests, DuplicateKeyTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  // create b+ tree
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 3, 3);
+  GenericKey<8> index_key;
+  Transaction *transaction = new Transaction(0);
+
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  // every key gets key + 1 values
+  for (int64_t key = 0; key < 20; key++) {
+    index_key.SetFromInteger(key);
+    for (int64_t slot = 0; slot <= key; slot++) {
+      EXPECT_TRUE(tree.Insert(index_key, RID(key, slot), transaction));
+    }
+  }
+  // the exact same pair is rejected
+  index_key.SetFromInteger(5);
+  EXPECT_FALSE(tree.Insert(index_key, RID(5, 3), transaction));
+
+  std::vector<RID> rids;
+  for (int64_t key = 0; key < 20; key++) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    EXPECT_TRUE(tree.GetValue(index_key, &rids));
+    ASSERT_EQ(rids.size(), key + 1);
+    for (int64_t slot = 0; slot <= key; slot++) {
+      EXPECT_EQ(rids[slot], RID(key, slot));
+    }
+  }
+
+  // the iterator yields one pair per value, in key order
+  int64_t count = 0;
+  int64_t last_key = -1;
+  for (auto iterator = tree.Begin(); iterator != tree.End(); ++iterator) {
+    auto location = (*iterator).second;
+    EXPECT_GE(location.GetPageId(), last_key);
+    last_key = location.GetPageId();
+    count++;
+  }
+  EXPECT_EQ(count, 20 * 21 / 2);
+
+  // removing single pairs keeps the remaining values of the key
+  index_key.SetFromInteger(7);
+  EXPECT_TRUE(tree.Remove(index_key, RID(7, 0), transaction));
+  EXPECT_FALSE(tree.Remove(index_key, RID(7, 0), transaction));
+  rids.clear();
+  tree.GetValue(index_key, &rids);
+  EXPECT_EQ(rids.size(), 7);
+  EXPECT_EQ(std::count(rids.begin(), rids.end(), RID(7, 0)), 0);
+
+  // removing the last value removes the key
+  index_key.SetFromInteger(0);
+  EXPECT_TRUE(tree.Remove(index_key, RID(0, 0), transaction));
+  rids.clear();
+  EXPECT_FALSE(tree.GetValue(index_key, &rids));
+
+  // removing a key drops all of its values
+  for (int64_t key = 1; key < 20; key++) {
+    index_key.SetFromInteger(key);
+    tree.Remove(index_key, transaction);
+    rids.clear();
+    EXPECT_FALSE(tree.GetValue(index_key, &rids));
+  }
+  EXPECT_TRUE(tree.IsEmpty());
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
+TEST(BPlusTreeTests, HotKeyOverflowTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  // create b+ tree
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator);
+  GenericKey<8> index_key;
+  Transaction *transaction = new Transaction(0);
+
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  // a hot key with far more values than a leaf can hold, between cold keys
+  const int64_t hot_key = 50;
+  const int64_t hot_values = 3000;
+  std::vector<int64_t> slots(hot_values);
+  std::iota(slots.begin(), slots.end(), 0);
+  std::shuffle(slots.begin(), slots.end(), std::mt19937(15445));
+  for (int64_t key = 0; key < 100; key++) {
+    index_key.SetFromInteger(key);
+    tree.Insert(index_key, RID(key, 0), transaction);
+  }
+  index_key.SetFromInteger(hot_key);
+  for (auto slot : slots) {
+    tree.Insert(index_key, RID(hot_key, slot + 1), transaction);
+  }
+  EXPECT_FALSE(tree.Insert(index_key, RID(hot_key, 2999), transaction));
+
+  std::vector<RID> rids;
+  EXPECT_TRUE(tree.GetValue(index_key, &rids));
+  EXPECT_EQ(rids.size(), hot_values + 1);
+
+  int64_t count = 0;
+  index_key.SetFromInteger(hot_key);
+  for (auto iterator = tree.Begin(index_key); iterator != tree.End(); ++iterator) {
+    count++;
+  }
+  EXPECT_EQ(count, hot_values + 1 + (100 - hot_key - 1));
+
+  // drain the hot key value by value, values move back from the overflow chain
+  for (int64_t i = 0; i < hot_values; i += 2) {
+    EXPECT_TRUE(tree.Remove(index_key, RID(hot_key, slots[i] + 1), transaction));
+  }
+  rids.clear();
+  tree.GetValue(index_key, &rids);
+  EXPECT_EQ(rids.size(), hot_values / 2 + 1);
+
+  tree.Remove(index_key, transaction);
+  rids.clear();
+  EXPECT_FALSE(tree.GetValue(index_key, &rids));
+  for (int64_t key = 0; key < 100; key++) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    EXPECT_EQ(tree.GetValue(index_key, &rids), key != hot_key);
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
+TEST(BPlusTreeTests, DuplicateMixedTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  // create b+ tree
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", bpm, comparator, 4, 4);
+  GenericKey<8> index_key;
+  Transaction *transaction = new Transaction(0);
+
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  // random inserts and single pair removals checked against a reference map
+  std::map<int64_t, std::set<int64_t>> expected;
+  std::mt19937 gen(15445);
+  for (int round = 0; round < 20000; round++) {
+    int64_t key = gen() % 200;
+    int64_t slot = gen() % 8;
+    index_key.SetFromInteger(key);
+    if (gen() % 3 != 0) {
+      EXPECT_EQ(tree.Insert(index_key, RID(key, slot), transaction), expected[key].insert(slot).second);
+    } else {
+      bool present = expected[key].erase(slot) == 1;
+      EXPECT_EQ(tree.Remove(index_key, RID(key, slot), transaction), present);
+    }
+  }
+
+  std::vector<RID> rids;
+  int64_t total = 0;
+  for (const auto &[key, slots] : expected) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    EXPECT_EQ(tree.GetValue(index_key, &rids), !slots.empty());
+    EXPECT_EQ(rids.size(), slots.size());
+    total += slots.size();
+  }
+  int64_t count = 0;
+  for (auto iterator = tree.Begin(); iterator != tree.End(); ++iterator) {
+    count++;
+  }
+  EXPECT_EQ(count, total);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
+}  // namespace bustub
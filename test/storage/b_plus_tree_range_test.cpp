@@ -0,0 +1,133 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// b_plus_tree_range_test.cpp
+//
+// Identification: test/storage/b_plus_tree_range_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree.h"
+#include "test_util.h"  // NOLINT
+
+namespace bustub {
+
+using RangeTree = BPlusTree<GenericKey<8>, RID, GenericComparator<8>>;
+
+// collect the keys produced by an iterator
+std::vector<int64_t> CollectKeys(RangeTree *tree, IndexIterator<GenericKey<8>, RID, GenericComparator<8>> iterator) {
+  std::vector<int64_t> keys;
+  for (; iterator != tree->End(); ++iterator) {
+    keys.push_back((*iterator).second.GetSlotNum());
+  }
+  return keys;
+}
+
+std::vector<int64_t> Sequence(int64_t from, int64_t to, int64_t step = 1) {
+  std::vector<int64_t> keys;
+  for (int64_t key = from; step > 0 ? key <= to : key >= to; key += step) {
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+TEST(BPlusTreeTests, RangeIteratorTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  // create b+ tree
+  RangeTree tree("foo_pk", bpm, comparator, 3, 3);
+  Transaction *transaction = new Transaction(0);
+
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  (void)header_page;
+
+  // even keys only, so bounds fall both on and between keys
+  std::vector<int64_t> keys = Sequence(0, 198, 2);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(15445));
+  GenericKey<8> index_key;
+  for (auto key : keys) {
+    index_key.SetFromInteger(key);
+    tree.Insert(index_key, RID(0, key), transaction);
+  }
+
+  GenericKey<8> lo;
+  GenericKey<8> hi;
+  lo.SetFromInteger(20);
+  hi.SetFromInteger(40);
+  EXPECT_EQ(CollectKeys(&tree, tree.Begin(&lo, true, &hi, true)), Sequence(20, 40, 2));
+  EXPECT_EQ(CollectKeys(&tree, tree.Begin(&lo, false, &hi, false)), Sequence(22, 38, 2));
+  EXPECT_EQ(CollectKeys(&tree, tree.RBegin(&lo, true, &hi, true)), Sequence(40, 20, -2));
+  EXPECT_EQ(CollectKeys(&tree, tree.RBegin(&lo, false, &hi, false)), Sequence(38, 22, -2));
+
+  // bounds between keys
+  lo.SetFromInteger(21);
+  hi.SetFromInteger(41);
+  EXPECT_EQ(CollectKeys(&tree, tree.Begin(&lo, false, &hi, false)), Sequence(22, 40, 2));
+  EXPECT_EQ(CollectKeys(&tree, tree.RBegin(&lo, false, &hi, false)), Sequence(40, 22, -2));
+
+  // open ends
+  EXPECT_EQ(CollectKeys(&tree, tree.Begin(nullptr, true, &hi, true)), Sequence(0, 40, 2));
+  EXPECT_EQ(CollectKeys(&tree, tree.Begin(&lo, true, nullptr, true)), Sequence(22, 198, 2));
+  EXPECT_EQ(CollectKeys(&tree, tree.RBegin()), Sequence(198, 0, -2));
+  EXPECT_EQ(CollectKeys(&tree, tree.RBegin(&lo, true)), Sequence(198, 22, -2));
+
+  // empty ranges
+  lo.SetFromInteger(50);
+  hi.SetFromInteger(50);
+  EXPECT_TRUE(CollectKeys(&tree, tree.Begin(&lo, false, &hi, true)).empty());
+  EXPECT_TRUE(CollectKeys(&tree, tree.RBegin(&lo, true, &hi, false)).empty());
+  lo.SetFromInteger(500);
+  EXPECT_TRUE(CollectKeys(&tree, tree.Begin(&lo, true, nullptr, true)).empty());
+  hi.SetFromInteger(-1);
+  EXPECT_TRUE(CollectKeys(&tree, tree.RBegin(nullptr, true, &hi, true)).empty());
+
+  // the prev-leaf links survive merges
+  for (int64_t key = 0; key < 200; key += 4) {
+    index_key.SetFromInteger(key);
+    tree.Remove(index_key, transaction);
+  }
+  auto forward = CollectKeys(&tree, tree.Begin());
+  auto backward = CollectKeys(&tree, tree.RBegin());
+  EXPECT_EQ(forward, Sequence(2, 198, 4));
+  std::reverse(backward.begin(), backward.end());
+  EXPECT_EQ(forward, backward);
+
+  // an iterator that stopped early holds no pin, all pages can be flushed out
+  lo.SetFromInteger(10);
+  hi.SetFromInteger(30);
+  {
+    auto iterator = tree.Begin(&lo, true, &hi, true);
+    while (!iterator.IsEnd()) {
+      ++iterator;
+    }
+    for (int i = 0; i < 50; i++) {
+      page_id_t temp_page_id;
+      EXPECT_NE(nullptr, bpm->NewPage(&temp_page_id));
+      bpm->UnpinPage(temp_page_id, false);
+    }
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete disk_manager;
+  delete bpm;
+  remove("test.db");
+  remove("test.log");
+}
+
+}  // namespace bustub
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// bloom_filter_test.cpp
+//
+// Identification: test/storage/bloom_filter_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/index/b_plus_tree_index.h"
+#include "storage/index/bloom_filter.h"
+#include "storage/index/extendible_hash_table_index.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+TEST(BloomFilterTest, FilterTest) {
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  const int num_keys = 10000;
+  page_id_t header_page_id;
+  {
+    BloomFilter filter(bpm, num_keys);
+    header_page_id = filter.GetHeaderPageId();
+    EXPECT_GE(filter.GetNumBits(), num_keys * BLOOM_FILTER_BITS_PER_KEY);
+    for (int64_t key = 0; key < num_keys; key++) {
+      filter.Insert(HashUtil::HashInt(key));
+    }
+
+    // no false negatives, and about the expected share of false positives
+    for (int64_t key = 0; key < num_keys; key++) {
+      EXPECT_TRUE(filter.MayContain(HashUtil::HashInt(key)));
+    }
+    int false_positives = 0;
+    for (int64_t key = num_keys; key < 11 * num_keys; key++) {
+      if (filter.MayContain(HashUtil::HashInt(key))) {
+        filter.RecordFalsePositive();
+        false_positives++;
+      }
+    }
+    EXPECT_EQ(11 * num_keys, filter.GetNumProbes());
+    EXPECT_EQ(false_positives, filter.GetNumFalsePositives());
+    EXPECT_EQ(10 * num_keys - false_positives, filter.GetNumNegatives());
+    EXPECT_LT(filter.GetExpectedFalsePositiveRate(), 0.02);
+    EXPECT_LT(filter.GetObservedFalsePositiveRate(), 3 * filter.GetExpectedFalsePositiveRate());
+  }
+
+  // the bits survive in the filter pages, and the key count is estimated from them
+  BloomFilter filter(bpm, 0, header_page_id);
+  for (int64_t key = 0; key < num_keys; key++) {
+    EXPECT_TRUE(filter.MayContain(HashUtil::HashInt(key)));
+  }
+  EXPECT_NEAR(num_keys, filter.GetNumInserted(), num_keys / 20);
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  delete bpm;
+  delete disk_manager;
+}
+
+TEST(BloomFilterTest, IndexFilterTest) {
+  DiskManager *disk_manager = new DiskManager("test.db");
+  BufferPoolManager *bpm = new BufferPoolManagerInstance(50, disk_manager);
+  std::vector<Column> columns{Column("a", TypeId::BIGINT), Column("b", TypeId::INTEGER)};
+  Schema schema(columns);
+  Transaction transaction(0);
+
+  page_id_t header_page_id;
+  bpm->NewPage(&header_page_id);
+  bpm->UnpinPage(header_page_id, true);
+  std::vector<std::unique_ptr<Index>> indexes;
+  indexes.push_back(std::make_unique<BPlusTreeIndex<GenericKey<8>, RID, GenericComparator<8>>>(
+      std::make_unique<IndexMetadata>("tree", "t", &schema, std::vector<uint32_t>{0}), bpm, header_page_id, 1000));
+  indexes.push_back(std::make_unique<ExtendibleHashTableIndex<GenericKey<8>, RID, GenericComparator<8>>>(
+      std::make_unique<IndexMetadata>("hash", "t", &schema, std::vector<uint32_t>{0}), bpm,
+      HashFunction<GenericKey<8>>(), 1000));
+
+  for (auto &index : indexes) {
+    for (int64_t key = 0; key < 1000; key += 2) {
+      Tuple tuple({ValueFactory::GetBigIntValue(key)}, index->GetKeySchema());
+      index->InsertEntry(tuple, RID(0, key), &transaction);
+    }
+    BloomFilter *filter = index->GetFilter();
+    ASSERT_NE(nullptr, filter);
+    EXPECT_EQ(500, filter->GetNumInserted());
+
+    // present keys always pass, absent keys are mostly answered by the filter alone
+    for (int64_t key = 0; key < 1000; key++) {
+      std::vector<RID> rids;
+      Tuple tuple({ValueFactory::GetBigIntValue(key)}, index->GetSearchKeySchema());
+      index->ScanKey(tuple, &rids, &transaction);
+      ASSERT_EQ(key % 2 == 0 ? 1 : 0, rids.size()) << index->GetName() << " key " << key;
+    }
+    EXPECT_EQ(1000, filter->GetNumProbes());
+    EXPECT_EQ(500, filter->GetNumNegatives() + filter->GetNumFalsePositives());
+    EXPECT_GT(filter->GetNumNegatives(), 450);
+  }
+
+  disk_manager->ShutDown();
+  remove("test.db");
+  indexes.clear();
+  delete bpm;
+  delete disk_manager;
+}
+
+}  // namespace bustub
@@ -0,0 +1,199 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// generic_key_test.cpp
+//
+// Identification: test/storage/generic_key_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "catalog/catalog.h"
+#include "gtest/gtest.h"
+#include "storage/index/generic_key.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(GenericKeyTest, NormalizedKeyTest) {
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 8)});
+  std::vector<Tuple> tuples;
+  for (int a : {-70000, -1, 0, 1, 256}) {
+    for (const char *b : {"", "a", "ab", "b", "zzzzzzz"}) {
+      tuples.emplace_back(std::vector<Value>{ValueFactory::GetIntegerValue(a), ValueFactory::GetVarcharValue(b)},
+                          &schema);
+    }
+  }
+  std::vector<GenericKey<32>> raw(tuples.size());
+  std::vector<GenericKey<32>> normalized(tuples.size());
+  for (size_t i = 0; i < tuples.size(); i++) {
+    raw[i].SetFromKey(tuples[i]);
+    normalized[i].SetFromNormalizedKey(tuples[i], &schema);
+  }
+
+  // memcmp of normalized keys orders them like the column by column comparison of raw keys
+  GenericComparator<32> raw_comparator(&schema);
+  GenericComparator<32> normalized_comparator(&schema, true);
+  for (size_t i = 0; i < tuples.size(); i++) {
+    for (size_t j = 0; j < tuples.size(); j++) {
+      EXPECT_EQ(raw_comparator(raw[i], raw[j]), normalized_comparator(normalized[i], normalized[j]))
+          << tuples[i].ToString(&schema) << " vs " << tuples[j].ToString(&schema);
+    }
+  }
+
+  // normalized keys decode back to the values they were built from
+  for (size_t i = 0; i < tuples.size(); i++) {
+    for (uint32_t col = 0; col < schema.GetColumnCount(); col++) {
+      EXPECT_EQ(CmpBool::CmpTrue,
+                normalized[i].ToNormalizedValue(&schema, col).CompareEquals(tuples[i].GetValue(&schema, col)));
+    }
+  }
+
+  // a comparator over a prefix of the columns ignores the rest of the key
+  Schema prefix({Column("a", TypeId::INTEGER)});
+  GenericComparator<32> prefix_comparator(&prefix, true);
+  EXPECT_EQ(0, prefix_comparator(normalized[0], normalized[4]));
+  EXPECT_EQ(-1, prefix_comparator(normalized[4], normalized[5]));
+
+  // a varchar prefix compares only up to the end of its own encoding
+  Schema varchar_first({Column("b", TypeId::VARCHAR, 8), Column("a", TypeId::INTEGER)});
+  Schema varchar_prefix({Column("b", TypeId::VARCHAR, 8)});
+  GenericKey<32> lhs;
+  GenericKey<32> rhs;
+  lhs.SetFromNormalizedKey(
+      Tuple({ValueFactory::GetVarcharValue("ab"), ValueFactory::GetIntegerValue(1)}, &varchar_first), &varchar_first);
+  rhs.SetFromNormalizedKey(
+      Tuple({ValueFactory::GetVarcharValue("ab"), ValueFactory::GetIntegerValue(2)}, &varchar_first), &varchar_first);
+  EXPECT_EQ(0, GenericComparator<32>(&varchar_prefix, true)(lhs, rhs));
+  EXPECT_EQ(-1, GenericComparator<32>(&varchar_first, true)(lhs, rhs));
+
+  // a null timestamp sorts before every timestamp and decodes back to null
+  std::string null_timestamp;
+  std::string zero_timestamp;
+  KeyEncoder::EncodeValue(ValueFactory::GetTimestampValue(BUSTUB_TIMESTAMP_NULL), &null_timestamp);
+  KeyEncoder::EncodeValue(ValueFactory::GetTimestampValue(0), &zero_timestamp);
+  EXPECT_LT(null_timestamp, zero_timestamp);
+  const char *data = null_timestamp.data();
+  EXPECT_TRUE(KeyEncoder::DecodeValue(&data, TypeId::TIMESTAMP).IsNull());
+  data = zero_timestamp.data();
+  EXPECT_EQ(0, KeyEncoder::DecodeValue(&data, TypeId::TIMESTAMP).GetAs<uint64_t>());
+
+  // -0.0 and 0.0 are the same key
+  Schema decimal({Column("d", TypeId::DECIMAL)});
+  lhs.SetFromNormalizedKey(Tuple({ValueFactory::GetDecimalValue(-0.0)}, &decimal), &decimal);
+  rhs.SetFromNormalizedKey(Tuple({ValueFactory::GetDecimalValue(0.0)}, &decimal), &decimal);
+  EXPECT_EQ(0, GenericComparator<32>(&decimal, true)(lhs, rhs));
+}
+
+// NOLINTNEXTLINE
+TEST(GenericKeyTest, NormalizedIndexTest) {
+  auto disk_manager = std::make_unique<DiskManager>("test.db");
+  auto bpm = std::make_unique<BufferPoolManagerInstance>(50, disk_manager.get());
+  auto catalog = std::make_unique<Catalog>(bpm.get(), nullptr, nullptr);
+  Transaction txn(0);
+
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 8)});
+  auto *table_info = catalog->CreateTable(&txn, "t", schema);
+  for (int i = 0; i < 300; i++) {
+    RID rid;
+    Tuple tuple({ValueFactory::GetIntegerValue(i - 150), ValueFactory::GetVarcharValue(std::to_string(i % 10))},
+                &schema);
+    table_info->table_->InsertTuple(tuple, &rid, &txn);
+  }
+
+  // the longest encoding of (b, a) takes 1 + 8 + 2 + 4 bytes, more than an 8 byte key holds
+  Schema key_schema({Column("b", TypeId::VARCHAR, 8), Column("a", TypeId::INTEGER)});
+  EXPECT_EQ(Catalog::NULL_INDEX_INFO,
+            (catalog->CreateIndex<GenericKey<8>, RID, GenericComparator<8>>(
+                &txn, "small", "t", schema, key_schema, {1, 0}, 8, HashFunction<GenericKey<8>>(),
+                IndexType::BPlusTreeIndex, {}, 0, true)));
+  auto *index_info = catalog->CreateIndex<GenericKey<32>, RID, GenericComparator<32>>(
+      &txn, "normalized", "t", schema, key_schema, {1, 0}, 32, HashFunction<GenericKey<32>>(),
+      IndexType::BPlusTreeIndex, {}, 0, true);
+  ASSERT_NE(Catalog::NULL_INDEX_INFO, index_info);
+  EXPECT_TRUE(index_info->index_->IsNormalized());
+
+  for (int i = 0; i < 300; i++) {
+    std::vector<RID> rids;
+    Tuple key({ValueFactory::GetVarcharValue(std::to_string(i % 10)), ValueFactory::GetIntegerValue(i - 150)},
+              &key_schema);
+    index_info->index_->ScanKey(key, &rids, &txn);
+    EXPECT_EQ(1, rids.size()) << "Wrong result for " << i;
+  }
+
+  // entries come out ordered by b, then by a, negative numbers first
+  auto *tree = dynamic_cast<BPlusTreeIndex<GenericKey<32>, RID, GenericComparator<32>> *>(index_info->index_.get());
+  ASSERT_NE(nullptr, tree);
+  std::vector<std::pair<std::string, int32_t>> entries;
+  for (auto iter = tree->GetBeginIterator(); !iter.IsEnd(); ++iter) {
+    const auto &key = (*iter).first;
+    entries.emplace_back(key.ToNormalizedValue(&key_schema, 0).ToString(),
+                         key.ToNormalizedValue(&key_schema, 1).GetAs<int32_t>());
+  }
+  ASSERT_EQ(300, entries.size());
+  EXPECT_TRUE(std::is_sorted(entries.begin(), entries.end()));
+  EXPECT_EQ(std::make_pair(std::string("0"), -150), entries.front());
+
+  // a varchar longer than declared or full of escaped zero bytes does not fit, and is never cut off
+  std::string long_string(40, 'x');
+  Tuple long_key({ValueFactory::GetVarcharValue(long_string), ValueFactory::GetIntegerValue(0)}, &key_schema);
+  GenericKey<32> long_index_key;
+  EXPECT_FALSE(long_index_key.SetFromNormalizedKey(long_key, &key_schema));
+  EXPECT_THROW(index_info->index_->InsertEntry(long_key, RID(0, 0), &txn), Exception);
+  std::vector<RID> rids;
+  index_info->index_->ScanKey(long_key, &rids, &txn);
+  EXPECT_TRUE(rids.empty());
+  // the longest encoding of (b, a) fits in 16 bytes as long as b holds no zero bytes
+  auto *tight_info = catalog->CreateIndex<GenericKey<16>, RID, GenericComparator<16>>(
+      &txn, "tight", "t", schema, key_schema, {1, 0}, 16, HashFunction<GenericKey<16>>(), IndexType::BPlusTreeIndex,
+      {}, 0, true);
+  ASSERT_NE(Catalog::NULL_INDEX_INFO, tight_info);
+  Tuple zero_key({ValueFactory::GetVarcharValue(std::string(8, '\0')), ValueFactory::GetIntegerValue(0)}, &key_schema);
+  EXPECT_THROW(tight_info->index_->InsertEntry(zero_key, RID(0, 0), &txn), Exception);
+
+  remove("test.db");
+}
+
+// Compares sorting keys with the column by column comparator against memcmp of normalized keys.
+// NOLINTNEXTLINE
+TEST(GenericKeyTest, DISABLED_ComparatorBenchmark) {
+  const int num_keys = 200000;
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::BIGINT)});
+  std::mt19937 gen(15445);
+  std::vector<GenericKey<16>> raw(num_keys);
+  std::vector<GenericKey<16>> normalized(num_keys);
+  for (int i = 0; i < num_keys; i++) {
+    Tuple tuple({ValueFactory::GetIntegerValue(static_cast<int32_t>(gen() % 1000)),
+                 ValueFactory::GetBigIntValue(static_cast<int64_t>(gen()) - (1LL << 31))},
+                &schema);
+    raw[i].SetFromKey(tuple);
+    normalized[i].SetFromNormalizedKey(tuple, &schema);
+  }
+
+  for (bool is_normalized : {false, true}) {
+    auto keys = is_normalized ? normalized : raw;
+    GenericComparator<16> comparator(&schema, is_normalized);
+    auto less = [&comparator](const GenericKey<16> &lhs, const GenericKey<16> &rhs) {
+      return comparator(lhs, rhs) < 0;
+    };
+    auto start = std::chrono::steady_clock::now();
+    std::sort(keys.begin(), keys.end(), less);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printf("%-10s sort of %d keys: %8.3fs\n", is_normalized ? "normalized" : "raw", num_keys, elapsed.count());
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end(), less));
+  }
+}
+
+}  // namespace bustub
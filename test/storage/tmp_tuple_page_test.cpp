@@ -19,11 +19,7 @@
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(TmpTuplePageTest, DISABLED_BasicTest) {
-  // There are many ways to do this assignment, and this is only one of them.
-  // If you don't like the TmpTuplePage idea, please feel free to delete this test case entirely.
-  // You will get full credit as long as you are correctly using a linear probe hash table.
-
+TEST(TmpTuplePageTest, BasicTest) {
   TmpTuplePage page{};
   page_id_t page_id = 15445;
   page.Init(page_id, PAGE_SIZE);
@@ -46,6 +42,21 @@ TEST(TmpTuplePageTest, DISABLED_BasicTest) {
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), PAGE_SIZE - 8);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + PAGE_SIZE - 8), 4);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + PAGE_SIZE - 4), 123);
+  ASSERT_EQ(tmp_tuple, TmpTuple(page_id, PAGE_SIZE - 8));
+
+  // tuples are read back from the last one inserted
+  Tuple other({ValueFactory::GetIntegerValue(456)}, &schema);
+  ASSERT_TRUE(page.Insert(other, &tmp_tuple));
+  Tuple read;
+  uint32_t offset = page.Get(page.GetFreeSpacePointer(), &read);
+  ASSERT_EQ(456, read.GetValue(&schema, 0).GetAs<int32_t>());
+  ASSERT_EQ(PAGE_SIZE, page.Get(offset, &read));
+  ASSERT_EQ(123, read.GetValue(&schema, 0).GetAs<int32_t>());
+
+  // until the page is full
+  while (page.Insert(tuple, &tmp_tuple)) {
+  }
+  ASSERT_LT(page.GetFreeSpacePointer(), 12 + 8);
 }
 
 }  // namespace bustub
@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena_pool_test.cpp
+//
+// Identification: test/type/arena_pool_test.cpp
+//
+// Copyright (c) 2015-2021, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "gtest/gtest.h"
+#include "storage/table/tuple.h"
+#include "type/arena_pool.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(ArenaPoolTest, AllocateAndResetTest) {
+  ArenaPool arena(1024);
+  // a chunk larger than a quarter of a block gets its own block, and the next small one follows the previous one
+  auto *first = static_cast<char *>(arena.Allocate(3));
+  auto *large = static_cast<char *>(arena.Allocate(4000));
+  memset(large, 0xff, 4000);
+  ASSERT_EQ(arena.Allocate(8), first + 8);
+
+  std::vector<char *> chunks;
+  for (int i = 0; i < 100; i++) {
+    auto *chunk = static_cast<char *>(arena.Allocate(i % 50 + 1));
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(chunk) % 8, 0);
+    memset(chunk, i, i % 50 + 1);
+    chunks.push_back(chunk);
+  }
+  for (int i = 0; i < 100; i++) {
+    for (int j = 0; j < i % 50 + 1; j++) {
+      ASSERT_EQ(chunks[i][j], static_cast<char>(i));
+    }
+  }
+
+  size_t reserved = arena.GetReservedBytes();
+  ASSERT_GT(arena.GetAllocatedBytes(), 4000);
+  ASSERT_GE(reserved, arena.GetAllocatedBytes());
+  arena.Reset();
+  ASSERT_EQ(arena.GetAllocatedBytes(), 0);
+  ASSERT_EQ(arena.GetReservedBytes(), 1024);
+  // the block kept is allocated from again
+  ASSERT_NE(arena.Allocate(8), nullptr);
+  ASSERT_EQ(arena.GetReservedBytes(), 1024);
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaPoolTest, ValuesAndTuplesTest) {
+  ArenaPool arena;
+  Value value = ValueFactory::GetVarcharValue(std::string("arena"), &arena);
+  ASSERT_EQ(value.ToString(), "arena");
+  ASSERT_EQ(arena.GetAllocatedBytes(), 8);
+  // copies share the bytes in the arena
+  Value copy = value;
+  ASSERT_EQ(copy.GetData(), value.GetData());
+  Value clone = ValueFactory::Clone(ValueFactory::GetVarcharValue(std::string("clone")), &arena);
+  ASSERT_EQ(clone.ToString(), "clone");
+  ASSERT_EQ(arena.GetAllocatedBytes(), 16);
+
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 16)});
+  Tuple tuple({ValueFactory::GetIntegerValue(7), value}, &schema, &arena);
+  ASSERT_FALSE(tuple.IsAllocated());
+  Tuple shared = tuple;
+  ASSERT_EQ(shared.GetData(), tuple.GetData());
+  shared.Materialize();
+  ASSERT_TRUE(shared.IsAllocated());
+  ASSERT_NE(shared.GetData(), tuple.GetData());
+  arena.Reset();
+  ASSERT_EQ(shared.GetValue(&schema, 0).GetAs<int32_t>(), 7);
+  ASSERT_EQ(shared.GetValue(&schema, 1).ToString(), "arena");
+}
+
+}  // namespace bustub
@@ -0,0 +1,131 @@
+// This source file was originally from:
+//   https://github.com/wangyi-fudan/wyhash
+//
+// We've changed it for use with BusTub:
+//   - Only the 64-bit hash (wyhash), the 64-bit integer mixer (wyhash64) and the default secret are kept; the random
+//     number generators, the 32-bit variants and the condom/endianness switches are dropped. The code assumes a
+//     little-endian target with 128-bit multiplication (gcc/clang on x86-64 or aarch64).
+//   - Everything lives in the wyhash namespace and the fixed secret is used unless one is passed in.
+
+//-----------------------------------------------------------------------------
+// wyhash was written by Wang Yi and is released into the public domain
+// (The Unlicense). The author hereby disclaims copyright to this source code.
+
+#ifndef _WYHASH_H_
+#define _WYHASH_H_
+
+#include <stdint.h>
+#include <string.h>
+
+namespace wyhash {
+
+#if defined(__GNUC__) || defined(__clang__)
+#define _wy_likely_(x) __builtin_expect(x, 1)
+#define _wy_unlikely_(x) __builtin_expect(x, 0)
+#else
+#define _wy_likely_(x) (x)
+#define _wy_unlikely_(x) (x)
+#endif
+
+//-----------------------------------------------------------------------------
+// default secret parameters
+
+static const uint64_t _wyp[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull,
+                                 0x4d5a2da51de1aa47ull};
+
+//-----------------------------------------------------------------------------
+// 128-bit multiply function
+
+static inline void _wymum(uint64_t *A, uint64_t *B) {
+  __uint128_t r = *A;
+  r *= *B;
+  *A = static_cast<uint64_t>(r);
+  *B = static_cast<uint64_t>(r >> 64);
+}
+
+// multiply and xor mix function, aka MUM
+static inline uint64_t _wymix(uint64_t A, uint64_t B) {
+  _wymum(&A, &B);
+  return A ^ B;
+}
+
+//-----------------------------------------------------------------------------
+// read functions
+
+static inline uint64_t _wyr8(const uint8_t *p) {
+  uint64_t v;
+  memcpy(&v, p, 8);
+  return v;
+}
+
+static inline uint64_t _wyr4(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+static inline uint64_t _wyr3(const uint8_t *p, size_t k) {
+  return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+//-----------------------------------------------------------------------------
+// wyhash main function
+
+static inline uint64_t wyhash(const void *key, size_t len, uint64_t seed, const uint64_t *secret = _wyp) {
+  const uint8_t *p = static_cast<const uint8_t *>(key);
+  seed ^= _wymix(seed ^ secret[0], secret[1]);
+  uint64_t a;
+  uint64_t b;
+  if (_wy_likely_(len <= 16)) {
+    if (_wy_likely_(len >= 4)) {
+      a = (_wyr4(p) << 32) | _wyr4(p + ((len >> 3) << 2));
+      b = (_wyr4(p + len - 4) << 32) | _wyr4(p + len - 4 - ((len >> 3) << 2));
+    } else if (_wy_likely_(len > 0)) {
+      a = _wyr3(p, len);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = len;
+    if (_wy_unlikely_(i > 48)) {
+      uint64_t see1 = seed;
+      uint64_t see2 = seed;
+      do {
+        seed = _wymix(_wyr8(p) ^ secret[1], _wyr8(p + 8) ^ seed);
+        see1 = _wymix(_wyr8(p + 16) ^ secret[2], _wyr8(p + 24) ^ see1);
+        see2 = _wymix(_wyr8(p + 32) ^ secret[3], _wyr8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (_wy_likely_(i > 48));
+      seed ^= see1 ^ see2;
+    }
+    while (_wy_unlikely_(i > 16)) {
+      seed = _wymix(_wyr8(p) ^ secret[1], _wyr8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = _wyr8(p + i - 16);
+    b = _wyr8(p + i - 8);
+  }
+  a ^= secret[1];
+  b ^= seed;
+  _wymum(&a, &b);
+  return _wymix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+// a useful 64bit-64bit mix function to produce deterministic pseudo random numbers that can pass BigCrush and PractRand
+static inline uint64_t wyhash64(uint64_t A, uint64_t B) {
+  A ^= 0x2d358dccaa6c78a5ull;
+  B ^= 0x8bb84b93962eacc9ull;
+  _wymum(&A, &B);
+  return _wymix(A ^ 0x2d358dccaa6c78a5ull, B ^ 0x8bb84b93962eacc9ull);
+}
+
+#undef _wy_likely_
+#undef _wy_unlikely_
+
+//-----------------------------------------------------------------------------
+
+}  // namespace wyhash
+#endif  // _WYHASH_H_